@@ -0,0 +1,79 @@
+/*
+ *
+ * 	Batch selection tool.
+ *
+ * 	Usage: batch [-j] [-c | -J | -b] [-t threads] input [output]
+ *
+ * 	Solves the design requests of input (CSV, or JSON lines with -j, see passive/BATCH.h) and
+ * 	writes one selection per request to output, or to the standard output, in the order of
+ * 	the input. Selections are written in the format of the input unless -c (CSV), -J (JSON
+ * 	lines) or -b (binary columns, see passive/COLUMNS.h) is given. Throughput is reported on
+ * 	the standard error.
+ *
+ * 	Build: cc -O2 -std=c99 -pthread batch.c -o batch -lm
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "passive/BATCH.h"
+
+int main(int argc, char** argv)
+{
+	BATCH_format format = BATCH_CSV;
+	BATCH_format output_format = -1;
+	BATCH_stats stats;
+	const char* input = NULL;
+	const char* output = NULL;
+	FILE* out = stdout;
+	int N_threads = 0;
+	int i, status;
+
+	for( i = 1 ; i < argc ; i++ )
+	{
+		if( strcmp( argv[i], "-j" ) == 0 ) format = BATCH_JSON;
+		else if( strcmp( argv[i], "-c" ) == 0 ) output_format = BATCH_CSV;
+		else if( strcmp( argv[i], "-J" ) == 0 ) output_format = BATCH_JSON;
+		else if( strcmp( argv[i], "-b" ) == 0 ) output_format = BATCH_BINARY;
+		else if( strcmp( argv[i], "-t" ) == 0 && i + 1 < argc ) N_threads = atoi( argv[++i] );
+		else if( input == NULL ) input = argv[i];
+		else if( output == NULL ) output = argv[i];
+		else
+		{
+			input = NULL;
+			break;
+		}
+	}
+
+	if( input == NULL )
+	{
+		fprintf( stderr, "usage: %s [-j] [-c | -J | -b] [-t threads] input [output]\n", argv[0] );
+		return(2);
+	}
+
+	if( (int)output_format < 0 ) output_format = format;
+
+	if( output != NULL && ( out = fopen( output, "wb" ) ) == NULL )
+	{
+		perror(output);
+		return(1);
+	}
+
+	status = BATCH_run( input, out, format, output_format, N_threads, &stats );
+
+	if( out != stdout && fclose(out) != 0 ) status = -1;
+
+	if( status < 0 )
+	{
+		fprintf( stderr, "%s: failed\n", input );
+		return(1);
+	}
+
+	fprintf( stderr, "%ld rows (%ld invalid) in %.3f s, %.0f rows/s\n", stats.rows, stats.invalid, stats.seconds, stats.rate );
+
+	return(0);
+}
@@ -0,0 +1,615 @@
+/*
+ *
+ * 	Benchmarks of the passive component functions.
+ *
+ * 	Usage: bench [--filter text] [--min-time seconds] [--max-space candidates]
+ * 	             [--baseline file] [--threshold percent] [--out file]
+ *
+ * 	Times every public function of RESISTOR.h, CAPACITOR.h, RC.h, wire.h and
+ * 	helper_functions.h, the sorted table search of SEARCH.h and the planner of PLANNER.h for
+ * 	every topology, for each of the seven EIA series. The selector benchmarks time the brute
+ * 	force loops (the *_BRUTE functions). Selectors are fed targets drawn log-uniformly over
+ * 	their range and values taken from real bills of materials; value and tolerance functions
+ * 	are fed standard values. Each benchmark repeats its function until --min-time (0.1 s) is
+ * 	spent. Brute force selectors whose search space exceeds --max-space (1e9 candidates) are
+ * 	skipped.
+ *
+ * 	Results are written as JSON: nanoseconds per query, candidates per query (the size of
+ * 	the brute force search space, or the number of network evaluations of a value function)
+ * 	and candidates per second. With --baseline, each benchmark is compared to the same
+ * 	benchmark of a previous output, and the tool exits with status 1 if any of them is slower
+ * 	by more than --threshold percent (10).
+ *
+ * 	Build: cc -O2 -std=c99 -pthread bench.c -o bench -lm
+ *
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "passive/PLANNER.h"
+#include "passive/wire.h"
+
+#define BENCH_TARGETS			1024
+#define BENCH_MAX_RESULTS		4096
+
+//	Inputs of a benchmark.
+
+typedef enum
+{
+	BENCH_NONE,								//	No input, or its own.
+	BENCH_SET,								//	Standard values.
+	BENCH_LOGUNIFORM,						//	Targets drawn log-uniformly.
+	BENCH_BOM								//	Targets from bills of materials.
+}BENCH_input;
+
+//	Range of the targets of a selector.
+
+typedef enum{ BENCH_RESISTANCE, BENCH_CAPACITANCE, BENCH_RATIO, BENCH_TIME } BENCH_domain;
+
+typedef struct
+{
+	const char* name;
+	BENCH_input input;
+	BENCH_domain domain;
+	int R_power, C_power;					//	Search space of NR^R_power * NC^C_power.
+	float evaluations;						//	Evaluations per candidate.
+	void (*run)(EIA_standard std, float x, int n);
+}BENCH_case;
+
+typedef struct
+{
+	char name[96];
+	double ns;
+	double candidates;
+	long iterations;
+	int skipped;
+	double baseline;						//	ns per query of the baseline, or 0.
+}BENCH_result;
+
+volatile float BENCH_sink;
+
+float BENCH_targets[4][2][BENCH_TARGETS];	//	By domain, for BENCH_LOGUNIFORM and BENCH_BOM.
+
+float BENCH_BOM_RESISTANCE[] =
+{
+	10e3f, 4.7e3f, 1e3f, 100e3f, 49.9f, 22.0f, 330.0f, 2.2e3f, 470.0f, 100.0f, 1.5e3f, 3.3e3f,
+	47e3f, 220e3f, 12.1e3f, 6.04e3f, 165.0f, 2.67e3f, 0.1f, 1e6f, 33.2e3f, 5.1e3f, 68.0f, 390e3f
+};
+
+float BENCH_BOM_CAPACITANCE[] =
+{
+	100e-9f, 10e-6f, 1e-6f, 4.7e-6f, 22e-12f, 15e-12f, 10e-9f, 470e-9f, 2.2e-6f, 47e-6f, 1e-9f,
+	33e-12f, 220e-9f, 100e-6f, 6.8e-9f, 18e-12f
+};
+
+float BENCH_BOM_RATIO[] =
+{
+	3.125f, 5.25f, 2.0f, 8.6f, 1.64f, 3.1667f, 0.5f, 3.065f, 0.1f, 10.0f, 0.2424f, 1.0f
+};
+
+float BENCH_BOM_TIME[] =
+{
+	1e-3f, 4.7e-4f, 1e-4f, 2.2e-5f, 1.5915e-4f, 3.1831e-6f, 0.015915f, 1e-2f, 0.1f, 1e-6f
+};
+
+/*	Part k of query n, taken from the standard values. */
+
+float BENCH_R(EIA_standard std, int n, int k)
+{
+	int N = RESISTOR_getSize(std);
+
+	return( RESISTOR_getSet(std)[ ( n * ( 2*k + 3 ) + 7*k ) % N ] );
+}
+
+float BENCH_C(EIA_standard std, int n, int k)
+{
+	int N = CAPACITOR_getSize(std);
+
+	return( CAPACITOR_getSet(std)[ ( n * ( 2*k + 3 ) + 7*k ) % N ] );
+}
+
+DUAL_t BENCH_DR(EIA_standard std, int n, int k, int N){ return( DUAL_variable( BENCH_R( std, n, k ), k, N ) ); }
+DUAL_t BENCH_DC(EIA_standard std, int n, int k, int N){ return( DUAL_variable( BENCH_C( std, n, k ), k, N ) ); }
+
+/*****			Benchmarked calls			*****/
+
+void BENCH_RESISTOR_init(EIA_standard std, float x, int n){ RESISTOR_init(); }
+void BENCH_RESISTOR_getSet(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_getSet(std)[n & 1]; }
+void BENCH_RESISTOR_ER2S(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_ER2S( BENCH_R(std,n,0), BENCH_R(std,n,1) ); }
+void BENCH_RESISTOR_ER2P(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_ER2P( BENCH_R(std,n,0), BENCH_R(std,n,1) ); }
+void BENCH_RESISTOR_ER3S(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_ER3S( BENCH_R(std,n,0), BENCH_R(std,n,1), BENCH_R(std,n,2) ); }
+void BENCH_RESISTOR_ER3P(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_ER3P( BENCH_R(std,n,0), BENCH_R(std,n,1), BENCH_R(std,n,2) ); }
+void BENCH_RESISTOR_ER2S_AD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_ER2S_AD( BENCH_DR(std,n,0,2), BENCH_DR(std,n,1,2) ).d[1]; }
+void BENCH_RESISTOR_ER2P_AD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_ER2P_AD( BENCH_DR(std,n,0,2), BENCH_DR(std,n,1,2) ).d[1]; }
+void BENCH_RESISTOR_ER3S_AD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_ER3S_AD( BENCH_DR(std,n,0,3), BENCH_DR(std,n,1,3), BENCH_DR(std,n,2,3) ).d[2]; }
+void BENCH_RESISTOR_ER3P_AD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_ER3P_AD( BENCH_DR(std,n,0,3), BENCH_DR(std,n,1,3), BENCH_DR(std,n,2,3) ).d[2]; }
+void BENCH_RESISTOR_1R(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_1R_BRUTE( x, std ); }
+void BENCH_RESISTOR_2RS(EIA_standard std, float x, int n){ float a, b; RESISTOR_2RS_BRUTE( x, std, &a, &b ); BENCH_sink = a + b; }
+void BENCH_RESISTOR_2RP(EIA_standard std, float x, int n){ float a, b; RESISTOR_2RP_BRUTE( x, std, &a, &b ); BENCH_sink = a + b; }
+void BENCH_RESISTOR_3RS(EIA_standard std, float x, int n){ float a, b, c; RESISTOR_3RS_BRUTE( x, std, &a, &b, &c ); BENCH_sink = a + b + c; }
+void BENCH_RESISTOR_3RP(EIA_standard std, float x, int n){ float a, b, c; RESISTOR_3RP_BRUTE( x, std, &a, &b, &c ); BENCH_sink = a + b + c; }
+void BENCH_RESISTOR_1R_SD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_1R_SD( BENCH_R(std,n,0), 5.0f ); }
+void BENCH_RESISTOR_2RS_SD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_2RS_SD( BENCH_R(std,n,0), BENCH_R(std,n,1), 5.0f ); }
+void BENCH_RESISTOR_2RP_SD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_2RP_SD( BENCH_R(std,n,0), BENCH_R(std,n,1), 5.0f ); }
+void BENCH_RESISTOR_3RS_SD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_3RS_SD( BENCH_R(std,n,0), BENCH_R(std,n,1), BENCH_R(std,n,2), 5.0f ); }
+void BENCH_RESISTOR_3RP_SD(EIA_standard std, float x, int n){ BENCH_sink = RESISTOR_3RP_SD( BENCH_R(std,n,0), BENCH_R(std,n,1), BENCH_R(std,n,2), 5.0f ); }
+void BENCH_RESISTOR_RATIO_1R(EIA_standard std, float x, int n){ float a, b; RESISTOR_RATIO_1R_BRUTE( x, std, 1e7f, 0.0f, &a, &b ); BENCH_sink = a + b; }
+void BENCH_RESISTOR_RATIO_2RS(EIA_standard std, float x, int n){ float a, b, c, d; RESISTOR_RATIO_2RS_BRUTE( x, std, 1e7f, 0.0f, &a, &b, &c, &d ); BENCH_sink = a + b + c + d; }
+void BENCH_RESISTOR_RATIO_2RP(EIA_standard std, float x, int n){ float a, b, c, d; RESISTOR_RATIO_2RP_BRUTE( x, std, 1e7f, 0.0f, &a, &b, &c, &d ); BENCH_sink = a + b + c + d; }
+
+void BENCH_CAPACITOR_init(EIA_standard std, float x, int n){ CAPACITOR_init(); }
+void BENCH_CAPACITOR_getSet(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_getSet(std)[n & 1]; }
+void BENCH_CAPACITOR_EC2S(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_EC2S( BENCH_C(std,n,0), BENCH_C(std,n,1) ); }
+void BENCH_CAPACITOR_EC2P(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_EC2P( BENCH_C(std,n,0), BENCH_C(std,n,1) ); }
+void BENCH_CAPACITOR_EC3S(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_EC3S( BENCH_C(std,n,0), BENCH_C(std,n,1), BENCH_C(std,n,2) ); }
+void BENCH_CAPACITOR_EC3P(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_EC3P( BENCH_C(std,n,0), BENCH_C(std,n,1), BENCH_C(std,n,2) ); }
+void BENCH_CAPACITOR_ECnS(EIA_standard std, float x, int n){ float C[4] = { BENCH_C(std,n,0), BENCH_C(std,n,1), BENCH_C(std,n,2), BENCH_C(std,n,3) }; BENCH_sink = CAPACITOR_ECnS( C, 4 ); }
+void BENCH_CAPACITOR_ECnP(EIA_standard std, float x, int n){ float C[4] = { BENCH_C(std,n,0), BENCH_C(std,n,1), BENCH_C(std,n,2), BENCH_C(std,n,3) }; BENCH_sink = CAPACITOR_ECnP( C, 4 ); }
+void BENCH_CAPACITOR_EC2S_AD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_EC2S_AD( BENCH_DC(std,n,0,2), BENCH_DC(std,n,1,2) ).d[1]; }
+void BENCH_CAPACITOR_EC2P_AD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_EC2P_AD( BENCH_DC(std,n,0,2), BENCH_DC(std,n,1,2) ).d[1]; }
+void BENCH_CAPACITOR_EC3S_AD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_EC3S_AD( BENCH_DC(std,n,0,3), BENCH_DC(std,n,1,3), BENCH_DC(std,n,2,3) ).d[2]; }
+void BENCH_CAPACITOR_EC3P_AD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_EC3P_AD( BENCH_DC(std,n,0,3), BENCH_DC(std,n,1,3), BENCH_DC(std,n,2,3) ).d[2]; }
+void BENCH_CAPACITOR_ECnS_AD(EIA_standard std, float x, int n){ DUAL_t C[4]; int k; for( k = 0 ; k < 4 ; k++ ) C[k] = BENCH_DC(std,n,k,4); BENCH_sink = CAPACITOR_ECnS_AD( C, 4 ).d[3]; }
+void BENCH_CAPACITOR_ECnP_AD(EIA_standard std, float x, int n){ DUAL_t C[4]; int k; for( k = 0 ; k < 4 ; k++ ) C[k] = BENCH_DC(std,n,k,4); BENCH_sink = CAPACITOR_ECnP_AD( C, 4 ).d[3]; }
+void BENCH_CAPACITOR_1C(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_1C_BRUTE( x, std ); }
+void BENCH_CAPACITOR_2CS(EIA_standard std, float x, int n){ float a, b; CAPACITOR_2CS_BRUTE( x, std, &a, &b ); BENCH_sink = a + b; }
+void BENCH_CAPACITOR_2CP(EIA_standard std, float x, int n){ float a, b; CAPACITOR_2CP_BRUTE( x, std, &a, &b ); BENCH_sink = a + b; }
+void BENCH_CAPACITOR_3CS(EIA_standard std, float x, int n){ float a, b, c; CAPACITOR_3CS_BRUTE( x, std, &a, &b, &c ); BENCH_sink = a + b + c; }
+void BENCH_CAPACITOR_3CP(EIA_standard std, float x, int n){ float a, b, c; CAPACITOR_3CP_BRUTE( x, std, &a, &b, &c ); BENCH_sink = a + b + c; }
+void BENCH_CAPACITOR_1C_SD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_1C_SD( BENCH_C(std,n,0), 10.0f ); }
+void BENCH_CAPACITOR_2CS_SD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_2CS_SD( BENCH_C(std,n,0), BENCH_C(std,n,1), 10.0f ); }
+void BENCH_CAPACITOR_2CP_SD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_2CP_SD( BENCH_C(std,n,0), BENCH_C(std,n,1), 10.0f ); }
+void BENCH_CAPACITOR_3CS_SD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_3CS_SD( BENCH_C(std,n,0), BENCH_C(std,n,1), BENCH_C(std,n,2), 10.0f ); }
+void BENCH_CAPACITOR_3CP_SD(EIA_standard std, float x, int n){ BENCH_sink = CAPACITOR_3CP_SD( BENCH_C(std,n,0), BENCH_C(std,n,1), BENCH_C(std,n,2), 10.0f ); }
+
+void BENCH_RC_init(EIA_standard std, float x, int n){ RC_init(); }
+void BENCH_RC_TC_1R1C(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_1R1C( BENCH_R(std,n,0), BENCH_C(std,n,1) ); }
+void BENCH_RC_TC_2RS1C(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_2RS1C( BENCH_R(std,n,0), BENCH_R(std,n,1), BENCH_C(std,n,2) ); }
+void BENCH_RC_TC_2RP1C(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_2RP1C( BENCH_R(std,n,0), BENCH_R(std,n,1), BENCH_C(std,n,2) ); }
+void BENCH_RC_TC_3RS1C(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_3RS1C( BENCH_R(std,n,0), BENCH_R(std,n,1), BENCH_R(std,n,2), BENCH_C(std,n,3) ); }
+void BENCH_RC_TC_3RP1C(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_3RP1C( BENCH_R(std,n,0), BENCH_R(std,n,1), BENCH_R(std,n,2), BENCH_C(std,n,3) ); }
+void BENCH_RC_TC_1R1C_AD(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_1R1C_AD( BENCH_DR(std,n,0,2), BENCH_DC(std,n,1,2) ).d[1]; }
+void BENCH_RC_TC_2RS1C_AD(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_2RS1C_AD( BENCH_DR(std,n,0,3), BENCH_DR(std,n,1,3), BENCH_DC(std,n,2,3) ).d[2]; }
+void BENCH_RC_TC_2RP1C_AD(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_2RP1C_AD( BENCH_DR(std,n,0,3), BENCH_DR(std,n,1,3), BENCH_DC(std,n,2,3) ).d[2]; }
+void BENCH_RC_TC_3RS1C_AD(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_3RS1C_AD( BENCH_DR(std,n,0,4), BENCH_DR(std,n,1,4), BENCH_DR(std,n,2,4), BENCH_DC(std,n,3,4) ).d[3]; }
+void BENCH_RC_TC_3RP1C_AD(EIA_standard std, float x, int n){ BENCH_sink = RC_TC_3RP1C_AD( BENCH_DR(std,n,0,4), BENCH_DR(std,n,1,4), BENCH_DR(std,n,2,4), BENCH_DC(std,n,3,4) ).d[3]; }
+void BENCH_RC_1R1C(EIA_standard std, float x, int n){ float R, C; RC_1R1C_BRUTE( x, std, std, 1e7f, 0.0f, 1.0f, 0.0f, &R, &C ); BENCH_sink = R * C; }
+void BENCH_RC_2RS1C(EIA_standard std, float x, int n){ float a, b, C; RC_2RS1C_BRUTE( x, std, std, 1e7f, 0.0f, 1.0f, 0.0f, &a, &b, &C ); BENCH_sink = a + b + C; }
+void BENCH_RC_2RP1C(EIA_standard std, float x, int n){ float a, b, C; RC_2RP1C_BRUTE( x, std, std, 1e7f, 0.0f, 1.0f, 0.0f, &a, &b, &C ); BENCH_sink = a + b + C; }
+void BENCH_RC_3RS1C(EIA_standard std, float x, int n){ float a, b, c, C; RC_3RS1C_BRUTE( x, std, std, 1e7f, 0.0f, 1.0f, 0.0f, &a, &b, &c, &C ); BENCH_sink = a + b + c + C; }
+void BENCH_RC_3RP1C(EIA_standard std, float x, int n){ float a, b, c, C; RC_3RP1C_BRUTE( x, std, std, 1e7f, 0.0f, 1.0f, 0.0f, &a, &b, &c, &C ); BENCH_sink = a + b + c + C; }
+
+//	Wire functions take frequencies from 50 Hz to 10 MHz, currents from 0.1 A to 20 A and
+//	current densities from 2 to 6 A/mm^2.
+
+float BENCH_frequency(int n){ return( 50.0f * powf( 2e5f, (float)( ( n * 37 ) % 101 ) / 100.0f ) ); }
+float BENCH_current(int n){ return( 0.1f * powf( 200.0f, (float)( ( n * 53 ) % 97 ) / 96.0f ) ); }
+float BENCH_density(int n){ return( 2e6f + 4e6f * (float)( ( n * 17 ) % 89 ) / 88.0f ); }
+
+void BENCH_WIRE_getSkinDepth(EIA_standard std, float x, int n){ BENCH_sink = WIRE_getSkinDepth( n & 1 ? ALUMINIUM : COPPER, BENCH_frequency(n) ); }
+void BENCH_WIRE_getMaxGauge(EIA_standard std, float x, int n){ BENCH_sink = (float)WIRE_getMaxGauge( n & 1 ? ALUMINIUM : COPPER, BENCH_current(n), BENCH_density(n), BENCH_frequency(n) ); }
+void BENCH_WIRE_getMinGauge(EIA_standard std, float x, int n){ BENCH_sink = (float)WIRE_getMinGauge( n & 1 ? ALUMINIUM : COPPER, BENCH_current(n), BENCH_density(n), BENCH_frequency(n) ); }
+void BENCH_WIRE_getParameters(EIA_standard std, float x, int n){ float d, A, r; WIRE_getParameters( n & 1 ? ALUMINIUM : COPPER, 5e-4f * SWG[n % 46], BENCH_frequency(n), &d, &A, &r ); BENCH_sink = d + A + r; }
+
+void BENCH_mean(EIA_standard std, float x, int n){ BENCH_sink = mean( RESISTOR_getSet(std), RESISTOR_getSize(std) ); }
+void BENCH_standard_deviation(EIA_standard std, float x, int n){ BENCH_sink = standard_deviation( RESISTOR_getSet(std), RESISTOR_getSize(std) ); }
+void BENCH_lower_bound(EIA_standard std, float x, int n){ BENCH_sink = (float)lower_bound( RESISTOR_getSet(std), RESISTOR_getSize(std), x ); }
+void BENCH_upper_bound(EIA_standard std, float x, int n){ BENCH_sink = (float)upper_bound( RESISTOR_getSet(std), RESISTOR_getSize(std), x ); }
+
+int BENCH_codes[ ( RESISTOR_MAX_POWER - RESISTOR_MIN_POWER + 1 ) * EIA_MAX_COUNT ];
+
+void BENCH_lower_bound_int(EIA_standard std, float x, int n)
+{
+	int N = RESISTOR_getSize(std);
+	int k;
+
+	if( n == 0 ) for( k = 0 ; k < N ; k++ ) BENCH_codes[k] = (int)( 100.0f * RESISTOR_getSet(std)[k] );
+
+	BENCH_sink = (float)lower_bound_int( BENCH_codes, N, (int)( 100.0f * x ) );
+}
+
+//	Sorted table search of every topology, with the search space of the matching selector.
+
+#define BENCH_SEARCH(topology)																\
+void BENCH_SEARCH_##topology(EIA_standard std, float x, int n)								\
+{																							\
+	SEARCH_query query;																		\
+	SEARCH_result result;																	\
+																							\
+	SEARCH_initQuery( &query, SEARCH_##topology, x, std );									\
+	SEARCH_run( &query, &result );															\
+	BENCH_sink = result.value;																\
+}
+
+BENCH_SEARCH(RESISTOR_1R) BENCH_SEARCH(RESISTOR_2RS) BENCH_SEARCH(RESISTOR_2RP) BENCH_SEARCH(RESISTOR_3RS) BENCH_SEARCH(RESISTOR_3RP)
+BENCH_SEARCH(CAPACITOR_1C) BENCH_SEARCH(CAPACITOR_2CS) BENCH_SEARCH(CAPACITOR_2CP) BENCH_SEARCH(CAPACITOR_3CS) BENCH_SEARCH(CAPACITOR_3CP)
+BENCH_SEARCH(RATIO_1R) BENCH_SEARCH(RATIO_2RS) BENCH_SEARCH(RATIO_2RP)
+BENCH_SEARCH(RC_1R1C) BENCH_SEARCH(RC_2RS1C) BENCH_SEARCH(RC_2RP1C) BENCH_SEARCH(RC_3RS1C) BENCH_SEARCH(RC_3RP1C)
+
+//	Selectors through the planner, which picks the brute force loop, the search or a threaded
+//	search for each call.
+
+#define BENCH_PLANNER(topology)																\
+void BENCH_PLANNER_##topology(EIA_standard std, float x, int n)							\
+{																							\
+	SEARCH_query query;																		\
+	SEARCH_result result;																	\
+																							\
+	SEARCH_initQuery( &query, SEARCH_##topology, x, std );									\
+	PLANNER_run( &query, &result );															\
+	BENCH_sink = result.value;																\
+}
+
+BENCH_PLANNER(RESISTOR_1R) BENCH_PLANNER(RESISTOR_2RS) BENCH_PLANNER(RESISTOR_2RP) BENCH_PLANNER(RESISTOR_3RS) BENCH_PLANNER(RESISTOR_3RP)
+BENCH_PLANNER(CAPACITOR_1C) BENCH_PLANNER(CAPACITOR_2CS) BENCH_PLANNER(CAPACITOR_2CP) BENCH_PLANNER(CAPACITOR_3CS) BENCH_PLANNER(CAPACITOR_3CP)
+BENCH_PLANNER(RATIO_1R) BENCH_PLANNER(RATIO_2RS) BENCH_PLANNER(RATIO_2RP)
+BENCH_PLANNER(RC_1R1C) BENCH_PLANNER(RC_2RS1C) BENCH_PLANNER(RC_2RP1C) BENCH_PLANNER(RC_3RS1C) BENCH_PLANNER(RC_3RP1C)
+
+#define BENCH_CASE(name, input, domain, R_power, C_power, evaluations)	{ #name, input, domain, R_power, C_power, evaluations, BENCH_##name }
+
+BENCH_case BENCH_cases[] =
+{
+	BENCH_CASE(RESISTOR_init,			BENCH_NONE,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_getSet,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_ER2S,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_ER2P,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_ER3S,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_ER3P,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_ER2S_AD,		BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_ER2P_AD,		BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_ER3S_AD,		BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_ER3P_AD,		BENCH_SET,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(RESISTOR_1R,				BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	1, 0, 1),
+	BENCH_CASE(RESISTOR_2RS,			BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	2, 0, 1),
+	BENCH_CASE(RESISTOR_2RP,			BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	2, 0, 1),
+	BENCH_CASE(RESISTOR_3RS,			BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	3, 0, 1),
+	BENCH_CASE(RESISTOR_3RP,			BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	3, 0, 1),
+	BENCH_CASE(RESISTOR_1R_SD,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 2),
+	BENCH_CASE(RESISTOR_2RS_SD,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 4),
+	BENCH_CASE(RESISTOR_2RP_SD,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 4),
+	BENCH_CASE(RESISTOR_3RS_SD,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 8),
+	BENCH_CASE(RESISTOR_3RP_SD,			BENCH_SET,			BENCH_RESISTANCE,	0, 0, 8),
+	BENCH_CASE(RESISTOR_RATIO_1R,		BENCH_LOGUNIFORM,	BENCH_RATIO,		2, 0, 1),
+	BENCH_CASE(RESISTOR_RATIO_2RS,		BENCH_LOGUNIFORM,	BENCH_RATIO,		4, 0, 1),
+	BENCH_CASE(RESISTOR_RATIO_2RP,		BENCH_LOGUNIFORM,	BENCH_RATIO,		4, 0, 1),
+
+	BENCH_CASE(CAPACITOR_init,			BENCH_NONE,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_getSet,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_EC2S,			BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_EC2P,			BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_EC3S,			BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_EC3P,			BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_ECnS,			BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_ECnP,			BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_EC2S_AD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_EC2P_AD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_EC3S_AD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_EC3P_AD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_ECnS_AD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_ECnP_AD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 1),
+	BENCH_CASE(CAPACITOR_1C,			BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 1, 1),
+	BENCH_CASE(CAPACITOR_2CS,			BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 2, 1),
+	BENCH_CASE(CAPACITOR_2CP,			BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 2, 1),
+	BENCH_CASE(CAPACITOR_3CS,			BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 3, 1),
+	BENCH_CASE(CAPACITOR_3CP,			BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 3, 1),
+	BENCH_CASE(CAPACITOR_1C_SD,			BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 2),
+	BENCH_CASE(CAPACITOR_2CS_SD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 4),
+	BENCH_CASE(CAPACITOR_2CP_SD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 4),
+	BENCH_CASE(CAPACITOR_3CS_SD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 8),
+	BENCH_CASE(CAPACITOR_3CP_SD,		BENCH_SET,			BENCH_CAPACITANCE,	0, 0, 8),
+
+	BENCH_CASE(RC_init,					BENCH_NONE,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_1R1C,				BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_2RS1C,				BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_2RP1C,				BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_3RS1C,				BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_3RP1C,				BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_1R1C_AD,			BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_2RS1C_AD,			BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_2RP1C_AD,			BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_3RS1C_AD,			BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_TC_3RP1C_AD,			BENCH_SET,			BENCH_TIME,			0, 0, 1),
+	BENCH_CASE(RC_1R1C,					BENCH_LOGUNIFORM,	BENCH_TIME,			1, 1, 1),
+	BENCH_CASE(RC_2RS1C,				BENCH_LOGUNIFORM,	BENCH_TIME,			2, 1, 1),
+	BENCH_CASE(RC_2RP1C,				BENCH_LOGUNIFORM,	BENCH_TIME,			2, 1, 1),
+	BENCH_CASE(RC_3RS1C,				BENCH_LOGUNIFORM,	BENCH_TIME,			3, 1, 1),
+	BENCH_CASE(RC_3RP1C,				BENCH_LOGUNIFORM,	BENCH_TIME,			3, 1, 1),
+
+	BENCH_CASE(WIRE_getSkinDepth,		BENCH_NONE,			BENCH_RESISTANCE,	0, 0, 1),
+	BENCH_CASE(WIRE_getMaxGauge,		BENCH_NONE,			BENCH_RESISTANCE,	0, 0, 46),
+	BENCH_CASE(WIRE_getMinGauge,		BENCH_NONE,			BENCH_RESISTANCE,	0, 0, 46),
+	BENCH_CASE(WIRE_getParameters,		BENCH_NONE,			BENCH_RESISTANCE,	0, 0, 1),
+
+	BENCH_CASE(mean,					BENCH_SET,			BENCH_RESISTANCE,	1, 0, 1),
+	BENCH_CASE(standard_deviation,		BENCH_SET,			BENCH_RESISTANCE,	1, 0, 1),
+	BENCH_CASE(lower_bound,				BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	1, 0, 1),
+	BENCH_CASE(upper_bound,				BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	1, 0, 1),
+	BENCH_CASE(lower_bound_int,			BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	1, 0, 1),
+
+	BENCH_CASE(SEARCH_RESISTOR_1R,		BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	1, 0, 1),
+	BENCH_CASE(SEARCH_RESISTOR_2RS,		BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	2, 0, 1),
+	BENCH_CASE(SEARCH_RESISTOR_2RP,		BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	2, 0, 1),
+	BENCH_CASE(SEARCH_RESISTOR_3RS,		BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	3, 0, 1),
+	BENCH_CASE(SEARCH_RESISTOR_3RP,		BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	3, 0, 1),
+	BENCH_CASE(SEARCH_CAPACITOR_1C,		BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 1, 1),
+	BENCH_CASE(SEARCH_CAPACITOR_2CS,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 2, 1),
+	BENCH_CASE(SEARCH_CAPACITOR_2CP,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 2, 1),
+	BENCH_CASE(SEARCH_CAPACITOR_3CS,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 3, 1),
+	BENCH_CASE(SEARCH_CAPACITOR_3CP,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 3, 1),
+	BENCH_CASE(SEARCH_RATIO_1R,			BENCH_LOGUNIFORM,	BENCH_RATIO,		2, 0, 1),
+	BENCH_CASE(SEARCH_RATIO_2RS,		BENCH_LOGUNIFORM,	BENCH_RATIO,		4, 0, 1),
+	BENCH_CASE(SEARCH_RATIO_2RP,		BENCH_LOGUNIFORM,	BENCH_RATIO,		4, 0, 1),
+	BENCH_CASE(SEARCH_RC_1R1C,			BENCH_LOGUNIFORM,	BENCH_TIME,			1, 1, 1),
+	BENCH_CASE(SEARCH_RC_2RS1C,			BENCH_LOGUNIFORM,	BENCH_TIME,			2, 1, 1),
+	BENCH_CASE(SEARCH_RC_2RP1C,			BENCH_LOGUNIFORM,	BENCH_TIME,			2, 1, 1),
+	BENCH_CASE(SEARCH_RC_3RS1C,			BENCH_LOGUNIFORM,	BENCH_TIME,			3, 1, 1),
+	BENCH_CASE(SEARCH_RC_3RP1C,			BENCH_LOGUNIFORM,	BENCH_TIME,			3, 1, 1),
+
+	BENCH_CASE(PLANNER_RESISTOR_1R,		BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	1, 0, 1),
+	BENCH_CASE(PLANNER_RESISTOR_2RS,	BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	2, 0, 1),
+	BENCH_CASE(PLANNER_RESISTOR_2RP,	BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	2, 0, 1),
+	BENCH_CASE(PLANNER_RESISTOR_3RS,	BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	3, 0, 1),
+	BENCH_CASE(PLANNER_RESISTOR_3RP,	BENCH_LOGUNIFORM,	BENCH_RESISTANCE,	3, 0, 1),
+	BENCH_CASE(PLANNER_CAPACITOR_1C,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 1, 1),
+	BENCH_CASE(PLANNER_CAPACITOR_2CS,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 2, 1),
+	BENCH_CASE(PLANNER_CAPACITOR_2CP,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 2, 1),
+	BENCH_CASE(PLANNER_CAPACITOR_3CS,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 3, 1),
+	BENCH_CASE(PLANNER_CAPACITOR_3CP,	BENCH_LOGUNIFORM,	BENCH_CAPACITANCE,	0, 3, 1),
+	BENCH_CASE(PLANNER_RATIO_1R,		BENCH_LOGUNIFORM,	BENCH_RATIO,		2, 0, 1),
+	BENCH_CASE(PLANNER_RATIO_2RS,		BENCH_LOGUNIFORM,	BENCH_RATIO,		4, 0, 1),
+	BENCH_CASE(PLANNER_RATIO_2RP,		BENCH_LOGUNIFORM,	BENCH_RATIO,		4, 0, 1),
+	BENCH_CASE(PLANNER_RC_1R1C,			BENCH_LOGUNIFORM,	BENCH_TIME,			1, 1, 1),
+	BENCH_CASE(PLANNER_RC_2RS1C,		BENCH_LOGUNIFORM,	BENCH_TIME,			2, 1, 1),
+	BENCH_CASE(PLANNER_RC_2RP1C,		BENCH_LOGUNIFORM,	BENCH_TIME,			2, 1, 1),
+	BENCH_CASE(PLANNER_RC_3RS1C,		BENCH_LOGUNIFORM,	BENCH_TIME,			3, 1, 1),
+	BENCH_CASE(PLANNER_RC_3RP1C,		BENCH_LOGUNIFORM,	BENCH_TIME,			3, 1, 1)
+};
+
+/*****			Harness			*****/
+
+/*	Fills the targets of every domain, drawn log-uniformly or from bills of materials. */
+
+void BENCH_initTargets()
+{
+	float low[4] = { 1.0f, 1e-12f, 0.01f, 1e-7f };
+	float high[4] = { 1e6f, 1e-2f, 100.0f, 1.0f };
+	float* bom[4] = { BENCH_BOM_RESISTANCE, BENCH_BOM_CAPACITANCE, BENCH_BOM_RATIO, BENCH_BOM_TIME };
+	int N_bom[4];
+	unsigned int state = 12345;
+	int d, k;
+
+	N_bom[0] = sizeof(BENCH_BOM_RESISTANCE) / sizeof(float);
+	N_bom[1] = sizeof(BENCH_BOM_CAPACITANCE) / sizeof(float);
+	N_bom[2] = sizeof(BENCH_BOM_RATIO) / sizeof(float);
+	N_bom[3] = sizeof(BENCH_BOM_TIME) / sizeof(float);
+
+	for( d = 0 ; d < 4 ; d++ )
+	{
+		for( k = 0 ; k < BENCH_TARGETS ; k++ )
+		{
+			state = state * 1103515245u + 12345u;
+
+			BENCH_targets[d][0][k] = low[d] * powf( high[d] / low[d], (float)( state >> 8 ) / 16777216.0f );
+			BENCH_targets[d][1][k] = bom[d][ k % N_bom[d] ];
+		}
+	}
+}
+
+/*	Runs one benchmark until min_time is spent, and returns its time per query in ns. */
+
+double BENCH_measure(BENCH_case* c, EIA_standard std, BENCH_input input, double min_time, long* iterations)
+{
+	float* target = ( input == BENCH_BOM ) ? BENCH_targets[c->domain][1] : BENCH_targets[c->domain][0];
+	double start, elapsed;
+	long n = 0, batch = 1, k;
+
+	//	A first call outside the timing builds lazily initialized tables.
+
+	c->run( std, target[0], 0 );
+
+	start = SEARCH_now();
+
+	do
+	{
+		for( k = 0 ; k < batch ; k++, n++ ) c->run( std, target[ n % BENCH_TARGETS ], (int)( n % 65536 ) );
+
+		elapsed = SEARCH_now() - start;
+
+		if( batch < ( 1L << 20 ) ) batch *= 2;
+	}
+	while( elapsed < min_time );
+
+	*iterations = n;
+
+	return( 1e9 * elapsed / (double)n );
+}
+
+/*	Reads the ns per query of each benchmark of a previous output. */
+
+int BENCH_loadBaseline(const char* path, BENCH_result* result, int N)
+{
+	FILE* in = fopen( path, "r" );
+	char* text;
+	char* s;
+	char* name;
+	char* end;
+	long size;
+	int k, found = 0;
+
+	if( in == NULL ) return(-1);
+
+	fseek( in, 0, SEEK_END );
+	size = ftell(in);
+	fseek( in, 0, SEEK_SET );
+
+	text = (char*)malloc( size + 1 );
+
+	if( text == NULL || fread( text, 1, size, in ) != (size_t)size )
+	{
+		free(text);
+		fclose(in);
+		return(-1);
+	}
+
+	text[size] = 0;
+	fclose(in);
+
+	for( s = strstr( text, "\"name\": \"" ) ; s != NULL ; s = strstr( s, "\"name\": \"" ) )
+	{
+		name = s + 9;
+		end = strchr( name, '"' );
+
+		if( end == NULL ) break;
+
+		*end = 0;
+		s = end + 1;
+		end = strchr( s, '}' );
+
+		if( end != NULL ) *end = 0;
+
+		for( k = 0 ; k < N ; k++ )
+		{
+			if( strcmp( result[k].name, name ) == 0 && strstr( s, "\"ns_per_query\": " ) != NULL )
+			{
+				result[k].baseline = atof( strstr( s, "\"ns_per_query\": " ) + 16 );
+				found++;
+			}
+		}
+
+		if( end == NULL ) break;
+
+		s = end + 1;
+	}
+
+	free(text);
+
+	return(found);
+}
+
+int main(int argc, char** argv)
+{
+	EIA_standard standards[7] =
+	{
+		EIA_STANDARD_E3, EIA_STANDARD_E6, EIA_STANDARD_E12, EIA_STANDARD_E24, EIA_STANDARD_E48, EIA_STANDARD_E96,
+		EIA_STANDARD_E192
+	};
+	const char* input_name[4] = { "none", "set", "loguniform", "bom" };
+	static BENCH_result result[BENCH_MAX_RESULTS];
+	const char* filter = NULL;
+	const char* baseline = NULL;
+	const char* output = NULL;
+	double min_time = 0.1, max_space = 1e9, threshold = 10.0, space;
+	FILE* out = stdout;
+	BENCH_case* c;
+	BENCH_input input;
+	int N = 0, regressions = 0;
+	int i, s, k, last;
+
+	for( i = 1 ; i < argc ; i++ )
+	{
+		if( i + 1 < argc && strcmp( argv[i], "--filter" ) == 0 ) filter = argv[++i];
+		else if( i + 1 < argc && strcmp( argv[i], "--min-time" ) == 0 ) min_time = atof( argv[++i] );
+		else if( i + 1 < argc && strcmp( argv[i], "--max-space" ) == 0 ) max_space = atof( argv[++i] );
+		else if( i + 1 < argc && strcmp( argv[i], "--baseline" ) == 0 ) baseline = argv[++i];
+		else if( i + 1 < argc && strcmp( argv[i], "--threshold" ) == 0 ) threshold = atof( argv[++i] );
+		else if( i + 1 < argc && strcmp( argv[i], "--out" ) == 0 ) output = argv[++i];
+		else
+		{
+			fprintf( stderr, "usage: %s [--filter text] [--min-time seconds] [--max-space candidates]\n"
+							 "       [--baseline file] [--threshold percent] [--out file]\n", argv[0] );
+			return(2);
+		}
+	}
+
+	RC_init();
+	BENCH_initTargets();
+
+	for( i = 0 ; i < (int)( sizeof(BENCH_cases) / sizeof(BENCH_case) ) ; i++ )
+	{
+		c = &BENCH_cases[i];
+
+		for( s = 0 ; s < 7 ; s++ )
+		{
+			for( input = c->input ; input <= ( c->input == BENCH_LOGUNIFORM ? BENCH_BOM : c->input ) ; input++ )
+			{
+				BENCH_result* r = &result[N];
+
+				//	Functions which do not depend on a standard are run once.
+
+				if( c->input == BENCH_NONE && s > 0 ) continue;
+
+				if( c->input == BENCH_NONE ) snprintf( r->name, sizeof(r->name), "%s", c->name );
+				else snprintf( r->name, sizeof(r->name), "%s/E%d/%s", c->name, (int)standards[s], input_name[input] );
+
+				if( filter != NULL && strstr( r->name, filter ) == NULL ) continue;
+
+				space = c->evaluations * pow( RESISTOR_getSize( standards[s] ), c->R_power ) * pow( CAPACITOR_getSize( standards[s] ), c->C_power );
+
+				r->candidates = space;
+				r->skipped = ( space > max_space && strncmp( c->name, "SEARCH_", 7 ) != 0 && strncmp( c->name, "PLANNER_", 8 ) != 0 );
+				r->ns = 0.0;
+				r->iterations = 0;
+				r->baseline = 0.0;
+
+				if( !r->skipped ) r->ns = BENCH_measure( c, standards[s], input, min_time, &r->iterations );
+
+				fprintf( stderr, "%-48s %14.1f ns %s\n", r->name, r->ns, r->skipped ? "(skipped)" : "" );
+
+				if( ++N == BENCH_MAX_RESULTS ) break;
+			}
+		}
+	}
+
+	if( baseline != NULL && BENCH_loadBaseline( baseline, result, N ) < 0 )
+	{
+		fprintf( stderr, "%s: cannot read baseline\n", baseline );
+		return(2);
+	}
+
+	if( output != NULL && ( out = fopen( output, "w" ) ) == NULL )
+	{
+		perror(output);
+		return(2);
+	}
+
+	fprintf( out, "{\n  \"min_time\": %g,\n  \"max_space\": %g,\n  \"benchmarks\": [\n", min_time, max_space );
+
+	for( k = 0 ; k < N ; k++ )
+	{
+		BENCH_result* r = &result[k];
+
+		last = ( k == N - 1 );
+
+		if( r->skipped )
+		{
+			fprintf( out, "    {\"name\": \"%s\", \"candidates_per_query\": %.6g, \"skipped\": true}%s\n", r->name, r->candidates, last ? "" : "," );
+			continue;
+		}
+
+		fprintf( out, "    {\"name\": \"%s\", \"iterations\": %ld, \"ns_per_query\": %.6g, \"candidates_per_query\": %.6g, \"candidates_per_second\": %.6g",
+				 r->name, r->iterations, r->ns, r->candidates, r->candidates * 1e9 / r->ns );
+
+		if( r->baseline > 0.0 )
+		{
+			fprintf( out, ", \"baseline_ns_per_query\": %.6g, \"change_percent\": %.2f", r->baseline, 100.0 * ( r->ns / r->baseline - 1.0 ) );
+
+			if( r->ns > r->baseline * ( 1.0 + 0.01 * threshold ) )
+			{
+				fprintf( stderr, "regression: %s %.1f ns (baseline %.1f ns)\n", r->name, r->ns, r->baseline );
+				regressions++;
+			}
+		}
+
+		fprintf( out, "}%s\n", last ? "" : "," );
+	}
+
+	fprintf( out, "  ]\n}\n" );
+
+	if( out != stdout ) fclose(out);
+
+	return( regressions > 0 ? 1 : 0 );
+}
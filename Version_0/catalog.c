@@ -0,0 +1,336 @@
+/*
+ *
+ * 	Component catalog tool.
+ *
+ * 	Usage: catalog build input.csv output
+ * 	       catalog generate rows output [--seed N]
+ * 	       catalog select catalog topology target [--package name]... [--tolerance percent]
+ * 	                      [--power W] [--tempco ppm] [--price max] [--stock N] [--count N]
+ *
+ * 	build converts a CSV catalog, one part per line
+ *
+ * 		part,element,value,tolerance,power,package,tempco,price,stock
+ *
+ * 	with element R or C, into the mapped format of passive/CATALOG.h; blank lines, lines
+ * 	starting with '#' and lines whose value is not a number, such as a header, are skipped.
+ * 	generate writes a catalog of random parts of vendor like packages, tolerances and prices,
+ * 	drawn from the E series. select filters the parts of the catalog and selects the parts of
+ * 	a topology (named as in passive/BATCH.h, e.g. RESISTOR_2RS) closest to a target with the
+ * 	selectors of passive/MIXED.h, then prints them with their part numbers. With --count, as
+ * 	many targets around the target are selected to time the search. The time to map, filter
+ * 	and search is reported on the standard error.
+ *
+ * 	Build: cc -O2 -std=c99 -pthread catalog.c -o catalog -lm
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "passive/BATCH.h"
+#include "passive/CATALOG.h"
+
+#define CATALOG_TOOL_LINE		1024
+
+float CATALOG_random(unsigned int* state)
+{
+	*state = *state * 1103515245u + 12345u;
+
+	return( (float)( *state >> 8 ) / 16777216.0f );
+}
+
+/*	Reads a CSV catalog into parts. Returns their number, or -1 on error. */
+
+long CATALOG_read(const char* path, CATALOG_part** part)
+{
+	char line[CATALOG_TOOL_LINE];
+	char* field[9];
+	char* end;
+	CATALOG_part* p;
+	FILE* in;
+	long N = 0, capacity = 0;
+	int k;
+
+	*part = NULL;
+
+	if( ( in = fopen( path, "r" ) ) == NULL ) return(-1);
+
+	while( fgets( line, sizeof(line), in ) != NULL )
+	{
+		line[ strcspn( line, "\r\n" ) ] = 0;
+
+		if( line[0] == 0 || line[0] == '#' ) continue;
+
+		for( k = 0, field[0] = line ; k < 8 && ( end = strchr( field[k], ',' ) ) != NULL ; k++ )
+		{
+			*end = 0;
+			field[k+1] = end + 1;
+		}
+
+		if( k < 8 || strtof( field[2], &end ) <= 0.0f || end == field[2] ) continue;
+
+		if( N == capacity )
+		{
+			capacity = 2 * capacity + 1024;
+			p = (CATALOG_part*)realloc( *part, sizeof(CATALOG_part) * capacity );
+
+			if( p == NULL ) break;
+
+			*part = p;
+		}
+
+		p = &(*part)[N];
+		p->element = ( field[1][0] == 'C' || field[1][0] == 'c' ) ? NETWORK_CAPACITOR : NETWORK_RESISTOR;
+		p->value = strtof( field[2], NULL );
+		p->tolerance = strtof( field[3], NULL );
+		p->power = strtof( field[4], NULL );
+		p->tempco = strtof( field[6], NULL );
+		p->price = strtof( field[7], NULL );
+		p->stock = (uint32_t)strtoul( field[8], NULL, 10 );
+		p->name = strdup( field[0] );
+
+		memset( p->package, 0, CATALOG_NAME );
+		strncpy( p->package, field[5], CATALOG_NAME - 1 );
+
+		if( p->name == NULL ) break;
+
+		N++;
+	}
+
+	if( ferror(in) || !feof(in) ) N = -1;
+
+	fclose(in);
+
+	return(N);
+}
+
+/*	Fills N random parts, with part numbers in names. */
+
+void CATALOG_generate(CATALOG_part* part, char* names, long N, unsigned int seed)
+{
+	const char* package[6] = { "0201", "0402", "0603", "0805", "1206", "2512" };
+	const float power[6] = { 0.05f, 0.063f, 0.1f, 0.125f, 0.25f, 1.0f };
+	const float R_tolerance[4] = { 0.1f, 0.5f, 1.0f, 5.0f };
+	const float C_tolerance[4] = { 1.0f, 5.0f, 10.0f, 20.0f };
+	const EIA_standard series[4] = { EIA_STANDARD_E192, EIA_STANDARD_E96, EIA_STANDARD_E96, EIA_STANDARD_E24 };
+	unsigned int state = seed * 2654435761u + 1u;
+	float* set;
+	long n;
+	int p, t, size;
+
+	for( n = 0 ; n < N ; n++ )
+	{
+		part[n].element = ( CATALOG_random(&state) < 0.7f ) ? NETWORK_RESISTOR : NETWORK_CAPACITOR;
+
+		p = (int)( 6.0f * CATALOG_random(&state) ) % 6;
+		t = (int)( 4.0f * CATALOG_random(&state) ) % 4;
+
+		if( part[n].element == NETWORK_RESISTOR )
+		{
+			set = RESISTOR_getSet( series[t] );
+			size = RESISTOR_getSize( series[t] );
+			part[n].tolerance = R_tolerance[t];
+			part[n].tempco = ( t < 2 ) ? 25.0f : ( t == 2 ) ? 100.0f : 200.0f;
+		}
+		else
+		{
+			set = CAPACITOR_getSet( series[ 3 - t / 2 ] );
+			size = CAPACITOR_getSize( series[ 3 - t / 2 ] );
+			part[n].tolerance = C_tolerance[t];
+			part[n].tempco = ( t < 2 ) ? 30.0f : 15000.0f;
+		}
+
+		part[n].value = set[ (int)( size * CATALOG_random(&state) ) % size ];
+		part[n].power = power[p];
+		part[n].price = 0.001f * (float)( 1 + (int)( 100.0f * CATALOG_random(&state) ) ) * ( 1.0f + p ) / ( 1.0f + t );
+		part[n].stock = ( CATALOG_random(&state) < 0.25f ) ? 0 : (uint32_t)( 100000.0f * CATALOG_random(&state) );
+
+		memset( part[n].package, 0, CATALOG_NAME );
+		strcpy( part[n].package, package[p] );
+
+		snprintf( names + 24 * n, 24, "%c%s-%08ld", ( part[n].element == NETWORK_RESISTOR ) ? 'R' : 'C', package[p], n );
+		part[n].name = names + 24 * n;
+	}
+}
+
+int CATALOG_select(int argc, char** argv)
+{
+	CATALOG_file file;
+	CATALOG_filter filter;
+	CATALOG_set set[2];
+	MIXED_set mixed[SEARCH_MAX_PARTS];
+	SEARCH_topology topology;
+	NETWORK_element element;
+	float part[SEARCH_MAX_PARTS];
+	float* output[SEARCH_MAX_PARTS];
+	float target, X, value;
+	double start, t_map, t_filter, t_search;
+	unsigned int state = 1;
+	int64_t row;
+	int N_parts, count = 1, code, k, e;
+
+	if( argc < 5 || !BATCH_parseTopology( argv[3], (int)strlen( argv[3] ), &topology ) || ( target = strtof( argv[4], NULL ) ) <= 0.0f ) return(2);
+
+	start = SEARCH_now();
+
+	if( CATALOG_map( argv[2], &file ) < 0 )
+	{
+		fprintf( stderr, "%s: not a catalog\n", argv[2] );
+		return(1);
+	}
+
+	t_map = SEARCH_now() - start;
+
+	CATALOG_initFilter( &filter, NETWORK_RESISTOR );
+
+	for( k = 5 ; k < argc ; k++ )
+	{
+		if( k + 1 < argc && strcmp( argv[k], "--package" ) == 0 )
+		{
+			if( ( code = CATALOG_getPackage( &file, argv[++k] ) ) < 0 )
+			{
+				fprintf( stderr, "no part in package %s\n", argv[k] );
+				return(1);
+			}
+
+			filter.packages |= (uint64_t)1 << code;
+		}
+		else if( k + 1 < argc && strcmp( argv[k], "--tolerance" ) == 0 ) filter.tolerance_max = strtof( argv[++k], NULL );
+		else if( k + 1 < argc && strcmp( argv[k], "--power" ) == 0 ) filter.power_min = strtof( argv[++k], NULL );
+		else if( k + 1 < argc && strcmp( argv[k], "--tempco" ) == 0 ) filter.tempco_max = strtof( argv[++k], NULL );
+		else if( k + 1 < argc && strcmp( argv[k], "--price" ) == 0 ) filter.price_max = strtof( argv[++k], NULL );
+		else if( k + 1 < argc && strcmp( argv[k], "--stock" ) == 0 ) filter.stock_min = (uint32_t)strtoul( argv[++k], NULL, 10 );
+		else if( k + 1 < argc && strcmp( argv[k], "--count" ) == 0 ) count = atoi( argv[++k] );
+		else return(2);
+	}
+
+	//	The values of each element accepted by the filter.
+
+	start = SEARCH_now();
+
+	for( e = NETWORK_RESISTOR ; e <= NETWORK_CAPACITOR ; e++ )
+	{
+		filter.element = (NETWORK_element)e;
+
+		if( CATALOG_getSet( &file, &filter, &set[e] ) < 0 )
+		{
+			fprintf( stderr, "too many values or out of memory\n" );
+			return(1);
+		}
+	}
+
+	t_filter = SEARCH_now() - start;
+
+	N_parts = SEARCH_getParts(topology);
+
+	for( k = 0 ; k < N_parts ; k++ )
+	{
+		mixed[k] = set[ COLUMNS_getElement( topology, k, N_parts ) ].set;
+		output[k] = &part[k];
+	}
+
+	start = SEARCH_now();
+
+	for( k = 1 ; k < count ; k++ )
+	{
+		X = target * powf( 10.0f, 2.0f * CATALOG_random(&state) - 1.0f );
+
+		MIXED_select( topology, X, mixed, INFINITY, 0.0f, INFINITY, 0.0f, output );
+	}
+
+	MIXED_select( topology, target, mixed, INFINITY, 0.0f, INFINITY, 0.0f, output );
+
+	t_search = ( SEARCH_now() - start ) / ( count > 0 ? count : 1 );
+
+	for( k = 0 ; k < N_parts ; k++ )
+	{
+		element = COLUMNS_getElement( topology, k, N_parts );
+		row = CATALOG_getRow( &set[element], part[k] );
+
+		if( row < 0 )
+		{
+			printf( "part %d: none\n", k + 1 );
+			continue;
+		}
+
+		printf( "part %d: %-14g %-20s %-6s %5g %% %8.4f %8u in stock\n", k + 1, part[k], file.names + file.name[row],
+				file.package_name + CATALOG_NAME * file.package[row], file.tolerance[row], file.price[row], file.stock[row] );
+	}
+
+	if( !isnan( part[0] ) )
+	{
+		value = SEARCH_evaluate( topology, part );
+		printf( "value %.9g, error %.3g %%\n", value, 100.0f * fabsf( value - target ) / target );
+	}
+
+	fprintf( stderr, "%lu rows mapped in %.3f ms, %d resistor and %d capacitor values in %.3f ms, %.3f ms per search\n",
+			 (unsigned long)file.rows, 1e3 * t_map, set[0].N, set[1].N, 1e3 * t_filter, 1e3 * t_search );
+
+	CATALOG_freeSet( &set[0] );
+	CATALOG_freeSet( &set[1] );
+	CATALOG_unmap( &file );
+
+	return(0);
+}
+
+int main(int argc, char** argv)
+{
+	CATALOG_part* part = NULL;
+	char* names = NULL;
+	long N = -1;
+	unsigned int seed = 1;
+	int status = 2;
+
+	if( argc >= 4 && strcmp( argv[1], "build" ) == 0 )
+	{
+		N = CATALOG_read( argv[2], &part );
+
+		if( N < 0 )
+		{
+			fprintf( stderr, "%s: cannot be read\n", argv[2] );
+			return(1);
+		}
+
+		status = ( CATALOG_write( argv[3], part, (uint64_t)N ) == 0 ) ? 0 : 1;
+	}
+	else if( argc >= 4 && strcmp( argv[1], "generate" ) == 0 && ( N = atol( argv[2] ) ) > 0 )
+	{
+		if( argc >= 6 && strcmp( argv[4], "--seed" ) == 0 ) seed = (unsigned int)atoi( argv[5] );
+
+		part = (CATALOG_part*)malloc( sizeof(CATALOG_part) * N );
+		names = (char*)malloc( 24 * (size_t)N );
+
+		if( part == NULL || names == NULL )
+		{
+			fprintf( stderr, "out of memory\n" );
+			return(1);
+		}
+
+		CATALOG_generate( part, names, N, seed );
+
+		status = ( CATALOG_write( argv[3], part, (uint64_t)N ) == 0 ) ? 0 : 1;
+		N = 0;
+	}
+	else if( argc >= 2 && strcmp( argv[1], "select" ) == 0 ) status = CATALOG_select( argc, argv );
+
+	if( status == 2 )
+	{
+		fprintf( stderr, "usage: %s build input.csv output\n"
+						 "       %s generate rows output [--seed N]\n"
+						 "       %s select catalog topology target [--package name]... [--tolerance percent]\n"
+						 "                      [--power W] [--tempco ppm] [--price max] [--stock N] [--count N]\n", argv[0], argv[0], argv[0] );
+	}
+	else if( status == 1 && part != NULL ) fprintf( stderr, "%s: cannot be written\n", argv[3] );
+
+	//	Part numbers read from a file were allocated one by one.
+
+	while( N > 0 ) free( (void*)part[--N].name );
+
+	free(part);
+	free(names);
+
+	return(status);
+}
@@ -0,0 +1,11 @@
+/*
+ *
+ * 	Shared library exposing the batch interface of passive/ABI.h.
+ *
+ * 	Build: cc -O2 -std=c99 -pthread -shared -fPIC libpassive.c -o libpassive.so -lm
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "passive/ABI.h"
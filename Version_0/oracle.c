@@ -0,0 +1,1509 @@
+/*
+ *
+ * 	Differential check of the search engines against the brute force selectors.
+ *
+ * 	Usage: oracle [--filter text] [--count N] [--budget candidates] [--seed N]
+ * 	              [--precision float|double|long] [--metric absolute|relative|log]
+ * 	              [--resistors low high] [--capacitors low high] [--series m1,m2,...]
+ *
+ * 	The brute force selectors of RESISTOR.h, CAPACITOR.h and RC.h are the reference: for
+ * 	every topology and standard, the same queries are run through them, through the sorted
+ * 	table search of SEARCH.h and through the planner of PLANNER.h, and the errors of the
+ * 	selections must agree to within a few units in the last place of the target. When the
+ * 	brute force and the search are equally close but with different parts the query is
+ * 	counted as a tie. Queries are --count (100) log-uniform targets, plus edge cases: standard
+ * 	values, decade boundaries and values next to them, midpoints of neighbouring values,
+ * 	targets outside the range of the sets, and, for the selectors taking bounds, bounds which
+ * 	exclude every part or admit a single value. When no part lies within the bounds the brute
+ * 	force selectors leave their outputs untouched, and the search must return no selection.
+ *
+ * 	With --precision double or long, the search and the planner compare candidates in that
+ * 	precision, and the brute force selection, still made in float, is measured in it too. The
+ * 	search must then be as close as the brute force to within a few units in the last place
+ * 	of that precision, and may only be closer by the rounding of float.
+ * 	With --metric relative, errors are relative to the target, which orders candidates as the
+ * 	absolute errors of the brute force do. With --metric log, the brute force selection may be
+ * 	farther from the target than the one of the search, which must only not be worse.
+ *
+ * 	--resistors and --capacitors set the decades of the standard values (see
+ * 	SYNTHESIS_setRange()), from 10^low to 10^(high+1). --series adds a custom series of
+ * 	mantissas (see EIA_addSeries()), checked after E3 to E192.
+ *
+ * 	The selectors of MIXED.h, which take one set of values per part, are checked against a
+ * 	brute force enumeration of the same sets: each series with the next one, and with a stock
+ * 	list of every other value of the next one.
+ *
+ * 	The yield searches of YIELD.h are checked, for E12 and E24 and both distributions, against
+ * 	a brute force Monte Carlo: every combination of parts within the bounds is evaluated on
+ * 	all the sampled builds the search shares, and the best yield must be the one the search
+ * 	returns. The yield of its selection is also estimated again on ORACLE_YIELD_BUILDS fresh
+ * 	builds, and must agree within the sampling error of both estimates.
+ *
+ * 	The sharded searches of SHARD.h are checked, for E24, on ORACLE_SHARD_WORKERS local
+ * 	workers: the merged lists of the ORACLE_SHARD_K best selections must be those of
+ * 	SEARCH_runTop() over the whole range, also once a worker has been killed and another
+ * 	answers with malformed replies. A batch of the E24 cases of every topology run on the
+ * 	work-stealing scheduler of SCHEDULER.h, or submitted as jobs of ASYNC.h, must give the
+ * 	selections of SEARCH_run(); jobs must report their progress in order, and keep to their
+ * 	cancellation, time budget and accepted error. A forked query daemon of DAEMON.h must answer batches of
+ * 	mixed search and wire requests as this process does, count them in its metrics and exit
+ * 	on DAEMON_SHUTDOWN.
+ *
+ * 	Brute force calls are limited to --budget (1e9) candidates per topology and standard, so
+ * 	that fewer random targets are run on large search spaces. The time of both engines and
+ * 	the speedup are reported for each topology and standard; the tool exits with status 1 if
+ * 	any query disagrees.
+ *
+ * 	Build: cc -O2 -std=c99 -pthread oracle.c -o oracle -lm
+ *
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <float.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "passive/ASYNC.h"
+#include "passive/DAEMON.h"
+#include "passive/MIXED.h"
+#include "passive/PLANNER.h"
+#include "passive/YIELD.h"
+
+#define ORACLE_MAX_CASES		4096
+#define ORACLE_ULPS				8.0f
+#define ORACLE_YIELD_SAMPLES	256				//	Builds shared by the candidates of a yield search.
+#define ORACLE_YIELD_BUILDS		8192			//	Fresh builds estimating the yield of its selection.
+#define ORACLE_SHARD_WORKERS	4
+#define ORACLE_SHARD_K			8
+#define ORACLE_SCHEDULER_THREADS	4
+#define ORACLE_ASYNC_THREADS	4
+
+typedef struct
+{
+	float target;
+	float R_max, R_min;
+	float C_max, C_min;
+}ORACLE_case;
+
+const char* ORACLE_name[] =
+{
+	"RESISTOR_1R", "RESISTOR_2RS", "RESISTOR_2RP", "RESISTOR_3RS", "RESISTOR_3RP",
+	"CAPACITOR_1C", "CAPACITOR_2CS", "CAPACITOR_2CP", "CAPACITOR_3CS", "CAPACITOR_3CP",
+	"RESISTOR_RATIO_1R", "RESISTOR_RATIO_2RS", "RESISTOR_RATIO_2RP",
+	"RC_1R1C", "RC_2RS1C", "RC_2RP1C", "RC_3RS1C", "RC_3RP1C"
+};
+
+const char* ORACLE_mixedName[] =
+{
+	"MIXED_1R", "MIXED_2RS", "MIXED_2RP", "MIXED_3RS", "MIXED_3RP",
+	"MIXED_1C", "MIXED_2CS", "MIXED_2CP", "MIXED_3CS", "MIXED_3CP",
+	"MIXED_RATIO_1R", "MIXED_RATIO_2RS", "MIXED_RATIO_2RP",
+	"MIXED_RC_1R1C", "MIXED_RC_2RS1C", "MIXED_RC_2RP1C", "MIXED_RC_3RS1C", "MIXED_RC_3RP1C"
+};
+
+//	Yield search: its network, its N_R resistors followed by a capacitor if it has more parts,
+//	a window of relative half width around the target, the bounds of the parts and their
+//	tolerances in percent. The searches enumerate interchangeable parts once, in increasing
+//	order, and since each part of a build has its own deviations the brute force must too:
+//	bit k of ordered is set if part k is not below part k-1.
+
+typedef struct
+{
+	const char* name;
+	YIELD_network network;
+	int N_parts, N_R, ordered;
+	float target, window;
+	float R_max, R_min, C_max, C_min;
+	float T_R, T_C;
+}ORACLE_yieldCase;
+
+ORACLE_yieldCase ORACLE_yieldCases[] =
+{
+	{ "YIELD_RESISTOR_1R", YIELD_network1R, 1, 1, 0, 4321.0f, 0.01f, INFINITY, 0.0f, INFINITY, 0.0f, 1.0f, 0.0f },
+	{ "YIELD_RESISTOR_2RS", YIELD_network2RS, 2, 2, 0x2, 4321.0f, 0.005f, INFINITY, 0.0f, INFINITY, 0.0f, 1.0f, 0.0f },
+	{ "YIELD_RESISTOR_2RP", YIELD_network2RP, 2, 2, 0x2, 4321.0f, 0.005f, INFINITY, 0.0f, INFINITY, 0.0f, 1.0f, 0.0f },
+	{ "YIELD_RESISTOR_RATIO_1R", YIELD_networkRatio1R, 2, 2, 0, 2.345f, 0.01f, 1e5f, 1e3f, INFINITY, 0.0f, 1.0f, 0.0f },
+	{ "YIELD_RESISTOR_RATIO_2RS", YIELD_networkRatio2RS, 4, 4, 0xA, 2.345f, 0.005f, 1e4f, 1e3f, INFINITY, 0.0f, 1.0f, 0.0f },
+	{ "YIELD_RESISTOR_RATIO_2RP", YIELD_networkRatio2RP, 4, 4, 0xA, 2.345f, 0.005f, 1e4f, 1e3f, INFINITY, 0.0f, 1.0f, 0.0f },
+	{ "YIELD_RC_1R1C", YIELD_network1R1C, 2, 1, 0, 1.234e-4f, 0.02f, 1e5f, 1e3f, 1e-7f, 1e-9f, 1.0f, 5.0f },
+	{ "YIELD_RC_2RS1C", YIELD_network2RS1C, 3, 2, 0x2, 1.234e-4f, 0.02f, 1e5f, 1e3f, 1e-7f, 1e-9f, 1.0f, 5.0f },
+	{ "YIELD_RC_2RP1C", YIELD_network2RP1C, 3, 2, 0x2, 1.234e-4f, 0.02f, 1e5f, 1e3f, 1e-7f, 1e-9f, 1.0f, 5.0f },
+	{ "YIELD_RC_3RS1C", YIELD_network3RS1C, 4, 3, 0x6, 1.234e-4f, 0.02f, 1e4f, 1e3f, 1e-7f, 1e-8f, 1.0f, 5.0f },
+	{ "YIELD_RC_3RP1C", YIELD_network3RP1C, 4, 3, 0x6, 1.234e-4f, 0.02f, 1e4f, 1e3f, 1e-7f, 1e-8f, 1.0f, 5.0f }
+};
+
+/*	Returns 1 if a topology takes bounds on its parts. */
+
+int ORACLE_isBounded(SEARCH_topology topology)
+{
+	return( topology >= SEARCH_RATIO_1R );
+}
+
+/*	Size of the brute force search space of a query. */
+
+double ORACLE_space(SEARCH_topology topology, EIA_standard std)
+{
+	double NR = RESISTOR_getSize(std);
+	double NC = CAPACITOR_getSize(std);
+
+	switch(topology)
+	{
+		case(SEARCH_RATIO_1R):	return( NR * NR );
+		case(SEARCH_RATIO_2RS):
+		case(SEARCH_RATIO_2RP):	return( NR * NR * NR * NR );
+		case(SEARCH_RC_1R1C):	return( NR * NC );
+		case(SEARCH_RC_2RS1C):
+		case(SEARCH_RC_2RP1C):	return( NR * NR * NC );
+		case(SEARCH_RC_3RS1C):
+		case(SEARCH_RC_3RP1C):	return( NR * NR * NR * NC );
+		default: break;
+	}
+
+	if( topology >= SEARCH_CAPACITOR_1C ) return( pow( NC, SEARCH_getParts(topology) ) );
+
+	return( pow( NR, SEARCH_getParts(topology) ) );
+}
+
+float ORACLE_random(unsigned int* state)
+{
+	*state = *state * 1103515245u + 12345u;
+
+	return( (float)( *state >> 8 ) / 16777216.0f );
+}
+
+void ORACLE_add(ORACLE_case* cases, int* N, float target, float R_max, float R_min, float C_max, float C_min)
+{
+	if( *N == ORACLE_MAX_CASES ) return;
+
+	cases[*N].target = target;
+	cases[*N].R_max = R_max;
+	cases[*N].R_min = R_min;
+	cases[*N].C_max = C_max;
+	cases[*N].C_min = C_min;
+
+	(*N)++;
+}
+
+/*
+ * ORACLE_cases(topology, std, count, seed, cases)
+ *
+ * Description:
+ *
+ * Builds the edge cases and count random targets of a topology and standard, and returns
+ * their number.
+ *
+ */
+
+int ORACLE_cases(SEARCH_topology topology, EIA_standard std, int count, unsigned int seed, ORACLE_case* cases)
+{
+	float low, high;
+	float* set;
+	int N_set, N = 0, k, d;
+	unsigned int state = seed * 2654435761u + (unsigned int)( 97 * topology + std );
+
+	//	Range of the targets and values placed on them.
+
+	if( topology >= SEARCH_CAPACITOR_1C && topology <= SEARCH_CAPACITOR_3CP )
+	{
+		set = CAPACITOR_getSet(std);
+		N_set = CAPACITOR_getSize(std);
+	}
+	else
+	{
+		set = RESISTOR_getSet(std);
+		N_set = RESISTOR_getSize(std);
+	}
+
+	switch(topology)
+	{
+		case(SEARCH_RATIO_1R):
+		case(SEARCH_RATIO_2RS):
+		case(SEARCH_RATIO_2RP):	low = 1e-3f; high = 1e3f; break;
+		case(SEARCH_RC_1R1C):
+		case(SEARCH_RC_2RS1C):
+		case(SEARCH_RC_2RP1C):
+		case(SEARCH_RC_3RS1C):
+		case(SEARCH_RC_3RP1C):	low = 1e-9f; high = 1e2f; break;
+		default:				low = set[0] / 3.0f; high = set[N_set-1] * 3.0f; break;
+	}
+
+	//	Standard values, their midpoints and values next to them.
+
+	for( k = 0 ; k < N_set ; k += 1 + N_set / 8 )
+	{
+		if( topology >= SEARCH_RATIO_1R ) break;
+
+		ORACLE_add( cases, &N, set[k], INFINITY, 0.0f, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, nextafterf( set[k], INFINITY ), INFINITY, 0.0f, INFINITY, 0.0f );
+
+		if( k + 1 < N_set ) ORACLE_add( cases, &N, 0.5f * ( set[k] + set[k+1] ), INFINITY, 0.0f, INFINITY, 0.0f );
+	}
+
+	//	Decade boundaries and values next to them.
+
+	for( d = (int)floorf( log10f(low) ) ; d <= (int)ceilf( log10f(high) ) ; d++ )
+	{
+		float x = powf( 10.0f, (float)d );
+
+		ORACLE_add( cases, &N, x, INFINITY, 0.0f, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, x * 0.999f, INFINITY, 0.0f, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, x * 1.001f, INFINITY, 0.0f, INFINITY, 0.0f );
+	}
+
+	//	Targets outside the range of the sets, and ties of simple ratios.
+
+	ORACLE_add( cases, &N, low * 0.1f, INFINITY, 0.0f, INFINITY, 0.0f );
+	ORACLE_add( cases, &N, high * 10.0f, INFINITY, 0.0f, INFINITY, 0.0f );
+	ORACLE_add( cases, &N, high * 1e3f, INFINITY, 0.0f, INFINITY, 0.0f );
+
+	if( topology >= SEARCH_RATIO_1R && topology <= SEARCH_RATIO_2RP )
+	{
+		ORACLE_add( cases, &N, 1.0f, INFINITY, 0.0f, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, 2.0f, INFINITY, 0.0f, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, 0.5f, INFINITY, 0.0f, INFINITY, 0.0f );
+	}
+
+	//	Bounds which exclude every part, or admit a single value or decade.
+
+	if( ORACLE_isBounded(topology) )
+	{
+		float R = RESISTOR_getSet(std)[ RESISTOR_getSize(std) / 2 ];
+		float C = CAPACITOR_getSet(std)[ CAPACITOR_getSize(std) / 2 ];
+		float x = sqrtf( low * high );
+
+		ORACLE_add( cases, &N, x, 0.5f, 0.1f, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, x, 1e9f, 1e8f, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, x, 100.0f, 200.0f, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, x, R, R, INFINITY, 0.0f );
+		ORACLE_add( cases, &N, x, 10e3f, 1e3f, INFINITY, 0.0f );
+
+		if( topology >= SEARCH_RC_1R1C )
+		{
+			ORACLE_add( cases, &N, x, INFINITY, 0.0f, 1e-14f, 0.0f );
+			ORACLE_add( cases, &N, x, INFINITY, 0.0f, C, C );
+			ORACLE_add( cases, &N, x, R, R, C, C );
+			ORACLE_add( cases, &N, x, 100e3f, 1e3f, 1e-6f, 1e-9f );
+		}
+	}
+
+	//	Random targets.
+
+	for( k = 0 ; k < count ; k++ ) ORACLE_add( cases, &N, low * powf( high / low, ORACLE_random(&state) ), INFINITY, 0.0f, INFINITY, 0.0f );
+
+	return(N);
+}
+
+/*	Returns 1 if the selection b is as close to the target as the brute force selection a, to
+	within a few units in the last place of the precision of the query. a is chosen in float:
+	in a wider precision b may be closer by the rounding of float, and in the logarithmic
+	metric, for which a is not the reference, b must only not be farther. */
+
+int ORACLE_agree(SEARCH_result* a, SEARCH_result* b, SEARCH_query* query)
+{
+	double scale, epsilon;
+
+	if( a->N_parts == 0 || b->N_parts == 0 ) return( a->N_parts == b->N_parts );
+
+	switch(query->precision)
+	{
+		case(SEARCH_DOUBLE):		epsilon = DBL_EPSILON; break;
+		case(SEARCH_LONG_DOUBLE):	epsilon = LDBL_EPSILON; break;
+		default:					epsilon = FLT_EPSILON; break;
+	}
+
+	scale = fmax( (double)query->target, fmax( a->value, b->value ) );
+
+	if( query->metric != SEARCH_ABSOLUTE ) scale /= query->target;
+
+	if( b->error - a->error > ORACLE_ULPS * epsilon * scale ) return(0);
+
+	return( query->metric == SEARCH_LOGARITHMIC || a->error - b->error <= ORACLE_ULPS * FLT_EPSILON * scale );
+}
+
+int ORACLE_sameParts(SEARCH_result* a, SEARCH_result* b, SEARCH_query* query)
+{
+	SEARCH_result x = *a, y = *b;
+	int k;
+
+	SEARCH_canonical( &x, query );
+	SEARCH_canonical( &y, query );
+
+	for( k = 0 ; k < x.N_parts ; k++ ) if( x.part[k] != y.part[k] ) return(0);
+
+	return(1);
+}
+
+/*	Brute force selection from one set per part: every combination of the values within the
+	bounds of their parts, as MIXED_select() takes them. */
+
+void ORACLE_enumerate(SEARCH_topology topology, float X, MIXED_set* set, float* bound, int k, float* part, float* best, float* error)
+{
+	float e;
+	int i;
+
+	if( k == SEARCH_getParts(topology) )
+	{
+		e = fabsf( SEARCH_evaluate( topology, part ) - X );
+
+		if( e < *error )
+		{
+			*error = e;
+
+			for( i = 0 ; i < k ; i++ ) best[i] = part[i];
+		}
+
+		return;
+	}
+
+	for( i = 0 ; i < set[k].N ; i++ )
+	{
+		if( set[k].value[i] > bound[2*k] || set[k].value[i] < bound[2*k + 1] ) continue;
+
+		part[k] = set[k].value[i];
+
+		ORACLE_enumerate( topology, X, set, bound, k + 1, part, best, error );
+	}
+}
+
+/*
+ * ORACLE_mixed(topology, set, std, name, count, budget, seed, total)
+ *
+ * Description:
+ *
+ * Checks MIXED_select() against the brute force selection from the same sets, on the cases
+ * of the standard std, which the sets need not include, and adds their number to total.
+ * Prints a row and returns the number of disagreements, or -1 if the space is over budget.
+ *
+ */
+
+int ORACLE_mixed(SEARCH_topology topology, MIXED_set* set, EIA_standard std, const char* name, int count, double budget, unsigned int seed, int* total)
+{
+	static ORACLE_case cases[ORACLE_MAX_CASES];
+	float bound[2 * SEARCH_MAX_PARTS], part[SEARCH_MAX_PARTS], best[SEARCH_MAX_PARTS], fast[SEARCH_MAX_PARTS];
+	float* output[SEARCH_MAX_PARTS];
+	float error, fast_error, scale;
+	double space = 1.0, start, t_brute = 0.0, t_fast = 0.0;
+	int N, N_parts = SEARCH_getParts(topology), k, p, bad = 0;
+
+	for( p = 0 ; p < N_parts ; p++ )
+	{
+		space *= set[p].N;
+		output[p] = &fast[p];
+	}
+
+	N = ORACLE_cases( topology, std, 0, seed, cases );
+
+	if( budget / space < 1.0 )
+	{
+		printf( "%-26s %5s %6s\n", name, "mixed", "skipped" );
+		return(-1);
+	}
+
+	N = ORACLE_cases( topology, std, (int)fmin( (double)count, fmax( 0.0, budget / space - N ) ), seed, cases );
+	N = (int)fmin( (double)N, budget / space );
+
+	//	Build the tables before timing the search.
+
+	MIXED_select( topology, cases[0].target, set, INFINITY, 0.0f, INFINITY, 0.0f, output );
+
+	for( k = 0 ; k < N ; k++ )
+	{
+		for( p = 0 ; p < N_parts ; p++ )
+		{
+			bound[2*p]     = ( topology >= SEARCH_RATIO_1R ) ? cases[k].R_max : INFINITY;
+			bound[2*p + 1] = ( topology >= SEARCH_RATIO_1R ) ? cases[k].R_min : 0.0f;
+		}
+
+		if( topology >= SEARCH_RC_1R1C )
+		{
+			bound[ 2 * N_parts - 2 ] = cases[k].C_max;
+			bound[ 2 * N_parts - 1 ] = cases[k].C_min;
+		}
+
+		error = INFINITY;
+
+		start = SEARCH_now();
+		ORACLE_enumerate( topology, cases[k].target, set, bound, 0, part, best, &error );
+		t_brute += SEARCH_now() - start;
+
+		start = SEARCH_now();
+		MIXED_select( topology, cases[k].target, set, cases[k].R_max, cases[k].R_min, cases[k].C_max, cases[k].C_min, output );
+		t_fast += SEARCH_now() - start;
+
+		fast_error = isnan( fast[0] ) ? INFINITY : fabsf( SEARCH_evaluate( topology, fast ) - cases[k].target );
+		scale = fmaxf( cases[k].target, SEARCH_evaluate( topology, fast ) );
+
+		if( ( error < INFINITY ) != ( fast_error < INFINITY ) ||
+			( error < INFINITY && fabsf( error - fast_error ) > ORACLE_ULPS * FLT_EPSILON * scale ) )
+		{
+			if( bad++ < 3 ) fprintf( stderr, "%s target %.9g: brute error %.9g, mixed error %.9g\n", name, cases[k].target, error, fast_error );
+		}
+	}
+
+	printf( "%-26s %5s %6d %5s %4d %14.1f %14.1f %10.1f\n", name, "mixed", N, "-", bad, 1e9 * t_brute / N, 1e9 * t_fast / N, t_brute / t_fast );
+
+	fflush(stdout);
+
+	*total += N;
+
+	return(bad);
+}
+
+/*	Runs yield search c on a window around target, and returns the yield. */
+
+float ORACLE_runYield(int c, float target, EIA_standard std, YIELD_distribution distribution, float* x)
+{
+	ORACLE_yieldCase* y = &ORACLE_yieldCases[c];
+	float max = target * ( 1.0f + y->window ), min = target * ( 1.0f - y->window );
+	int N = ORACLE_YIELD_SAMPLES;
+
+	switch(c)
+	{
+		case(0):	return( YIELD_RESISTOR_1R( max, min, std, y->T_R, distribution, N, &x[0] ) );
+		case(1):	return( YIELD_RESISTOR_2RS( max, min, std, y->T_R, distribution, N, &x[0], &x[1] ) );
+		case(2):	return( YIELD_RESISTOR_2RP( max, min, std, y->T_R, distribution, N, &x[0], &x[1] ) );
+		case(3):	return( YIELD_RESISTOR_RATIO_1R( max, min, std, y->R_max, y->R_min, y->T_R, distribution, N, &x[0], &x[1] ) );
+		case(4):	return( YIELD_RESISTOR_RATIO_2RS( max, min, std, y->R_max, y->R_min, y->T_R, distribution, N, &x[0], &x[1], &x[2], &x[3] ) );
+		case(5):	return( YIELD_RESISTOR_RATIO_2RP( max, min, std, y->R_max, y->R_min, y->T_R, distribution, N, &x[0], &x[1], &x[2], &x[3] ) );
+		case(6):	return( YIELD_RC_1R1C( max, min, std, std, y->R_max, y->R_min, y->C_max, y->C_min, y->T_R, y->T_C, distribution, N, &x[0], &x[1] ) );
+		case(7):	return( YIELD_RC_2RS1C( max, min, std, std, y->R_max, y->R_min, y->C_max, y->C_min, y->T_R, y->T_C, distribution, N, &x[0], &x[1], &x[2] ) );
+		case(8):	return( YIELD_RC_2RP1C( max, min, std, std, y->R_max, y->R_min, y->C_max, y->C_min, y->T_R, y->T_C, distribution, N, &x[0], &x[1], &x[2] ) );
+		case(9):	return( YIELD_RC_3RS1C( max, min, std, std, y->R_max, y->R_min, y->C_max, y->C_min, y->T_R, y->T_C, distribution, N, &x[0], &x[1], &x[2], &x[3] ) );
+		default:	return( YIELD_RC_3RP1C( max, min, std, std, y->R_max, y->R_min, y->C_max, y->C_min, y->T_R, y->T_C, distribution, N, &x[0], &x[1], &x[2], &x[3] ) );
+	}
+}
+
+/*	Number of the N_samples builds of deviations d, N_parts per build, of the parts x whose
+	value lands in the window of a search. */
+
+int ORACLE_pass(YIELD_search* search, float* d, int N_samples, float* x)
+{
+	float sample[YIELD_MAX_PARTS];
+	float value;
+	int k, i, pass = 0;
+
+	for( k = 0 ; k < N_samples ; k++ )
+	{
+		for( i = 0 ; i < search->N_parts ; i++ ) sample[i] = x[i] * ( 1.0f + search->t[i] * d[ k * search->N_parts + i ] );
+
+		value = search->network(sample);
+
+		if( value >= search->spec_min && value <= search->spec_max ) pass++;
+	}
+
+	return(pass);
+}
+
+/*	Brute force Monte Carlo: the most builds of the shared samples any combination of the
+	values within bounds of each part, from part k on, lets pass, part k - 1 being value
+	previous of its set. */
+
+int ORACLE_yieldEnumerate(YIELD_search* search, float** set, int* N, int ordered, int k, int previous, float* x)
+{
+	int i, pass, best = 0;
+
+	if( k == search->N_parts ) return( ORACLE_pass( search, search->deviation, search->N_samples, x ) );
+
+	for( i = ( ordered & ( 1 << k ) ) ? previous : 0 ; i < N[k] ; i++ )
+	{
+		x[k] = set[k][i];
+		pass = ORACLE_yieldEnumerate( search, set, N, ordered, k + 1, i, x );
+
+		if( pass > best ) best = pass;
+	}
+
+	return(best);
+}
+
+/*
+ * ORACLE_yield(c, std, distribution, name, count, budget, seed, total)
+ *
+ * Description:
+ *
+ * Checks yield search c against the brute force Monte Carlo on windows around its target
+ * and up to count others, and adds their number to total. Prints a row and returns the
+ * number of disagreements, or -1 if the space is over budget.
+ *
+ */
+
+int ORACLE_yield(int c, EIA_standard std, YIELD_distribution distribution, const char* name, int count, double budget, unsigned int seed, int* total)
+{
+	ORACLE_yieldCase* y = &ORACLE_yieldCases[c];
+	YIELD_search search;
+	float* set[YIELD_MAX_PARTS];
+	float* fresh;
+	float x[YIELD_MAX_PARTS], part[YIELD_MAX_PARTS];
+	float target, yield, estimate, sigma;
+	double space = 1.0, start, t_brute = 0.0, t_fast = 0.0;
+	int N[YIELD_MAX_PARTS], N_set, low, high, best, pass, n, N_windows, k, i, bad = 0;
+	unsigned int state = seed * 2654435761u + (unsigned int)( 31 * c + std );
+
+	for( k = 0 ; k < y->N_parts ; k++ )
+	{
+		if( k < y->N_R )
+		{
+			set[k] = RESISTOR_getSet(std);
+			N_set = RESISTOR_getSize(std);
+			low = lower_bound( set[k], N_set, y->R_min );
+			high = upper_bound( set[k], N_set, y->R_max );
+		}
+		else
+		{
+			set[k] = CAPACITOR_getSet(std);
+			N_set = CAPACITOR_getSize(std);
+			low = lower_bound( set[k], N_set, y->C_min );
+			high = upper_bound( set[k], N_set, y->C_max );
+		}
+
+		set[k] += low;
+		N[k] = high - low;
+		space *= N[k];
+	}
+
+	if( budget / space < 1.0 )
+	{
+		printf( "%-26s %5s %6s\n", name, "yield", "skipped" );
+		return(-1);
+	}
+
+	N_windows = 1 + (int)fmin( (double)count, fmin( 4.0, budget / space - 1.0 ) );
+
+	fresh = (float*)malloc( sizeof(float) * ORACLE_YIELD_BUILDS * y->N_parts );
+
+	if( fresh == NULL ) return(-1);
+
+	for( i = 0 ; i < ORACLE_YIELD_BUILDS * y->N_parts ; i++ ) fresh[i] = YIELD_deviation( distribution, &state );
+
+	for( n = 0 ; n < N_windows ; n++ )
+	{
+		target = ( n == 0 ) ? y->target : y->target * powf( 10.0f, ORACLE_random(&state) - 0.5f );
+
+		for( k = 0 ; k < y->N_parts ; k++ ) part[k] = NAN;
+
+		start = SEARCH_now();
+		yield = ORACLE_runYield( c, target, std, distribution, part );
+		t_fast += SEARCH_now() - start;
+
+		//	The samples of the search, drawn again from the same seed.
+
+		if( !YIELD_begin( &search, y->network, y->N_parts, target * ( 1.0f + y->window ), target * ( 1.0f - y->window ), distribution, ORACLE_YIELD_SAMPLES ) )
+		{
+			free(fresh);
+			return(-1);
+		}
+
+		for( k = 0 ; k < y->N_parts ; k++ ) search.t[k] = 0.01f * ( ( k < y->N_R ) ? y->T_R : y->T_C );
+
+		start = SEARCH_now();
+		best = ORACLE_yieldEnumerate( &search, set, N, y->ordered, 0, 0, x );
+		t_brute += SEARCH_now() - start;
+
+		pass = isnan( part[0] ) ? 0 : ORACLE_pass( &search, search.deviation, ORACLE_YIELD_SAMPLES, part );
+
+		if( yield != (float)best / ORACLE_YIELD_SAMPLES || pass != best )
+		{
+			if( bad++ < 3 ) fprintf( stderr, "%s target %.9g: yield %.4f with %d builds of its parts, brute force %d builds\n", name, target, yield, pass, best );
+		}
+		else if( best > 0 )
+		{
+			estimate = (float)ORACLE_pass( &search, fresh, ORACLE_YIELD_BUILDS, part ) / ORACLE_YIELD_BUILDS;
+			sigma = sqrtf( yield * ( 1.0f - yield ) * ( 1.0f / ORACLE_YIELD_SAMPLES + 1.0f / ORACLE_YIELD_BUILDS ) );
+
+			if( fabsf( estimate - yield ) > 5.0f * sigma + 0.02f )
+			{
+				if( bad++ < 3 ) fprintf( stderr, "%s target %.9g: yield %.4f, %.4f on fresh builds\n", name, target, yield, estimate );
+			}
+		}
+
+		YIELD_end(&search);
+	}
+
+	free(fresh);
+
+	printf( "%-26s %5s %6d %5s %4d %14.1f %14.1f %10.1f\n", name, "yield", N_windows, "-", bad, 1e9 * t_brute / N_windows, 1e9 * t_fast / N_windows, t_brute / t_fast );
+
+	fflush(stdout);
+
+	*total += N_windows;
+
+	return(bad);
+}
+
+/*	Worker which answers every shard with a selection of too many parts, until SHARD_QUIT. */
+
+void ORACLE_liar(int fd)
+{
+	unsigned char request[SHARD_REQUEST_SIZE], reply[ SHARD_REPLY_SIZE(1) ];
+	SHARD_message type;
+
+	memset( reply, 0, sizeof(reply) );
+
+	while( SHARD_receive( fd, &type, request, SHARD_REQUEST_SIZE ) >= 0 && type == SHARD_REQUEST )
+	{
+		memcpy( reply, request, 8 );
+		SHARD_putInt( reply + 8, 1 );
+		SHARD_putInt( reply + 12, 1000 );
+
+		if( SHARD_send( fd, SHARD_REPLY, reply, sizeof(reply) ) < 0 ) break;
+	}
+
+	_exit(0);
+}
+
+/*	Returns the number of queries whose lists differ from those of the whole range. */
+
+int ORACLE_sameTop(SEARCH_result* top, int* N_top, SEARCH_result* reference, int* N_reference, int N, const char* name, const char* run)
+{
+	int bad = 0, q, i;
+
+	for( q = 0 ; q < N ; q++ )
+	{
+		for( i = 0 ; i < N_top[q] && N_top[q] == N_reference[q] ; i++ )
+		{
+			if( SEARCH_compare( &top[ q * ORACLE_SHARD_K + i ], &reference[ q * ORACLE_SHARD_K + i ] ) != 0 ||
+				top[ q * ORACLE_SHARD_K + i ].value != reference[ q * ORACLE_SHARD_K + i ].value ) break;
+		}
+
+		if( N_top[q] != N_reference[q] || i < N_top[q] )
+		{
+			if( bad++ < 3 ) fprintf( stderr, "%s %s query %d: %d selections, %d over the whole range, first difference at %d\n", name, run, q, N_top[q], N_reference[q], i );
+		}
+	}
+
+	return(bad);
+}
+
+/*
+ * ORACLE_shard(topology, std, name, count, seed, total)
+ *
+ * Description:
+ *
+ * Checks SHARD_coordinate() on ORACLE_SHARD_WORKERS local workers against SEARCH_runTop()
+ * over the whole range of each case, then again once the first worker has been killed and
+ * a worker sending malformed replies has joined, and adds the number of cases to total.
+ * Prints a row and returns the number of disagreements.
+ *
+ */
+
+int ORACLE_shard(SEARCH_topology topology, EIA_standard std, const char* name, int count, unsigned int seed, int* total)
+{
+	static ORACLE_case cases[ORACLE_MAX_CASES];
+	int fd[ ORACLE_SHARD_WORKERS + 1 ], pair[2];
+	pid_t pid[ ORACLE_SHARD_WORKERS + 1 ];
+	SEARCH_query* query;
+	SEARCH_result *top, *reference;
+	SEARCH_state state;
+	int *N_top, *N_reference;
+	double start, t_whole, t_shard;
+	int N, N_outer, N_workers, k, bad = 0;
+
+	N = ORACLE_cases( topology, std, count, seed, cases );
+
+	query = (SEARCH_query*)malloc( sizeof(SEARCH_query) * N );
+	top = (SEARCH_result*)malloc( sizeof(SEARCH_result) * N * ORACLE_SHARD_K );
+	reference = (SEARCH_result*)malloc( sizeof(SEARCH_result) * N * ORACLE_SHARD_K );
+	N_top = (int*)malloc( sizeof(int) * N );
+	N_reference = (int*)malloc( sizeof(int) * N );
+
+	//	Whole ranges first, so that the workers inherit the tables.
+
+	start = SEARCH_now();
+
+	for( k = 0 ; k < N ; k++ )
+	{
+		SEARCH_initQuery( &query[k], topology, cases[k].target, std );
+
+		query[k].R_max = cases[k].R_max;
+		query[k].R_min = cases[k].R_min;
+		query[k].C_max = cases[k].C_max;
+		query[k].C_min = cases[k].C_min;
+
+		N_outer = SEARCH_prepare( &state, &query[k] );
+		N_reference[k] = ( N_outer > 0 ) ? SEARCH_runTop( &query[k], 0, N_outer, ORACLE_SHARD_K, reference + k * ORACLE_SHARD_K ) : 0;
+	}
+
+	t_whole = SEARCH_now() - start;
+
+	N_workers = SHARD_spawn( ORACLE_SHARD_WORKERS, fd, pid );
+
+	start = SEARCH_now();
+
+	if( SHARD_coordinate( fd, N_workers, query, N, ORACLE_SHARD_K, top, N_top ) < 0 )
+	{
+		fprintf( stderr, "%s: coordination failed on %d workers\n", name, N_workers );
+		bad++;
+	}
+	else bad += ORACLE_sameTop( top, N_top, reference, N_reference, N, name, "all workers" );
+
+	t_shard = SEARCH_now() - start;
+
+	//	The shards of a killed worker and of a liar go to the others.
+
+	if( N_workers > 0 ) kill( pid[0], SIGKILL );
+
+	if( N_workers == ORACLE_SHARD_WORKERS && socketpair( AF_UNIX, SOCK_STREAM, 0, pair ) == 0 )
+	{
+		if( ( pid[N_workers] = fork() ) == 0 )
+		{
+			for( k = 0 ; k < N_workers ; k++ ) close( fd[k] );
+
+			close( pair[0] );
+			ORACLE_liar( pair[1] );
+		}
+
+		close( pair[1] );
+
+		if( pid[N_workers] > 0 ) fd[ N_workers++ ] = pair[0];
+		else close( pair[0] );
+	}
+
+	if( SHARD_coordinate( fd, N_workers, query, N, ORACLE_SHARD_K, top, N_top ) < 0 )
+	{
+		fprintf( stderr, "%s: coordination failed after a worker was killed\n", name );
+		bad++;
+	}
+	else bad += ORACLE_sameTop( top, N_top, reference, N_reference, N, name, "killed worker" );
+
+	SHARD_stop( N_workers, fd, pid );
+
+	printf( "%-26s %5s %6d %5s %4d %14.1f %14.1f %10.1f\n", name, "shard", N, "-", bad, 1e9 * t_whole / N, 1e9 * t_shard / N, t_whole / t_shard );
+
+	fflush(stdout);
+
+	*total += N;
+
+	free(query);
+	free(top);
+	free(reference);
+	free(N_top);
+	free(N_reference);
+
+	return(bad);
+}
+
+/*
+ * ORACLE_scheduler(std, name, count, seed, total)
+ *
+ * Description:
+ *
+ * Runs the cases of every topology for the standard std as one batch on a scheduler of
+ * ORACLE_SCHEDULER_THREADS workers, twice, and checks the selections against SEARCH_run().
+ * Adds the number of queries to total, prints a row and returns the number of disagreements.
+ *
+ */
+
+int ORACLE_scheduler(EIA_standard std, const char* name, int count, unsigned int seed, int* total)
+{
+	static ORACLE_case cases[ORACLE_MAX_CASES];
+	SCHEDULER_t* scheduler;
+	SEARCH_query* query;
+	SEARCH_result *result, *reference;
+	double start, t_alone, t_batch = 0.0;
+	int N = 0, N_cases, t, k, run, j, bad = 0;
+
+	query = (SEARCH_query*)malloc( sizeof(SEARCH_query) * ORACLE_MAX_CASES * ( SEARCH_RC_3RP1C + 1 ) );
+	result = (SEARCH_result*)malloc( sizeof(SEARCH_result) * ORACLE_MAX_CASES * ( SEARCH_RC_3RP1C + 1 ) );
+	reference = (SEARCH_result*)malloc( sizeof(SEARCH_result) * ORACLE_MAX_CASES * ( SEARCH_RC_3RP1C + 1 ) );
+	scheduler = SCHEDULER_create(ORACLE_SCHEDULER_THREADS);
+
+	if( query == NULL || result == NULL || reference == NULL || scheduler == NULL )
+	{
+		fprintf( stderr, "%s: out of memory\n", name );
+		free(query);
+		free(result);
+		free(reference);
+		if( scheduler != NULL ) SCHEDULER_destroy(scheduler);
+		return(1);
+	}
+
+	for( t = SEARCH_RESISTOR_1R ; t <= SEARCH_RC_3RP1C ; t++ )
+	{
+		N_cases = ORACLE_cases( (SEARCH_topology)t, std, count, seed, cases );
+
+		for( k = 0 ; k < N_cases ; k++, N++ )
+		{
+			SEARCH_initQuery( &query[N], (SEARCH_topology)t, cases[k].target, std );
+
+			query[N].R_max = cases[k].R_max;
+			query[N].R_min = cases[k].R_min;
+			query[N].C_max = cases[k].C_max;
+			query[N].C_min = cases[k].C_min;
+		}
+	}
+
+	start = SEARCH_now();
+
+	for( k = 0 ; k < N ; k++ ) SEARCH_run( &query[k], &reference[k] );
+
+	t_alone = SEARCH_now() - start;
+
+	for( run = 0 ; run < 2 ; run++ )
+	{
+		start = SEARCH_now();
+
+		if( SCHEDULER_run( scheduler, query, result, N ) < 0 )
+		{
+			fprintf( stderr, "%s: batch failed\n", name );
+			bad++;
+			break;
+		}
+
+		t_batch += ( SEARCH_now() - start ) / 2.0;
+
+		for( k = 0 ; k < N ; k++ )
+		{
+			j = ( result[k].N_parts == reference[k].N_parts && result[k].value == reference[k].value && result[k].error == reference[k].error );
+
+			if( j && SEARCH_compare( &result[k], &reference[k] ) != 0 ) j = 0;
+
+			if( !j && bad++ < 3 )
+			{
+				fprintf( stderr, "%s %s target %.9g: scheduler %d parts %.9g (error %.9g), search %d parts %.9g (error %.9g)\n", name, ORACLE_name[ query[k].topology ],
+						 query[k].target, result[k].N_parts, result[k].value, result[k].error, reference[k].N_parts, reference[k].value, reference[k].error );
+			}
+		}
+	}
+
+	SCHEDULER_destroy(scheduler);
+
+	printf( "%-26s %5s %6d %5s %4d %14.1f %14.1f %10.1f\n", name, "batch", N, "-", bad, 1e9 * t_alone / N, 1e9 * t_batch / N, t_alone / t_batch );
+
+	fflush(stdout);
+
+	*total += N;
+
+	free(query);
+	free(result);
+	free(reference);
+
+	return(bad);
+}
+
+//	Progress of an asynchronous job, as seen by its callback.
+
+typedef struct
+{
+	float fraction;
+	double error;
+	int calls;
+	int bad;								//	Reports going backwards.
+}ORACLE_progress;
+
+void ORACLE_onProgress(void* user, float fraction, SEARCH_result* best)
+{
+	ORACLE_progress* progress = (ORACLE_progress*)user;
+
+	if( fraction < progress->fraction || fraction > 1.0f || best->error > progress->error ) progress->bad++;
+
+	progress->fraction = fraction;
+	progress->error = best->error;
+	progress->calls++;
+}
+
+/*
+ * ORACLE_async(std, name, count, seed, total)
+ *
+ * Description:
+ *
+ * Submits the cases of every topology for the standard std to a pool of ORACLE_ASYNC_THREADS
+ * workers and checks the selections against SEARCH_run(), and the progress reports of each
+ * job. Then, on a pool of one worker, cancels a running and a pending job of a slow query,
+ * and runs it with a time budget and with an accepted error. Adds the number of jobs to
+ * total, prints a row and returns the number of disagreements.
+ *
+ */
+
+int ORACLE_async(EIA_standard std, const char* name, int count, unsigned int seed, int* total)
+{
+	static ORACLE_case cases[ORACLE_MAX_CASES];
+	ASYNC_pool* pool;
+	ASYNC_job** job;
+	ASYNC_job *running, *pending;
+	ASYNC_status status, first;
+	ORACLE_progress* progress;
+	SEARCH_query* query;
+	SEARCH_query slow;
+	SEARCH_control control;
+	SEARCH_result *result, *reference, best, full;
+	double start, t_alone, t_async;
+	int N = 0, N_cases, t, k, bad = 0;
+
+	query = (SEARCH_query*)malloc( sizeof(SEARCH_query) * ORACLE_MAX_CASES * ( SEARCH_RC_3RP1C + 1 ) );
+	result = (SEARCH_result*)malloc( sizeof(SEARCH_result) * ORACLE_MAX_CASES * ( SEARCH_RC_3RP1C + 1 ) );
+	reference = (SEARCH_result*)malloc( sizeof(SEARCH_result) * ORACLE_MAX_CASES * ( SEARCH_RC_3RP1C + 1 ) );
+	progress = (ORACLE_progress*)malloc( sizeof(ORACLE_progress) * ORACLE_MAX_CASES * ( SEARCH_RC_3RP1C + 1 ) );
+	job = (ASYNC_job**)malloc( sizeof(ASYNC_job*) * ORACLE_MAX_CASES * ( SEARCH_RC_3RP1C + 1 ) );
+	pool = ASYNC_createPool(ORACLE_ASYNC_THREADS);
+
+	if( query == NULL || result == NULL || reference == NULL || progress == NULL || job == NULL || pool == NULL )
+	{
+		fprintf( stderr, "%s: out of memory\n", name );
+		free(query);
+		free(result);
+		free(reference);
+		free(progress);
+		free(job);
+		if( pool != NULL ) ASYNC_destroyPool(pool);
+		return(1);
+	}
+
+	for( t = SEARCH_RESISTOR_1R ; t <= SEARCH_RC_3RP1C ; t++ )
+	{
+		N_cases = ORACLE_cases( (SEARCH_topology)t, std, count, seed, cases );
+
+		for( k = 0 ; k < N_cases ; k++, N++ )
+		{
+			SEARCH_initQuery( &query[N], (SEARCH_topology)t, cases[k].target, std );
+
+			query[N].R_max = cases[k].R_max;
+			query[N].R_min = cases[k].R_min;
+			query[N].C_max = cases[k].C_max;
+			query[N].C_min = cases[k].C_min;
+		}
+	}
+
+	start = SEARCH_now();
+
+	for( k = 0 ; k < N ; k++ ) SEARCH_run( &query[k], &reference[k] );
+
+	t_alone = SEARCH_now() - start;
+
+	//	Every job runs to completion, reporting its progress in order.
+
+	start = SEARCH_now();
+
+	for( k = 0 ; k < N ; k++ )
+	{
+		progress[k].fraction = 0.0f;
+		progress[k].error = INFINITY;
+		progress[k].calls = 0;
+		progress[k].bad = 0;
+
+		job[k] = ASYNC_submit( pool, &query[k], NULL, ORACLE_onProgress, NULL, &progress[k] );
+	}
+
+	for( k = 0 ; k < N ; k++ )
+	{
+		status = ( job[k] != NULL ) ? ASYNC_wait( job[k], &result[k] ) : ASYNC_FAILED;
+
+		if( status != ASYNC_DONE || !result[k].optimal || SEARCH_compare( &result[k], &reference[k] ) != 0 || result[k].value != reference[k].value ||
+			progress[k].bad > 0 || progress[k].calls == 0 || ( progress[k].fraction != 1.0f && result[k].error > 0.0 ) )
+		{
+			if( bad++ < 3 )
+			{
+				fprintf( stderr, "%s %s target %.9g: status %d, job %d parts %.9g (error %.9g), search %d parts %.9g (error %.9g), %d reports out of order\n",
+						 name, ORACLE_name[ query[k].topology ], query[k].target, (int)status, result[k].N_parts, result[k].value, result[k].error,
+						 reference[k].N_parts, reference[k].value, reference[k].error, progress[k].bad );
+			}
+		}
+
+		if( job[k] != NULL ) ASYNC_free( job[k] );
+	}
+
+	t_async = SEARCH_now() - start;
+
+	ASYNC_destroyPool(pool);
+
+	//	Cancellation of a running job, and of one still queued behind it.
+
+	SEARCH_initQuery( &slow, SEARCH_RC_3RP1C, 1.234e-4f, std );
+	SEARCH_run( &slow, &full );
+
+	pool = ASYNC_createPool(1);
+
+	running = ASYNC_submit( pool, &slow, NULL, NULL, NULL, NULL );
+	pending = ASYNC_submit( pool, &slow, NULL, NULL, NULL, NULL );
+
+	if( pool == NULL || running == NULL || pending == NULL )
+	{
+		fprintf( stderr, "%s: could not submit the slow query\n", name );
+		bad++;
+	}
+	else
+	{
+		first = ASYNC_poll( pending, NULL, &best );
+
+		if( first == ASYNC_PENDING && ( best.N_parts != 0 || best.value != 0.0 || best.error != INFINITY ) )
+		{
+			fprintf( stderr, "%s: pending job reports %d parts %.9g (error %.9g)\n", name, best.N_parts, best.value, best.error );
+			bad++;
+		}
+
+		ASYNC_cancel(pending);
+		ASYNC_cancel(running);
+
+		status = ASYNC_wait( running, &best );
+
+		if( ( status != ASYNC_CANCELLED && status != ASYNC_DONE ) || best.error < full.error || ( status == ASYNC_DONE && best.error != full.error ) )
+		{
+			fprintf( stderr, "%s: cancelled job %d with error %.9g, %.9g for the whole search\n", name, (int)status, best.error, full.error );
+			bad++;
+		}
+
+		status = ASYNC_wait( pending, &best );
+
+		if( first == ASYNC_PENDING && ( status != ASYNC_CANCELLED || best.N_parts != 0 ) )
+		{
+			fprintf( stderr, "%s: job cancelled before it ran ended %d with %d parts\n", name, (int)status, best.N_parts );
+			bad++;
+		}
+	}
+
+	if( running != NULL ) ASYNC_free(running);
+	if( pending != NULL ) ASYNC_free(pending);
+
+	//	A time budget gives at worst the whole search, an accepted error a selection within it.
+
+	SEARCH_initControl(&control);
+	control.time_budget = 1e-4;
+	best.error = INFINITY;
+
+	running = ( pool != NULL ) ? ASYNC_submit( pool, &slow, &control, NULL, NULL, NULL ) : NULL;
+	status = ( running != NULL ) ? ASYNC_wait( running, &best ) : ASYNC_FAILED;
+
+	if( status != ASYNC_DONE || best.error < full.error || ( best.optimal && best.error != full.error ) )
+	{
+		fprintf( stderr, "%s: job with a time budget ended %d with error %.9g, %.9g for the whole search\n", name, (int)status, best.error, full.error );
+		bad++;
+	}
+
+	if( running != NULL ) ASYNC_free(running);
+
+	SEARCH_initControl(&control);
+	control.T = 1.0f;
+
+	running = ( pool != NULL ) ? ASYNC_submit( pool, &slow, &control, NULL, NULL, NULL ) : NULL;
+	status = ( running != NULL ) ? ASYNC_wait( running, &best ) : ASYNC_FAILED;
+
+	if( status != ASYNC_DONE || best.error < full.error || ( full.error <= SEARCH_tolerance( &slow, control.T ) && best.error > SEARCH_tolerance( &slow, control.T ) ) )
+	{
+		fprintf( stderr, "%s: job with an accepted error ended %d with error %.9g, %.9g accepted\n", name, (int)status, best.error, SEARCH_tolerance( &slow, control.T ) );
+		bad++;
+	}
+
+	if( running != NULL ) ASYNC_free(running);
+	if( pool != NULL ) ASYNC_destroyPool(pool);
+
+	printf( "%-26s %5s %6d %5s %4d %14.1f %14.1f %10.1f\n", name, "async", N, "-", bad, 1e9 * t_alone / N, 1e9 * t_async / N, t_alone / t_async );
+
+	fflush(stdout);
+
+	*total += N;
+
+	free(query);
+	free(result);
+	free(reference);
+	free(progress);
+	free(job);
+
+	return(bad);
+}
+
+/*
+ * ORACLE_daemon(std, name, count, seed, total)
+ *
+ * Description:
+ *
+ * Forks DAEMON_run() and sends it, for every topology, a batch of the cases of the standard
+ * std in every precision and metric, interleaved with wire requests and an invalid query.
+ * The answers must be those of SEARCH_run() and of wire.h in this process, the metrics must
+ * count every request, and the daemon must exit after a DAEMON_SHUTDOWN request. Adds the
+ * number of requests to total, prints a row and returns the number of disagreements.
+ *
+ */
+
+int ORACLE_daemon(EIA_standard std, const char* name, int count, unsigned int seed, int* total)
+{
+	static ORACLE_case cases[ORACLE_MAX_CASES];
+	static DAEMON_request request[DAEMON_MAX_BATCH];
+	static DAEMON_response response[DAEMON_MAX_BATCH];
+	struct timespec pause = { 0, 20000000 };
+	SEARCH_result result;
+	char path[64];
+	pid_t pid;
+	double start, t_local = 0.0, t_daemon = 0.0;
+	float delta, A_c, r;
+	int fd = -1, N, N_cases, N_requests = 0, N_searches = 0, t, k, i, j, status, bad = 0;
+
+	snprintf( path, sizeof(path), "/tmp/oracle-%d.sock", (int)getpid() );
+
+	if( ( pid = fork() ) == 0 ) _exit( DAEMON_run( path, 2 ) == 0 ? 0 : 1 );
+
+	for( k = 0 ; k < 1000 && pid > 0 && ( fd = DAEMON_connect(path) ) < 0 ; k++ ) nanosleep( &pause, NULL );
+
+	if( fd < 0 )
+	{
+		fprintf( stderr, "%s: no daemon on %s\n", name, path );
+
+		if( pid > 0 )
+		{
+			kill( pid, SIGKILL );
+			waitpid( pid, NULL, 0 );
+		}
+
+		return(1);
+	}
+
+	for( t = SEARCH_RESISTOR_1R ; t <= SEARCH_RC_3RP1C ; t++ )
+	{
+		N_cases = ORACLE_cases( (SEARCH_topology)t, std, count, seed, cases );
+
+		for( k = 0, N = 0 ; k < N_cases && N + 3 <= DAEMON_MAX_BATCH ; k++ )
+		{
+			request[N].op = DAEMON_SEARCH;
+			SEARCH_initQuery( &request[N].query, (SEARCH_topology)t, cases[k].target, std );
+			request[N].query.R_max = cases[k].R_max;
+			request[N].query.R_min = cases[k].R_min;
+			request[N].query.C_max = cases[k].C_max;
+			request[N].query.C_min = cases[k].C_min;
+			request[N].query.precision = (SEARCH_precision)( k % 3 );
+			request[N].query.metric = (SEARCH_metric)( ( k / 3 ) % 3 );
+			N++;
+
+			request[N].op = (DAEMON_op)( DAEMON_SKIN_DEPTH + k % 4 );
+			request[N].conductor = ( k % 2 ) ? ALUMINIUM : COPPER;
+			request[N].a = ( request[N].op == DAEMON_SKIN_DEPTH ) ? 50.0f * (float)( k + 1 ) : 0.1f * (float)( k + 1 );
+			request[N].b = ( request[N].op == DAEMON_WIRE_PARAMETERS ) ? 1e3f * (float)( k + 1 ) : 3e6f;
+			request[N].c = 1e3f * (float)( k + 1 );
+			N++;
+		}
+
+		request[N].op = DAEMON_SEARCH;
+		SEARCH_initQuery( &request[N].query, (SEARCH_topology)99, 1.0f, std );
+		N++;
+
+		start = SEARCH_now();
+
+		if( DAEMON_call( fd, request, response, N ) < 0 )
+		{
+			fprintf( stderr, "%s %s: call failed\n", name, ORACLE_name[t] );
+			bad++;
+			break;
+		}
+
+		t_daemon += SEARCH_now() - start;
+
+		for( i = 0 ; i < N ; i++ )
+		{
+			DAEMON_request* q = &request[i];
+			DAEMON_response* a = &response[i];
+			int agree = 1;
+
+			switch( q->op )
+			{
+				case(DAEMON_SEARCH):
+				{
+					if( (int)q->query.topology == 99 )
+					{
+						agree = ( a->status == -1 );
+						break;
+					}
+
+					start = SEARCH_now();
+					SEARCH_run( &q->query, &result );
+					t_local += SEARCH_now() - start;
+					N_searches++;
+
+					agree = ( a->status == 0 && a->count == result.N_parts && a->value == result.value && a->error == result.error &&
+							  a->precision == q->query.precision && a->metric == q->query.metric );
+
+					for( j = 0 ; j < result.N_parts && agree ; j++ ) agree = ( a->x[j] == result.part[j] );
+				}; break;
+
+				case(DAEMON_SKIN_DEPTH): agree = ( a->count == 1 && a->x[0] == WIRE_getSkinDepth( q->conductor, q->a ) ); break;
+				case(DAEMON_MAX_GAUGE): agree = ( a->count == 1 && a->x[0] == (float)WIRE_getMaxGauge( q->conductor, q->a, q->b, q->c ) ); break;
+				case(DAEMON_MIN_GAUGE): agree = ( a->count == 1 && a->x[0] == (float)WIRE_getMinGauge( q->conductor, q->a, q->b, q->c ) ); break;
+
+				case(DAEMON_WIRE_PARAMETERS):
+				{
+					WIRE_getParameters( q->conductor, q->a, q->b, &delta, &A_c, &r );
+					agree = ( a->count == 3 && a->x[0] == delta && a->x[1] == A_c && a->x[2] == r );
+				}; break;
+
+				default: break;
+			}
+
+			if( !agree && bad++ < 3 ) fprintf( stderr, "%s %s: request %d (op %d) answered status %d count %d value %.9g\n", name, ORACLE_name[t], i, (int)q->op, a->status, a->count, a->value );
+		}
+
+		N_requests += N;
+	}
+
+	//	Every request so far is in the metrics, then the daemon stops.
+
+	request[0].op = DAEMON_METRICS;
+	request[1].op = DAEMON_SHUTDOWN;
+
+	if( DAEMON_call( fd, request, response, 2 ) < 0 || response[0].count != N_requests || response[0].x[0] > response[0].x[1] || response[0].x[3] <= 0.0f )
+	{
+		fprintf( stderr, "%s: metrics of %d requests for %d\n", name, response[0].count, N_requests );
+		bad++;
+	}
+
+	close(fd);
+
+	if( waitpid( pid, &status, 0 ) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0 )
+	{
+		fprintf( stderr, "%s: daemon did not exit after shutdown\n", name );
+		bad++;
+	}
+
+	printf( "%-26s %5s %6d %5s %4d %14.1f %14.1f %10.1f\n", name, "daemon", N_requests, "-", bad, 1e9 * t_local / N_searches, 1e9 * t_daemon / N_requests, t_local / t_daemon );
+
+	fflush(stdout);
+
+	*total += N_requests;
+
+	return(bad);
+}
+
+int main(int argc, char** argv)
+{
+	EIA_standard standards[7 + EIA_MAX_CUSTOM] =
+	{
+		EIA_STANDARD_E3, EIA_STANDARD_E6, EIA_STANDARD_E12, EIA_STANDARD_E24, EIA_STANDARD_E48, EIA_STANDARD_E96,
+		EIA_STANDARD_E192
+	};
+	float mantissa[EIA_MAX_COUNT];
+	char* field;
+	static ORACLE_case cases[ORACLE_MAX_CASES];
+	SEARCH_query query;
+	SEARCH_result brute, fast, planned;
+	const char* filter = NULL;
+	double budget = 1e9, space, start, t_brute, t_fast;
+	int count = 100, N, N_random, N_edge, mismatches = 0, total = 0;
+	unsigned int seed = 1;
+	SEARCH_precision precision = SEARCH_FLOAT;
+	SEARCH_metric metric = SEARCH_ABSOLUTE;
+	int t, s, k, ties, bad, run, N_standards = 7, N_mantissas;
+	int p;
+	MIXED_set mixed_set[SEARCH_MAX_PARTS];
+	NETWORK_element element;
+	float* stock = NULL;
+	char name[64];
+
+	for( k = 1 ; k < argc ; k++ )
+	{
+		if( k + 1 < argc && strcmp( argv[k], "--filter" ) == 0 ) filter = argv[++k];
+		else if( k + 1 < argc && strcmp( argv[k], "--count" ) == 0 ) count = atoi( argv[++k] );
+		else if( k + 1 < argc && strcmp( argv[k], "--budget" ) == 0 ) budget = atof( argv[++k] );
+		else if( k + 1 < argc && strcmp( argv[k], "--seed" ) == 0 ) seed = (unsigned int)atoi( argv[++k] );
+		else if( k + 1 < argc && strcmp( argv[k], "--precision" ) == 0 && strcmp( argv[k+1], "float" ) == 0 ) { precision = SEARCH_FLOAT; k++; }
+		else if( k + 1 < argc && strcmp( argv[k], "--precision" ) == 0 && strcmp( argv[k+1], "double" ) == 0 ) { precision = SEARCH_DOUBLE; k++; }
+		else if( k + 1 < argc && strcmp( argv[k], "--precision" ) == 0 && strcmp( argv[k+1], "long" ) == 0 ) { precision = SEARCH_LONG_DOUBLE; k++; }
+		else if( k + 1 < argc && strcmp( argv[k], "--metric" ) == 0 && strcmp( argv[k+1], "absolute" ) == 0 ) { metric = SEARCH_ABSOLUTE; k++; }
+		else if( k + 1 < argc && strcmp( argv[k], "--metric" ) == 0 && strcmp( argv[k+1], "relative" ) == 0 ) { metric = SEARCH_RELATIVE; k++; }
+		else if( k + 1 < argc && strcmp( argv[k], "--metric" ) == 0 && strcmp( argv[k+1], "log" ) == 0 ) { metric = SEARCH_LOGARITHMIC; k++; }
+		else if( k + 2 < argc && strcmp( argv[k], "--resistors" ) == 0 &&
+				 SYNTHESIS_setRange( NETWORK_RESISTOR, atoi( argv[k+1] ), atoi( argv[k+2] ) ) == 0 ) k += 2;
+		else if( k + 2 < argc && strcmp( argv[k], "--capacitors" ) == 0 &&
+				 SYNTHESIS_setRange( NETWORK_CAPACITOR, atoi( argv[k+1] ), atoi( argv[k+2] ) ) == 0 ) k += 2;
+		else if( k + 1 < argc && strcmp( argv[k], "--series" ) == 0 && N_standards < 7 + EIA_MAX_CUSTOM )
+		{
+			for( field = strtok( argv[++k], "," ), N_mantissas = 0 ; field != NULL && N_mantissas < EIA_MAX_COUNT ; field = strtok( NULL, "," ) )
+			{
+				mantissa[N_mantissas++] = strtof( field, NULL );
+			}
+
+			if( ( standards[N_standards] = (EIA_standard)EIA_addSeries( mantissa, N_mantissas ) ) == (EIA_standard)-1 )
+			{
+				fprintf( stderr, "invalid series after %d mantissas\n", N_mantissas );
+				return(2);
+			}
+
+			N_standards++;
+		}
+		else
+		{
+			fprintf( stderr, "usage: %s [--filter text] [--count N] [--budget candidates] [--seed N] [--precision float|double|long] [--metric absolute|relative|log]"
+					  " [--resistors low high] [--capacitors low high] [--series m1,m2,...]\n", argv[0] );
+			return(2);
+		}
+	}
+
+	RC_init();
+
+	printf( "%-26s %5s %6s %5s %4s %14s %14s %10s\n", "function", "std", "cases", "ties", "bad", "brute ns", "search ns", "speedup" );
+
+	for( t = SEARCH_RESISTOR_1R ; t <= SEARCH_RC_3RP1C ; t++ )
+	{
+		for( s = 0 ; s < N_standards ; s++ )
+		{
+			snprintf( name, sizeof(name), "%s/E%d", ORACLE_name[t], (int)standards[s] );
+
+			if( filter != NULL && strstr( name, filter ) == NULL ) continue;
+
+			//	Edge cases are always run; random targets fill the rest of the budget.
+
+			space = ORACLE_space( (SEARCH_topology)t, standards[s] );
+			N_edge = ORACLE_cases( (SEARCH_topology)t, standards[s], 0, seed, cases );
+			N_random = (int)fmin( (double)count, fmax( 0.0, budget / space - N_edge ) );
+
+			if( budget / space < 1.0 )
+			{
+				printf( "%-26s %5d %6s\n", ORACLE_name[t], (int)standards[s], "skipped" );
+				continue;
+			}
+
+			N = ORACLE_cases( (SEARCH_topology)t, standards[s], N_random, seed, cases );
+			N = (int)fmin( (double)N, budget / space );
+
+			//	Build the tables before timing the search.
+
+			SEARCH_initQuery( &query, (SEARCH_topology)t, cases[0].target, standards[s] );
+			SEARCH_run( &query, &fast );
+
+			ties = 0;
+			bad = 0;
+			t_brute = 0.0;
+			t_fast = 0.0;
+
+			for( k = 0 ; k < N ; k++ )
+			{
+				SEARCH_initQuery( &query, (SEARCH_topology)t, cases[k].target, standards[s] );
+
+				query.R_max = cases[k].R_max;
+				query.R_min = cases[k].R_min;
+				query.C_max = cases[k].C_max;
+				query.C_min = cases[k].C_min;
+				query.precision = precision;
+				query.metric = metric;
+
+				start = SEARCH_now();
+				PLANNER_brute( &query, &brute );
+				t_brute += SEARCH_now() - start;
+
+				start = SEARCH_now();
+
+				for( run = 0 ; run < 8 ; run++ ) SEARCH_run( &query, &fast );
+
+				t_fast += ( SEARCH_now() - start ) / 8.0;
+
+				PLANNER_run( &query, &planned );
+
+				if( !ORACLE_agree( &brute, &fast, &query ) || !ORACLE_agree( &brute, &planned, &query ) )
+				{
+					if( bad++ < 3 )
+					{
+						fprintf( stderr, "%s target %.9g bounds R [%g, %g] C [%g, %g]: brute %d parts %.9g (error %.9g), search %d parts %.9g (error %.9g), planner %d parts %.9g\n",
+								 name, query.target, query.R_min, query.R_max, query.C_min, query.C_max,
+								 brute.N_parts, brute.value, brute.error, fast.N_parts, fast.value, fast.error, planned.N_parts, planned.value );
+					}
+				}
+				else if( brute.N_parts > 0 && !ORACLE_sameParts( &brute, &fast, &query ) ) ties++;
+			}
+
+			printf( "%-26s %5d %6d %5d %4d %14.1f %14.1f %10.1f\n", ORACLE_name[t], (int)standards[s], N, ties, bad,
+					1e9 * t_brute / N, 1e9 * t_fast / N, t_brute / t_fast );
+
+			fflush(stdout);
+
+			mismatches += bad;
+			total += N;
+		}
+	}
+
+	//	Mixed selections, of each series with the next one and with a stock list drawn from it.
+
+	for( t = SEARCH_RESISTOR_1R ; t <= SEARCH_RC_3RP1C ; t++ )
+	{
+		for( s = 0 ; s + 1 < N_standards ; s++ )
+		{
+			for( run = 0 ; run < 2 ; run++ )
+			{
+				snprintf( name, sizeof(name), "%s/E%d+%s%d", ORACLE_mixedName[t], (int)standards[s], run ? "stock" : "E", (int)standards[s+1] );
+
+				if( filter != NULL && strstr( name, filter ) == NULL ) continue;
+
+				for( N = 0 ; N < SEARCH_getParts( (SEARCH_topology)t ) ; N++ )
+				{
+					element = ( t >= SEARCH_CAPACITOR_1C && t <= SEARCH_CAPACITOR_3CP ) ||
+							  ( t >= SEARCH_RC_1R1C && N == SEARCH_getParts( (SEARCH_topology)t ) - 1 ) ? NETWORK_CAPACITOR : NETWORK_RESISTOR;
+
+					MIXED_series( &mixed_set[N], element, standards[ s + N % 2 ] );
+				}
+
+				//	A stock list of every other value of the finer series, some of them off by 0.3 %,
+				//	in place of part 1, or of the single part.
+
+				if( run )
+				{
+					p = ( SEARCH_getParts( (SEARCH_topology)t ) > 1 ) ? 1 : 0;
+
+					if( p == 0 ) MIXED_series( &mixed_set[0], mixed_set[0].element, standards[s+1] );
+
+					free(stock);
+					stock = (float*)malloc( sizeof(float) * mixed_set[p].N );
+
+					for( N = 0, ties = 0 ; N < mixed_set[p].N ; N += 2 ) stock[ties++] = mixed_set[p].value[N] * ( ( N % 4 == 0 ) ? 1.003f : 1.0f );
+
+					MIXED_stock( &mixed_set[p], mixed_set[p].element, stock, ties );
+				}
+
+				bad = ORACLE_mixed( (SEARCH_topology)t, mixed_set, standards[s], name, count, budget, seed, &total );
+
+				for( N = 0 ; N < SEARCH_getParts( (SEARCH_topology)t ) ; N++ ) MIXED_freeSet( &mixed_set[N] );
+
+				if( bad > 0 ) mismatches += bad;
+			}
+		}
+	}
+
+	free(stock);
+
+	//	Yield searches, against the brute force Monte Carlo.
+
+	for( t = 0 ; t < (int)( sizeof(ORACLE_yieldCases) / sizeof(ORACLE_yieldCases[0]) ) ; t++ )
+	{
+		for( s = 2 ; s < 4 ; s++ )
+		{
+			for( run = 0 ; run < 2 ; run++ )
+			{
+				snprintf( name, sizeof(name), "%s/E%d/%s", ORACLE_yieldCases[t].name, (int)standards[s], run ? "gauss" : "uniform" );
+
+				if( filter != NULL && strstr( name, filter ) == NULL ) continue;
+
+				bad = ORACLE_yield( t, standards[s], run ? YIELD_GAUSSIAN : YIELD_UNIFORM, name, count, budget, seed, &total );
+
+				if( bad > 0 ) mismatches += bad;
+			}
+		}
+	}
+
+	//	Sharded searches, against the whole range.
+
+	for( t = SEARCH_RESISTOR_1R ; t <= SEARCH_RC_3RP1C ; t++ )
+	{
+		snprintf( name, sizeof(name), "SHARD_%s/E%d", ORACLE_name[t], (int)standards[3] );
+
+		if( filter != NULL && strstr( name, filter ) == NULL ) continue;
+
+		mismatches += ORACLE_shard( (SEARCH_topology)t, standards[3], name, count, seed, &total );
+	}
+
+	//	Batches on the work-stealing scheduler.
+
+	snprintf( name, sizeof(name), "SCHEDULER/E%d", (int)standards[3] );
+
+	if( filter == NULL || strstr( name, filter ) != NULL ) mismatches += ORACLE_scheduler( standards[3], name, count, seed, &total );
+
+	//	Jobs of the asynchronous pool.
+
+	snprintf( name, sizeof(name), "ASYNC/E%d", (int)standards[3] );
+
+	if( filter == NULL || strstr( name, filter ) != NULL ) mismatches += ORACLE_async( standards[3], name, count, seed, &total );
+
+	//	Round trip through the query daemon.
+
+	snprintf( name, sizeof(name), "DAEMON/E%d", (int)standards[3] );
+
+	if( filter == NULL || strstr( name, filter ) != NULL ) mismatches += ORACLE_daemon( standards[3], name, count, seed, &total );
+
+	printf( "%d queries, %d disagreements\n", total, mismatches );
+
+	return( mismatches > 0 ? 1 : 0 );
+}
@@ -0,0 +1,248 @@
+/*
+ *
+ * 	Batch interface for foreign callers.
+ *
+ * 	The functions below only take integers, floats and pointers, so they can be called through
+ * 	ctypes, cffi or a Rust extern block. Arrays are owned by the caller and described by a
+ * 	pointer and a stride in bytes, as NumPy arrays are; a stride of 0 reads a scalar for every
+ * 	element. No memory is allocated per element: a batch is split into one contiguous range per
+ * 	thread, and each thread searches its elements with the sorted tables of SEARCH.h.
+ *
+ * 	The interface is versioned by ABI_VERSION, returned by ABI_version(). Functions return 0
+ * 	on success and a negative ABI_status otherwise. Compile libpassive.c into a shared library
+ * 	to load it.
+ *
+ */
+
+#ifndef PASSIVE_ABI_H_
+#define PASSIVE_ABI_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <pthread.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "SEARCH.h"
+
+#define ABI_VERSION				2
+#define ABI_MAX_THREADS			64
+#define ABI_MIN_PER_THREAD		64				//	Elements below which no thread is started.
+
+typedef enum
+{
+	ABI_OK = 0,
+	ABI_INVALID_ARGUMENT = -1,
+	ABI_OUT_OF_MEMORY = -2
+}ABI_status;
+
+//	Work of one thread.
+
+typedef struct
+{
+	SEARCH_query query;
+	int64_t begin, end;
+	const char* target;
+	int64_t target_stride;
+	char* part;
+	int64_t part_stride, row_stride;
+	char* value;
+	int64_t value_stride;
+	char* error;
+	int64_t error_stride;
+}ABI_range;
+
+/*****			Function declarations			*****/
+
+int ABI_version(void);
+int ABI_getParts(int topology);
+int ABI_addSeries(const float* mantissa, int N);
+int ABI_select(int topology, int R_std, int C_std, const float* bounds, int64_t N,
+			   const float* target, int64_t target_stride,
+			   float* part, int64_t part_stride, int64_t row_stride,
+			   float* value, int64_t value_stride,
+			   float* error, int64_t error_stride,
+			   int N_threads);
+
+/*****			Function definitions			*****/
+
+int ABI_version(void)
+{
+	return(ABI_VERSION);
+}
+
+/*	Returns the number of parts of a topology, which is the width of the part array of a batch,
+	or ABI_INVALID_ARGUMENT. */
+
+int ABI_getParts(int topology)
+{
+	if( topology < SEARCH_RESISTOR_1R || topology > SEARCH_RC_3RP1C ) return(ABI_INVALID_ARGUMENT);
+
+	return( SEARCH_getParts( (SEARCH_topology)topology ) );
+}
+
+int ABI_isStandard(int std)
+{
+	return( EIA_isStandard( (EIA_standard)std ) );
+}
+
+/*	Adds a custom series of N mantissas in increasing order from 1 to 10 (see EIA_addSeries())
+	and returns its standard, to be passed as R_std or C_std, or ABI_INVALID_ARGUMENT. */
+
+int ABI_addSeries(const float* mantissa, int N)
+{
+	int std;
+
+	if( mantissa == NULL ) return(ABI_INVALID_ARGUMENT);
+
+	std = EIA_addSeries( mantissa, N );
+
+	return( ( std < 0 ) ? ABI_INVALID_ARGUMENT : std );
+}
+
+/*	Builds the standard values and the pair tables a query needs, once. */
+
+int ABI_prepare(SEARCH_query* query)
+{
+	SEARCH_topology topology = query->topology;
+	int capacitors = ( topology >= SEARCH_CAPACITOR_1C && topology <= SEARCH_CAPACITOR_3CP );
+	int status = ABI_OK;
+
+	if( !capacitors &&
+		( SYNTHESIS_getTable( NETWORK_RESISTOR, query->R_std, SYNTHESIS_ADD ) == NULL ||
+		  SYNTHESIS_getTable( NETWORK_RESISTOR, query->R_std, SYNTHESIS_HARMONIC ) == NULL ) ) status = ABI_OUT_OF_MEMORY;
+
+	if( ( capacitors || topology >= SEARCH_RC_1R1C ) &&
+		( SYNTHESIS_getTable( NETWORK_CAPACITOR, query->C_std, SYNTHESIS_ADD ) == NULL ||
+		  SYNTHESIS_getTable( NETWORK_CAPACITOR, query->C_std, SYNTHESIS_HARMONIC ) == NULL ) ) status = ABI_OUT_OF_MEMORY;
+
+	return(status);
+}
+
+/*	Searches a range of elements. */
+
+void* ABI_work(void* argument)
+{
+	ABI_range* range = (ABI_range*)argument;
+	SEARCH_query query = range->query;
+	SEARCH_result result;
+	float* part;
+	int64_t n;
+	int k, N_parts = SEARCH_getParts( query.topology );
+
+	for( n = range->begin ; n < range->end ; n++ )
+	{
+		query.target = *(const float*)( range->target + n * range->target_stride );
+
+		result.N_parts = 0;
+
+		if( query.target > 0.0f && isfinite( query.target ) ) SEARCH_run( &query, &result );
+
+		if( result.N_parts == 0 )
+		{
+			result.value = NAN;
+			result.error = NAN;
+		}
+
+		if( range->part != NULL )
+		{
+			for( k = 0 ; k < N_parts ; k++ )
+			{
+				part = (float*)( range->part + n * range->row_stride + k * range->part_stride );
+				*part = ( k < result.N_parts ) ? result.part[k] : NAN;
+			}
+		}
+
+		if( range->value != NULL ) *(float*)( range->value + n * range->value_stride ) = result.value;
+		if( range->error != NULL ) *(float*)( range->error + n * range->error_stride ) = result.error;
+	}
+
+	return(NULL);
+}
+
+/*
+ * ABI_select(topology, R_std, C_std, bounds, N, target, target_stride, part, part_stride,
+ *			  row_stride, value, value_stride, error, error_stride, N_threads)
+ *
+ * Description:
+ *
+ * Selects the parts of a topology (a SEARCH_topology) closest to each of N targets, from the
+ * standards R_std and C_std (3, 6, ..., 192, or a series of ABI_addSeries()). bounds holds
+ * R_max, R_min, C_max and C_min, or is NULL for no bounds. Element n of part is the row at
+ * part + n*row_stride holding ABI_getParts(topology) parts part_stride bytes apart, ordered
+ * as the arguments of the selectors. The equivalent value and the absolute error are written
+ * to value and error. Any output may be NULL. When no selection lies within the bounds or a
+ * target is not positive, parts, value and error are NaN. Uses N_threads threads, or one per
+ * processor if 0.
+ *
+ */
+
+int ABI_select(int topology, int R_std, int C_std, const float* bounds, int64_t N,
+			   const float* target, int64_t target_stride,
+			   float* part, int64_t part_stride, int64_t row_stride,
+			   float* value, int64_t value_stride,
+			   float* error, int64_t error_stride,
+			   int N_threads)
+{
+	ABI_range range[ABI_MAX_THREADS];
+	pthread_t thread[ABI_MAX_THREADS];
+	int started[ABI_MAX_THREADS];
+	SEARCH_query query;
+	int i;
+
+	if( ABI_getParts(topology) < 0 || !ABI_isStandard(R_std) || !ABI_isStandard(C_std) || N < 0 ) return(ABI_INVALID_ARGUMENT);
+	if( N > 0 && target == NULL ) return(ABI_INVALID_ARGUMENT);
+
+	SEARCH_initQuery( &query, (SEARCH_topology)topology, 0.0f, (EIA_standard)R_std );
+
+	query.C_std = (EIA_standard)C_std;
+
+	if( bounds != NULL )
+	{
+		query.R_max = bounds[0];
+		query.R_min = bounds[1];
+		query.C_max = bounds[2];
+		query.C_min = bounds[3];
+	}
+
+	if( N == 0 ) return(ABI_OK);
+
+	if( ABI_prepare(&query) < 0 ) return(ABI_OUT_OF_MEMORY);
+
+	if( N_threads <= 0 ) N_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if( N_threads > ABI_MAX_THREADS ) N_threads = ABI_MAX_THREADS;
+	if( N_threads > N / ABI_MIN_PER_THREAD ) N_threads = (int)( N / ABI_MIN_PER_THREAD );
+	if( N_threads < 1 ) N_threads = 1;
+
+	for( i = 0 ; i < N_threads ; i++ )
+	{
+		range[i].query = query;
+		range[i].begin = N * i / N_threads;
+		range[i].end = N * ( i + 1 ) / N_threads;
+		range[i].target = (const char*)target;
+		range[i].target_stride = target_stride;
+		range[i].part = (char*)part;
+		range[i].part_stride = part_stride;
+		range[i].row_stride = row_stride;
+		range[i].value = (char*)value;
+		range[i].value_stride = value_stride;
+		range[i].error = (char*)error;
+		range[i].error_stride = error_stride;
+	}
+
+	for( i = 1 ; i < N_threads ; i++ ) started[i] = ( pthread_create( &thread[i], NULL, ABI_work, &range[i] ) == 0 );
+
+	ABI_work( &range[0] );
+
+	for( i = 1 ; i < N_threads ; i++ )
+	{
+		if( started[i] ) pthread_join( thread[i], NULL );
+		else ABI_work( &range[i] );
+	}
+
+	return(ABI_OK);
+}
+
+#endif /* PASSIVE_ABI_H_ */
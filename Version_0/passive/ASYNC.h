@@ -0,0 +1,450 @@
+/*
+ *
+ * 	Asynchronous searches on a pool of worker threads.
+ *
+ * 	ASYNC_submit queues a query and returns at once a job, which acts as a future of its
+ * 	result. A worker runs the search in chunks of outer positions, checking between chunks
+ * 	whether the job was cancelled and reporting the fraction of positions covered and the
+ * 	best selection so far. A cancelled job keeps the best selection found before it stopped.
+ *
+ * 	The standard values and pair tables are built on first use. Link with -pthread.
+ *
+ */
+
+#ifndef PASSIVE_ASYNC_H_
+#define PASSIVE_ASYNC_H_
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "SEARCH.h"
+
+#define ASYNC_MAX_THREADS		64
+#define ASYNC_CHUNKS			64			//	Progress reports per job.
+
+typedef enum{ ASYNC_PENDING, ASYNC_RUNNING, ASYNC_DONE, ASYNC_CANCELLED, ASYNC_FAILED } ASYNC_status;
+
+struct ASYNC_job;
+
+//	Called by the worker after every chunk, and once when the job is over.
+
+typedef void (*ASYNC_progress)(void* user, float fraction, SEARCH_result* best);
+typedef void (*ASYNC_done)(void* user, struct ASYNC_job* job);
+
+typedef struct ASYNC_job
+{
+	SEARCH_query query;
+	SEARCH_control control;
+	ASYNC_progress progress;
+	ASYNC_done done;
+	void* user;
+
+	pthread_mutex_t lock;
+	pthread_cond_t finished;
+	ASYNC_status status;
+	int cancel;								//	Cancellation token, checked between chunks.
+	int over;								//	Final status stored and callbacks returned.
+	float fraction;							//	Fraction of outer positions covered.
+	SEARCH_result best;
+
+	struct ASYNC_job* next;					//	Queue of the pool.
+}ASYNC_job;
+
+typedef struct
+{
+	pthread_t thread[ASYNC_MAX_THREADS];
+	int N_threads;
+	pthread_mutex_t lock;
+	pthread_cond_t available;
+	ASYNC_job* head;
+	ASYNC_job* tail;
+	int shutdown;
+}ASYNC_pool;
+
+/*****			Function declarations			*****/
+
+ASYNC_pool* ASYNC_createPool(int N_threads);
+void ASYNC_destroyPool(ASYNC_pool* pool);
+ASYNC_job* ASYNC_submit(ASYNC_pool* pool, SEARCH_query* query, SEARCH_control* control,
+						ASYNC_progress progress, ASYNC_done done, void* user);
+void ASYNC_cancel(ASYNC_job* job);
+ASYNC_status ASYNC_poll(ASYNC_job* job, float* fraction, SEARCH_result* best);
+ASYNC_status ASYNC_wait(ASYNC_job* job, SEARCH_result* result);
+void ASYNC_free(ASYNC_job* job);
+
+/*****			Function definitions			*****/
+
+/*	Returns 1 if the job was cancelled. */
+
+int ASYNC_isCancelled(ASYNC_job* job)
+{
+	int cancel;
+
+	pthread_mutex_lock( &job->lock );
+	cancel = job->cancel;
+	pthread_mutex_unlock( &job->lock );
+
+	return(cancel);
+}
+
+/*
+ * Stores the final state of a job and notifies its owner, then its waiters. The job is not
+ * touched after the waiters are woken, since they may free it.
+ */
+
+void ASYNC_finish(ASYNC_job* job, ASYNC_status status, float fraction)
+{
+	SEARCH_result best;
+
+	pthread_mutex_lock( &job->lock );
+	job->status = status;
+	job->fraction = fraction;
+	best = job->best;
+	pthread_mutex_unlock( &job->lock );
+
+	if( job->progress != NULL ) job->progress( job->user, fraction, &best );
+	if( job->done != NULL ) job->done( job->user, job );
+
+	pthread_mutex_lock( &job->lock );
+	job->over = 1;
+	pthread_cond_broadcast( &job->finished );
+	pthread_mutex_unlock( &job->lock );
+}
+
+/*
+ * ASYNC_execute(job)
+ *
+ * Description:
+ *
+ * Runs the search of a job chunk by chunk, merging the results of the chunks in order.
+ *
+ */
+
+void ASYNC_execute(ASYNC_job* job)
+{
+	SEARCH_control control = job->control;
+	SEARCH_state state;
+	SEARCH_result best, chunk;
+	double deadline = 0.0;
+	int N, size, begin;
+
+	N = SEARCH_prepare( &state, &job->query );
+
+	best.topology = job->query.topology;
+	best.N_parts = 0;
+	best.value = 0.0f;
+	best.error = INFINITY;
+	best.optimal = 0;
+
+	if( N < 0 )
+	{
+		ASYNC_finish( job, ASYNC_FAILED, 0.0f );
+		return;
+	}
+
+	if( control.time_budget > 0.0 ) deadline = SEARCH_now() + control.time_budget;
+
+	size = ( N + ASYNC_CHUNKS - 1 ) / ASYNC_CHUNKS;
+
+	for( begin = 0 ; begin < N ; begin += size )
+	{
+		if( ASYNC_isCancelled(job) ) break;
+
+		if( deadline > 0.0 )
+		{
+			control.time_budget = deadline - SEARCH_now();
+
+			if( control.time_budget <= 0.0 ) break;
+		}
+
+		SEARCH_runRange( &job->query, &control, begin, begin + size, &chunk );
+		SEARCH_merge( &best, &chunk );
+
+		pthread_mutex_lock( &job->lock );
+		job->best = best;
+		job->fraction = (float)( ( begin + size < N ) ? begin + size : N ) / (float)N;
+		pthread_mutex_unlock( &job->lock );
+
+		//	The chunk stopped before its end: the goal is met or the budget spent.
+
+		if( !chunk.optimal || chunk.error == 0.0f ) { begin += size; break; }
+
+		if( job->progress != NULL && begin + size < N ) job->progress( job->user, job->fraction, &best );
+	}
+
+	best.optimal = ( begin >= N && ( N == 0 || chunk.optimal ) ) || best.error == 0.0f;
+
+	pthread_mutex_lock( &job->lock );
+	job->best = best;
+	pthread_mutex_unlock( &job->lock );
+
+	ASYNC_finish( job, ASYNC_isCancelled(job) && !best.optimal ? ASYNC_CANCELLED : ASYNC_DONE,
+				  ( N > 0 ) ? job->fraction : 1.0f );
+}
+
+/*	Runs the jobs of the pool queue until the pool shuts down. */
+
+void* ASYNC_worker(void* argument)
+{
+	ASYNC_pool* pool = (ASYNC_pool*)argument;
+	ASYNC_job* job;
+
+	while(1)
+	{
+		pthread_mutex_lock( &pool->lock );
+
+		while( pool->head == NULL && !pool->shutdown ) pthread_cond_wait( &pool->available, &pool->lock );
+
+		if( pool->head == NULL )
+		{
+			pthread_mutex_unlock( &pool->lock );
+			return(NULL);
+		}
+
+		job = pool->head;
+		pool->head = job->next;
+
+		if( pool->head == NULL ) pool->tail = NULL;
+
+		pthread_mutex_unlock( &pool->lock );
+
+		pthread_mutex_lock( &job->lock );
+		job->status = ASYNC_RUNNING;
+		pthread_mutex_unlock( &job->lock );
+
+		ASYNC_execute(job);
+	}
+}
+
+/*
+ * ASYNC_createPool(N_threads)
+ *
+ * Description:
+ *
+ * Starts a pool of worker threads, one per online processor if N_threads is 0. Returns NULL
+ * on failure.
+ *
+ */
+
+ASYNC_pool* ASYNC_createPool(int N_threads)
+{
+	ASYNC_pool* pool;
+
+	if( N_threads <= 0 ) N_threads = (int)sysconf( _SC_NPROCESSORS_ONLN );
+	if( N_threads <= 0 ) N_threads = 1;
+	if( N_threads > ASYNC_MAX_THREADS ) N_threads = ASYNC_MAX_THREADS;
+
+	pool = (ASYNC_pool*)malloc( sizeof(ASYNC_pool) );
+
+	if( pool == NULL ) return(NULL);
+
+	pthread_mutex_init( &pool->lock, NULL );
+	pthread_cond_init( &pool->available, NULL );
+	pool->head = NULL;
+	pool->tail = NULL;
+	pool->shutdown = 0;
+
+	for( pool->N_threads = 0 ; pool->N_threads < N_threads ; pool->N_threads++ )
+	{
+		if( pthread_create( &pool->thread[ pool->N_threads ], NULL, ASYNC_worker, pool ) != 0 ) break;
+	}
+
+	if( pool->N_threads == 0 )
+	{
+		free(pool);
+		return(NULL);
+	}
+
+	return(pool);
+}
+
+/*
+ * ASYNC_destroyPool(pool)
+ *
+ * Description:
+ *
+ * Cancels the jobs still queued, waits for the running ones to finish and stops the pool.
+ * Jobs are not freed.
+ *
+ */
+
+void ASYNC_destroyPool(ASYNC_pool* pool)
+{
+	ASYNC_job* job;
+	ASYNC_job* next;
+	int i;
+
+	pthread_mutex_lock( &pool->lock );
+
+	job = pool->head;
+	pool->head = NULL;
+	pool->tail = NULL;
+	pool->shutdown = 1;
+
+	pthread_cond_broadcast( &pool->available );
+	pthread_mutex_unlock( &pool->lock );
+
+	while( job != NULL )
+	{
+		next = job->next;
+		ASYNC_finish( job, ASYNC_CANCELLED, 0.0f );
+		job = next;
+	}
+
+	for( i = 0 ; i < pool->N_threads ; i++ ) pthread_join( pool->thread[i], NULL );
+
+	pthread_mutex_destroy( &pool->lock );
+	pthread_cond_destroy( &pool->available );
+
+	free(pool);
+}
+
+/*
+ * ASYNC_submit(pool, query, control, progress, done, user)
+ *
+ * Description:
+ *
+ * Queues a search and returns its job, or NULL on failure. The query and control are copied.
+ * progress is called from a worker thread after every chunk of the search with the fraction
+ * of the search covered and the best selection so far, and done once the job is over.
+ * Either may be NULL. The job must not be freed from its callbacks.
+ *
+ * @parameter	control					:	Goal and time budget of the search, or NULL.
+ * @parameter	user					:	Pointer passed back to the callbacks.
+ *
+ */
+
+ASYNC_job* ASYNC_submit(ASYNC_pool* pool, SEARCH_query* query, SEARCH_control* control,
+						ASYNC_progress progress, ASYNC_done done, void* user)
+{
+	ASYNC_job* job;
+
+	job = (ASYNC_job*)malloc( sizeof(ASYNC_job) );
+
+	if( job == NULL ) return(NULL);
+
+	job->query = *query;
+
+	if( control != NULL ) job->control = *control;
+	else SEARCH_initControl( &job->control );
+
+	job->progress = progress;
+	job->done = done;
+	job->user = user;
+
+	pthread_mutex_init( &job->lock, NULL );
+	pthread_cond_init( &job->finished, NULL );
+	job->status = ASYNC_PENDING;
+	job->cancel = 0;
+	job->over = 0;
+	job->fraction = 0.0f;
+	job->best.topology = query->topology;
+	job->best.N_parts = 0;
+	job->best.value = 0.0f;
+	job->best.error = INFINITY;
+	job->best.optimal = 0;
+	job->next = NULL;
+
+	pthread_mutex_lock( &pool->lock );
+
+	if( pool->tail != NULL ) pool->tail->next = job;
+	else pool->head = job;
+
+	pool->tail = job;
+
+	pthread_cond_signal( &pool->available );
+	pthread_mutex_unlock( &pool->lock );
+
+	return(job);
+}
+
+/*
+ * ASYNC_cancel(job)
+ *
+ * Description:
+ *
+ * Asks a job to stop after its current chunk. The job still completes, with the best
+ * selection found so far.
+ *
+ */
+
+void ASYNC_cancel(ASYNC_job* job)
+{
+	pthread_mutex_lock( &job->lock );
+	job->cancel = 1;
+	pthread_mutex_unlock( &job->lock );
+}
+
+/*
+ * ASYNC_poll(job, fraction, best)
+ *
+ * Description:
+ *
+ * Returns the status of a job without blocking, and stores the fraction of the search
+ * covered and the best selection so far in fraction and best, which may be NULL.
+ *
+ */
+
+ASYNC_status ASYNC_poll(ASYNC_job* job, float* fraction, SEARCH_result* best)
+{
+	ASYNC_status status;
+
+	pthread_mutex_lock( &job->lock );
+
+	status = job->status;
+
+	if( fraction != NULL ) *fraction = job->fraction;
+	if( best != NULL ) *best = job->best;
+
+	pthread_mutex_unlock( &job->lock );
+
+	return(status);
+}
+
+/*
+ * ASYNC_wait(job, result)
+ *
+ * Description:
+ *
+ * Blocks until a job is over, stores its selection in result and returns its final status.
+ *
+ */
+
+ASYNC_status ASYNC_wait(ASYNC_job* job, SEARCH_result* result)
+{
+	ASYNC_status status;
+
+	pthread_mutex_lock( &job->lock );
+
+	while( !job->over ) pthread_cond_wait( &job->finished, &job->lock );
+
+	status = job->status;
+
+	if( result != NULL ) *result = job->best;
+
+	pthread_mutex_unlock( &job->lock );
+
+	return(status);
+}
+
+/*
+ * ASYNC_free(job)
+ *
+ * Description:
+ *
+ * Frees a job once it is over.
+ *
+ */
+
+void ASYNC_free(ASYNC_job* job)
+{
+	ASYNC_wait( job, NULL );
+
+	pthread_mutex_destroy( &job->lock );
+	pthread_cond_destroy( &job->finished );
+
+	free(job);
+}
+
+#endif /* PASSIVE_ASYNC_H_ */
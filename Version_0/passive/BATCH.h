@@ -0,0 +1,743 @@
+/*
+ *
+ * 	Streaming batch selection.
+ *
+ * 	BATCH_run() reads a file of design requests, one per line, and writes one selection per
+ * 	request in the order of the input. A request is either a CSV line
+ *
+ * 		target,topology,standard[,R_max,R_min,C_max,C_min[,T]]
+ *
+ * 	with empty bounds left unbounded, or a JSON object on a single line with the keys
+ * 	"target", "topology", "std" (or "R_std" and "C_std"), "R_max", "R_min", "C_max", "C_min"
+ * 	and "T". Topologies are named as in SEARCH_topology without the prefix, e.g. RESISTOR_2RS,
+ * 	and standards as E24 or 24, from E3 to E192, or by the number of a custom series (see
+ * 	EIA_addSeries()). When a tolerance T (in percentage) is given the search stops at the
+ * 	first selection within it, otherwise the closest selection is returned. Blank lines,
+ * 	lines starting with '#' and a CSV header on the first line are skipped.
+ *
+ * 	The file is memory mapped and processed in windows of BATCH_CHUNK bytes per thread. Each
+ * 	thread parses a chunk of whole lines, the pair tables the window needs are built, then
+ * 	each thread solves its chunk with the sorted table searches of SEARCH.h and formats its
+ * 	output, which is written in order before the next window. The output is CSV, JSON lines or
+ * 	the binary columnar format of COLUMNS.h. The pages of the input are unmapped once
+ * 	processed, which releases them where an advice such as POSIX_MADV_DONTNEED may be
+ * 	ignored, so memory stays bounded by the window whatever the size of the file.
+ *
+ */
+
+#ifndef PASSIVE_BATCH_H_
+#define PASSIVE_BATCH_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "COLUMNS.h"
+#include "SEARCH.h"
+
+#define BATCH_CHUNK				( 1 << 20 )		//	Input bytes per thread and window.
+#define BATCH_MAX_LINE			1024
+#define BATCH_MAX_THREADS		64
+#define BATCH_ROW_OUTPUT		256				//	Upper bound of the output of one row.
+
+typedef enum{ BATCH_CSV, BATCH_JSON, BATCH_BINARY } BATCH_format;
+
+typedef struct
+{
+	SEARCH_query query;
+	float T;
+	long line;									//	Line in the chunk.
+	int valid;
+	SEARCH_result result;						//	Kept for binary output.
+}BATCH_row;
+
+typedef struct
+{
+	const char* begin;
+	const char* end;
+	int first;									//	1 if the chunk starts the file.
+	BATCH_format format;
+	BATCH_format output_format;
+	BATCH_row* row;
+	int N_rows, row_capacity;
+	long N_lines;
+	long line;									//	First line of the chunk in the file.
+	int need[2][SYNTHESIS_STANDARDS];			//	Pair tables used, by element and standard.
+	char* output;
+	size_t length, output_capacity;
+	int failed;									//	1 if memory ran out.
+}BATCH_chunk;
+
+typedef struct
+{
+	long rows;
+	long invalid;
+	double seconds;
+	double rate;								//	Rows per second.
+}BATCH_stats;
+
+const char* BATCH_topologyName[] =
+{
+	"RESISTOR_1R", "RESISTOR_2RS", "RESISTOR_2RP", "RESISTOR_3RS", "RESISTOR_3RP",
+	"CAPACITOR_1C", "CAPACITOR_2CS", "CAPACITOR_2CP", "CAPACITOR_3CS", "CAPACITOR_3CP",
+	"RATIO_1R", "RATIO_2RS", "RATIO_2RP",
+	"RC_1R1C", "RC_2RS1C", "RC_2RP1C", "RC_3RS1C", "RC_3RP1C"
+};
+
+/*****			Function declarations			*****/
+
+int BATCH_parseTopology(const char* s, int length, SEARCH_topology* topology);
+int BATCH_parseStandard(const char* s, int length, EIA_standard* std);
+int BATCH_parseCSV(char* line, BATCH_row* row);
+int BATCH_parseJSON(char* line, BATCH_row* row);
+void BATCH_solve(BATCH_row* row, SEARCH_result* result);
+int BATCH_formatRow(char* buffer, BATCH_format format, long line, BATCH_row* row, SEARCH_result* result);
+int BATCH_run(const char* path, FILE* out, BATCH_format format, BATCH_format output_format, int N_threads, BATCH_stats* stats);
+
+/*****			Function definitions			*****/
+
+/*	Reads a topology name of the given length. Returns 1 on success. */
+
+int BATCH_parseTopology(const char* s, int length, SEARCH_topology* topology)
+{
+	int k;
+
+	for( k = 0 ; k <= SEARCH_RC_3RP1C ; k++ )
+	{
+		if( (int)strlen( BATCH_topologyName[k] ) == length && strncmp( BATCH_topologyName[k], s, length ) == 0 )
+		{
+			*topology = (SEARCH_topology)k;
+			return(1);
+		}
+	}
+
+	return(0);
+}
+
+/*	Reads a standard written E24 or 24, or the number of a custom series. Returns 1 on
+	success. */
+
+int BATCH_parseStandard(const char* s, int length, EIA_standard* std)
+{
+	int n = 0, k = 0;
+
+	if( length > 0 && ( s[0] == 'E' || s[0] == 'e' ) ) k = 1;
+
+	if( k == length ) return(0);
+
+	for( ; k < length ; k++ )
+	{
+		if( s[k] < '0' || s[k] > '9' ) return(0);
+
+		n = 10*n + ( s[k] - '0' );
+
+		if( n > 999 ) return(0);
+	}
+
+	if( !EIA_isStandard( (EIA_standard)n ) ) return(0);
+
+	*std = (EIA_standard)n;
+
+	return(1);
+}
+
+/*	Reads a number filling a whole field, or leaves x unchanged if the field is empty. */
+
+int BATCH_parseNumber(char* s, int length, float* x)
+{
+	char* end;
+	float y;
+
+	while( length > 0 && ( *s == ' ' || *s == '\t' ) ) { s++; length--; }
+	while( length > 0 && ( s[length-1] == ' ' || s[length-1] == '\t' || s[length-1] == '\r' ) ) length--;
+
+	if( length == 0 ) return(1);
+
+	y = strtof( s, &end );
+
+	if( end != s + length ) return(0);
+
+	*x = y;
+
+	return(1);
+}
+
+void BATCH_initRow(BATCH_row* row)
+{
+	SEARCH_initQuery( &row->query, SEARCH_RESISTOR_1R, NAN, EIA_STANDARD_E24 );
+
+	row->T = 0.0f;
+	row->valid = 0;
+}
+
+/*	Checks the fields read into a row. */
+
+int BATCH_check(BATCH_row* row)
+{
+	SEARCH_query* q = &row->query;
+
+	row->valid = isfinite( q->target ) && q->target > 0.0f && row->T >= 0.0f &&
+				 q->R_min >= 0.0f && q->R_max >= q->R_min && q->C_min >= 0.0f && q->C_max >= q->C_min;
+
+	return( row->valid );
+}
+
+/*
+ * BATCH_parseCSV(line, row)
+ *
+ * Description:
+ *
+ * Reads a CSV request from a line terminated by a null character. Returns 1 if the request
+ * is valid.
+ *
+ */
+
+int BATCH_parseCSV(char* line, BATCH_row* row)
+{
+	float* bound[5];
+	char* field = line;
+	char* end;
+	int k, length;
+
+	bound[0] = &row->query.R_max;
+	bound[1] = &row->query.R_min;
+	bound[2] = &row->query.C_max;
+	bound[3] = &row->query.C_min;
+	bound[4] = &row->T;
+
+	BATCH_initRow(row);
+
+	for( k = 0 ; field != NULL ; k++ )
+	{
+		end = strchr( field, ',' );
+		length = ( end != NULL ) ? (int)( end - field ) : (int)strlen(field);
+
+		while( length > 0 && ( field[length-1] == '\r' || field[length-1] == ' ' ) ) length--;
+		while( length > 0 && *field == ' ' ) { field++; length--; }
+
+		if( k == 0 )
+		{
+			if( length == 0 || !BATCH_parseNumber( field, length, &row->query.target ) ) return(0);
+		}
+		else if( k == 1 )
+		{
+			if( !BATCH_parseTopology( field, length, &row->query.topology ) ) return(0);
+		}
+		else if( k == 2 )
+		{
+			if( !BATCH_parseStandard( field, length, &row->query.R_std ) ) return(0);
+
+			row->query.C_std = row->query.R_std;
+		}
+		else if( k < 8 )
+		{
+			if( !BATCH_parseNumber( field, length, bound[k-3] ) ) return(0);
+		}
+		else return(0);
+
+		field = ( end != NULL ) ? end + 1 : NULL;
+	}
+
+	if( k < 3 ) return(0);
+
+	return( BATCH_check(row) );
+}
+
+/*	Finds the value of a key in a single line JSON object and returns its length, or -1. */
+
+int BATCH_findKey(char* line, const char* key, char** value)
+{
+	char* s = line;
+	int n = (int)strlen(key);
+	int length;
+
+	while( ( s = strchr( s, '"' ) ) != NULL )
+	{
+		if( strncmp( s + 1, key, n ) == 0 && s[n+1] == '"' )
+		{
+			s += n + 2;
+
+			while( *s == ' ' || *s == '\t' ) s++;
+
+			if( *s != ':' ) continue;
+
+			s++;
+
+			while( *s == ' ' || *s == '\t' ) s++;
+
+			if( *s == '"' )
+			{
+				*value = ++s;
+
+				for( length = 0 ; s[length] != '"' && s[length] != 0 ; length++ );
+
+				return( ( s[length] == '"' ) ? length : -1 );
+			}
+
+			*value = s;
+
+			for( length = 0 ; s[length] != ',' && s[length] != '}' && s[length] != 0 ; length++ );
+
+			return(length);
+		}
+
+		s++;
+	}
+
+	return(-1);
+}
+
+/*
+ * BATCH_parseJSON(line, row)
+ *
+ * Description:
+ *
+ * Reads a JSON request from a line terminated by a null character. Returns 1 if the request
+ * is valid.
+ *
+ */
+
+int BATCH_parseJSON(char* line, BATCH_row* row)
+{
+	const char* key[5] = { "R_max", "R_min", "C_max", "C_min", "T" };
+	float* bound[5];
+	char* value;
+	int length, k;
+
+	bound[0] = &row->query.R_max;
+	bound[1] = &row->query.R_min;
+	bound[2] = &row->query.C_max;
+	bound[3] = &row->query.C_min;
+	bound[4] = &row->T;
+
+	BATCH_initRow(row);
+
+	length = BATCH_findKey( line, "target", &value );
+
+	if( length <= 0 || !BATCH_parseNumber( value, length, &row->query.target ) ) return(0);
+
+	length = BATCH_findKey( line, "topology", &value );
+
+	if( length <= 0 || !BATCH_parseTopology( value, length, &row->query.topology ) ) return(0);
+
+	length = BATCH_findKey( line, "std", &value );
+
+	if( length >= 0 )
+	{
+		if( !BATCH_parseStandard( value, length, &row->query.R_std ) ) return(0);
+
+		row->query.C_std = row->query.R_std;
+	}
+
+	length = BATCH_findKey( line, "R_std", &value );
+
+	if( length >= 0 && !BATCH_parseStandard( value, length, &row->query.R_std ) ) return(0);
+
+	length = BATCH_findKey( line, "C_std", &value );
+
+	if( length >= 0 && !BATCH_parseStandard( value, length, &row->query.C_std ) ) return(0);
+
+	for( k = 0 ; k < 5 ; k++ )
+	{
+		length = BATCH_findKey( line, key[k], &value );
+
+		if( length >= 0 && !BATCH_parseNumber( value, length, bound[k] ) ) return(0);
+	}
+
+	return( BATCH_check(row) );
+}
+
+/*	Runs the search of a row. */
+
+void BATCH_solve(BATCH_row* row, SEARCH_result* result)
+{
+	SEARCH_control control;
+
+	SEARCH_initControl(&control);
+
+	control.T = row->T;
+
+	SEARCH_anytime( &row->query, &control, result );
+}
+
+/*
+ * BATCH_formatRow(buffer, format, line, row, result)
+ *
+ * Description:
+ *
+ * Writes the selection of a row, or an error for an invalid row, to buffer, which holds at
+ * least BATCH_ROW_OUTPUT characters. Returns the number of characters written.
+ *
+ */
+
+int BATCH_formatRow(char* buffer, BATCH_format format, long line, BATCH_row* row, SEARCH_result* result)
+{
+	int n, k;
+
+	if( !row->valid )
+	{
+		if( format == BATCH_JSON ) return( sprintf( buffer, "{\"line\":%ld,\"error\":\"invalid\"}\n", line ) );
+
+		return( sprintf( buffer, "%ld,invalid,,,,,,,,,\n", line ) );
+	}
+
+	if( format == BATCH_JSON )
+	{
+		n = sprintf( buffer, "{\"line\":%ld,\"topology\":\"%s\",\"target\":%.7g,\"parts\":[", line,
+					 BATCH_topologyName[ row->query.topology ], row->query.target );
+
+		for( k = 0 ; k < result->N_parts ; k++ ) n += sprintf( buffer + n, ( k > 0 ) ? ",%.7g" : "%.7g", result->part[k] );
+
+		if( result->N_parts == 0 ) return( n + sprintf( buffer + n, "],\"value\":null,\"error\":null,\"optimal\":false}\n" ) );
+
+		n += sprintf( buffer + n, "],\"value\":%.7g,\"error\":%.7g,\"optimal\":%s}\n",
+					  result->value, result->error, result->optimal ? "true" : "false" );
+
+		return(n);
+	}
+
+	n = sprintf( buffer, "%ld,%s,%.7g,%d", line, BATCH_topologyName[ row->query.topology ], row->query.target, result->N_parts );
+
+	for( k = 0 ; k < SEARCH_MAX_PARTS ; k++ )
+	{
+		if( k < result->N_parts ) n += sprintf( buffer + n, ",%.7g", result->part[k] );
+		else { buffer[n++] = ','; buffer[n] = 0; }
+	}
+
+	if( result->N_parts == 0 ) return( n + sprintf( buffer + n, ",,,0\n" ) );
+
+	return( n + sprintf( buffer + n, ",%.7g,%.7g,%d\n", result->value, result->error, result->optimal ) );
+}
+
+/*	Marks the pair tables a row needs. */
+
+void BATCH_need(BATCH_chunk* chunk, BATCH_row* row)
+{
+	SEARCH_topology topology = row->query.topology;
+	int R = SYNTHESIS_standardIndex( row->query.R_std ), C = SYNTHESIS_standardIndex( row->query.C_std );
+
+	if( R >= 0 && ( topology < SEARCH_CAPACITOR_1C || topology > SEARCH_CAPACITOR_3CP ) ) chunk->need[NETWORK_RESISTOR][R] = 1;
+
+	if( C >= 0 && ( ( topology >= SEARCH_CAPACITOR_1C && topology <= SEARCH_CAPACITOR_3CP ) || topology >= SEARCH_RC_1R1C ) )
+		chunk->need[NETWORK_CAPACITOR][C] = 1;
+}
+
+/*	First pass over a chunk: splits and parses its lines. */
+
+void* BATCH_parse(void* argument)
+{
+	BATCH_chunk* chunk = (BATCH_chunk*)argument;
+	char line[ BATCH_MAX_LINE + 1 ];
+	const char* s = chunk->begin;
+	const char* end;
+	char* text;
+	BATCH_row* row;
+	int length;
+	long k = 0;
+
+	chunk->N_rows = 0;
+
+	while( s < chunk->end )
+	{
+		end = memchr( s, '\n', chunk->end - s );
+
+		if( end == NULL ) end = chunk->end;
+
+		if( chunk->N_rows == chunk->row_capacity )
+		{
+			row = (BATCH_row*)realloc( chunk->row, sizeof(BATCH_row) * 2 * chunk->row_capacity );
+
+			if( row == NULL )
+			{
+				chunk->failed = 1;
+				break;
+			}
+
+			chunk->row = row;
+			chunk->row_capacity *= 2;
+		}
+
+		length = (int)( end - s );
+		row = &chunk->row[ chunk->N_rows ];
+		row->line = k++;
+
+		if( length > BATCH_MAX_LINE )
+		{
+			row->valid = 0;
+			chunk->N_rows++;
+			s = end + 1;
+			continue;
+		}
+
+		memcpy( line, s, length );
+		line[length] = 0;
+		s = end + 1;
+
+		for( text = line ; *text == ' ' || *text == '\t' ; text++ );
+
+		if( *text == 0 || *text == '\r' || *text == '#' ) continue;
+
+		if( chunk->format == BATCH_JSON ) BATCH_parseJSON( text, row );
+		else if( !BATCH_parseCSV( text, row ) && chunk->first && row->line == 0 ) continue;
+
+		if( row->valid ) BATCH_need( chunk, row );
+
+		chunk->N_rows++;
+	}
+
+	chunk->N_lines = k;
+
+	return(NULL);
+}
+
+/*	Second pass over a chunk: solves its rows and formats the output. */
+
+void* BATCH_process(void* argument)
+{
+	BATCH_chunk* chunk = (BATCH_chunk*)argument;
+	SEARCH_result result;
+	char* output;
+	int k;
+
+	chunk->length = 0;
+
+	for( k = 0 ; k < chunk->N_rows && !chunk->failed ; k++ )
+	{
+		if( chunk->output_format == BATCH_BINARY )
+		{
+			chunk->row[k].result.N_parts = 0;
+
+			if( chunk->row[k].valid ) BATCH_solve( &chunk->row[k], &chunk->row[k].result );
+
+			continue;
+		}
+
+		if( chunk->length + BATCH_ROW_OUTPUT > chunk->output_capacity )
+		{
+			output = (char*)realloc( chunk->output, 2 * chunk->output_capacity );
+
+			if( output == NULL )
+			{
+				chunk->failed = 1;
+				break;
+			}
+
+			chunk->output = output;
+			chunk->output_capacity *= 2;
+		}
+
+		result.N_parts = 0;
+
+		if( chunk->row[k].valid ) BATCH_solve( &chunk->row[k], &result );
+
+		chunk->length += BATCH_formatRow( chunk->output + chunk->length, chunk->output_format, chunk->line + chunk->row[k].line + 1, &chunk->row[k], &result );
+	}
+
+	return(NULL);
+}
+
+/*	Runs one pass over the chunks of a window on threads. */
+
+void BATCH_pass(BATCH_chunk* chunk, int N, void* (*pass)(void*))
+{
+	pthread_t thread[BATCH_MAX_THREADS];
+	int started[BATCH_MAX_THREADS];
+	int i;
+
+	for( i = 1 ; i < N ; i++ ) started[i] = ( pthread_create( &thread[i], NULL, pass, &chunk[i] ) == 0 );
+
+	pass( &chunk[0] );
+
+	for( i = 1 ; i < N ; i++ )
+	{
+		if( started[i] ) pthread_join( thread[i], NULL );
+		else pass( &chunk[i] );
+	}
+}
+
+/*
+ * BATCH_run(path, out, format, output_format, N_threads, stats)
+ *
+ * Description:
+ *
+ * Solves the requests of the file at path, written in format, and writes their selections to
+ * out in order and in output_format, using N_threads threads (one per processor if 0). Fills
+ * stats if not NULL. Returns 0, or -1 if the file could not be read or memory could not be
+ * allocated.
+ *
+ */
+
+int BATCH_run(const char* path, FILE* out, BATCH_format format, BATCH_format output_format, int N_threads, BATCH_stats* stats)
+{
+	BATCH_chunk chunk[BATCH_MAX_THREADS];
+	COLUMNS_writer* writer = NULL;
+	struct stat info;
+	const char* data;
+	const char* s;
+	const char* end;
+	size_t size, released = 0, page;
+	int fd, N, i, e, status = 0;
+	long line = 0, rows = 0, invalid = 0;
+	double start = SEARCH_now();
+
+	if( N_threads <= 0 ) N_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if( N_threads <= 0 ) N_threads = 1;
+	if( N_threads > BATCH_MAX_THREADS ) N_threads = BATCH_MAX_THREADS;
+
+	fd = open( path, O_RDONLY );
+
+	if( fd < 0 ) return(-1);
+
+	if( fstat( fd, &info ) < 0 )
+	{
+		close(fd);
+		return(-1);
+	}
+
+	size = (size_t)info.st_size;
+	data = ( size > 0 ) ? (const char*)mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 ) : NULL;
+
+	close(fd);
+
+	if( data == MAP_FAILED ) return(-1);
+
+	if( data != NULL ) posix_madvise( (void*)data, size, POSIX_MADV_SEQUENTIAL );
+
+	page = (size_t)sysconf(_SC_PAGESIZE);
+
+	//	Row and output buffers grow with the chunks and are kept from one window to the next.
+
+	for( i = 0 ; i < N_threads ; i++ )
+	{
+		chunk[i].format = format;
+		chunk[i].output_format = output_format;
+		chunk[i].row_capacity = 1024;
+		chunk[i].output_capacity = (size_t)BATCH_ROW_OUTPUT * 1024;
+		chunk[i].row = (BATCH_row*)malloc( sizeof(BATCH_row) * chunk[i].row_capacity );
+		chunk[i].output = (char*)malloc( chunk[i].output_capacity );
+		chunk[i].failed = 0;
+
+		if( chunk[i].row == NULL || chunk[i].output == NULL ) status = -1;
+	}
+
+	if( output_format == BATCH_BINARY )
+	{
+		writer = (COLUMNS_writer*)malloc( sizeof(COLUMNS_writer) );
+
+		if( writer == NULL || COLUMNS_begin( writer, out ) < 0 ) status = -1;
+	}
+
+	for( s = data ; status == 0 && s != NULL && s < data + size ; )
+	{
+		//	Split the next window into chunks of whole lines.
+
+		for( N = 0 ; N < N_threads && s < data + size ; N++ )
+		{
+			end = ( (size_t)( data + size - s ) > BATCH_CHUNK ) ? s + BATCH_CHUNK : data + size;
+
+			while( end < data + size && end[-1] != '\n' ) end++;
+
+			chunk[N].begin = s;
+			chunk[N].end = end;
+			chunk[N].first = ( s == data );
+			memset( chunk[N].need, 0, sizeof(chunk[N].need) );
+
+			s = end;
+		}
+
+		BATCH_pass( chunk, N, BATCH_parse );
+
+		//	Pair tables are built on this thread before any search uses them.
+
+		for( i = 0 ; i < N ; i++ )
+		{
+			chunk[i].line = line;
+			line += chunk[i].N_lines;
+
+			for( e = 0 ; e < SYNTHESIS_STANDARDS ; e++ )
+			{
+				if( chunk[i].need[NETWORK_RESISTOR][e] )
+				{
+					SYNTHESIS_getTable( NETWORK_RESISTOR, EIA_getStandard(e), SYNTHESIS_ADD );
+					SYNTHESIS_getTable( NETWORK_RESISTOR, EIA_getStandard(e), SYNTHESIS_HARMONIC );
+				}
+
+				if( chunk[i].need[NETWORK_CAPACITOR][e] )
+				{
+					SYNTHESIS_getTable( NETWORK_CAPACITOR, EIA_getStandard(e), SYNTHESIS_ADD );
+					SYNTHESIS_getTable( NETWORK_CAPACITOR, EIA_getStandard(e), SYNTHESIS_HARMONIC );
+				}
+			}
+		}
+
+		BATCH_pass( chunk, N, BATCH_process );
+
+		for( i = 0 ; i < N ; i++ )
+		{
+			if( chunk[i].failed )
+			{
+				status = -1;
+				break;
+			}
+
+			if( output_format == BATCH_BINARY )
+			{
+				for( e = 0 ; e < chunk[i].N_rows ; e++ )
+				{
+					BATCH_row* row = &chunk[i].row[e];
+
+					if( COLUMNS_append( writer, &row->query, row->valid ? &row->result : NULL ) < 0 ) status = -1;
+				}
+			}
+			else if( fwrite( chunk[i].output, 1, chunk[i].length, out ) != chunk[i].length ) status = -1;
+
+			rows += chunk[i].N_rows;
+
+			for( e = 0 ; e < chunk[i].N_rows ; e++ ) invalid += !chunk[i].row[e].valid;
+		}
+
+		//	Unmap the pages of the window; the next one starts at s.
+
+		if( (size_t)( s - data ) / page * page > released )
+		{
+			munmap( (void*)( data + released ), (size_t)( s - data ) / page * page - released );
+			released = (size_t)( s - data ) / page * page;
+		}
+	}
+
+	for( i = 0 ; i < N_threads ; i++ )
+	{
+		free( chunk[i].row );
+		free( chunk[i].output );
+	}
+
+	if( writer != NULL )
+	{
+		if( status == 0 && COLUMNS_end(writer) < 0 ) status = -1;
+
+		free(writer);
+	}
+
+	if( data != NULL && released < size ) munmap( (void*)( data + released ), size - released );
+
+	if( stats != NULL )
+	{
+		stats->rows = rows;
+		stats->invalid = invalid;
+		stats->seconds = SEARCH_now() - start;
+		stats->rate = ( stats->seconds > 0.0 ) ? (double)rows / stats->seconds : 0.0;
+	}
+
+	return(status);
+}
+
+#endif /* PASSIVE_BATCH_H_ */
@@ -2,25 +2,28 @@
 #ifndef PASSIVE_CAPACITOR_H_
 #define PASSIVE_CAPACITOR_H_
 
+#include "INSTRUMENT.h"
+
 #include <math.h>
 
 #include "EIA.h"
+#include "SELECTOR.h"
 #include "helper_functions.h"
+#include "DUAL.h"
+
+//	Default decades of the standard capacitors, from 1p to the top of the 1m decade: 8.2m for
+//	E12, up to 9.88m for E192. SYNTHESIS_setRange() sets others.
 
-#define CAPACITOR_MAX_POWER		-2
+#define CAPACITOR_MAX_POWER		-3
 #define CAPACITOR_MIN_POWER		-12
-#define CAPACITOR_POWER_RANGE	10
 
-float CAPACITOR_E3[ 3 * CAPACITOR_POWER_RANGE ];
-float CAPACITOR_E6[ 6 * CAPACITOR_POWER_RANGE ];
-float CAPACITOR_E12[ 12 * CAPACITOR_POWER_RANGE ];
-float CAPACITOR_E24[ 24 * CAPACITOR_POWER_RANGE ];
-float CAPACITOR_E48[ 48 * CAPACITOR_POWER_RANGE ];
-float CAPACITOR_E96[ 96 * CAPACITOR_POWER_RANGE ];
+EIA_range CAPACITOR_range = { CAPACITOR_MIN_POWER, CAPACITOR_MAX_POWER, { NULL } };
 
 /*********		Function declarations.		****************/
 
 void CAPACITOR_init();
+float* CAPACITOR_getSet(EIA_standard CAPACITOR_EIA_standard);
+int CAPACITOR_getSize(EIA_standard CAPACITOR_EIA_standard);
 
 float CAPACITOR_EC2S(float C1, float C2);
 float CAPACITOR_EC2P(float C1, float C2);
@@ -29,6 +32,28 @@ float CAPACITOR_EC3P(float C1, float C2, float C3);
 float CAPACITOR_ECnS(float* C, int N);
 float CAPACITOR_ECnP(float* C, int N);
 
+DUAL_t CAPACITOR_EC2S_AD(DUAL_t C1, DUAL_t C2);
+DUAL_t CAPACITOR_EC2P_AD(DUAL_t C1, DUAL_t C2);
+DUAL_t CAPACITOR_EC3S_AD(DUAL_t C1, DUAL_t C2, DUAL_t C3);
+DUAL_t CAPACITOR_EC3P_AD(DUAL_t C1, DUAL_t C2, DUAL_t C3);
+DUAL_t CAPACITOR_ECnS_AD(DUAL_t* C, int N);
+DUAL_t CAPACITOR_ECnP_AD(DUAL_t* C, int N);
+
+//	Selectors, which run the brute force loops below, or the query planner when PLANNER.h is
+//	included (see SELECTOR.h).
+
+float CAPACITOR_1C(float C, EIA_standard CAPACITOR_EIA_standard);
+void CAPACITOR_2CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2);
+void CAPACITOR_2CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2);
+void CAPACITOR_3CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3);
+void CAPACITOR_3CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3);
+
+float CAPACITOR_1C_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard);
+void CAPACITOR_2CS_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2);
+void CAPACITOR_2CP_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2);
+void CAPACITOR_3CS_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3);
+void CAPACITOR_3CP_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3);
+
 
 /*********		Function definitions.		****************/
 
@@ -38,46 +63,40 @@ float CAPACITOR_ECnP(float* C, int N);
  *
  * Description:
  *
- * Initializes standard set of resistors.
+ * Builds the standard capacitor values of every series ahead of their first use, which is
+ * otherwise when a selector needs them.
  *
  */
 
 void CAPACITOR_init()
 {
-	int i,j;
-
-	for( i = 0 ; i < CAPACITOR_POWER_RANGE ; i++ )
-	{
-		for( j = 0 ; j < 3 ; j++ )
-		{
-			CAPACITOR_E3[ 3*i + j ] = EIA_STANDARD_E3_SET[j] * pow( 10.0f, (float)( CAPACITOR_MIN_POWER + i ) );
-		}
+	int k;
 
-		for( j = 0 ; j < 6 ; j++ )
-		{
-			CAPACITOR_E6[ 6*i + j ] = EIA_STANDARD_E6_SET[j] * pow( 10.0f, (float)( CAPACITOR_MIN_POWER + i ) );
-		}
+	for( k = 0 ; k < EIA_SERIES ; k++ ) if( EIA_isStandard( EIA_getStandard(k) ) ) CAPACITOR_getSet( EIA_getStandard(k) );
+}
 
-		for( j = 0 ; j < 12 ; j++ )
-		{
-			CAPACITOR_E12[ 12*i + j ] = EIA_STANDARD_E12_SET[j] * pow( 10.0f, (float)( CAPACITOR_MIN_POWER + i ) );
-		}
+/*
+ *
+ * CAPACITOR_getSet(CAPACITOR_EIA_standard)
+ *
+ * Description:
+ *
+ * Returns the table of standard capacitor values for the given EIA standard, over the
+ * decades of CAPACITOR_range, building it on first use. The table is sorted in ascending
+ * order and holds CAPACITOR_getSize(CAPACITOR_EIA_standard) values.
+ *
+ */
 
-		for( j = 0 ; j < 24 ; j++ )
-		{
-			CAPACITOR_E24[ 24*i + j ] = EIA_STANDARD_E24_SET[j] * pow( 10.0f, (float)( CAPACITOR_MIN_POWER + i ) );
-		}
+float* CAPACITOR_getSet(EIA_standard CAPACITOR_EIA_standard)
+{
+	return( EIA_getSet( &CAPACITOR_range, CAPACITOR_EIA_standard ) );
+}
 
-		for( j = 0 ; j < 48 ; j++ )
-		{
-			CAPACITOR_E48[ 48*i + j ] = EIA_STANDARD_E48_SET[j] * pow( 10.0f, (float)( CAPACITOR_MIN_POWER + i ) );
-		}
+/*	Returns the number of standard capacitor values of an EIA standard. */
 
-		for( j = 0 ; j < 96 ; j++ )
-		{
-			CAPACITOR_E96[ 96*i + j ] = EIA_STANDARD_E96_SET[j] * pow( 10.0f, (float)( CAPACITOR_MIN_POWER + i ) );
-		}
-	}
+int CAPACITOR_getSize(EIA_standard CAPACITOR_EIA_standard)
+{
+	return( EIA_getSize( &CAPACITOR_range, CAPACITOR_EIA_standard ) );
 }
 
 /*
@@ -211,7 +230,74 @@ float CAPACITOR_ECnP(float* C, int N)
 }
 
 /*
- * 	CAPACITOR_1C( C, CAPACITOR_EIA_standard )
+ * 	CAPACITOR_EC2S_AD(C1, C2), CAPACITOR_EC2P_AD(C1, C2), CAPACITOR_EC3S_AD(C1, C2, C3),
+ * 	CAPACITOR_EC3P_AD(C1, C2, C3), CAPACITOR_ECnS_AD( C[], N), CAPACITOR_ECnP_AD( C[], N)
+ *
+ * 	Description:
+ *
+ * 	Dual number versions of the equivalent capacitance functions above. They return the
+ * 	equivalent capacitance together with its partial derivatives with respect to the input
+ * 	variables of the capacitors in a single evaluation. For N = 0 the n versions return, like
+ * 	the float ones, an infinite capacitance in series and 0 in parallel.
+ *
+ */
+
+DUAL_t CAPACITOR_EC2S_AD(DUAL_t C1, DUAL_t C2)
+{
+	return( DUAL_inv( DUAL_add( DUAL_inv(C1), DUAL_inv(C2) ) ) );
+}
+
+DUAL_t CAPACITOR_EC2P_AD(DUAL_t C1, DUAL_t C2)
+{
+	return( DUAL_add( C1, C2 ) );
+}
+
+DUAL_t CAPACITOR_EC3S_AD(DUAL_t C1, DUAL_t C2, DUAL_t C3)
+{
+	return( DUAL_inv( DUAL_add( DUAL_add( DUAL_inv(C1), DUAL_inv(C2) ), DUAL_inv(C3) ) ) );
+}
+
+DUAL_t CAPACITOR_EC3P_AD(DUAL_t C1, DUAL_t C2, DUAL_t C3)
+{
+	return( DUAL_add( DUAL_add( C1, C2 ), C3 ) );
+}
+
+DUAL_t CAPACITOR_ECnS_AD(DUAL_t* C, int N)
+{
+	DUAL_t result;
+	int i;
+
+	if( N <= 0 ) return( DUAL_constant( INFINITY, 0 ) );
+
+	result = DUAL_constant( 0.0f, C[0].N );
+
+	for( i = 0 ; i < N ; i++ )
+	{
+		result = DUAL_add( result, DUAL_inv( C[i] ) );
+	}
+
+	return( DUAL_inv(result) );
+}
+
+DUAL_t CAPACITOR_ECnP_AD(DUAL_t* C, int N)
+{
+	DUAL_t result;
+	int i;
+
+	if( N <= 0 ) return( DUAL_constant( 0.0f, 0 ) );
+
+	result = DUAL_constant( 0.0f, C[0].N );
+
+	for( i = 0 ; i < N ; i++ )
+	{
+		result = DUAL_add( result, C[i] );
+	}
+
+	return(result);
+}
+
+/*
+ * 	CAPACITOR_1C_BRUTE( C, CAPACITOR_EIA_standard )
  *
  * 	Description:
  *
@@ -222,42 +308,49 @@ float CAPACITOR_ECnP(float* C, int N)
  *
  */
 
-float CAPACITOR_1C( float C, EIA_standard CAPACITOR_EIA_standard )
+float CAPACITOR_1C_BRUTE( float C, EIA_standard CAPACITOR_EIA_standard )
 {
 	float error;
 	float error_min;
-	float C_optimal;
+	float C_optimal = NAN;
 	float* C_set;
 
 	int i;
 	int limit;
 
-	error_min = pow(1.0f, (float)CAPACITOR_MAX_POWER + 1.0f);
-	limit = CAPACITOR_POWER_RANGE*CAPACITOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_CAPACITOR_1C, C );
+
+	error_min = INFINITY;
+	limit = CAPACITOR_getSize(CAPACITOR_EIA_standard);
+
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_standard);
 
-	switch(CAPACITOR_EIA_standard)
+	if( C_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; break;
+		INSTRUMENT_END(call);
+		return(NAN);
 	}
 
+	INSTRUMENT_SETUP(call);
+
 	for( i = 0 ; i < limit ; i++ )
 	{
 		error = C_set[i] - C;
 
 		if( error < 0.0f ) error = -error;
 
+		INSTRUMENT_CANDIDATE(call);
+
 		if( error < error_min )
 		{
+			INSTRUMENT_IMPROVED(call);
 			error_min = error;
 			C_optimal = C_set[i];
 		}
 	}
 
+	INSTRUMENT_END(call);
+
 	return(C_optimal);
 }
 
@@ -265,7 +358,7 @@ float CAPACITOR_1C( float C, EIA_standard CAPACITOR_EIA_standard )
 
 /*****
  *
- * CAPACITOR_2CS(C,CAPACITOR_EIA_standard, C1, C2)
+ * CAPACITOR_2CS_BRUTE(C,CAPACITOR_EIA_standard, C1, C2)
  *
  * DESCRIPTION:
  *
@@ -279,32 +372,35 @@ float CAPACITOR_1C( float C, EIA_standard CAPACITOR_EIA_standard )
  *
  *****/
 
-void CAPACITOR_2CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2 )
+void CAPACITOR_2CS_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2 )
 {
 	float error;
 	float error_min;
 	float* C_set;
-	float C1_optimal;
-	float C2_optimal;
+	float C1_optimal = NAN;
+	float C2_optimal = NAN;
 	float C_series;
 
 	int i,j;
 	int limit;
 
-	limit = CAPACITOR_POWER_RANGE*CAPACITOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_CAPACITOR_2CS, C );
+
+	limit = CAPACITOR_getSize(CAPACITOR_EIA_standard);
 
-	error_min = pow( 10.0f, (float)( CAPACITOR_POWER_RANGE + 1 ) );
+	error_min = INFINITY;
 
-	switch(CAPACITOR_EIA_standard)
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_standard);
+
+	if( C_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; 	break;
+		*C1 = NAN;
+		*C2 = NAN;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -318,8 +414,11 @@ void CAPACITOR_2CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
 				error = -error;
 			}
 
+			INSTRUMENT_CANDIDATE(call);
+
 			if( error < error_min )
 			{
+				INSTRUMENT_IMPROVED(call);
 				error_min = error;
 				C1_optimal = C_set[i];
 				C2_optimal = C_set[j];
@@ -329,11 +428,13 @@ void CAPACITOR_2CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
 
 	*C1 = C1_optimal;
 	*C2 = C2_optimal;
+
+	INSTRUMENT_END(call);
 }
 
 /*****
  *
- * CAPACITOR_2CP(C,CAPACITOR_EIA_standard, C1, C2)
+ * CAPACITOR_2CP_BRUTE(C,CAPACITOR_EIA_standard, C1, C2)
  *
  * DESCRIPTION:
  *
@@ -347,32 +448,35 @@ void CAPACITOR_2CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
  *
  *****/
 
-void CAPACITOR_2CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2 )
+void CAPACITOR_2CP_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2 )
 {
 	float error;
 	float error_min;
 	float* C_set;
-	float C1_optimal;
-	float C2_optimal;
+	float C1_optimal = NAN;
+	float C2_optimal = NAN;
 	float C_parallel;
 
 	int i,j;
 	int limit;
 
-	limit = CAPACITOR_POWER_RANGE*CAPACITOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_CAPACITOR_2CP, C );
+
+	limit = CAPACITOR_getSize(CAPACITOR_EIA_standard);
 
-	error_min = pow( 10.0f, (float)( CAPACITOR_POWER_RANGE + 1 ) );
+	error_min = INFINITY;
 
-	switch(CAPACITOR_EIA_standard)
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_standard);
+
+	if( C_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; 	break;
+		*C1 = NAN;
+		*C2 = NAN;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -386,8 +490,11 @@ void CAPACITOR_2CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
 				error = -error;
 			}
 
+			INSTRUMENT_CANDIDATE(call);
+
 			if( error < error_min )
 			{
+				INSTRUMENT_IMPROVED(call);
 				error_min = error;
 				C1_optimal = C_set[i];
 				C2_optimal = C_set[j];
@@ -397,12 +504,14 @@ void CAPACITOR_2CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
 
 	*C1 = C1_optimal;
 	*C2 = C2_optimal;
+
+	INSTRUMENT_END(call);
 }
 
 
 /*****
  *
- * CAPACITOR_3CS(C,CAPACITOR_EIA_standard, C1, C2, C3)
+ * CAPACITOR_3CS_BRUTE(C,CAPACITOR_EIA_standard, C1, C2, C3)
  *
  * DESCRIPTION:
  *
@@ -417,33 +526,37 @@ void CAPACITOR_2CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
  *
  *****/
 
-void CAPACITOR_3CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3)
+void CAPACITOR_3CS_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3)
 {
 	float error;
 	float error_min;
 	float* C_set;
-	float C1_optimal;
-	float C2_optimal;
-	float C3_optimal;
+	float C1_optimal = NAN;
+	float C2_optimal = NAN;
+	float C3_optimal = NAN;
 	float C_series;
 
 	int i,j,k;
 	int limit;
 
-	limit = CAPACITOR_POWER_RANGE*CAPACITOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_CAPACITOR_3CS, C );
 
-	error_min = pow( 10.0f, (float)( CAPACITOR_POWER_RANGE + 1 ) );
+	limit = CAPACITOR_getSize(CAPACITOR_EIA_standard);
 
-	switch(CAPACITOR_EIA_standard)
+	error_min = INFINITY;
+
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_standard);
+
+	if( C_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; 	break;
+		*C1 = NAN;
+		*C2 = NAN;
+		*C3 = NAN;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -459,8 +572,11 @@ void CAPACITOR_3CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
 					error = -error;
 				}
 
+				INSTRUMENT_CANDIDATE(call);
+
 				if( error < error_min )
 				{
+					INSTRUMENT_IMPROVED(call);
 					error_min = error;
 					C1_optimal = C_set[i];
 					C2_optimal = C_set[j];
@@ -473,12 +589,14 @@ void CAPACITOR_3CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
 	*C1 = C1_optimal;
 	*C2 = C2_optimal;
 	*C3 = C3_optimal;
+
+	INSTRUMENT_END(call);
 }
 
 
 /*****
  *
- * CAPACITOR_3CP(C,CAPACITOR_EIA_standard, C1, C2, C3)
+ * CAPACITOR_3CP_BRUTE(C,CAPACITOR_EIA_standard, C1, C2, C3)
  *
  * DESCRIPTION:
  *
@@ -493,33 +611,37 @@ void CAPACITOR_3CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
  *
  *****/
 
-void CAPACITOR_3CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3)
+void CAPACITOR_3CP_BRUTE(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3)
 {
 	float error;
 	float error_min;
 	float* C_set;
-	float C1_optimal;
-	float C2_optimal;
-	float C3_optimal;
+	float C1_optimal = NAN;
+	float C2_optimal = NAN;
+	float C3_optimal = NAN;
 	float C_parallel;
 
 	int i,j,k;
 	int limit;
 
-	limit = CAPACITOR_POWER_RANGE*CAPACITOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_CAPACITOR_3CP, C );
+
+	limit = CAPACITOR_getSize(CAPACITOR_EIA_standard);
+
+	error_min = INFINITY;
 
-	error_min = pow( 10.0f, (float)( CAPACITOR_POWER_RANGE + 1 ) );
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_standard);
 
-	switch(CAPACITOR_EIA_standard)
+	if( C_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; 	break;
+		*C1 = NAN;
+		*C2 = NAN;
+		*C3 = NAN;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -535,8 +657,11 @@ void CAPACITOR_3CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
 					error = -error;
 				}
 
+				INSTRUMENT_CANDIDATE(call);
+
 				if( error < error_min )
 				{
+					INSTRUMENT_IMPROVED(call);
 					error_min = error;
 					C1_optimal = C_set[i];
 					C2_optimal = C_set[j];
@@ -549,6 +674,8 @@ void CAPACITOR_3CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, floa
 	*C1 = C1_optimal;
 	*C2 = C2_optimal;
 	*C3 = C3_optimal;
+
+	INSTRUMENT_END(call);
 }
 
 /**
@@ -725,5 +852,50 @@ float CAPACITOR_3CP_SD(float C1, float C2, float C3, float T)
 	return( 100.0f * result );
 }
 
+/*****			Selectors			*****/
+
+float CAPACITOR_1C(float C, EIA_standard CAPACITOR_EIA_standard)
+{
+	float C1 = NAN;
+	float* part[1] = { &C1 };
+
+	if( SELECTOR_planner == NULL ) return( CAPACITOR_1C_BRUTE( C, CAPACITOR_EIA_standard ) );
+
+	SELECTOR_planner( SEARCH_CAPACITOR_1C, C, CAPACITOR_EIA_standard, CAPACITOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+
+	return(C1);
+}
+
+void CAPACITOR_2CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2)
+{
+	float* part[2] = { C1, C2 };
+
+	if( SELECTOR_planner == NULL ) CAPACITOR_2CS_BRUTE( C, CAPACITOR_EIA_standard, C1, C2 );
+	else SELECTOR_planner( SEARCH_CAPACITOR_2CS, C, CAPACITOR_EIA_standard, CAPACITOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void CAPACITOR_2CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2)
+{
+	float* part[2] = { C1, C2 };
+
+	if( SELECTOR_planner == NULL ) CAPACITOR_2CP_BRUTE( C, CAPACITOR_EIA_standard, C1, C2 );
+	else SELECTOR_planner( SEARCH_CAPACITOR_2CP, C, CAPACITOR_EIA_standard, CAPACITOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void CAPACITOR_3CS(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3)
+{
+	float* part[3] = { C1, C2, C3 };
+
+	if( SELECTOR_planner == NULL ) CAPACITOR_3CS_BRUTE( C, CAPACITOR_EIA_standard, C1, C2, C3 );
+	else SELECTOR_planner( SEARCH_CAPACITOR_3CS, C, CAPACITOR_EIA_standard, CAPACITOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void CAPACITOR_3CP(float C, EIA_standard CAPACITOR_EIA_standard, float* C1, float* C2, float* C3)
+{
+	float* part[3] = { C1, C2, C3 };
+
+	if( SELECTOR_planner == NULL ) CAPACITOR_3CP_BRUTE( C, CAPACITOR_EIA_standard, C1, C2, C3 );
+	else SELECTOR_planner( SEARCH_CAPACITOR_3CP, C, CAPACITOR_EIA_standard, CAPACITOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
 
 #endif /* PASSIVE_CAPACITOR_H_ */
@@ -0,0 +1,671 @@
+/*
+ *
+ * 	Memory mapped catalog of components.
+ *
+ * 	A catalog holds the parts of vendors, with their value, tolerance, power, package,
+ * 	temperature coefficient, price and stock, in a binary file which is mapped and used in
+ * 	place: opening a catalog of millions of rows reads no more than its header. The file is a
+ * 	64 byte header, a directory of package names and tolerance classes, the columns, the
+ * 	bitmaps and the part numbers:
+ *
+ * 		float		value, tolerance (%), power (W), tempco (|ppm/K|), price
+ * 		uint32_t	stock, name (offset of the part number)
+ * 		uint8_t		package, tolerance class
+ * 		uint64_t	one bitmap of rows per package, and per tolerance class
+ * 		char		part numbers, each ending with a zero
+ *
+ * 	Each column is as wide as the number of rows and aligned to 8 bytes. Rows are sorted by
+ * 	element, resistors first, then by value and price, so the value column is its own sorted
+ * 	index and the rows of a value come cheapest first. The bitmap of a package has the bit of
+ * 	every row in that package; the bitmap of a tolerance class has the bit of every row at
+ * 	least as precise as the class. Numbers are written in the byte order of the machine, which
+ * 	the magic number of the header tells.
+ *
+ * 	CATALOG_getSet() filters the rows of an element by combining bitmaps a word at a time, and
+ * 	scanning the numeric columns only for the words left, then keeps the cheapest row of each
+ * 	value. The values form a MIXED_set, from which any selector of MIXED.h chooses parts, and
+ * 	CATALOG_getRow() tells the row each selected part comes from.
+ *
+ */
+
+#ifndef PASSIVE_CATALOG_H_
+#define PASSIVE_CATALOG_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MIXED.h"
+
+#define CATALOG_MAGIC			0x43565350		//	"PSVC"
+#define CATALOG_VERSION			1
+#define CATALOG_HEADER_SIZE		64
+#define CATALOG_MAX_PACKAGES	64
+#define CATALOG_MAX_CLASSES		16
+#define CATALOG_NAME			16				//	Bytes of a package name, with its ending zero.
+#define CATALOG_DIRECTORY_SIZE	( CATALOG_MAX_PACKAGES * CATALOG_NAME + CATALOG_MAX_CLASSES * 4 )
+
+typedef enum
+{
+	CATALOG_VALUE, CATALOG_TOLERANCE, CATALOG_POWER, CATALOG_TEMPCO, CATALOG_PRICE,
+	CATALOG_STOCK, CATALOG_NAME_OFFSET,
+	CATALOG_PACKAGE, CATALOG_CLASS,
+	CATALOG_COUNT
+}CATALOG_column;
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t rows;
+	uint64_t split;								//	First capacitor row.
+	uint32_t N_packages;
+	uint32_t N_classes;
+	uint64_t names;								//	Bytes of part numbers.
+	uint64_t reserved[3];
+}CATALOG_header;
+
+//	Part to be written.
+
+typedef struct
+{
+	NETWORK_element element;
+	float value;
+	float tolerance;
+	float power;
+	float tempco;
+	float price;
+	uint32_t stock;
+	char package[CATALOG_NAME];
+	const char* name;
+}CATALOG_part;
+
+//	Mapped catalog.
+
+typedef struct
+{
+	const unsigned char* data;
+	size_t size;
+	uint64_t rows, split, words;
+	int N_packages, N_classes;
+	const char* package_name;					//	N_packages names of CATALOG_NAME bytes.
+	const float* class_tolerance;				//	Tolerance of each class, increasing.
+	const float* value;
+	const float* tolerance;
+	const float* power;
+	const float* tempco;
+	const float* price;
+	const uint32_t* stock;
+	const uint32_t* name;
+	const uint8_t* package;
+	const uint8_t* tolerance_class;
+	const uint64_t* package_bitmap;				//	words per package.
+	const uint64_t* class_bitmap;				//	words per class.
+	const char* names;
+}CATALOG_file;
+
+//	Rows accepted by a selection. Bounds which accept every row are INFINITY or 0.
+
+typedef struct
+{
+	NETWORK_element element;
+	uint64_t packages;							//	Bit k accepts package k; 0 accepts any.
+	float tolerance_max;
+	float power_min;
+	float tempco_max;
+	float price_max;
+	uint32_t stock_min;
+}CATALOG_filter;
+
+//	Values of the rows accepted by a filter, and the cheapest row of each.
+
+typedef struct
+{
+	MIXED_set set;
+	float* value;
+	uint64_t* row;
+	int N;
+}CATALOG_set;
+
+/*****			Function declarations			*****/
+
+size_t CATALOG_offset(CATALOG_column column, uint64_t rows);
+int CATALOG_write(const char* path, CATALOG_part* part, uint64_t N);
+int CATALOG_map(const char* path, CATALOG_file* file);
+void CATALOG_unmap(CATALOG_file* file);
+int CATALOG_getPackage(CATALOG_file* file, const char* name);
+void CATALOG_initFilter(CATALOG_filter* filter, NETWORK_element element);
+uint64_t CATALOG_filterRows(CATALOG_file* file, CATALOG_filter* filter, uint64_t* bitmap);
+int CATALOG_getSet(CATALOG_file* file, CATALOG_filter* filter, CATALOG_set* set);
+void CATALOG_freeSet(CATALOG_set* set);
+int64_t CATALOG_getRow(CATALOG_set* set, float part);
+
+/*****			Function definitions			*****/
+
+/*	Bytes rounded up to a multiple of 8. */
+
+size_t CATALOG_align(size_t n)
+{
+	return( ( n + 7 ) & ~(size_t)7 );
+}
+
+/*	Offset of a column in a file of rows rows, and of the bitmaps with CATALOG_COUNT. */
+
+size_t CATALOG_offset(CATALOG_column column, uint64_t rows)
+{
+	size_t offset = CATALOG_HEADER_SIZE + CATALOG_DIRECTORY_SIZE;
+	int c;
+
+	for( c = 0 ; c < (int)column ; c++ ) offset += CATALOG_align( (size_t)rows * ( ( c < CATALOG_PACKAGE ) ? 4 : 1 ) );
+
+	return(offset);
+}
+
+/*	Orders parts by element, value and price for qsort. */
+
+int CATALOG_compareParts(const void* a, const void* b)
+{
+	const CATALOG_part* x = (const CATALOG_part*)a;
+	const CATALOG_part* y = (const CATALOG_part*)b;
+
+	if( x->element != y->element ) return( ( x->element > y->element ) - ( x->element < y->element ) );
+	if( x->value != y->value ) return( ( x->value > y->value ) - ( x->value < y->value ) );
+
+	return( ( x->price > y->price ) - ( x->price < y->price ) );
+}
+
+/*
+ * CATALOG_write(path, part, N)
+ *
+ * Description:
+ *
+ * Writes a catalog of N parts, which are sorted in place. Returns 0, or -1 if a value is not
+ * positive and finite, a tolerance is not finite and non-negative, the parts have more than CATALOG_MAX_PACKAGES packages or
+ * CATALOG_MAX_CLASSES tolerances, memory ran out or the file could not be written.
+ *
+ */
+
+int CATALOG_write(const char* path, CATALOG_part* part, uint64_t N)
+{
+	CATALOG_header header;
+	char package_name[CATALOG_MAX_PACKAGES][CATALOG_NAME];
+	float class_tolerance[CATALOG_MAX_CLASSES], swap;
+	uint8_t* code = NULL;
+	unsigned char* column = NULL;
+	uint64_t* bitmap = NULL;
+	uint64_t words = ( N + 63 ) / 64, r, names = 0;
+	uint32_t offset;
+	FILE* out;
+	int N_packages = 0, N_classes = 0, c, k, status = 0;
+
+	for( r = 0 ; r < N ; r++ )
+	{
+		if( !( part[r].value > 0.0f ) || !isfinite( part[r].value ) ) return(-1);
+		if( !( part[r].tolerance >= 0.0f ) || !isfinite( part[r].tolerance ) ) return(-1);
+
+		names += strlen( part[r].name ) + 1;
+	}
+
+	if( names > UINT32_MAX ) return(-1);
+
+	qsort( part, N, sizeof(CATALOG_part), CATALOG_compareParts );
+
+	//	Packages and tolerance classes.
+
+	memset( package_name, 0, sizeof(package_name) );
+	memset( class_tolerance, 0, sizeof(class_tolerance) );
+
+	for( r = 0 ; r < N ; r++ )
+	{
+		for( k = 0 ; k < N_packages && strncmp( package_name[k], part[r].package, CATALOG_NAME - 1 ) != 0 ; k++ );
+
+		if( k == N_packages )
+		{
+			if( N_packages == CATALOG_MAX_PACKAGES ) return(-1);
+
+			strncpy( package_name[N_packages++], part[r].package, CATALOG_NAME - 1 );
+		}
+
+		for( k = 0 ; k < N_classes && class_tolerance[k] != part[r].tolerance ; k++ );
+
+		if( k == N_classes )
+		{
+			if( N_classes == CATALOG_MAX_CLASSES ) return(-1);
+
+			class_tolerance[N_classes++] = part[r].tolerance;
+		}
+	}
+
+	for( k = 1 ; k < N_classes ; k++ )
+	{
+		for( c = k ; c > 0 && class_tolerance[c-1] > class_tolerance[c] ; c-- )
+		{
+			swap = class_tolerance[c-1];
+			class_tolerance[c-1] = class_tolerance[c];
+			class_tolerance[c] = swap;
+		}
+	}
+
+	memset( &header, 0, sizeof(header) );
+
+	header.magic = CATALOG_MAGIC;
+	header.version = CATALOG_VERSION;
+	header.rows = N;
+	header.N_packages = (uint32_t)N_packages;
+	header.N_classes = (uint32_t)N_classes;
+	header.names = names;
+
+	for( header.split = 0 ; header.split < N && part[ header.split ].element == NETWORK_RESISTOR ; header.split++ );
+
+	//	Columns are written one at a time from a buffer of the widest one.
+
+	code = (uint8_t*)malloc( 2 * N + 1 );
+	column = (unsigned char*)malloc( CATALOG_align( 4 * N ) + 8 );
+	bitmap = (uint64_t*)malloc( sizeof(uint64_t) * words + 8 );
+	out = fopen( path, "wb" );
+
+	if( code == NULL || column == NULL || bitmap == NULL || out == NULL )
+	{
+		free(code);
+		free(column);
+		free(bitmap);
+
+		if( out != NULL ) fclose(out);
+
+		return(-1);
+	}
+
+	for( r = 0 ; r < N ; r++ )
+	{
+		for( k = 0 ; strncmp( package_name[k], part[r].package, CATALOG_NAME - 1 ) != 0 ; k++ );
+
+		code[2*r] = (uint8_t)k;
+
+		for( k = 0 ; class_tolerance[k] != part[r].tolerance ; k++ );
+
+		code[2*r + 1] = (uint8_t)k;
+	}
+
+	if( fwrite( &header, sizeof(header), 1, out ) != 1 ) status = -1;
+	if( fwrite( package_name, sizeof(package_name), 1, out ) != 1 ) status = -1;
+	if( fwrite( class_tolerance, sizeof(class_tolerance), 1, out ) != 1 ) status = -1;
+
+	for( c = 0 ; c < CATALOG_COUNT && status == 0 ; c++ )
+	{
+		memset( column, 0, CATALOG_align( 4 * N ) );
+
+		for( r = 0, offset = 0 ; r < N ; r++ )
+		{
+			switch(c)
+			{
+				case(CATALOG_VALUE):		memcpy( column + 4*r, &part[r].value, 4 ); break;
+				case(CATALOG_TOLERANCE):	memcpy( column + 4*r, &part[r].tolerance, 4 ); break;
+				case(CATALOG_POWER):		memcpy( column + 4*r, &part[r].power, 4 ); break;
+				case(CATALOG_TEMPCO):		memcpy( column + 4*r, &part[r].tempco, 4 ); break;
+				case(CATALOG_PRICE):		memcpy( column + 4*r, &part[r].price, 4 ); break;
+				case(CATALOG_STOCK):		memcpy( column + 4*r, &part[r].stock, 4 ); break;
+				case(CATALOG_NAME_OFFSET):
+				{
+					memcpy( column + 4*r, &offset, 4 );
+					offset += (uint32_t)strlen( part[r].name ) + 1;
+				}; break;
+				case(CATALOG_PACKAGE):		column[r] = code[2*r]; break;
+				case(CATALOG_CLASS):		column[r] = code[2*r + 1]; break;
+			}
+		}
+
+		if( fwrite( column, CATALOG_offset( c + 1, N ) - CATALOG_offset( c, N ), 1, out ) != 1 && N > 0 ) status = -1;
+	}
+
+	//	Bitmaps of the packages, then of the rows at least as precise as each class.
+
+	for( c = 0 ; c < N_packages + N_classes && status == 0 ; c++ )
+	{
+		memset( bitmap, 0, sizeof(uint64_t) * words );
+
+		for( r = 0 ; r < N ; r++ )
+		{
+			if( c < N_packages ? ( code[2*r] == c ) : ( code[2*r + 1] <= c - N_packages ) ) bitmap[ r / 64 ] |= (uint64_t)1 << ( r % 64 );
+		}
+
+		if( words > 0 && fwrite( bitmap, sizeof(uint64_t) * words, 1, out ) != 1 ) status = -1;
+	}
+
+	for( r = 0 ; r < N && status == 0 ; r++ ) if( fwrite( part[r].name, strlen( part[r].name ) + 1, 1, out ) != 1 ) status = -1;
+
+	if( fclose(out) != 0 ) status = -1;
+
+	free(code);
+	free(column);
+	free(bitmap);
+
+	return(status);
+}
+
+/*
+ * CATALOG_map(path, file)
+ *
+ * Description:
+ *
+ * Maps a catalog for reading. Returns 0, or -1 if it cannot be read, was written with another
+ * byte order or version, is truncated, or a part number lies outside the file.
+ *
+ */
+
+int CATALOG_map(const char* path, CATALOG_file* file)
+{
+	CATALOG_header header;
+	struct stat info;
+	size_t bitmaps;
+	uint64_t r;
+	void* data;
+	int fd;
+
+	fd = open( path, O_RDONLY );
+
+	if( fd < 0 ) return(-1);
+
+	if( fstat( fd, &info ) < 0 || (size_t)info.st_size < CATALOG_HEADER_SIZE + CATALOG_DIRECTORY_SIZE )
+	{
+		close(fd);
+		return(-1);
+	}
+
+	data = mmap( NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+	close(fd);
+
+	if( data == MAP_FAILED ) return(-1);
+
+	file->data = (const unsigned char*)data;
+	file->size = (size_t)info.st_size;
+
+	memcpy( &header, file->data, sizeof(header) );
+
+	file->rows = header.rows;
+	file->split = header.split;
+	file->words = ( header.rows + 63 ) / 64;
+	file->N_packages = (int)header.N_packages;
+	file->N_classes = (int)header.N_classes;
+
+	//	Every row takes several bytes, which bounds the sizes before they are added up.
+
+	bitmaps = ( header.rows < file->size && header.N_packages <= CATALOG_MAX_PACKAGES && header.N_classes <= CATALOG_MAX_CLASSES ) ?
+			  CATALOG_offset( CATALOG_COUNT, header.rows ) + sizeof(uint64_t) * file->words * ( header.N_packages + header.N_classes ) : 0;
+
+	if( header.magic != CATALOG_MAGIC || header.version != CATALOG_VERSION || header.split > header.rows || bitmaps == 0 ||
+		header.names > file->size || bitmaps + header.names != file->size )
+	{
+		munmap( data, file->size );
+		return(-1);
+	}
+
+	file->package_name = (const char*)( file->data + CATALOG_HEADER_SIZE );
+	file->class_tolerance = (const float*)( file->data + CATALOG_HEADER_SIZE + CATALOG_MAX_PACKAGES * CATALOG_NAME );
+	file->value = (const float*)( file->data + CATALOG_offset( CATALOG_VALUE, file->rows ) );
+	file->tolerance = (const float*)( file->data + CATALOG_offset( CATALOG_TOLERANCE, file->rows ) );
+	file->power = (const float*)( file->data + CATALOG_offset( CATALOG_POWER, file->rows ) );
+	file->tempco = (const float*)( file->data + CATALOG_offset( CATALOG_TEMPCO, file->rows ) );
+	file->price = (const float*)( file->data + CATALOG_offset( CATALOG_PRICE, file->rows ) );
+	file->stock = (const uint32_t*)( file->data + CATALOG_offset( CATALOG_STOCK, file->rows ) );
+	file->name = (const uint32_t*)( file->data + CATALOG_offset( CATALOG_NAME_OFFSET, file->rows ) );
+	file->package = file->data + CATALOG_offset( CATALOG_PACKAGE, file->rows );
+	file->tolerance_class = file->data + CATALOG_offset( CATALOG_CLASS, file->rows );
+	file->package_bitmap = (const uint64_t*)( file->data + CATALOG_offset( CATALOG_COUNT, file->rows ) );
+	file->class_bitmap = file->package_bitmap + file->words * file->N_packages;
+	file->names = (const char*)( file->data + bitmaps );
+
+	//	Part numbers start within the names, and the last one ends there.
+
+	for( r = 0 ; r < file->rows && file->name[r] < header.names ; r++ );
+
+	if( r < file->rows || ( header.names > 0 && file->names[ header.names - 1 ] != '\0' ) )
+	{
+		munmap( data, file->size );
+		return(-1);
+	}
+
+	return(0);
+}
+
+void CATALOG_unmap(CATALOG_file* file)
+{
+	munmap( (void*)file->data, file->size );
+}
+
+/*	Returns the code of a package, or -1 if no part has it. */
+
+int CATALOG_getPackage(CATALOG_file* file, const char* name)
+{
+	int k;
+
+	for( k = 0 ; k < file->N_packages ; k++ ) if( strncmp( file->package_name + k * CATALOG_NAME, name, CATALOG_NAME - 1 ) == 0 ) return(k);
+
+	return(-1);
+}
+
+/*
+ * CATALOG_initFilter(filter, element)
+ *
+ * Description:
+ *
+ * Initializes a filter accepting every part of an element.
+ *
+ */
+
+void CATALOG_initFilter(CATALOG_filter* filter, NETWORK_element element)
+{
+	filter->element = element;
+	filter->packages = 0;
+	filter->tolerance_max = INFINITY;
+	filter->power_min = 0.0f;
+	filter->tempco_max = INFINITY;
+	filter->price_max = INFINITY;
+	filter->stock_min = 0;
+}
+
+/*
+ * CATALOG_filterRows(file, filter, bitmap)
+ *
+ * Description:
+ *
+ * Sets in bitmap, of file->words words, the bits of the rows accepted by a filter, and returns
+ * their number. The bitmaps of the packages and of the tolerance class are combined first;
+ * the numeric columns are then only read for the words with rows left.
+ *
+ */
+
+uint64_t CATALOG_filterRows(CATALOG_file* file, CATALOG_filter* filter, uint64_t* bitmap)
+{
+	uint64_t begin = ( filter->element == NETWORK_RESISTOR ) ? 0 : file->split;
+	uint64_t end = ( filter->element == NETWORK_RESISTOR ) ? file->split : file->rows;
+	uint64_t w, mask, bit, r, count = 0;
+	int numeric, k, c;
+
+	//	Rows of the element.
+
+	for( w = 0 ; w < file->words ; w++ )
+	{
+		bitmap[w] = ( 64 * w >= begin && 64 * w + 64 <= end ) ? ~(uint64_t)0 : 0;
+
+		if( bitmap[w] != 0 || 64 * w >= end || 64 * w + 64 <= begin ) continue;
+
+		for( bit = 0 ; bit < 64 ; bit++ )
+		{
+			r = 64 * w + bit;
+
+			if( r >= begin && r < end ) bitmap[w] |= (uint64_t)1 << bit;
+		}
+	}
+
+	//	Packages, and the largest class within the tolerance.
+
+	if( filter->packages != 0 )
+	{
+		for( w = begin / 64 ; w < ( end + 63 ) / 64 ; w++ )
+		{
+			for( k = 0, mask = 0 ; k < file->N_packages ; k++ )
+			{
+				if( filter->packages & ( (uint64_t)1 << k ) ) mask |= file->package_bitmap[ k * file->words + w ];
+			}
+
+			bitmap[w] &= mask;
+		}
+	}
+
+	if( filter->tolerance_max < INFINITY )
+	{
+		for( c = file->N_classes - 1 ; c >= 0 && file->class_tolerance[c] > filter->tolerance_max ; c-- );
+
+		for( w = begin / 64 ; w < ( end + 63 ) / 64 ; w++ ) bitmap[w] &= ( c >= 0 ) ? file->class_bitmap[ c * file->words + w ] : 0;
+	}
+
+	numeric = ( filter->power_min > 0.0f || filter->tempco_max < INFINITY || filter->price_max < INFINITY || filter->stock_min > 0 );
+
+	for( w = begin / 64 ; w < ( end + 63 ) / 64 ; w++ )
+	{
+		if( bitmap[w] == 0 ) continue;
+
+		if( numeric )
+		{
+			for( bit = 0, mask = 0 ; bit < 64 && 64 * w + bit < file->rows ; bit++ )
+			{
+				r = 64 * w + bit;
+
+				mask |= (uint64_t)( file->power[r] >= filter->power_min && file->tempco[r] <= filter->tempco_max &&
+									file->price[r] <= filter->price_max && file->stock[r] >= filter->stock_min ) << bit;
+			}
+
+			bitmap[w] &= mask;
+		}
+
+		for( mask = bitmap[w] ; mask != 0 ; mask &= mask - 1 ) count++;
+	}
+
+	return(count);
+}
+
+/*
+ * CATALOG_getSet(file, filter, set)
+ *
+ * Description:
+ *
+ * Makes set the values of the rows accepted by a filter, each with its cheapest row, and
+ * set->set the MIXED_set of these values for the selectors of MIXED.h. Returns the number of
+ * values, or -1 if memory ran out or there are more than MIXED_MAX_VALUES of them. The set,
+ * with the pair tables set->set keeps, is freed with CATALOG_freeSet(), and is valid while
+ * the file is mapped.
+ *
+ */
+
+int CATALOG_getSet(CATALOG_file* file, CATALOG_filter* filter, CATALOG_set* set)
+{
+	uint64_t* bitmap;
+	uint64_t* row;
+	float* value;
+	uint64_t w, bit, r;
+	int N = 0;
+
+	set->value = NULL;
+	set->row = NULL;
+	set->N = 0;
+	set->set.tables = NULL;
+
+	bitmap = (uint64_t*)malloc( sizeof(uint64_t) * file->words + 8 );
+
+	if( bitmap == NULL ) return(-1);
+
+	CATALOG_filterRows( file, filter, bitmap );
+
+	//	Rows are in order of value, cheapest first: the first row of a value is kept.
+
+	for( w = 0 ; w < file->words ; w++ )
+	{
+		for( bit = 0 ; bit < 64 && bitmap[w] != 0 ; bit++ )
+		{
+			if( !( bitmap[w] & ( (uint64_t)1 << bit ) ) ) continue;
+
+			r = 64 * w + bit;
+
+			if( N > 0 && file->value[r] == set->value[ N - 1 ] ) continue;
+
+			if( N == MIXED_MAX_VALUES )
+			{
+				free(bitmap);
+				CATALOG_freeSet(set);
+				return(-1);
+			}
+
+			if( N % 1024 == 0 )
+			{
+				value = (float*)realloc( set->value, sizeof(float) * ( N + 1024 ) );
+
+				if( value != NULL ) set->value = value;
+
+				row = (uint64_t*)realloc( set->row, sizeof(uint64_t) * ( N + 1024 ) );
+
+				if( row != NULL ) set->row = row;
+
+				if( value == NULL || row == NULL )
+				{
+					free(bitmap);
+					CATALOG_freeSet(set);
+					return(-1);
+				}
+			}
+
+			set->value[N] = file->value[r];
+			set->row[N] = r;
+			N++;
+		}
+	}
+
+	free(bitmap);
+
+	set->N = N;
+	set->set.value = set->value;
+	set->set.N = N;
+	set->set.element = filter->element;
+	set->set.std = (EIA_standard)0;
+
+	//	The values are sorted already; the set keeps the pair tables it is searched with.
+
+	if( N > 0 && MIXED_stock( &set->set, filter->element, set->value, N ) < 0 )
+	{
+		CATALOG_freeSet(set);
+		return(-1);
+	}
+
+	return(N);
+}
+
+/*	Frees the values of a set, and the pair tables its MIXED_set and the copies of it kept. */
+
+void CATALOG_freeSet(CATALOG_set* set)
+{
+	MIXED_freeSet( &set->set );
+	free(set->value);
+	free(set->row);
+	set->value = NULL;
+	set->row = NULL;
+	set->N = 0;
+}
+
+/*	Returns the row of a part selected from a set, or -1 if it is not one of its values. */
+
+int64_t CATALOG_getRow(CATALOG_set* set, float part)
+{
+	int k = lower_bound( set->value, set->N, part );
+
+	return( ( k < set->N && set->value[k] == part ) ? (int64_t)set->row[k] : -1 );
+}
+
+#endif /* PASSIVE_CATALOG_H_ */
@@ -0,0 +1,463 @@
+/*
+ *
+ * 	Binary columnar format of selections.
+ *
+ * 	A file is a 32 byte header, blocks of selections and a 16 byte footer holding the number
+ * 	of selections, so that it can be written to a pipe without seeking back. Every block but
+ * 	the last holds COLUMNS_BLOCK selections; the last one holds the rest. Inside a block of n
+ * 	selections the columns follow each other, each n entries wide:
+ *
+ * 		float		target, value, error
+ * 		uint16_t	part[0], part[1], part[2], part[3]
+ * 		uint8_t		topology, N_parts, R_std, C_std
+ *
+ * 	Parts are stored as their index in the set of SYNTHESIS_getSet() of their element and
+ * 	standard, and unused parts as COLUMNS_NONE. A request which could not be solved has no
+ * 	parts, topology COLUMNS_INVALID and a NaN value and error. Numbers are written in the byte
+ * 	order of the machine, which the magic number of the header tells; columns are aligned so
+ * 	that a mapped file can be read in place through COLUMNS_getBlock().
+ *
+ * 	Since parts are indices, a file can only be decoded with the sets it was written with: the
+ * 	header records the decades of RESISTOR_range and CAPACITOR_range, the number of custom
+ * 	series and a hash of their mantissas, which COLUMNS_map() checks against those in use.
+ *
+ */
+
+#ifndef PASSIVE_COLUMNS_H_
+#define PASSIVE_COLUMNS_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "helper_functions.h"
+#include "SEARCH.h"
+
+#define COLUMNS_MAGIC			0x52565350		//	"PSVR"
+#define COLUMNS_VERSION			2
+#define COLUMNS_HEADER_SIZE		32
+#define COLUMNS_FOOTER_SIZE		16
+#define COLUMNS_BLOCK			4096			//	Selections per block.
+#define COLUMNS_ROW_SIZE		24				//	Bytes per selection.
+#define COLUMNS_NONE			0xFFFF
+#define COLUMNS_INVALID			0xFF
+
+typedef enum
+{
+	COLUMNS_TARGET, COLUMNS_VALUE, COLUMNS_ERROR,
+	COLUMNS_PART_0, COLUMNS_PART_1, COLUMNS_PART_2, COLUMNS_PART_3,
+	COLUMNS_TOPOLOGY, COLUMNS_N_PARTS, COLUMNS_R_STD, COLUMNS_C_STD,
+	COLUMNS_COUNT
+}COLUMNS_column;
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t block;								//	Selections per block.
+	uint32_t columns;
+	int8_t R_low, R_high;						//	Decades of the sets of the parts.
+	int8_t C_low, C_high;
+	uint32_t N_custom;							//	Custom series, and a hash of them.
+	uint64_t custom;
+}COLUMNS_header;
+
+//	Selections written but not yet flushed.
+
+typedef struct
+{
+	FILE* out;
+	int n;
+	uint64_t rows;
+	unsigned char block[ COLUMNS_BLOCK * COLUMNS_ROW_SIZE ];
+}COLUMNS_writer;
+
+//	Mapped file.
+
+typedef struct
+{
+	const unsigned char* data;
+	size_t size;
+	uint64_t rows;
+	uint64_t N_blocks;
+}COLUMNS_file;
+
+//	Columns of a block, pointing into the mapped file.
+
+typedef struct
+{
+	int n;
+	const float* target;
+	const float* value;
+	const float* error;
+	const uint16_t* part[SEARCH_MAX_PARTS];
+	const uint8_t* topology;
+	const uint8_t* N_parts;
+	const uint8_t* R_std;
+	const uint8_t* C_std;
+}COLUMNS_block;
+
+/*****			Function declarations			*****/
+
+size_t COLUMNS_offset(COLUMNS_column column, int n);
+void COLUMNS_describe(COLUMNS_header* header);
+NETWORK_element COLUMNS_getElement(SEARCH_topology topology, int slot, int N_parts);
+int COLUMNS_begin(COLUMNS_writer* writer, FILE* out);
+int COLUMNS_append(COLUMNS_writer* writer, SEARCH_query* query, SEARCH_result* result);
+int COLUMNS_end(COLUMNS_writer* writer);
+int COLUMNS_map(const char* path, COLUMNS_file* file);
+void COLUMNS_unmap(COLUMNS_file* file);
+void COLUMNS_getBlock(COLUMNS_file* file, uint64_t b, COLUMNS_block* block);
+int COLUMNS_getRow(COLUMNS_file* file, uint64_t row, SEARCH_query* query, SEARCH_result* result);
+
+/*****			Function definitions			*****/
+
+/*	Offset of a column in a block of n selections. */
+
+size_t COLUMNS_offset(COLUMNS_column column, int n)
+{
+	if( column <= COLUMNS_ERROR ) return( (size_t)n * 4 * column );
+	if( column <= COLUMNS_PART_3 ) return( (size_t)n * ( 12 + 2 * ( column - COLUMNS_PART_0 ) ) );
+
+	return( (size_t)n * ( 20 + ( column - COLUMNS_TOPOLOGY ) ) );
+}
+
+/*	Element of the part in a slot of a selection. */
+
+NETWORK_element COLUMNS_getElement(SEARCH_topology topology, int slot, int N_parts)
+{
+	if( topology >= SEARCH_CAPACITOR_1C && topology <= SEARCH_CAPACITOR_3CP ) return(NETWORK_CAPACITOR);
+	if( topology >= SEARCH_RC_1R1C && slot == N_parts - 1 ) return(NETWORK_CAPACITOR);
+
+	return(NETWORK_RESISTOR);
+}
+
+/*	Sets the fields of a header which describe the sets in use: their decades, and the custom
+	series with an FNV-1a hash of their counts and mantissas in hundredths. */
+
+void COLUMNS_describe(COLUMNS_header* header)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	int s, k;
+
+	header->R_low = (int8_t)RESISTOR_range.low;
+	header->R_high = (int8_t)RESISTOR_range.high;
+	header->C_low = (int8_t)CAPACITOR_range.low;
+	header->C_high = (int8_t)CAPACITOR_range.high;
+
+	pthread_mutex_lock(&EIA_lock);
+
+	header->N_custom = (uint32_t)EIA_N_custom;
+
+	for( s = 0 ; s < EIA_N_custom ; s++ )
+	{
+		hash = ( hash ^ (uint64_t)EIA_customCount[s] ) * 1099511628211ULL;
+
+		for( k = 0 ; k < EIA_customCount[s] ; k++ ) hash = ( hash ^ (uint64_t)lroundf( 100.0f * EIA_custom[s][k] ) ) * 1099511628211ULL;
+	}
+
+	pthread_mutex_unlock(&EIA_lock);
+
+	header->custom = hash;
+}
+
+/*
+ * COLUMNS_begin(writer, out)
+ *
+ * Description:
+ *
+ * Starts a file on out by writing its header. Returns 0, or -1 on a write error.
+ *
+ */
+
+int COLUMNS_begin(COLUMNS_writer* writer, FILE* out)
+{
+	COLUMNS_header header;
+
+	memset( &header, 0, sizeof(header) );
+
+	header.magic = COLUMNS_MAGIC;
+	header.version = COLUMNS_VERSION;
+	header.block = COLUMNS_BLOCK;
+	header.columns = COLUMNS_COUNT;
+
+	COLUMNS_describe(&header);
+
+	writer->out = out;
+	writer->n = 0;
+	writer->rows = 0;
+
+	return( ( fwrite( &header, sizeof(header), 1, out ) == 1 ) ? 0 : -1 );
+}
+
+/*	Writes the n selections of the current block, compacting its columns if it is partial. */
+
+int COLUMNS_flush(COLUMNS_writer* writer)
+{
+	int n = writer->n;
+	int c;
+
+	if( n == 0 ) return(0);
+
+	if( n < COLUMNS_BLOCK )
+	{
+		for( c = COLUMNS_VALUE ; c < COLUMNS_COUNT ; c++ )
+		{
+			memmove( writer->block + COLUMNS_offset( c, n ), writer->block + COLUMNS_offset( c, COLUMNS_BLOCK ),
+					 COLUMNS_offset( c + 1, n ) - COLUMNS_offset( c, n ) );
+		}
+	}
+
+	writer->n = 0;
+
+	return( ( fwrite( writer->block, (size_t)n * COLUMNS_ROW_SIZE, 1, writer->out ) == 1 ) ? 0 : -1 );
+}
+
+/*
+ * COLUMNS_append(writer, query, result)
+ *
+ * Description:
+ *
+ * Appends the selection made for a query, or an unsolved request if result is NULL. Returns
+ * 0, or -1 on a write error.
+ *
+ */
+
+int COLUMNS_append(COLUMNS_writer* writer, SEARCH_query* query, SEARCH_result* result)
+{
+	unsigned char* block = writer->block;
+	NETWORK_element element;
+	EIA_standard std;
+	float* set;
+	uint16_t index;
+	float x;
+	int i = writer->n;
+	int slot, N, k;
+
+	x = query->target;
+	memcpy( block + COLUMNS_offset( COLUMNS_TARGET, COLUMNS_BLOCK ) + 4*i, &x, 4 );
+
+	x = ( result != NULL && result->N_parts > 0 ) ? result->value : NAN;
+	memcpy( block + COLUMNS_offset( COLUMNS_VALUE, COLUMNS_BLOCK ) + 4*i, &x, 4 );
+
+	x = ( result != NULL && result->N_parts > 0 ) ? result->error : NAN;
+	memcpy( block + COLUMNS_offset( COLUMNS_ERROR, COLUMNS_BLOCK ) + 4*i, &x, 4 );
+
+	for( slot = 0 ; slot < SEARCH_MAX_PARTS ; slot++ )
+	{
+		index = COLUMNS_NONE;
+
+		if( result != NULL && slot < result->N_parts )
+		{
+			element = COLUMNS_getElement( result->topology, slot, result->N_parts );
+			std = ( element == NETWORK_RESISTOR ) ? query->R_std : query->C_std;
+			set = SYNTHESIS_getSet( element, std, &N );
+
+			//	Parts are entries of the set, up to rounding. A part outside any set stays COLUMNS_NONE.
+
+			if( set != NULL && N > 0 )
+			{
+				k = lower_bound( set, N, result->part[slot] );
+
+				if( k > 0 && ( k == N || set[k] - result->part[slot] > result->part[slot] - set[k-1] ) ) k--;
+
+				index = (uint16_t)k;
+			}
+		}
+
+		memcpy( block + COLUMNS_offset( COLUMNS_PART_0 + slot, COLUMNS_BLOCK ) + 2*i, &index, 2 );
+	}
+
+	block[ COLUMNS_offset( COLUMNS_TOPOLOGY, COLUMNS_BLOCK ) + i ] = ( result != NULL ) ? (uint8_t)result->topology : COLUMNS_INVALID;
+	block[ COLUMNS_offset( COLUMNS_N_PARTS, COLUMNS_BLOCK ) + i ] = ( result != NULL ) ? (uint8_t)result->N_parts : 0;
+	block[ COLUMNS_offset( COLUMNS_R_STD, COLUMNS_BLOCK ) + i ] = (uint8_t)query->R_std;
+	block[ COLUMNS_offset( COLUMNS_C_STD, COLUMNS_BLOCK ) + i ] = (uint8_t)query->C_std;
+
+	writer->rows++;
+
+	if( ++writer->n == COLUMNS_BLOCK ) return( COLUMNS_flush(writer) );
+
+	return(0);
+}
+
+/*
+ * COLUMNS_end(writer)
+ *
+ * Description:
+ *
+ * Writes the last block and the footer. Returns 0, or -1 on a write error. The stream is
+ * left open.
+ *
+ */
+
+int COLUMNS_end(COLUMNS_writer* writer)
+{
+	uint32_t footer[4];
+
+	if( COLUMNS_flush(writer) < 0 ) return(-1);
+
+	memcpy( footer, &writer->rows, 8 );
+	footer[2] = COLUMNS_MAGIC;
+	footer[3] = 0;
+
+	if( fwrite( footer, sizeof(footer), 1, writer->out ) != 1 ) return(-1);
+
+	return( ( fflush( writer->out ) == 0 ) ? 0 : -1 );
+}
+
+/*
+ * COLUMNS_map(path, file)
+ *
+ * Description:
+ *
+ * Maps a file for reading. Returns 0, or -1 if it cannot be read, was written with another
+ * byte order or version, is truncated, or was written with other decades or custom series
+ * than those in use, in which case its part indices would decode to other values.
+ *
+ */
+
+int COLUMNS_map(const char* path, COLUMNS_file* file)
+{
+	COLUMNS_header header, current;
+	struct stat info;
+	uint32_t footer[4];
+	uint64_t expected;
+	void* data;
+	int fd;
+
+	fd = open( path, O_RDONLY );
+
+	if( fd < 0 ) return(-1);
+
+	if( fstat( fd, &info ) < 0 || (size_t)info.st_size < COLUMNS_HEADER_SIZE + COLUMNS_FOOTER_SIZE )
+	{
+		close(fd);
+		return(-1);
+	}
+
+	data = mmap( NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+	close(fd);
+
+	if( data == MAP_FAILED ) return(-1);
+
+	file->data = (const unsigned char*)data;
+	file->size = (size_t)info.st_size;
+
+	memcpy( &header, file->data, sizeof(header) );
+	memcpy( footer, file->data + file->size - COLUMNS_FOOTER_SIZE, sizeof(footer) );
+	memcpy( &file->rows, footer, 8 );
+
+	file->N_blocks = ( file->rows + COLUMNS_BLOCK - 1 ) / COLUMNS_BLOCK;
+	expected = COLUMNS_HEADER_SIZE + COLUMNS_FOOTER_SIZE + file->rows * COLUMNS_ROW_SIZE;
+
+	COLUMNS_describe(&current);
+
+	if( header.magic != COLUMNS_MAGIC || header.version != COLUMNS_VERSION || header.block != COLUMNS_BLOCK ||
+		footer[2] != COLUMNS_MAGIC || expected != file->size ||
+		header.R_low != current.R_low || header.R_high != current.R_high ||
+		header.C_low != current.C_low || header.C_high != current.C_high ||
+		header.N_custom != current.N_custom || header.custom != current.custom )
+	{
+		munmap( data, file->size );
+		return(-1);
+	}
+
+	return(0);
+}
+
+void COLUMNS_unmap(COLUMNS_file* file)
+{
+	munmap( (void*)file->data, file->size );
+}
+
+/*
+ * COLUMNS_getBlock(file, b, block)
+ *
+ * Description:
+ *
+ * Points block to the columns of block b of a mapped file.
+ *
+ */
+
+void COLUMNS_getBlock(COLUMNS_file* file, uint64_t b, COLUMNS_block* block)
+{
+	const unsigned char* base = file->data + COLUMNS_HEADER_SIZE + b * COLUMNS_BLOCK * COLUMNS_ROW_SIZE;
+	int n, slot;
+
+	n = ( b + 1 < file->N_blocks ) ? COLUMNS_BLOCK : (int)( file->rows - b * COLUMNS_BLOCK );
+
+	block->n = n;
+	block->target = (const float*)( base + COLUMNS_offset( COLUMNS_TARGET, n ) );
+	block->value = (const float*)( base + COLUMNS_offset( COLUMNS_VALUE, n ) );
+	block->error = (const float*)( base + COLUMNS_offset( COLUMNS_ERROR, n ) );
+
+	for( slot = 0 ; slot < SEARCH_MAX_PARTS ; slot++ ) block->part[slot] = (const uint16_t*)( base + COLUMNS_offset( COLUMNS_PART_0 + slot, n ) );
+
+	block->topology = base + COLUMNS_offset( COLUMNS_TOPOLOGY, n );
+	block->N_parts = base + COLUMNS_offset( COLUMNS_N_PARTS, n );
+	block->R_std = base + COLUMNS_offset( COLUMNS_R_STD, n );
+	block->C_std = base + COLUMNS_offset( COLUMNS_C_STD, n );
+}
+
+/*
+ * COLUMNS_getRow(file, row, query, result)
+ *
+ * Description:
+ *
+ * Decodes one selection of a mapped file, with its part values. Only the topology, target
+ * and standards of query are set, and the selection is not marked optimal. Returns 0, or -1
+ * if row is past the end of the file, which leaves query and result untouched, or if a
+ * standard or a part index is out of its set, whose parts are then left at 0.
+ *
+ */
+
+int COLUMNS_getRow(COLUMNS_file* file, uint64_t row, SEARCH_query* query, SEARCH_result* result)
+{
+	COLUMNS_block block;
+	NETWORK_element element;
+	float* set;
+	int i, slot, N, status = 0;
+
+	if( row >= file->rows ) return(-1);
+
+	COLUMNS_getBlock( file, row / COLUMNS_BLOCK, &block );
+
+	i = (int)( row % COLUMNS_BLOCK );
+
+	query->topology = ( block.topology[i] == COLUMNS_INVALID ) ? SEARCH_RESISTOR_1R : (SEARCH_topology)block.topology[i];
+	query->target = block.target[i];
+	query->R_std = (EIA_standard)block.R_std[i];
+	query->C_std = (EIA_standard)block.C_std[i];
+
+	result->topology = query->topology;
+	result->N_parts = block.N_parts[i];
+	result->value = block.value[i];
+	result->error = block.error[i];
+	result->optimal = 0;
+
+	for( slot = 0 ; slot < SEARCH_MAX_PARTS ; slot++ )
+	{
+		result->part[slot] = 0.0f;
+
+		if( slot >= result->N_parts ) continue;
+
+		element = COLUMNS_getElement( result->topology, slot, result->N_parts );
+		set = SYNTHESIS_getSet( element, ( element == NETWORK_RESISTOR ) ? query->R_std : query->C_std, &N );
+
+		if( set == NULL || block.part[slot][i] >= N ) status = -1;
+		else result->part[slot] = set[ block.part[slot][i] ];
+	}
+
+	return(status);
+}
+
+#endif /* PASSIVE_COLUMNS_H_ */
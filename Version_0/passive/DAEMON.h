@@ -0,0 +1,737 @@
+/*
+ *
+ * 	Query daemon with warm indexes.
+ *
+ * 	DAEMON_run() initializes the standard values and builds every pair table once, then
+ * 	serves selector and wire queries on a Unix domain socket until it receives a
+ * 	DAEMON_SHUTDOWN request. Messages use the framing of SHARD.h: a request message carries
+ * 	a batch of fixed-size request records and is answered by a message of as many response
+ * 	records, in the same order. Each client has its own receive buffer filled without
+ * 	blocking, so a client sending slowly does not hold up the others, and the requests of
+ * 	every client whose message is complete are run as one batch on a work-stealing
+ * 	scheduler.
+ *
+ * 	The latency of every request, from the arrival of its message to the sending of the
+ * 	answer, is kept in a histogram of DAEMON_STEP wide logarithmic buckets, from which a
+ * 	DAEMON_METRICS request reads the 50th and 99th percentiles.
+ *
+ */
+
+#ifndef PASSIVE_DAEMON_H_
+#define PASSIVE_DAEMON_H_
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 700
+#endif
+
+#include <errno.h>
+#include <math.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "SCHEDULER.h"
+#include "SHARD.h"
+#include "wire.h"
+
+#define DAEMON_MAX_CLIENTS		256
+#define DAEMON_MAX_BATCH		4096			//	Records per message.
+#define DAEMON_RECORD_SIZE		( 4 + SHARD_QUERY_SIZE )		//	Request: op, then a query or wire arguments.
+#define DAEMON_RESPONSE_SIZE	48
+#define DAEMON_BUFFER_SIZE		( DAEMON_MAX_BATCH * ( ( DAEMON_RECORD_SIZE > DAEMON_RESPONSE_SIZE ) ? DAEMON_RECORD_SIZE : DAEMON_RESPONSE_SIZE ) )
+#define DAEMON_MESSAGE_SIZE		( 12 + DAEMON_MAX_BATCH * DAEMON_RECORD_SIZE )		//	Header and largest request payload.
+#define DAEMON_BUCKETS			256
+#define DAEMON_FLOOR			1e-7			//	Lower bound of the first bucket, in seconds.
+#define DAEMON_STEP				1.1				//	Ratio of consecutive bucket bounds.
+
+//	Message types, following those of SHARD.h.
+
+#define DAEMON_REQUEST			16
+#define DAEMON_RESPONSE			17
+
+typedef enum
+{
+	DAEMON_SEARCH,							//	Any selector, as a SEARCH_query.
+	DAEMON_SKIN_DEPTH,						//	WIRE_getSkinDepth(conductor, a = f)
+	DAEMON_MAX_GAUGE,						//	WIRE_getMaxGauge(conductor, a = I_max, b = J_max, c = f)
+	DAEMON_MIN_GAUGE,						//	WIRE_getMinGauge(conductor, a = I_max, b = J_max, c = f)
+	DAEMON_WIRE_PARAMETERS,					//	WIRE_getParameters(conductor, a = radius, b = f)
+	DAEMON_METRICS,							//	Latency percentiles.
+	DAEMON_SHUTDOWN
+}DAEMON_op;
+
+typedef struct
+{
+	DAEMON_op op;
+	SEARCH_query query;
+	conductor_t conductor;
+	float a, b, c;
+}DAEMON_request;
+
+//	Search results are ( N_parts, part[0..3], value, error ), with the error measured in the
+//	precision and metric of the query; gauges, skin depths and wire parameters are returned in
+//	x[0..count); metrics are ( requests, p50, p99, mean, max ) in seconds.
+
+typedef struct
+{
+	int status;								//	0, or -1 if the request failed.
+	int count;
+	float x[4];
+	double value;
+	double error;
+	SEARCH_precision precision;
+	SEARCH_metric metric;
+}DAEMON_response;
+
+//	A request record holds the op and a query, or the op and the four wire arguments.
+
+typedef char DAEMON_checkRecord[ ( DAEMON_RECORD_SIZE >= 4 + SHARD_QUERY_SIZE && DAEMON_RECORD_SIZE >= 20 ) ? 1 : -1 ];
+
+//	Connection of a client: the part of its next message received so far, and where its
+//	records sit in the current batch.
+
+typedef struct
+{
+	unsigned char* buffer;
+	int filled;
+	double arrival;							//	Time the first byte of the message arrived.
+	int first;
+	int count;								//	Records in the batch, -1 if none.
+}DAEMON_client;
+
+typedef struct
+{
+	long count;
+	long bucket[DAEMON_BUCKETS];
+	double sum;
+	double max;
+}DAEMON_metrics;
+
+/*****			Function declarations			*****/
+
+void DAEMON_warm();
+void DAEMON_record(DAEMON_metrics* metrics, double latency);
+double DAEMON_getPercentile(DAEMON_metrics* metrics, double p);
+void DAEMON_execute(SCHEDULER_t* scheduler, DAEMON_request* request, DAEMON_response* response, int N, DAEMON_metrics* metrics);
+int DAEMON_run(const char* path, int N_threads);
+int DAEMON_connect(const char* path);
+int DAEMON_call(int fd, DAEMON_request* request, DAEMON_response* response, int N);
+
+/*****			Function definitions			*****/
+
+/*
+ * DAEMON_warm()
+ *
+ * Description:
+ *
+ * Initializes the standard values and builds the pair tables of every standard.
+ *
+ */
+
+void DAEMON_warm()
+{
+	EIA_standard std;
+	int i;
+
+	RC_init();
+
+	for( i = 0 ; i < SYNTHESIS_STANDARDS ; i++ )
+	{
+		std = EIA_getStandard(i);
+
+		if( !EIA_isStandard(std) ) continue;
+
+		SYNTHESIS_getTable( NETWORK_RESISTOR, std, SYNTHESIS_ADD );
+		SYNTHESIS_getTable( NETWORK_RESISTOR, std, SYNTHESIS_HARMONIC );
+		SYNTHESIS_getTable( NETWORK_CAPACITOR, std, SYNTHESIS_ADD );
+		SYNTHESIS_getTable( NETWORK_CAPACITOR, std, SYNTHESIS_HARMONIC );
+	}
+}
+
+/*	Adds the latency of one request to the metrics. */
+
+void DAEMON_record(DAEMON_metrics* metrics, double latency)
+{
+	int k = 0;
+
+	if( latency > DAEMON_FLOOR ) k = (int)( log( latency / DAEMON_FLOOR ) / log( DAEMON_STEP ) );
+	if( k >= DAEMON_BUCKETS ) k = DAEMON_BUCKETS - 1;
+
+	metrics->bucket[k]++;
+	metrics->count++;
+	metrics->sum += latency;
+
+	if( latency > metrics->max ) metrics->max = latency;
+}
+
+/*
+ * DAEMON_getPercentile(metrics, p)
+ *
+ * Description:
+ *
+ * Returns the latency below which a fraction p of the requests were answered, to within one
+ * bucket, or 0 if no request was recorded.
+ *
+ */
+
+double DAEMON_getPercentile(DAEMON_metrics* metrics, double p)
+{
+	long rank, seen = 0;
+	int k;
+
+	if( metrics->count == 0 ) return(0.0);
+
+	rank = (long)ceil( p * (double)metrics->count );
+
+	if( rank < 1 ) rank = 1;
+
+	for( k = 0 ; k < DAEMON_BUCKETS ; k++ )
+	{
+		seen += metrics->bucket[k];
+
+		if( seen >= rank ) break;
+	}
+
+	//	Geometric middle of the bucket.
+
+	return( DAEMON_FLOOR * pow( DAEMON_STEP, (double)k + 0.5 ) );
+}
+
+/*	Request encoding: op, then a SHARD query or ( conductor, a, b, c ). Response encoding:
+	status, count, precision, metric, x[0..3], value and error. */
+
+void DAEMON_putRequest(unsigned char* buffer, DAEMON_request* request)
+{
+	memset( buffer, 0, DAEMON_RECORD_SIZE );
+
+	SHARD_putInt( buffer, (uint32_t)request->op );
+
+	if( request->op == DAEMON_SEARCH )
+	{
+		SHARD_putQuery( buffer + 4, &request->query );
+		return;
+	}
+
+	SHARD_putInt( buffer + 4, (uint32_t)request->conductor );
+	SHARD_putFloat( buffer + 8, request->a );
+	SHARD_putFloat( buffer + 12, request->b );
+	SHARD_putFloat( buffer + 16, request->c );
+}
+
+void DAEMON_getRequest(unsigned char* buffer, DAEMON_request* request)
+{
+	request->op = (DAEMON_op)SHARD_getInt( buffer );
+
+	if( request->op == DAEMON_SEARCH )
+	{
+		SHARD_getQuery( buffer + 4, &request->query );
+		return;
+	}
+
+	request->conductor = (conductor_t)SHARD_getInt( buffer + 4 );
+	request->a = SHARD_getFloat( buffer + 8 );
+	request->b = SHARD_getFloat( buffer + 12 );
+	request->c = SHARD_getFloat( buffer + 16 );
+}
+
+void DAEMON_putResponse(unsigned char* buffer, DAEMON_response* response)
+{
+	int i;
+
+	SHARD_putInt( buffer, (uint32_t)response->status );
+	SHARD_putInt( buffer + 4, (uint32_t)response->count );
+	SHARD_putInt( buffer + 8, (uint32_t)response->precision );
+	SHARD_putInt( buffer + 12, (uint32_t)response->metric );
+
+	for( i = 0 ; i < 4 ; i++ ) SHARD_putFloat( buffer + 16 + 4*i, response->x[i] );
+
+	SHARD_putDouble( buffer + 32, response->value );
+	SHARD_putDouble( buffer + 40, response->error );
+}
+
+void DAEMON_getResponse(unsigned char* buffer, DAEMON_response* response)
+{
+	int i;
+
+	response->status = (int)SHARD_getInt( buffer );
+	response->count = (int)SHARD_getInt( buffer + 4 );
+	response->precision = (SEARCH_precision)SHARD_getInt( buffer + 8 );
+	response->metric = (SEARCH_metric)SHARD_getInt( buffer + 12 );
+
+	for( i = 0 ; i < 4 ; i++ ) response->x[i] = SHARD_getFloat( buffer + 16 + 4*i );
+
+	response->value = SHARD_getDouble( buffer + 32 );
+	response->error = SHARD_getDouble( buffer + 40 );
+}
+
+/*	Returns 1 if a wire request names a known conductor and its first N_args arguments are
+	finite and positive. */
+
+int DAEMON_isWire(DAEMON_request* request, int N_args)
+{
+	float x[3];
+	int i;
+
+	if( request->conductor != COPPER && request->conductor != ALUMINIUM ) return(0);
+
+	x[0] = request->a;
+	x[1] = request->b;
+	x[2] = request->c;
+
+	for( i = 0 ; i < N_args ; i++ )
+	{
+		if( !isfinite( x[i] ) || x[i] <= 0.0f ) return(0);
+	}
+
+	return(1);
+}
+
+/*
+ * DAEMON_execute(scheduler, request, response, N, metrics)
+ *
+ * Description:
+ *
+ * Answers a batch of requests. The searches are run on the scheduler when there are several
+ * of them, and in place otherwise. A query out of range, or a wire request with an unknown
+ * conductor or an argument that is not finite and positive, gets status -1.
+ *
+ */
+
+void DAEMON_execute(SCHEDULER_t* scheduler, DAEMON_request* request, DAEMON_response* response, int N, DAEMON_metrics* metrics)
+{
+	SEARCH_query* query;
+	SEARCH_result* result;
+	int* index;
+	float delta, A_c, r;
+	int N_search = 0;
+	int i, j;
+
+	query = (SEARCH_query*)malloc( sizeof(SEARCH_query) * ( N + 1 ) );
+	result = (SEARCH_result*)malloc( sizeof(SEARCH_result) * ( N + 1 ) );
+	index = (int*)malloc( sizeof(int) * ( N + 1 ) );
+
+	for( i = 0 ; i < N ; i++ )
+	{
+		response[i].status = 0;
+		response[i].count = 0;
+		response[i].value = 0.0;
+		response[i].error = 0.0;
+		response[i].precision = SEARCH_FLOAT;
+		response[i].metric = SEARCH_ABSOLUTE;
+
+		for( j = 0 ; j < 4 ; j++ ) response[i].x[j] = 0.0f;
+
+		switch( request[i].op )
+		{
+			case(DAEMON_SEARCH):
+			{
+				if( query == NULL || result == NULL || index == NULL || !SHARD_isValid( &request[i].query ) )
+				{
+					response[i].status = -1;
+					break;
+				}
+
+				response[i].precision = request[i].query.precision;
+				response[i].metric = request[i].query.metric;
+				query[N_search] = request[i].query;
+				index[N_search++] = i;
+			}; break;
+
+			case(DAEMON_SKIN_DEPTH):
+			{
+				if( !DAEMON_isWire( &request[i], 1 ) )
+				{
+					response[i].status = -1;
+					break;
+				}
+
+				response[i].count = 1;
+				response[i].x[0] = WIRE_getSkinDepth( request[i].conductor, request[i].a );
+			}; break;
+
+			case(DAEMON_MAX_GAUGE):
+			{
+				if( !DAEMON_isWire( &request[i], 3 ) )
+				{
+					response[i].status = -1;
+					break;
+				}
+
+				response[i].count = 1;
+				response[i].x[0] = (float)WIRE_getMaxGauge( request[i].conductor, request[i].a, request[i].b, request[i].c );
+			}; break;
+
+			case(DAEMON_MIN_GAUGE):
+			{
+				if( !DAEMON_isWire( &request[i], 3 ) )
+				{
+					response[i].status = -1;
+					break;
+				}
+
+				response[i].count = 1;
+				response[i].x[0] = (float)WIRE_getMinGauge( request[i].conductor, request[i].a, request[i].b, request[i].c );
+			}; break;
+
+			case(DAEMON_WIRE_PARAMETERS):
+			{
+				if( !DAEMON_isWire( &request[i], 2 ) )
+				{
+					response[i].status = -1;
+					break;
+				}
+
+				WIRE_getParameters( request[i].conductor, request[i].a, request[i].b, &delta, &A_c, &r );
+
+				response[i].count = 3;
+				response[i].x[0] = delta;
+				response[i].x[1] = A_c;
+				response[i].x[2] = r;
+			}; break;
+
+			case(DAEMON_METRICS):
+			{
+				response[i].count = (int)metrics->count;
+				response[i].x[0] = (float)DAEMON_getPercentile( metrics, 0.50 );
+				response[i].x[1] = (float)DAEMON_getPercentile( metrics, 0.99 );
+				response[i].x[2] = ( metrics->count > 0 ) ? (float)( metrics->sum / (double)metrics->count ) : 0.0f;
+				response[i].x[3] = (float)metrics->max;
+			}; break;
+
+			case(DAEMON_SHUTDOWN): break;
+
+			default: response[i].status = -1; break;
+		}
+	}
+
+	if( N_search < 2 || scheduler == NULL || SCHEDULER_run( scheduler, query, result, N_search ) < 0 )
+	{
+		for( i = 0 ; i < N_search ; i++ ) SEARCH_run( &query[i], &result[i] );
+	}
+
+	for( i = 0 ; i < N_search ; i++ )
+	{
+		DAEMON_response* answer = &response[ index[i] ];
+
+		answer->count = result[i].N_parts;
+
+		for( j = 0 ; j < result[i].N_parts ; j++ ) answer->x[j] = result[i].part[j];
+
+		answer->value = result[i].value;
+		answer->error = result[i].error;
+	}
+
+	free(query);
+	free(result);
+	free(index);
+}
+
+/*	Grows the request and response arrays to hold N records. Returns 0, or -1 on failure. */
+
+int DAEMON_reserve(DAEMON_request** request, DAEMON_response** response, int* capacity, int N)
+{
+	DAEMON_request* more_requests;
+	DAEMON_response* more_responses;
+	int size;
+
+	if( N <= *capacity ) return(0);
+
+	size = ( 2 * *capacity > N ) ? 2 * *capacity : N;
+
+	more_requests = (DAEMON_request*)realloc( *request, sizeof(DAEMON_request) * size );
+
+	if( more_requests == NULL ) return(-1);
+
+	*request = more_requests;
+
+	more_responses = (DAEMON_response*)realloc( *response, sizeof(DAEMON_response) * size );
+
+	if( more_responses == NULL ) return(-1);
+
+	*response = more_responses;
+	*capacity = size;
+
+	return(0);
+}
+
+/*
+ * DAEMON_receive(client, fd)
+ *
+ * Description:
+ *
+ * Reads what a client socket has available of its next message without blocking. Returns
+ * the number of request records once the message is complete, -2 while it is not, and -1
+ * on error, end of stream or a malformed message.
+ *
+ */
+
+int DAEMON_receive(DAEMON_client* client, int fd)
+{
+	uint32_t length = 0;
+	ssize_t n;
+	int size = 12;
+
+	if( client->filled >= 12 )
+	{
+		length = SHARD_getInt( client->buffer + 8 );
+		size = 12 + (int)length;
+	}
+
+	n = recv( fd, client->buffer + client->filled, size - client->filled, MSG_DONTWAIT );
+
+	if( n < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ) ) return(-2);
+	if( n <= 0 ) return(-1);
+
+	if( client->filled == 0 ) client->arrival = SEARCH_now();
+
+	client->filled += (int)n;
+
+	if( client->filled == 12 )
+	{
+		//	Header complete: check it before waiting for the payload.
+
+		length = SHARD_getInt( client->buffer + 8 );
+
+		if( SHARD_getInt( client->buffer ) != SHARD_MAGIC || SHARD_getInt( client->buffer + 4 ) != DAEMON_REQUEST ) return(-1);
+		if( length > DAEMON_MAX_BATCH * DAEMON_RECORD_SIZE || length % DAEMON_RECORD_SIZE != 0 ) return(-1);
+	}
+
+	if( client->filled < 12 || client->filled < 12 + (int)length ) return(-2);
+
+	client->filled = 0;
+
+	return( (int)length / DAEMON_RECORD_SIZE );
+}
+
+/*
+ * DAEMON_run(path, N_threads)
+ *
+ * Description:
+ *
+ * Warms the tables and serves requests on a Unix domain socket bound to path, with
+ * N_threads workers (one per processor if 0), until a DAEMON_SHUTDOWN request. The batch
+ * arrays grow to the largest number of records received in one poll round. Returns 0
+ * after a shutdown request and -1 if the socket could not be set up.
+ *
+ */
+
+int DAEMON_run(const char* path, int N_threads)
+{
+	static unsigned char buffer[DAEMON_BUFFER_SIZE];
+	static DAEMON_metrics metrics;
+	static DAEMON_client client[ DAEMON_MAX_CLIENTS + 1 ];
+	struct pollfd poller[ DAEMON_MAX_CLIENTS + 1 ];
+	struct sockaddr_un address;
+	SCHEDULER_t* scheduler;
+	DAEMON_request* request = NULL;
+	DAEMON_response* response = NULL;
+	DAEMON_client* c;
+	int listener, N_clients, N, capacity = 0, shutdown, i, k;
+	double now;
+
+	DAEMON_warm();
+
+	listener = socket( AF_UNIX, SOCK_STREAM, 0 );
+
+	if( listener < 0 ) return(-1);
+
+	memset( &address, 0, sizeof(address) );
+	address.sun_family = AF_UNIX;
+	strncpy( address.sun_path, path, sizeof(address.sun_path) - 1 );
+	unlink(path);
+
+	if( bind( listener, (struct sockaddr*)&address, sizeof(address) ) < 0 || listen( listener, 64 ) < 0 )
+	{
+		close(listener);
+		return(-1);
+	}
+
+	scheduler = ( N_threads == 1 ) ? NULL : SCHEDULER_create(N_threads);
+
+	memset( &metrics, 0, sizeof(metrics) );
+
+	poller[0].fd = listener;
+	poller[0].events = POLLIN;
+	N_clients = 0;
+	shutdown = 0;
+
+	while( !shutdown )
+	{
+		if( poll( poller, N_clients + 1, -1 ) < 0 ) continue;
+
+		//	Read what every ready client has sent, and batch the messages that are complete.
+
+		N = 0;
+
+		for( i = 1 ; i <= N_clients ; i++ )
+		{
+			c = &client[i];
+			c->count = -1;
+
+			if( poller[i].revents == 0 ) continue;
+
+			k = DAEMON_receive( c, poller[i].fd );
+
+			if( k == -2 ) continue;
+
+			if( k < 0 || DAEMON_reserve( &request, &response, &capacity, N + k ) < 0 )
+			{
+				close( poller[i].fd );
+				poller[i].fd = -1;
+				continue;
+			}
+
+			c->first = N;
+			c->count = k;
+
+			for( k = 0 ; k < c->count ; k++ )
+			{
+				DAEMON_getRequest( c->buffer + 12 + k * DAEMON_RECORD_SIZE, &request[N + k] );
+
+				if( request[N + k].op == DAEMON_SHUTDOWN ) shutdown = 1;
+			}
+
+			N += c->count;
+		}
+
+		DAEMON_execute( scheduler, request, response, N, &metrics );
+
+		//	Answer in the order of the batch.
+
+		for( i = 1 ; i <= N_clients ; i++ )
+		{
+			c = &client[i];
+
+			if( c->count < 0 || poller[i].fd < 0 ) continue;
+
+			for( k = 0 ; k < c->count ; k++ ) DAEMON_putResponse( buffer + DAEMON_RESPONSE_SIZE * k, &response[ c->first + k ] );
+
+			if( SHARD_send( poller[i].fd, (SHARD_message)DAEMON_RESPONSE, buffer, DAEMON_RESPONSE_SIZE * c->count ) < 0 )
+			{
+				close( poller[i].fd );
+				poller[i].fd = -1;
+				continue;
+			}
+
+			now = SEARCH_now();
+
+			for( k = 0 ; k < c->count ; k++ ) DAEMON_record( &metrics, now - c->arrival );
+		}
+
+		//	Drop closed clients and accept new ones.
+
+		for( i = 1, k = 1 ; i <= N_clients ; i++ )
+		{
+			if( poller[i].fd < 0 )
+			{
+				free( client[i].buffer );
+				continue;
+			}
+
+			client[k] = client[i];
+			poller[k++] = poller[i];
+		}
+
+		N_clients = k - 1;
+
+		if( ( poller[0].revents & POLLIN ) && N_clients < DAEMON_MAX_CLIENTS )
+		{
+			k = accept( listener, NULL, NULL );
+			c = &client[ N_clients + 1 ];
+			c->buffer = ( k >= 0 ) ? (unsigned char*)malloc( DAEMON_MESSAGE_SIZE ) : NULL;
+			c->filled = 0;
+
+			if( c->buffer != NULL )
+			{
+				N_clients++;
+				poller[N_clients].fd = k;
+				poller[N_clients].events = POLLIN;
+				poller[N_clients].revents = 0;
+			}
+			else if( k >= 0 ) close(k);
+		}
+	}
+
+	for( i = 1 ; i <= N_clients ; i++ )
+	{
+		close( poller[i].fd );
+		free( client[i].buffer );
+	}
+
+	close(listener);
+	unlink(path);
+
+	if( scheduler != NULL ) SCHEDULER_destroy(scheduler);
+
+	free(request);
+	free(response);
+
+	return(0);
+}
+
+/*
+ * DAEMON_connect(path)
+ *
+ * Description:
+ *
+ * Connects to a daemon and returns the socket, or -1 on failure.
+ *
+ */
+
+int DAEMON_connect(const char* path)
+{
+	struct sockaddr_un address;
+	int fd;
+
+	fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+
+	if( fd < 0 ) return(-1);
+
+	memset( &address, 0, sizeof(address) );
+	address.sun_family = AF_UNIX;
+	strncpy( address.sun_path, path, sizeof(address.sun_path) - 1 );
+
+	if( connect( fd, (struct sockaddr*)&address, sizeof(address) ) < 0 )
+	{
+		close(fd);
+		return(-1);
+	}
+
+	return(fd);
+}
+
+/*
+ * DAEMON_call(fd, request, response, N)
+ *
+ * Description:
+ *
+ * Sends a batch of at most DAEMON_MAX_BATCH requests to a daemon and waits for their
+ * responses. Returns 0, or -1 on error.
+ *
+ */
+
+int DAEMON_call(int fd, DAEMON_request* request, DAEMON_response* response, int N)
+{
+	static unsigned char buffer[DAEMON_BUFFER_SIZE];
+	SHARD_message type;
+	int length, i;
+
+	if( N < 1 || N > DAEMON_MAX_BATCH ) return(-1);
+
+	for( i = 0 ; i < N ; i++ ) DAEMON_putRequest( buffer + i * DAEMON_RECORD_SIZE, &request[i] );
+
+	if( SHARD_send( fd, (SHARD_message)DAEMON_REQUEST, buffer, N * DAEMON_RECORD_SIZE ) < 0 ) return(-1);
+
+	length = SHARD_receive( fd, &type, buffer, sizeof(buffer) );
+
+	if( length != DAEMON_RESPONSE_SIZE * N || type != DAEMON_RESPONSE ) return(-1);
+
+	for( i = 0 ; i < N ; i++ ) DAEMON_getResponse( buffer + DAEMON_RESPONSE_SIZE * i, &response[i] );
+
+	return(0);
+}
+
+#endif /* PASSIVE_DAEMON_H_ */
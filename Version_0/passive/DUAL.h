@@ -0,0 +1,244 @@
+/*
+ *
+ * 	Forward mode automatic differentiation with dual numbers.
+ *
+ * 	A dual number carries a value together with its partial derivatives with respect
+ * 	to up to DUAL_MAX_VARS input variables, so a single evaluation of a network returns
+ * 	its value and the sensitivity to every part.
+ *
+ */
+
+#ifndef PASSIVE_DUAL_H_
+#define PASSIVE_DUAL_H_
+
+#include <math.h>
+
+#define DUAL_MAX_VARS		8
+
+typedef struct
+{
+	float v;						//	Value.
+	float d[DUAL_MAX_VARS];			//	Partial derivatives.
+	int N;							//	Number of input variables.
+}DUAL_t;
+
+/*****			Function declarations			*****/
+
+DUAL_t DUAL_constant(float v, int N);
+DUAL_t DUAL_variable(float v, int index, int N);
+void DUAL_seed(float* x, int N, DUAL_t* X);
+
+DUAL_t DUAL_add(DUAL_t a, DUAL_t b);
+DUAL_t DUAL_sub(DUAL_t a, DUAL_t b);
+DUAL_t DUAL_mul(DUAL_t a, DUAL_t b);
+DUAL_t DUAL_div(DUAL_t a, DUAL_t b);
+DUAL_t DUAL_inv(DUAL_t a);
+DUAL_t DUAL_scale(DUAL_t a, float k);
+
+float DUAL_sensitivity(DUAL_t y, float* x, int index);
+float DUAL_SD(DUAL_t y, float* x, float T);
+
+/*****			Function definitions			*****/
+
+/*
+ * DUAL_constant(v, N)
+ *
+ * Returns a constant of value v in a space of N input variables, at most DUAL_MAX_VARS.
+ *
+ */
+
+DUAL_t DUAL_constant(float v, int N)
+{
+	DUAL_t result;
+	int i;
+
+	if( N < 0 ) N = 0;
+	if( N > DUAL_MAX_VARS ) N = DUAL_MAX_VARS;
+
+	result.v = v;
+	result.N = N;
+
+	for( i = 0 ; i < N ; i++ ) result.d[i] = 0.0f;
+
+	return(result);
+}
+
+/*
+ * DUAL_variable(v, index, N)
+ *
+ * Returns input variable number index of value v in a space of N input variables. Beyond
+ * DUAL_MAX_VARS variables there is no room for the derivative, and a constant is returned.
+ *
+ */
+
+DUAL_t DUAL_variable(float v, int index, int N)
+{
+	DUAL_t result;
+
+	result = DUAL_constant(v, N);
+
+	if( index >= 0 && index < result.N ) result.d[index] = 1.0f;
+
+	return(result);
+}
+
+/*
+ * DUAL_seed(x, N, X)
+ *
+ * Turns the N values of x into the N input variables X. Only the first DUAL_MAX_VARS are
+ * differentiated, the others being constants.
+ *
+ */
+
+void DUAL_seed(float* x, int N, DUAL_t* X)
+{
+	int i;
+
+	for( i = 0 ; i < N ; i++ ) X[i] = ( i < DUAL_MAX_VARS ) ? DUAL_variable(x[i], i, N) : DUAL_constant(x[i], N);
+}
+
+/*	Widens the operand with fewer variables to the other, its missing derivatives being 0. */
+
+void DUAL_match(DUAL_t* a, DUAL_t* b)
+{
+	DUAL_t* narrow = ( a->N < b->N ) ? a : b;
+	int N = ( a->N < b->N ) ? b->N : a->N;
+	int i;
+
+	if( N > DUAL_MAX_VARS ) N = DUAL_MAX_VARS;
+
+	for( i = ( narrow->N > 0 ) ? narrow->N : 0 ; i < N ; i++ ) narrow->d[i] = 0.0f;
+
+	a->N = N;
+	b->N = N;
+}
+
+/*	Arithmetic on dual numbers. The result has the variables of the operand with the most. */
+
+DUAL_t DUAL_add(DUAL_t a, DUAL_t b)
+{
+	int i;
+
+	DUAL_match( &a, &b );
+
+	a.v += b.v;
+
+	for( i = 0 ; i < a.N ; i++ ) a.d[i] += b.d[i];
+
+	return(a);
+}
+
+DUAL_t DUAL_sub(DUAL_t a, DUAL_t b)
+{
+	int i;
+
+	DUAL_match( &a, &b );
+
+	a.v -= b.v;
+
+	for( i = 0 ; i < a.N ; i++ ) a.d[i] -= b.d[i];
+
+	return(a);
+}
+
+DUAL_t DUAL_mul(DUAL_t a, DUAL_t b)
+{
+	int i;
+
+	DUAL_match( &a, &b );
+
+	for( i = 0 ; i < a.N ; i++ ) a.d[i] = a.d[i] * b.v + a.v * b.d[i];
+
+	a.v *= b.v;
+
+	return(a);
+}
+
+DUAL_t DUAL_div(DUAL_t a, DUAL_t b)
+{
+	int i;
+	float q;
+
+	DUAL_match( &a, &b );
+
+	q = a.v / b.v;
+
+	for( i = 0 ; i < a.N ; i++ ) a.d[i] = ( a.d[i] - q * b.d[i] ) / b.v;
+
+	a.v = q;
+
+	return(a);
+}
+
+DUAL_t DUAL_inv(DUAL_t a)
+{
+	int i;
+	float q;
+
+	q = 1.0f / a.v;
+
+	for( i = 0 ; i < a.N ; i++ ) a.d[i] = -q * q * a.d[i];
+
+	a.v = q;
+
+	return(a);
+}
+
+DUAL_t DUAL_scale(DUAL_t a, float k)
+{
+	int i;
+
+	a.v *= k;
+
+	for( i = 0 ; i < a.N ; i++ ) a.d[i] *= k;
+
+	return(a);
+}
+
+/*
+ * DUAL_sensitivity(y, x, index)
+ *
+ * Returns the normalized sensitivity ( x / y ) * dy/dx of y to input variable number
+ * index, i.e. the relative change of y per relative change of x.
+ *
+ * @parameter	y				:	Network value with its partial derivatives.
+ * @parameter	x				:	Values of the input variables.
+ * @parameter	index			:	Input variable.
+ *
+ */
+
+float DUAL_sensitivity(DUAL_t y, float* x, int index)
+{
+	return( y.d[index] * x[index] / y.v );
+}
+
+/*
+ * DUAL_SD(y, x, T)
+ *
+ * Returns the standard deviation of a network value as a percentage of its nominal value
+ * when every input variable takes its nominal value plus or minus its tolerance. The
+ * result is exact for networks linear in their parts (series resistors, parallel
+ * capacitors) and a first order estimate otherwise.
+ *
+ * @parameter	y				:	Network value with its partial derivatives.
+ * @parameter	x				:	Values of the input variables.
+ * @parameter	T				:	Tolerance of the parts (in percentage).
+ *
+ */
+
+float DUAL_SD(DUAL_t y, float* x, float T)
+{
+	float result = 0.0f;
+	float s;
+	int i;
+
+	for( i = 0 ; i < y.N ; i++ )
+	{
+		s = DUAL_sensitivity(y, x, i);
+		result += s * s;
+	}
+
+	return( T * sqrt(result) );
+}
+
+#endif /* PASSIVE_DUAL_H_ */
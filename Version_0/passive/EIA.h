@@ -4,20 +4,63 @@
  *
  * 	Holds standard EIA coefficients.
  *
+ * 	A standard value is also coded exactly in 16 bits as its decade and its mantissa in
+ * 	hundredths (100 to 999):
+ *
+ * 		code = ( decade + EIA_DECADE_BIAS ) << EIA_MANTISSA_BITS | mantissa
+ *
+ * 	for decades from -32 to 31. Codes of equal nominal values are equal, codes sort in the
+ * 	order of their values, and EIA_decode() gives the same float as the sets of RESISTOR.h and
+ * 	CAPACITOR.h, which are built from it.
+ *
+ * 	Besides the series E3 to E192, up to EIA_MAX_CUSTOM custom series, such as the preferred
+ * 	values of a vendor, can be added with EIA_addSeries(). They are numbered from
+ * 	EIA_STANDARD_CUSTOM and are used wherever an EIA_standard is taken.
+ *
+ * 	An EIA_range holds the standard values of every series over a range of decades. The values
+ * 	of a series are only decoded when it is first used, so that the memory and the time spent
+ * 	follow the series and decades a program actually searches. Link with -pthread.
+ *
  */
 
 #ifndef PASSIVE_EIA_H_
 #define PASSIVE_EIA_H_
 
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#define EIA_MAX_CUSTOM			8				//	Custom series.
+#define EIA_MAX_COUNT			192				//	Values per decade of a series.
+#define EIA_SERIES				( 7 + EIA_MAX_CUSTOM )
+#define EIA_DECADE_BIAS			32
+#define EIA_MANTISSA_BITS		10
+#define EIA_NONE				0xFFFF			//	Code of no value.
+
+#define EIA_DECADE(code)		( (int)( (code) >> EIA_MANTISSA_BITS ) - EIA_DECADE_BIAS )
+#define EIA_MANTISSA(code)		( (int)( (code) & ( ( 1 << EIA_MANTISSA_BITS ) - 1 ) ) )
+
+typedef unsigned short EIA_code;
+
 typedef enum{
 	EIA_STANDARD_E3 = 3,
 	EIA_STANDARD_E6 = 6,
 	EIA_STANDARD_E12 = 12,
 	EIA_STANDARD_E24 = 24,
 	EIA_STANDARD_E48 = 48,
-	EIA_STANDARD_E96 = 96
+	EIA_STANDARD_E96 = 96,
+	EIA_STANDARD_E192 = 192,
+	EIA_STANDARD_CUSTOM = 200					//	First custom series.
 }EIA_standard;
 
+//	Standard values of every series from decade low to decade high, each set built on first use.
+
+typedef struct
+{
+	int low, high;
+	float* set[EIA_SERIES];
+}EIA_range;
+
 float EIA_STANDARD_E3_SET[3] = { 1.00f, 2.20f, 4.70f };
 
 float EIA_STANDARD_E6_SET[6] = { 1.00f, 1.50f, 2.20f, 3.30f, 4.70f, 6.80f };
@@ -53,4 +96,336 @@ float EIA_STANDARD_E96_SET[96] =
 	7.50f, 7.68f, 7.87f, 8.06f, 8.25f, 8.45f, 8.66f, 8.87f, 9.09f, 9.31f, 9.53f, 9.76f
 };
 
+float EIA_STANDARD_E192_SET[192] =
+{
+	1.00f, 1.01f, 1.02f, 1.04f, 1.05f, 1.06f, 1.07f, 1.09f, 1.10f, 1.11f, 1.13f, 1.14f,
+	1.15f, 1.17f, 1.18f, 1.20f, 1.21f, 1.23f, 1.24f, 1.26f, 1.27f, 1.29f, 1.30f, 1.32f,
+	1.33f, 1.35f, 1.37f, 1.38f, 1.40f, 1.42f, 1.43f, 1.45f, 1.47f, 1.49f, 1.50f, 1.52f,
+	1.54f, 1.56f, 1.58f, 1.60f, 1.62f, 1.64f, 1.65f, 1.67f, 1.69f, 1.72f, 1.74f, 1.76f,
+	1.78f, 1.80f, 1.82f, 1.84f, 1.87f, 1.89f, 1.91f, 1.93f, 1.96f, 1.98f, 2.00f, 2.03f,
+	2.05f, 2.08f, 2.10f, 2.13f, 2.15f, 2.18f, 2.21f, 2.23f, 2.26f, 2.29f, 2.32f, 2.34f,
+	2.37f, 2.40f, 2.43f, 2.46f, 2.49f, 2.52f, 2.55f, 2.58f, 2.61f, 2.64f, 2.67f, 2.71f,
+	2.74f, 2.77f, 2.80f, 2.84f, 2.87f, 2.91f, 2.94f, 2.98f, 3.01f, 3.05f, 3.09f, 3.12f,
+	3.16f, 3.20f, 3.24f, 3.28f, 3.32f, 3.36f, 3.40f, 3.44f, 3.48f, 3.52f, 3.57f, 3.61f,
+	3.65f, 3.70f, 3.74f, 3.79f, 3.83f, 3.88f, 3.92f, 3.97f, 4.02f, 4.07f, 4.12f, 4.17f,
+	4.22f, 4.27f, 4.32f, 4.37f, 4.42f, 4.48f, 4.53f, 4.59f, 4.64f, 4.70f, 4.75f, 4.81f,
+	4.87f, 4.93f, 4.99f, 5.05f, 5.11f, 5.17f, 5.23f, 5.30f, 5.36f, 5.42f, 5.49f, 5.56f,
+	5.62f, 5.69f, 5.76f, 5.83f, 5.90f, 5.97f, 6.04f, 6.12f, 6.19f, 6.26f, 6.34f, 6.42f,
+	6.49f, 6.57f, 6.65f, 6.73f, 6.81f, 6.90f, 6.98f, 7.06f, 7.15f, 7.23f, 7.32f, 7.41f,
+	7.50f, 7.59f, 7.68f, 7.77f, 7.87f, 7.96f, 8.06f, 8.16f, 8.25f, 8.35f, 8.45f, 8.56f,
+	8.66f, 8.76f, 8.87f, 8.98f, 9.09f, 9.20f, 9.31f, 9.42f, 9.53f, 9.65f, 9.76f, 9.88f
+};
+
+//	Mantissas of the custom series, rounded to hundredths, and their number.
+
+float EIA_custom[EIA_MAX_CUSTOM][EIA_MAX_COUNT];
+int EIA_customCount[EIA_MAX_CUSTOM];
+int EIA_N_custom = 0;
+
+pthread_mutex_t EIA_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*****			Function declarations			*****/
+
+float* EIA_getSeries(EIA_standard std);
+int EIA_getCount(EIA_standard std);
+int EIA_isStandard(EIA_standard std);
+int EIA_addSeries(const float* mantissa, int N);
+EIA_code EIA_getCode(EIA_standard std, int index, int decade);
+EIA_code EIA_encode(float x);
+float EIA_decode(EIA_code code);
+int EIA_seriesIndex(EIA_standard std);
+EIA_standard EIA_getStandard(int k);
+int EIA_setRange(EIA_range* range, int low, int high);
+int EIA_getSize(EIA_range* range, EIA_standard std);
+float* EIA_getSet(EIA_range* range, EIA_standard std);
+
+/*****			Function definitions			*****/
+
+/*	Returns the mantissas of a series, from 1 to 10, or NULL if it is not known. A custom series
+	is only known once EIA_addSeries() has published it. */
+
+float* EIA_getSeries(EIA_standard std)
+{
+	switch(std)
+	{
+		case(EIA_STANDARD_E3):	return(EIA_STANDARD_E3_SET);
+		case(EIA_STANDARD_E6):	return(EIA_STANDARD_E6_SET);
+		case(EIA_STANDARD_E12):	return(EIA_STANDARD_E12_SET);
+		case(EIA_STANDARD_E24):	return(EIA_STANDARD_E24_SET);
+		case(EIA_STANDARD_E48):	return(EIA_STANDARD_E48_SET);
+		case(EIA_STANDARD_E96):	return(EIA_STANDARD_E96_SET);
+		case(EIA_STANDARD_E192):	return(EIA_STANDARD_E192_SET);
+		default: break;
+	}
+
+	if( std >= EIA_STANDARD_CUSTOM && (int)std < EIA_STANDARD_CUSTOM + __atomic_load_n( &EIA_N_custom, __ATOMIC_ACQUIRE ) ) return( EIA_custom[ std - EIA_STANDARD_CUSTOM ] );
+
+	return(NULL);
+}
+
+/*	Returns the number of values per decade of a series, or 0 if it is not known. The number
+	of custom series is read atomically, as EIA_addSeries() publishes it. */
+
+int EIA_getCount(EIA_standard std)
+{
+	int N_custom;
+
+	if( std >= EIA_STANDARD_CUSTOM )
+	{
+		N_custom = __atomic_load_n( &EIA_N_custom, __ATOMIC_ACQUIRE );
+
+		return( ( (int)std < EIA_STANDARD_CUSTOM + N_custom ) ? EIA_customCount[ std - EIA_STANDARD_CUSTOM ] : 0 );
+	}
+
+	switch(std)
+	{
+		case(EIA_STANDARD_E3):
+		case(EIA_STANDARD_E6):
+		case(EIA_STANDARD_E12):
+		case(EIA_STANDARD_E24):
+		case(EIA_STANDARD_E48):
+		case(EIA_STANDARD_E96):
+		case(EIA_STANDARD_E192):	return( (int)std );
+		default: break;
+	}
+
+	return(0);
+}
+
+/*	Returns 1 if std is a standard series or a custom series already added. */
+
+int EIA_isStandard(EIA_standard std)
+{
+	return( EIA_getCount(std) > 0 );
+}
+
+/*
+ * EIA_addSeries(mantissa, N)
+ *
+ * Description:
+ *
+ * Adds a custom series of N values per decade, given by their mantissas in increasing order
+ * from 1 to 10 excluded, such as 1.0, 1.1, 1.3 and 4.7. Mantissas are rounded to hundredths,
+ * as those of the standard series are. Returns the EIA_standard of the series, or -1 if
+ * there are already EIA_MAX_CUSTOM of them, N is not from 1 to EIA_MAX_COUNT or the rounded
+ * mantissas are not increasing from 1.00 to 9.99.
+ *
+ */
+
+int EIA_addSeries(const float* mantissa, int N)
+{
+	float* series;
+	int k, previous = 0, hundredths, std = -1;
+
+	if( N < 1 || N > EIA_MAX_COUNT ) return(-1);
+
+	pthread_mutex_lock(&EIA_lock);
+
+	if( EIA_N_custom < EIA_MAX_CUSTOM )
+	{
+		series = EIA_custom[EIA_N_custom];
+
+		for( k = 0 ; k < N ; k++ )
+		{
+			hundredths = (int)lroundf( 100.0f * mantissa[k] );
+
+			if( !( mantissa[k] > 0.0f ) || hundredths <= previous || hundredths < 100 || hundredths > 999 ) break;
+
+			series[k] = (float)( hundredths / 100.0 );
+			previous = hundredths;
+		}
+
+		if( k == N )
+		{
+			EIA_customCount[EIA_N_custom] = N;
+			std = EIA_STANDARD_CUSTOM + EIA_N_custom;
+
+			__atomic_store_n( &EIA_N_custom, EIA_N_custom + 1, __ATOMIC_RELEASE );
+		}
+	}
+
+	pthread_mutex_unlock(&EIA_lock);
+
+	return(std);
+}
+
+/*	Returns the code of value number index of a series in a decade. */
+
+EIA_code EIA_getCode(EIA_standard std, int index, int decade)
+{
+	int mantissa = (int)lroundf( 100.0f * EIA_getSeries(std)[index] );
+
+	return( (EIA_code)( ( ( decade + EIA_DECADE_BIAS ) << EIA_MANTISSA_BITS ) | mantissa ) );
+}
+
+/*
+ * EIA_encode(x)
+ *
+ * Description:
+ *
+ * Returns the code of the three digit value closest to x, which is the code of x if x is a
+ * standard value, or EIA_NONE if x is not positive or out of the range of the decades.
+ *
+ */
+
+EIA_code EIA_encode(float x)
+{
+	double scaled;
+	int decade, mantissa;
+
+	if( !( x > 0.0f ) || !isfinite(x) ) return(EIA_NONE);
+
+	decade = (int)floor( log10( (double)x ) );
+	scaled = (double)x / pow( 10.0, (double)decade );
+
+	//	log10 may be off by one next to a power of ten.
+
+	if( scaled < 1.0 ) { decade--; scaled *= 10.0; }
+	if( scaled >= 10.0 ) { decade++; scaled /= 10.0; }
+
+	mantissa = (int)lround( 100.0 * scaled );
+
+	if( mantissa >= 1000 ) { decade++; mantissa = 100; }
+
+	if( decade < -EIA_DECADE_BIAS || decade >= EIA_DECADE_BIAS ) return(EIA_NONE);
+
+	return( (EIA_code)( ( ( decade + EIA_DECADE_BIAS ) << EIA_MANTISSA_BITS ) | mantissa ) );
+}
+
+/*
+ * EIA_decode(code)
+ *
+ * Description:
+ *
+ * Returns the value of a code, rounded as the standard sets are, or NaN for EIA_NONE.
+ *
+ */
+
+float EIA_decode(EIA_code code)
+{
+	float mantissa;
+
+	if( code == EIA_NONE ) return(NAN);
+
+	mantissa = (float)( EIA_MANTISSA(code) / 100.0 );
+
+	return( (float)( (double)mantissa * pow( 10.0, (double)EIA_DECADE(code) ) ) );
+}
+
+/*	Position of a series in the sets of a range, or -1 if it is not a series. */
+
+int EIA_seriesIndex(EIA_standard std)
+{
+	switch(std)
+	{
+		case(EIA_STANDARD_E3):	return(0);
+		case(EIA_STANDARD_E6):	return(1);
+		case(EIA_STANDARD_E12):	return(2);
+		case(EIA_STANDARD_E24):	return(3);
+		case(EIA_STANDARD_E48):	return(4);
+		case(EIA_STANDARD_E96):	return(5);
+		case(EIA_STANDARD_E192):	return(6);
+		default: break;
+	}
+
+	if( std >= EIA_STANDARD_CUSTOM && std < EIA_STANDARD_CUSTOM + EIA_MAX_CUSTOM ) return( 7 + std - EIA_STANDARD_CUSTOM );
+
+	return(-1);
+}
+
+/*	Returns the series at position k of the sets of a range, inverse of EIA_seriesIndex(). */
+
+EIA_standard EIA_getStandard(int k)
+{
+	EIA_standard std[7] =
+	{
+		EIA_STANDARD_E3, EIA_STANDARD_E6, EIA_STANDARD_E12, EIA_STANDARD_E24, EIA_STANDARD_E48, EIA_STANDARD_E96,
+		EIA_STANDARD_E192
+	};
+
+	return( ( k < 7 ) ? std[k] : (EIA_standard)( EIA_STANDARD_CUSTOM + k - 7 ) );
+}
+
+/*
+ * EIA_setRange(range, low, high)
+ *
+ * Description:
+ *
+ * Sets the decades of a range, from 10^low to 10^(high+1) excluded, and frees the sets
+ * already built. Returns 0, or -1 if the decades cannot be coded. The sets must not be in
+ * use.
+ *
+ */
+
+int EIA_setRange(EIA_range* range, int low, int high)
+{
+	int k;
+
+	if( low > high || low < -EIA_DECADE_BIAS || high >= EIA_DECADE_BIAS ) return(-1);
+
+	pthread_mutex_lock(&EIA_lock);
+
+	for( k = 0 ; k < EIA_SERIES ; k++ )
+	{
+		free( range->set[k] );
+		range->set[k] = NULL;
+	}
+
+	range->low = low;
+	range->high = high;
+
+	pthread_mutex_unlock(&EIA_lock);
+
+	return(0);
+}
+
+/*	Returns the number of values of a series in a range. */
+
+int EIA_getSize(EIA_range* range, EIA_standard std)
+{
+	return( EIA_getCount(std) * ( range->high - range->low + 1 ) );
+}
+
+/*
+ * EIA_getSet(range, std)
+ *
+ * Description:
+ *
+ * Returns the EIA_getSize(range, std) values of a series in a range, in ascending order,
+ * decoding them on first use. A set is decoded under EIA_lock and published by an atomic
+ * store once complete, so that the sets already built are read without locking. Returns
+ * NULL if the series is not known or the set could not be allocated.
+ *
+ */
+
+float* EIA_getSet(EIA_range* range, EIA_standard std)
+{
+	float* set;
+	int k = EIA_seriesIndex(std), N = EIA_getCount(std), i, j;
+
+	if( N == 0 || k < 0 ) return(NULL);
+
+	set = __atomic_load_n( &range->set[k], __ATOMIC_ACQUIRE );
+
+	if( set != NULL ) return(set);
+
+	pthread_mutex_lock(&EIA_lock);
+
+	set = range->set[k];
+
+	if( set == NULL && ( set = (float*)malloc( sizeof(float) * EIA_getSize( range, std ) ) ) != NULL )
+	{
+		for( i = range->low ; i <= range->high ; i++ )
+		{
+			for( j = 0 ; j < N ; j++ ) set[ N * ( i - range->low ) + j ] = EIA_decode( EIA_getCode( std, j, i ) );
+		}
+
+		__atomic_store_n( &range->set[k], set, __ATOMIC_RELEASE );
+	}
+
+	pthread_mutex_unlock(&EIA_lock);
+
+	return(set);
+}
+
 #endif /* PASSIVE_EIA_H_ */
@@ -0,0 +1,314 @@
+/*
+ *
+ * 	Optional instrumentation of the selectors.
+ *
+ * 	When PASSIVE_INSTRUMENT is defined, every call of a brute force selector and every search
+ * 	range of SEARCH.h counts the candidates it evaluates, the candidates it rejects because a
+ * 	part is out of bounds, and the improvements of its best error, and times its setup (the
+ * 	choice of sets and bounds) and its whole run. At the end of the call these are added to
+ * 	process-wide statistics of the function: totals, a histogram of the time of a call in
+ * 	INSTRUMENT_STEP wide logarithmic buckets, a histogram of the candidates of a call in powers
+ * 	of two, and the target of the slowest call. INSTRUMENT_dump() writes them in the Prometheus
+ * 	text format, to be read by hand or scraped.
+ *
+ * 	Otherwise the macros below expand to nothing and this header declares nothing, so the
+ * 	selectors compile exactly as without it. Instrumented programs need -pthread, and when
+ * 	they include system headers before the passive ones, _POSIX_C_SOURCE 200809L.
+ *
+ */
+
+#ifndef PASSIVE_INSTRUMENT_H_
+#define PASSIVE_INSTRUMENT_H_
+
+#ifdef PASSIVE_INSTRUMENT
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define INSTRUMENT_BUCKETS		128
+#define INSTRUMENT_FLOOR		1e-7			//	Lower bound of the first time bucket, in seconds.
+#define INSTRUMENT_STEP			1.2				//	Ratio of consecutive time bucket bounds.
+#define INSTRUMENT_POWERS		48				//	Candidate buckets: 0, 1, 2-3, 4-7, ...
+
+//	Instrumented functions: the brute force selectors, in the order of SEARCH_topology, then
+//	the search ranges of each topology.
+
+typedef enum
+{
+	INSTRUMENT_RESISTOR_1R, INSTRUMENT_RESISTOR_2RS, INSTRUMENT_RESISTOR_2RP, INSTRUMENT_RESISTOR_3RS, INSTRUMENT_RESISTOR_3RP,
+	INSTRUMENT_CAPACITOR_1C, INSTRUMENT_CAPACITOR_2CS, INSTRUMENT_CAPACITOR_2CP, INSTRUMENT_CAPACITOR_3CS, INSTRUMENT_CAPACITOR_3CP,
+	INSTRUMENT_RATIO_1R, INSTRUMENT_RATIO_2RS, INSTRUMENT_RATIO_2RP,
+	INSTRUMENT_RC_1R1C, INSTRUMENT_RC_2RS1C, INSTRUMENT_RC_2RP1C, INSTRUMENT_RC_3RS1C, INSTRUMENT_RC_3RP1C,
+	INSTRUMENT_SEARCH,
+	INSTRUMENT_FUNCTIONS = 2 * INSTRUMENT_SEARCH
+}INSTRUMENT_function;
+
+//	Counters of one call.
+
+typedef struct
+{
+	int function;
+	float target;
+	long long candidates;
+	long long pruned;
+	long long improvements;
+	double start;
+	double setup;
+}INSTRUMENT_call;
+
+//	Statistics of one function.
+
+typedef struct
+{
+	long long calls;
+	long long candidates;
+	long long pruned;
+	long long improvements;
+	double seconds;
+	double setup_seconds;
+	long long time_bucket[INSTRUMENT_BUCKETS];
+	long long candidate_bucket[INSTRUMENT_POWERS];
+	double slowest;
+	float slowest_target;
+	long long slowest_candidates;
+}INSTRUMENT_stats;
+
+const char* INSTRUMENT_name[INSTRUMENT_SEARCH] =
+{
+	"RESISTOR_1R", "RESISTOR_2RS", "RESISTOR_2RP", "RESISTOR_3RS", "RESISTOR_3RP",
+	"CAPACITOR_1C", "CAPACITOR_2CS", "CAPACITOR_2CP", "CAPACITOR_3CS", "CAPACITOR_3CP",
+	"RESISTOR_RATIO_1R", "RESISTOR_RATIO_2RS", "RESISTOR_RATIO_2RP",
+	"RC_1R1C", "RC_2RS1C", "RC_2RP1C", "RC_3RS1C", "RC_3RP1C"
+};
+
+INSTRUMENT_stats INSTRUMENT_table[INSTRUMENT_FUNCTIONS];
+pthread_mutex_t INSTRUMENT_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define INSTRUMENT_START(call, f, x)	INSTRUMENT_begin( &(call), (f), (x) )
+#define INSTRUMENT_BEGIN(call, f, x)	INSTRUMENT_call call; INSTRUMENT_begin( &call, (f), (x) )
+#define INSTRUMENT_SETUP(call)			( (call).setup = INSTRUMENT_now() )
+#define INSTRUMENT_CANDIDATE(call)		( (call).candidates++ )
+#define INSTRUMENT_PRUNED(call)			( (call).pruned++ )
+#define INSTRUMENT_IMPROVED(call)		( (call).improvements++ )
+#define INSTRUMENT_END(call)			INSTRUMENT_end( &(call) )
+
+/*****			Function declarations			*****/
+
+double INSTRUMENT_now(void);
+void INSTRUMENT_begin(INSTRUMENT_call* call, int function, float target);
+void INSTRUMENT_end(INSTRUMENT_call* call);
+void INSTRUMENT_getStats(int function, INSTRUMENT_stats* stats);
+double INSTRUMENT_getPercentile(INSTRUMENT_stats* stats, double p);
+void INSTRUMENT_reset(void);
+void INSTRUMENT_dump(FILE* out);
+
+/*****			Function definitions			*****/
+
+double INSTRUMENT_now(void)
+{
+	struct timespec now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+
+	return( (double)now.tv_sec + 1e-9 * (double)now.tv_nsec );
+}
+
+void INSTRUMENT_begin(INSTRUMENT_call* call, int function, float target)
+{
+	call->function = function;
+	call->target = target;
+	call->candidates = 0;
+	call->pruned = 0;
+	call->improvements = 0;
+	call->start = INSTRUMENT_now();
+	call->setup = call->start;
+}
+
+/*
+ * INSTRUMENT_end(call)
+ *
+ * Description:
+ *
+ * Adds the counters and the time of a finished call to the statistics of its function.
+ *
+ */
+
+void INSTRUMENT_end(INSTRUMENT_call* call)
+{
+	INSTRUMENT_stats* stats = &INSTRUMENT_table[ call->function ];
+	double seconds = INSTRUMENT_now() - call->start;
+	long long n;
+	int k = 0, m = 0;
+
+	if( seconds > INSTRUMENT_FLOOR ) k = (int)( log( seconds / INSTRUMENT_FLOOR ) / log( INSTRUMENT_STEP ) );
+	if( k >= INSTRUMENT_BUCKETS ) k = INSTRUMENT_BUCKETS - 1;
+
+	for( n = call->candidates ; n > 0 && m < INSTRUMENT_POWERS - 1 ; n >>= 1 ) m++;
+
+	pthread_mutex_lock(&INSTRUMENT_lock);
+
+	stats->calls++;
+	stats->candidates += call->candidates;
+	stats->pruned += call->pruned;
+	stats->improvements += call->improvements;
+	stats->seconds += seconds;
+	stats->setup_seconds += call->setup - call->start;
+	stats->time_bucket[k]++;
+	stats->candidate_bucket[m]++;
+
+	if( seconds > stats->slowest )
+	{
+		stats->slowest = seconds;
+		stats->slowest_target = call->target;
+		stats->slowest_candidates = call->candidates;
+	}
+
+	pthread_mutex_unlock(&INSTRUMENT_lock);
+}
+
+/*	Copies the statistics of a function. */
+
+void INSTRUMENT_getStats(int function, INSTRUMENT_stats* stats)
+{
+	pthread_mutex_lock(&INSTRUMENT_lock);
+
+	*stats = INSTRUMENT_table[function];
+
+	pthread_mutex_unlock(&INSTRUMENT_lock);
+}
+
+/*
+ * INSTRUMENT_getPercentile(stats, p)
+ *
+ * Description:
+ *
+ * Returns the time below which a fraction p of the calls finished, to within one bucket, or
+ * 0 if no call was recorded.
+ *
+ */
+
+double INSTRUMENT_getPercentile(INSTRUMENT_stats* stats, double p)
+{
+	long long rank, seen = 0;
+	int k;
+
+	if( stats->calls == 0 ) return(0.0);
+
+	rank = (long long)ceil( p * (double)stats->calls );
+
+	if( rank < 1 ) rank = 1;
+
+	for( k = 0 ; k < INSTRUMENT_BUCKETS ; k++ )
+	{
+		seen += stats->time_bucket[k];
+
+		if( seen >= rank ) break;
+	}
+
+	return( INSTRUMENT_FLOOR * pow( INSTRUMENT_STEP, (double)k + 0.5 ) );
+}
+
+void INSTRUMENT_reset(void)
+{
+	pthread_mutex_lock(&INSTRUMENT_lock);
+
+	memset( INSTRUMENT_table, 0, sizeof(INSTRUMENT_table) );
+
+	pthread_mutex_unlock(&INSTRUMENT_lock);
+}
+
+/*
+ * INSTRUMENT_dump(out)
+ *
+ * Description:
+ *
+ * Writes the statistics of every function called so far in the Prometheus text format.
+ * Functions are labelled by name, and by engine: "brute" for the selectors and "search" for
+ * SEARCH.h. Time buckets are in seconds and cumulative, as are candidate buckets.
+ *
+ */
+
+void INSTRUMENT_dump(FILE* out)
+{
+	INSTRUMENT_stats stats;
+	long long seen;
+	char label[96];
+	int f, k;
+
+	fprintf( out, "# TYPE passive_calls_total counter\n" );
+	fprintf( out, "# TYPE passive_candidates_total counter\n" );
+	fprintf( out, "# TYPE passive_pruned_total counter\n" );
+	fprintf( out, "# TYPE passive_improvements_total counter\n" );
+	fprintf( out, "# TYPE passive_setup_seconds_total counter\n" );
+	fprintf( out, "# TYPE passive_slowest_seconds gauge\n" );
+	fprintf( out, "# TYPE passive_slowest_target gauge\n" );
+	fprintf( out, "# TYPE passive_call_seconds histogram\n" );
+	fprintf( out, "# TYPE passive_call_candidates histogram\n" );
+
+	for( f = 0 ; f < INSTRUMENT_FUNCTIONS ; f++ )
+	{
+		INSTRUMENT_getStats( f, &stats );
+
+		if( stats.calls == 0 ) continue;
+
+		snprintf( label, sizeof(label), "function=\"%s\",engine=\"%s\"",
+				  INSTRUMENT_name[ f % INSTRUMENT_SEARCH ], ( f < INSTRUMENT_SEARCH ) ? "brute" : "search" );
+
+		fprintf( out, "passive_calls_total{%s} %lld\n", label, stats.calls );
+		fprintf( out, "passive_candidates_total{%s} %lld\n", label, stats.candidates );
+		fprintf( out, "passive_pruned_total{%s} %lld\n", label, stats.pruned );
+		fprintf( out, "passive_improvements_total{%s} %lld\n", label, stats.improvements );
+		fprintf( out, "passive_setup_seconds_total{%s} %.9g\n", label, stats.setup_seconds );
+		fprintf( out, "passive_slowest_seconds{%s} %.9g\n", label, stats.slowest );
+		fprintf( out, "passive_slowest_target{%s} %.9g\n", label, stats.slowest_target );
+
+		for( k = 0, seen = 0 ; k < INSTRUMENT_BUCKETS ; k++ )
+		{
+			if( stats.time_bucket[k] == 0 ) continue;
+
+			seen += stats.time_bucket[k];
+
+			fprintf( out, "passive_call_seconds_bucket{%s,le=\"%.3g\"} %lld\n", label, INSTRUMENT_FLOOR * pow( INSTRUMENT_STEP, (double)( k + 1 ) ), seen );
+		}
+
+		fprintf( out, "passive_call_seconds_bucket{%s,le=\"+Inf\"} %lld\n", label, stats.calls );
+		fprintf( out, "passive_call_seconds_sum{%s} %.9g\n", label, stats.seconds );
+		fprintf( out, "passive_call_seconds_count{%s} %lld\n", label, stats.calls );
+
+		for( k = 0, seen = 0 ; k < INSTRUMENT_POWERS ; k++ )
+		{
+			if( stats.candidate_bucket[k] == 0 ) continue;
+
+			seen += stats.candidate_bucket[k];
+
+			fprintf( out, "passive_call_candidates_bucket{%s,le=\"%lld\"} %lld\n", label, ( k == 0 ) ? 0LL : ( 1LL << k ) - 1, seen );
+		}
+
+		fprintf( out, "passive_call_candidates_bucket{%s,le=\"+Inf\"} %lld\n", label, stats.calls );
+		fprintf( out, "passive_call_candidates_sum{%s} %lld\n", label, stats.candidates );
+		fprintf( out, "passive_call_candidates_count{%s} %lld\n", label, stats.calls );
+	}
+
+	fflush(out);
+}
+
+#else
+
+#define INSTRUMENT_START(call, f, x)	( (void)0 )
+#define INSTRUMENT_BEGIN(call, f, x)	( (void)0 )
+#define INSTRUMENT_SETUP(call)			( (void)0 )
+#define INSTRUMENT_CANDIDATE(call)		( (void)0 )
+#define INSTRUMENT_PRUNED(call)			( (void)0 )
+#define INSTRUMENT_IMPROVED(call)		( (void)0 )
+#define INSTRUMENT_END(call)			( (void)0 )
+
+#endif /* PASSIVE_INSTRUMENT */
+
+#endif /* PASSIVE_INSTRUMENT_H_ */
@@ -0,0 +1,142 @@
+/*
+ *
+ * 	Interval arithmetic on positive quantities.
+ *
+ * 	Every operation rounds its lower bound down and its upper bound up by one unit in the
+ * 	last place, so the result is guaranteed to contain every value reachable by its
+ * 	operands despite floating point rounding.
+ *
+ */
+
+#ifndef PASSIVE_INTERVAL_H_
+#define PASSIVE_INTERVAL_H_
+
+#include <math.h>
+
+typedef struct
+{
+	float min;
+	float max;
+}INTERVAL_t;
+
+/*****			Function declarations			*****/
+
+float INTERVAL_down(float x);
+float INTERVAL_up(float x);
+
+INTERVAL_t INTERVAL_tolerance(float x, float T);
+INTERVAL_t INTERVAL_add(INTERVAL_t a, INTERVAL_t b);
+INTERVAL_t INTERVAL_harmonic(INTERVAL_t a, INTERVAL_t b);
+INTERVAL_t INTERVAL_mul(INTERVAL_t a, INTERVAL_t b);
+INTERVAL_t INTERVAL_div(INTERVAL_t a, INTERVAL_t b);
+
+/*****			Function definitions			*****/
+
+/*	Rounds x down or up by one unit in the last place. The quantities being positive, a lower
+	bound never goes below 0. */
+
+float INTERVAL_down(float x)
+{
+	float y = nextafterf( x, -INFINITY );
+
+	return( ( y < 0.0f ) ? 0.0f : y );
+}
+
+float INTERVAL_up(float x){ return( nextafterf( x, INFINITY ) ); }
+
+/*
+ * INTERVAL_tolerance(x, T)
+ *
+ * Returns the interval of a part of nominal value x and tolerance T (in percentage). The
+ * quantities being positive, a tolerance of 100 % or more gives a lower bound of 0.
+ *
+ */
+
+INTERVAL_t INTERVAL_tolerance(float x, float T)
+{
+	INTERVAL_t result;
+	float t;
+
+	if( T < 0.0f ) T = 0.0f;
+
+	//	Each of the fraction, the factors and the bounds is rounded outward.
+
+	t = INTERVAL_up( T / 100.0f );
+
+	result.min = ( T < 100.0f ) ? INTERVAL_down( x * INTERVAL_down( 1.0f - t ) ) : 0.0f;
+	result.max = INTERVAL_up( x * INTERVAL_up( 1.0f + t ) );
+
+	return(result);
+}
+
+/*
+ * INTERVAL_add(a, b)
+ *
+ * Returns the interval of a + b.
+ *
+ */
+
+INTERVAL_t INTERVAL_add(INTERVAL_t a, INTERVAL_t b)
+{
+	INTERVAL_t result;
+
+	result.min = INTERVAL_down( a.min + b.min );
+	result.max = INTERVAL_up( a.max + b.max );
+
+	return(result);
+}
+
+/*
+ * INTERVAL_harmonic(a, b)
+ *
+ * Returns the interval of 1 / ( 1/a + 1/b ), which increases with both a and b. Its lower
+ * bound is 0 when both lower bounds are.
+ *
+ */
+
+INTERVAL_t INTERVAL_harmonic(INTERVAL_t a, INTERVAL_t b)
+{
+	INTERVAL_t result;
+
+	if( a.min + b.min == 0.0f ) result.min = 0.0f;
+	else result.min = INTERVAL_down( INTERVAL_down( a.min * b.min ) / INTERVAL_up( a.min + b.min ) );
+	result.max = INTERVAL_up( INTERVAL_up( a.max * b.max ) / INTERVAL_down( a.max + b.max ) );
+
+	return(result);
+}
+
+/*
+ * INTERVAL_mul(a, b)
+ *
+ * Returns the interval of a * b.
+ *
+ */
+
+INTERVAL_t INTERVAL_mul(INTERVAL_t a, INTERVAL_t b)
+{
+	INTERVAL_t result;
+
+	result.min = INTERVAL_down( a.min * b.min );
+	result.max = INTERVAL_up( a.max * b.max );
+
+	return(result);
+}
+
+/*
+ * INTERVAL_div(a, b)
+ *
+ * Returns the interval of a / b.
+ *
+ */
+
+INTERVAL_t INTERVAL_div(INTERVAL_t a, INTERVAL_t b)
+{
+	INTERVAL_t result;
+
+	result.min = INTERVAL_down( a.min / b.max );
+	result.max = INTERVAL_up( a.max / b.min );
+
+	return(result);
+}
+
+#endif /* PASSIVE_INTERVAL_H_ */
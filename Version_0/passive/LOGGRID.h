@@ -0,0 +1,405 @@
+/*
+ *
+ * 	Synthesis of series/parallel networks of many parts on a logarithmic value grid.
+ *
+ * 	The values reachable with exactly k standard parts are built by dynamic programming from
+ * 	the values reachable with fewer parts, connecting every sub-network of a parts in series
+ * 	and in parallel with every sub-network of k - a parts. Values are quantized to cells of
+ * 	equal width in log10, each cell keeping the value closest to its centre and pointers to
+ * 	the two sub-networks it was made of.
+ *
+ * 	After a one-off build per element and standard, the best network of up to N_max parts
+ * 	for any target is found by looking at the few cells around the target in each level, and
+ * 	rebuilt by following the back-pointers.
+ *
+ * 	Since every cell keeps a single network, the accuracy of the grid is about half a cell; the
+ * 	build time grows with the square of the number of cells per decade. SYNTHESIS_getNetwork
+ * 	gives exact results up to four parts.
+ *
+ */
+
+#ifndef PASSIVE_LOGGRID_H_
+#define PASSIVE_LOGGRID_H_
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "SYNTHESIS.h"
+
+#define LOGGRID_MAX_PARTS				8
+#define LOGGRID_CELLS_PER_DECADE		500
+#define LOGGRID_PART					2			//	Operation of a cell holding a single part.
+
+typedef struct
+{
+	float value;					//	Representative value, 0 if the cell is empty.
+	float distance;					//	Distance of the value to the centre of the cell, in cells.
+	unsigned char op;				//	SYNTHESIS_op used, or LOGGRID_PART.
+	unsigned char left_parts;		//	Number of parts of the left sub-network.
+	int left;						//	Cells of the sub-networks in their levels.
+	int right;
+}LOGGRID_cell;
+
+typedef struct
+{
+	NETWORK_element element;
+	EIA_standard std;
+	int N_max;
+	int cells_per_decade;
+	int N_cells;
+	float log_min;									//	log10 of the lower edge of cell 0.
+
+	LOGGRID_cell* level[ LOGGRID_MAX_PARTS + 1 ];		//	Cells reachable with exactly k parts.
+	int* occupied[ LOGGRID_MAX_PARTS + 1 ];			//	Sorted indexes of the non-empty cells.
+	int N_occupied[ LOGGRID_MAX_PARTS + 1 ];
+}LOGGRID_t;
+
+/*****			Function declarations			*****/
+
+int LOGGRID_build(LOGGRID_t* grid, NETWORK_element element, EIA_standard std, int N_max, int cells_per_decade);
+void LOGGRID_free(LOGGRID_t* grid);
+int LOGGRID_getCell(LOGGRID_t* grid, float value);
+float LOGGRID_getNetwork(LOGGRID_t* grid, float X, int N_max, NETWORK_t* network);
+
+/*****			Function definitions			*****/
+
+/*
+ * LOGGRID_store(grid, k, value, op, left_parts, left, right)
+ *
+ * Description:
+ *
+ * Stores a value reachable with k parts in its cell of level k if the cell is empty or the
+ * value is closer to the centre of the cell than its current representative.
+ *
+ */
+
+void LOGGRID_store(LOGGRID_t* grid, int k, float value, int op, int left_parts, int left, int right)
+{
+	LOGGRID_cell* cell;
+	float position, distance;
+	int index;
+
+	position = ( log10f(value) - grid->log_min ) * grid->cells_per_decade;
+	index = (int)position;
+
+	if( index < 0 || index >= grid->N_cells ) return;
+
+	cell = &grid->level[k][index];
+	distance = fabsf( position - index - 0.5f );
+
+	if( cell->value != 0.0f && distance >= cell->distance ) return;
+
+	cell->value = value;
+	cell->distance = distance;
+	cell->op = (unsigned char)op;
+	cell->left_parts = (unsigned char)left_parts;
+	cell->left = left;
+	cell->right = right;
+}
+
+/*
+ * LOGGRID_build(grid, element, std, N_max, cells_per_decade)
+ *
+ * Description:
+ *
+ * Builds the levels of networks of 1 to N_max parts of an element and standard. Returns 0 if
+ * the standard has no values, N_max or cells_per_decade is below 1, or the grid could not be
+ * allocated.
+ *
+ * Connecting a sub-network with one smaller than itself by more than the width of a cell
+ * leaves the value in the same cell, where the level of the larger sub-network already holds
+ * an equivalent network with fewer parts, so such pairs are skipped.
+ *
+ * @parameter	grid					:	Grid to be built.
+ * @parameter	element					:	Resistors or capacitors.
+ * @parameter	std						:	EIA standard from which the parts are chosen.
+ * @parameter	N_max					:	Maximum number of parts, up to LOGGRID_MAX_PARTS.
+ * @parameter	cells_per_decade		:	Resolution of the grid, e.g. LOGGRID_CELLS_PER_DECADE.
+ *
+ */
+
+int LOGGRID_build(LOGGRID_t* grid, NETWORK_element element, EIA_standard std, int N_max, int cells_per_decade)
+{
+	LOGGRID_cell* x;
+	LOGGRID_cell* y;
+	float* set;
+	float log_max;
+	int N, k, a, b, i, j, begin, end, band, op, count;
+
+	if( N_max > LOGGRID_MAX_PARTS ) N_max = LOGGRID_MAX_PARTS;
+
+	for( k = 0 ; k <= LOGGRID_MAX_PARTS ; k++ )
+	{
+		grid->level[k] = NULL;
+		grid->occupied[k] = NULL;
+		grid->N_occupied[k] = 0;
+	}
+
+	set = SYNTHESIS_getSet(element, std, &N);
+
+	if( set == NULL || N == 0 || N_max < 1 || cells_per_decade < 1 ) return(0);
+
+	grid->element = element;
+	grid->std = std;
+	grid->N_max = N_max;
+	grid->cells_per_decade = cells_per_decade;
+
+	//	Parallel networks reach down to set[0] / N_max, series ones up to set[N-1] * N_max.
+
+	grid->log_min = floorf( log10f( set[0] / N_max ) );
+	log_max = log10f( set[N-1] * N_max );
+	grid->N_cells = (int)( ( log_max - grid->log_min ) * cells_per_decade ) + 2;
+
+	band = (int)( cells_per_decade * -log10f( powf( 10.0f, 1.0f / cells_per_decade ) - 1.0f ) ) + 1;
+
+	for( k = 1 ; k <= N_max ; k++ )
+	{
+		grid->level[k] = (LOGGRID_cell*)calloc( grid->N_cells, sizeof(LOGGRID_cell) );
+		grid->occupied[k] = (int*)malloc( sizeof(int) * grid->N_cells );
+
+		if( grid->level[k] == NULL || grid->occupied[k] == NULL )
+		{
+			LOGGRID_free(grid);
+			return(0);
+		}
+
+		if( k == 1 )
+		{
+			for( i = 0 ; i < N ; i++ ) LOGGRID_store( grid, 1, set[i], LOGGRID_PART, 0, i, i );
+		}
+
+		//	Connect every network of a parts with every network of k - a parts.
+
+		for( a = 1 ; a <= k / 2 ; a++ )
+		{
+			b = k - a;
+
+			for( i = 0 ; i < grid->N_occupied[a] ; i++ )
+			{
+				x = &grid->level[a][ grid->occupied[a][i] ];
+
+				begin = lower_bound_int( grid->occupied[b], grid->N_occupied[b], grid->occupied[a][i] - band );
+				end   = lower_bound_int( grid->occupied[b], grid->N_occupied[b], grid->occupied[a][i] + band + 1 );
+
+				if( a == b && begin < i ) begin = i;
+
+				for( j = begin ; j < end ; j++ )
+				{
+					y = &grid->level[b][ grid->occupied[b][j] ];
+
+					for( op = 0 ; op < 2 ; op++ )
+					{
+						LOGGRID_store( grid, k, SYNTHESIS_combine( (SYNTHESIS_op)op, x->value, y->value ),
+									   op, a, grid->occupied[a][i], grid->occupied[b][j] );
+					}
+				}
+			}
+		}
+
+		count = 0;
+
+		for( i = 0 ; i < grid->N_cells ; i++ )
+		{
+			if( grid->level[k][i].value != 0.0f ) grid->occupied[k][ count++ ] = i;
+		}
+
+		grid->N_occupied[k] = count;
+	}
+
+	return(1);
+}
+
+/*
+ * LOGGRID_free(grid)
+ *
+ * Description:
+ *
+ * Releases the levels of a grid.
+ *
+ */
+
+void LOGGRID_free(LOGGRID_t* grid)
+{
+	int k;
+
+	for( k = 0 ; k <= LOGGRID_MAX_PARTS ; k++ )
+	{
+		free(grid->level[k]);
+		free(grid->occupied[k]);
+		grid->level[k] = NULL;
+		grid->occupied[k] = NULL;
+		grid->N_occupied[k] = 0;
+	}
+}
+
+/*
+ * LOGGRID_rebuild(grid, k, index, network)
+ *
+ * Description:
+ *
+ * Adds the network held by cell index of level k to network by following its back-pointers
+ * and returns the index of its root node.
+ *
+ */
+
+int LOGGRID_rebuild(LOGGRID_t* grid, int k, int index, NETWORK_t* network)
+{
+	LOGGRID_cell* cell;
+	int left, right, additive;
+
+	cell = &grid->level[k][index];
+
+	if( cell->op == LOGGRID_PART ) return( NETWORK_addPart( network, cell->value, 0.0f ) );
+
+	left  = LOGGRID_rebuild( grid, cell->left_parts, cell->left, network );
+	right = LOGGRID_rebuild( grid, k - cell->left_parts, cell->right, network );
+
+	additive = ( cell->op == SYNTHESIS_ADD );
+
+	if( additive == ( network->element == NETWORK_RESISTOR ) ) return( NETWORK_addSeries( network, left, right ) );
+
+	return( NETWORK_addParallel( network, left, right ) );
+}
+
+/*
+ * LOGGRID_getCell(grid, value)
+ *
+ * Description:
+ *
+ * Returns the cell of a value, clamped to the cells of the grid.
+ *
+ */
+
+int LOGGRID_getCell(LOGGRID_t* grid, float value)
+{
+	int index;
+
+	index = (int)( ( log10f(value) - grid->log_min ) * grid->cells_per_decade );
+
+	if( index < 0 ) index = 0;
+	if( index >= grid->N_cells ) index = grid->N_cells - 1;
+
+	return(index);
+}
+
+/*
+ * LOGGRID_getNetwork(grid, X, N_max, network)
+ *
+ * Description:
+ *
+ * Finds the network of at most N_max parts of a built grid whose equivalent value is closest
+ * to X, stores it in network and returns its equivalent value. Networks with fewer parts are
+ * preferred when equally close. Returns 0 with an empty network if the grid holds nothing.
+ *
+ * Besides the cells around X in every level, the networks made of one standard part connected
+ * to the cells around the exact complement in the level below are tried. This refines the
+ * outermost connection beyond the resolution of the grid at a cost that depends only on the
+ * size of the standard set.
+ *
+ * @parameter	grid					:	Built grid.
+ * @parameter	X						:	Target equivalent value.
+ * @parameter	N_max					:	Maximum number of parts, up to the one of the grid.
+ * @parameter	network					:	Pointer to the network found.
+ *
+ */
+
+float LOGGRID_getNetwork(LOGGRID_t* grid, float X, int N_max, NETWORK_t* network)
+{
+	LOGGRID_cell* level;
+	LOGGRID_cell* part;
+	float value, error, error_min, y;
+	int k, c, i, op, center, part_root, root;
+	int k_best, c_best, i_best, op_best;
+
+	NETWORK_init(network, grid->element);
+
+	if( N_max > grid->N_max ) N_max = grid->N_max;
+
+	center = LOGGRID_getCell(grid, X);
+
+	error_min = INFINITY;
+	value = 0.0f;
+	k_best = 0;
+	c_best = 0;
+	i_best = -1;
+	op_best = 0;
+
+	for( k = 1 ; k <= N_max ; k++ )
+	{
+		level = grid->level[k];
+
+		//	Walk down to the first value not above X and up to the first value not below it.
+
+		for( c = center ; c >= 0 ; c-- )
+		{
+			if( level[c].value == 0.0f ) continue;
+
+			error = fabsf( level[c].value - X );
+
+			if( error < error_min ){ error_min = error; value = level[c].value; k_best = k; c_best = c; i_best = -1; }
+
+			if( level[c].value <= X ) break;
+		}
+
+		for( c = center ; c < grid->N_cells ; c++ )
+		{
+			if( level[c].value == 0.0f ) continue;
+
+			error = fabsf( level[c].value - X );
+
+			if( error < error_min ){ error_min = error; value = level[c].value; k_best = k; c_best = c; i_best = -1; }
+
+			if( level[c].value >= X ) break;
+		}
+
+		if( k == 1 ) continue;
+
+		//	One part connected to a network of k - 1 parts.
+
+		level = grid->level[ k - 1 ];
+
+		for( i = 0 ; i < grid->N_occupied[1] ; i++ )
+		{
+			part = &grid->level[1][ grid->occupied[1][i] ];
+
+			for( op = 0 ; op < 2 ; op++ )
+			{
+				y = SYNTHESIS_solve( (SYNTHESIS_op)op, X, part->value );
+
+				if( y == 0.0f || y == INFINITY ) continue;
+
+				center = LOGGRID_getCell(grid, y);
+
+				for( c = center - 1 ; c <= center + 1 ; c++ )
+				{
+					if( c < 0 || c >= grid->N_cells || level[c].value == 0.0f ) continue;
+
+					y = SYNTHESIS_combine( (SYNTHESIS_op)op, part->value, level[c].value );
+					error = fabsf( y - X );
+
+					if( error < error_min ){ error_min = error; value = y; k_best = k; c_best = c; i_best = i; op_best = op; }
+				}
+			}
+		}
+
+		center = LOGGRID_getCell(grid, X);
+	}
+
+	if( k_best == 0 ) return(0.0f);
+
+	if( i_best < 0 )
+	{
+		LOGGRID_rebuild( grid, k_best, c_best, network );
+		return(value);
+	}
+
+	part_root = LOGGRID_rebuild( grid, 1, grid->occupied[1][i_best], network );
+	root = LOGGRID_rebuild( grid, k_best - 1, c_best, network );
+
+	if( ( op_best == SYNTHESIS_ADD ) == ( grid->element == NETWORK_RESISTOR ) ) NETWORK_addSeries( network, part_root, root );
+	else NETWORK_addParallel( network, part_root, root );
+
+	return(value);
+}
+
+#endif /* PASSIVE_LOGGRID_H_ */
@@ -0,0 +1,842 @@
+/*
+ *
+ * 	Selection of networks whose parts come from different sets of values.
+ *
+ * 	Designs often combine a coarse part from a cheap series with a trim part from a precision
+ * 	one, or draw each part from what is in stock. The selectors below take one MIXED_set per
+ * 	part: the standard values of a series (MIXED_series()) or a stock list of values
+ * 	(MIXED_stock()), so an E24 resistor in series with an E96 one is a single search rather
+ * 	than one search per combination of series.
+ *
+ * 	Every set is sorted, so as in SEARCH.h the outer parts are enumerated and the others are
+ * 	solved for and looked up by binary search: a single part in its own set, and a pair in a
+ * 	sorted table of every pair of its two sets, which is built once per element, pair of series and
+ * 	operation and shared by all searches. When a set is a stock list, the alternative is to
+ * 	scan the smaller set for every outer candidate and search the other one, which needs no
+ * 	table. The stock list keeps the table of each other set it is searched with, up to
+ * 	MIXED_STOCK_TABLES of them until MIXED_freeSet(), and builds it once the scans have cost
+ * 	as much as its sort. A mixed search thus costs about as much as the search of a single
+ * 	series.
+ *
+ * 	Candidates are compared by their absolute error in float, as the brute force selectors
+ * 	do. When no candidate lies within the bounds, the parts are NaN.
+ *
+ */
+
+#ifndef PASSIVE_MIXED_H_
+#define PASSIVE_MIXED_H_
+
+#include <pthread.h>
+
+#include "SEARCH.h"
+
+#define MIXED_MAX_VALUES		65535				//	Values of a set, indexed by unsigned short in pair tables.
+#define MIXED_MAX_PAIRS			( 1 << 23 )			//	Entries of a table of a stock list.
+#define MIXED_STOCK_TABLES		4					//	Tables kept by a stock list.
+
+//	Pair tables kept by a stock list, each with the other set and the operation it is for, and
+//	the cost of the scans made while it is not built. Sets are told apart by an identity
+//	which is never reused.
+
+typedef struct
+{
+	unsigned long id;							//	Identity of the stock list.
+	int N;
+	unsigned long partner[MIXED_STOCK_TABLES];
+	int first[MIXED_STOCK_TABLES];				//	1 if the stock list is the first set of the pair.
+	SYNTHESIS_op op[MIXED_STOCK_TABLES];
+	double rent[MIXED_STOCK_TABLES];
+	SYNTHESIS_table table[MIXED_STOCK_TABLES];
+}MIXED_stockTables;
+
+//	Sorted values a part is chosen from.
+
+typedef struct
+{
+	float* value;								//	In increasing order.
+	int N;
+	NETWORK_element element;
+	EIA_standard std;							//	Series of the values, or 0 for a stock list.
+	MIXED_stockTables* tables;					//	Tables of a stock list, shared by its copies.
+}MIXED_set;
+
+//	Table of the pairs of two series, and the decades it was built for.
+
+typedef struct
+{
+	SYNTHESIS_table table;
+	int low, high;
+}MIXED_cache;
+
+//	Search in progress.
+
+typedef struct
+{
+	SEARCH_topology topology;
+	float target;
+	MIXED_set* set[SEARCH_MAX_PARTS];
+	int low[SEARCH_MAX_PARTS], high[SEARCH_MAX_PARTS];		//	Values within bounds.
+	SYNTHESIS_op op;
+	SYNTHESIS_table* table;						//	Pairs of parts 0 and 1, or NULL.
+	float part[SEARCH_MAX_PARTS];
+	float best[SEARCH_MAX_PARTS];
+	float error;
+}MIXED_state;
+
+MIXED_cache MIXED_tables[2][EIA_SERIES][EIA_SERIES][2];
+
+unsigned long MIXED_stockCount = 0;
+
+pthread_mutex_t MIXED_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*****			Function declarations			*****/
+
+int MIXED_series(MIXED_set* set, NETWORK_element element, EIA_standard std);
+int MIXED_stock(MIXED_set* set, NETWORK_element element, float* value, int N);
+void MIXED_freeSet(MIXED_set* set);
+void MIXED_select(SEARCH_topology topology, float X, MIXED_set* set, float R_max, float R_min, float C_max, float C_min, float** part);
+
+void MIXED_1R(float R, MIXED_set* set, float* R1);
+void MIXED_2RS(float R, MIXED_set* set, float* R1, float* R2);
+void MIXED_2RP(float R, MIXED_set* set, float* R1, float* R2);
+void MIXED_3RS(float R, MIXED_set* set, float* R1, float* R2, float* R3);
+void MIXED_3RP(float R, MIXED_set* set, float* R1, float* R2, float* R3);
+void MIXED_1C(float C, MIXED_set* set, float* C1);
+void MIXED_2CS(float C, MIXED_set* set, float* C1, float* C2);
+void MIXED_2CP(float C, MIXED_set* set, float* C1, float* C2);
+void MIXED_3CS(float C, MIXED_set* set, float* C1, float* C2, float* C3);
+void MIXED_3CP(float C, MIXED_set* set, float* C1, float* C2, float* C3);
+void MIXED_RATIO_1R(float ratio, MIXED_set* set, float R_max, float R_min, float* R1, float* R2);
+void MIXED_RATIO_2RS(float ratio, MIXED_set* set, float R_max, float R_min,
+					 float* R1_A, float* R1_B, float* R2_A, float* R2_B);
+void MIXED_RATIO_2RP(float ratio, MIXED_set* set, float R_max, float R_min,
+					 float* R1_A, float* R1_B, float* R2_A, float* R2_B);
+void MIXED_RC_1R1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+				   float* R, float* C);
+void MIXED_RC_2RS1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+					float* R1, float* R2, float* C);
+void MIXED_RC_2RP1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+					float* R1, float* R2, float* C);
+void MIXED_RC_3RS1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+					float* R1, float* R2, float* R3, float* C);
+void MIXED_RC_3RP1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+					float* R1, float* R2, float* R3, float* C);
+
+/*****			Function definitions			*****/
+
+/*
+ * MIXED_series(set, element, std)
+ *
+ * Description:
+ *
+ * Makes set the standard values of a series of an element, in the decades of the element
+ * (see SYNTHESIS_setRange(), after which the set must be made again). Returns 0, or -1 if
+ * std is not a series or its values could not be allocated.
+ *
+ */
+
+int MIXED_series(MIXED_set* set, NETWORK_element element, EIA_standard std)
+{
+	set->element = element;
+	set->std = std;
+	set->N = 0;
+	set->value = NULL;
+	set->tables = NULL;
+
+	if( !EIA_isStandard(std) ) return(-1);
+
+	set->value = SYNTHESIS_getSet( element, std, &set->N );
+
+	return( ( set->value == NULL || set->N > MIXED_MAX_VALUES ) ? -1 : 0 );
+}
+
+/*
+ * MIXED_stock(set, element, value, N)
+ *
+ * Description:
+ *
+ * Makes set the N values of a stock list, which are sorted in place and must stay allocated
+ * while the set is used. The pair tables the set keeps are freed with MIXED_freeSet(), once
+ * neither the set nor its copies are used. Returns 0, or -1 if a value is not positive and
+ * finite, N is not between 1 and MIXED_MAX_VALUES or memory ran out.
+ *
+ */
+
+int MIXED_stock(MIXED_set* set, NETWORK_element element, float* value, int N)
+{
+	int k;
+
+	if( value == NULL || N < 1 || N > MIXED_MAX_VALUES ) return(-1);
+
+	for( k = 0 ; k < N ; k++ ) if( !( value[k] > 0.0f ) || !isfinite( value[k] ) ) return(-1);
+
+	//	Values are ordered as the first column of a pair.
+
+	qsort( value, N, sizeof(float), SYNTHESIS_comparePairs );
+
+	set->tables = (MIXED_stockTables*)calloc( 1, sizeof(MIXED_stockTables) );
+
+	if( set->tables == NULL ) return(-1);
+
+	pthread_mutex_lock(&MIXED_lock);
+	set->tables->id = 2 * ++MIXED_stockCount;
+	pthread_mutex_unlock(&MIXED_lock);
+
+	set->value = value;
+	set->N = N;
+	set->element = element;
+	set->std = (EIA_standard)0;
+
+	return(0);
+}
+
+/*	Fills a table with every pair of a value of A and a value of B, combined with op and
+	sorted. Returns -1 if it could not be allocated. */
+
+int MIXED_build(SYNTHESIS_table* table, MIXED_set* A, MIXED_set* B, SYNTHESIS_op op)
+{
+	float* pair;
+	int i, j, k;
+
+	table->N = 0;
+	table->value = NULL;
+	table->i = NULL;
+	table->j = NULL;
+
+	if( (double)A->N * B->N > MIXED_MAX_PAIRS ) return(-1);
+
+	pair = (float*)malloc( sizeof(float) * 3 * A->N * B->N );
+
+	table->value = (float*)malloc( sizeof(float) * A->N * B->N );
+	table->i = (unsigned short*)malloc( sizeof(unsigned short) * A->N * B->N );
+	table->j = (unsigned short*)malloc( sizeof(unsigned short) * A->N * B->N );
+
+	if( pair == NULL || table->value == NULL || table->i == NULL || table->j == NULL )
+	{
+		free(pair);
+		free(table->value);
+		free(table->i);
+		free(table->j);
+		table->value = NULL;
+		table->i = NULL;
+		table->j = NULL;
+
+		return(-1);
+	}
+
+	k = 0;
+
+	for( i = 0 ; i < A->N ; i++ )
+	{
+		for( j = 0 ; j < B->N ; j++ )
+		{
+			pair[ 3*k ]     = SYNTHESIS_combine( op, A->value[i], B->value[j] );
+			pair[ 3*k + 1 ] = (float)i;
+			pair[ 3*k + 2 ] = (float)j;
+			k++;
+		}
+	}
+
+	qsort( pair, k, 3 * sizeof(float), SYNTHESIS_comparePairs );
+
+	for( i = 0 ; i < k ; i++ )
+	{
+		table->value[i] = pair[ 3*i ];
+		table->i[i] = (unsigned short)pair[ 3*i + 1 ];
+		table->j[i] = (unsigned short)pair[ 3*i + 2 ];
+	}
+
+	table->N = k;
+
+	free(pair);
+
+	return(0);
+}
+
+/*	Frees a table built for one call. */
+
+void MIXED_free(SYNTHESIS_table* table)
+{
+	free(table->value);
+	free(table->i);
+	free(table->j);
+	table->value = NULL;
+	table->N = 0;
+}
+
+/*	Frees the pair tables kept by a stock list. A set of a series keeps none. */
+
+void MIXED_freeSet(MIXED_set* set)
+{
+	int k;
+
+	if( set->tables == NULL ) return;
+
+	for( k = 0 ; k < set->tables->N ; k++ ) MIXED_free( &set->tables->table[k] );
+
+	free(set->tables);
+	set->tables = NULL;
+}
+
+/*	Identity of a set: that of a stock list, or for a series the series and the decades of
+	its element, so that a table kept for a series is not used once they change. */
+
+unsigned long MIXED_identity(MIXED_set* set)
+{
+	EIA_range* range = ( set->element == NETWORK_RESISTOR ) ? &RESISTOR_range : &CAPACITOR_range;
+
+	if( set->tables != NULL ) return( set->tables->id );
+
+	return( 1 | (unsigned long)set->std << 1 | (unsigned long)( range->low + 64 ) << 10 | (unsigned long)( range->high + 64 ) << 18 );
+}
+
+/*
+ * MIXED_getStockTable(A, B, op, scan, sort)
+ *
+ * Description:
+ *
+ * Returns the table kept by a stock list A or B for the pairs of A and B combined with op,
+ * building it once the scans made without it, scan for this search, cost as much as its
+ * sort. Returns NULL if it is not built, or the stock list has no room left for it.
+ *
+ */
+
+SYNTHESIS_table* MIXED_getStockTable(MIXED_set* A, MIXED_set* B, SYNTHESIS_op op, double scan, double sort)
+{
+	MIXED_stockTables* tables = ( A->tables != NULL ) ? A->tables : B->tables;
+	SYNTHESIS_table* table = NULL;
+	MIXED_set* other;
+	unsigned long partner;
+	int first = ( A->tables != NULL ), k;
+
+	other = first ? B : A;
+
+	//	A stock list made without MIXED_stock() has no identity.
+
+	if( tables == NULL || ( other->tables == NULL && EIA_seriesIndex(other->std) < 0 ) ) return(NULL);
+
+	partner = MIXED_identity(other);
+
+	pthread_mutex_lock(&MIXED_lock);
+
+	for( k = 0 ; k < tables->N ; k++ ) if( tables->partner[k] == partner && tables->first[k] == first && tables->op[k] == op ) break;
+
+	if( k == tables->N && k < MIXED_STOCK_TABLES )
+	{
+		tables->partner[k] = partner;
+		tables->first[k] = first;
+		tables->op[k] = op;
+		tables->rent[k] = 0.0;
+		tables->table[k].value = NULL;
+		tables->N++;
+	}
+
+	if( k < tables->N )
+	{
+		if( tables->table[k].value == NULL && ( tables->rent[k] += scan ) >= sort ) MIXED_build( &tables->table[k], A, B, op );
+
+		if( tables->table[k].value != NULL ) table = &tables->table[k];
+	}
+
+	pthread_mutex_unlock(&MIXED_lock);
+
+	return(table);
+}
+
+/*
+ * MIXED_getTable(A, B, op, scratch)
+ *
+ * Description:
+ *
+ * Returns the sorted table of every pair of a value of A and a value of B combined with op.
+ * The table of two series of an element is built on first use, and again when the decades
+ * of the element change; any other table is built in scratch, to be freed with MIXED_free().
+ * Returns NULL if the table could not be allocated.
+ *
+ */
+
+SYNTHESIS_table* MIXED_getTable(MIXED_set* A, MIXED_set* B, SYNTHESIS_op op, SYNTHESIS_table* scratch)
+{
+	EIA_range* range;
+	MIXED_cache* cache;
+	SYNTHESIS_table* table = NULL;
+
+	if( EIA_seriesIndex(A->std) < 0 || EIA_seriesIndex(B->std) < 0 || A->element != B->element )
+	{
+		return( ( MIXED_build( scratch, A, B, op ) == 0 ) ? scratch : NULL );
+	}
+
+	range = ( A->element == NETWORK_RESISTOR ) ? &RESISTOR_range : &CAPACITOR_range;
+	cache = &MIXED_tables[A->element][ EIA_seriesIndex(A->std) ][ EIA_seriesIndex(B->std) ][op];
+
+	pthread_mutex_lock(&MIXED_lock);
+
+	if( cache->table.value != NULL && ( cache->low != range->low || cache->high != range->high ) ) MIXED_free( &cache->table );
+
+	if( cache->table.value != NULL || MIXED_build( &cache->table, A, B, op ) == 0 )
+	{
+		cache->low = range->low;
+		cache->high = range->high;
+		table = &cache->table;
+	}
+
+	pthread_mutex_unlock(&MIXED_lock);
+
+	return(table);
+}
+
+/*	Keeps the candidate in state->part if it is closer to the target than the best one. */
+
+void MIXED_consider(MIXED_state* state)
+{
+	float error;
+	int i;
+
+	error = fabsf( SEARCH_evaluate( state->topology, state->part ) - state->target );
+
+	if( error < state->error )
+	{
+		state->error = error;
+
+		for( i = 0 ; i < SEARCH_MAX_PARTS ; i++ ) state->best[i] = state->part[i];
+	}
+}
+
+/*
+ * MIXED_tryPair(state, x)
+ *
+ * Description:
+ *
+ * Tries the pairs within bounds around x as parts 0 and 1 of the candidate: the entries of
+ * the pair table on each side of x, or, without a table, the two values of one set around
+ * the solution for each value of the smaller one.
+ *
+ */
+
+void MIXED_tryPair(MIXED_state* state, float x)
+{
+	SYNTHESIS_table* table = state->table;
+	MIXED_set* A = state->set[0];
+	MIXED_set* B = state->set[1];
+	float* other;
+	int a, b, position, k;
+
+	if( table == NULL )
+	{
+		//	Values of the smaller set are scanned, and the other part is searched.
+
+		a = ( state->high[1] - state->low[1] < state->high[0] - state->low[0] );
+		b = 1 - a;
+		other = state->set[b]->value;
+
+		for( k = state->low[a] ; k < state->high[a] ; k++ )
+		{
+			state->part[a] = state->set[a]->value[k];
+
+			position = state->low[b] + lower_bound( other + state->low[b], state->high[b] - state->low[b],
+													SYNTHESIS_solve( state->op, x, state->part[a] ) );
+
+			if( position > state->low[b] )
+			{
+				state->part[b] = other[ position - 1 ];
+				MIXED_consider(state);
+			}
+
+			if( position < state->high[b] )
+			{
+				state->part[b] = other[position];
+				MIXED_consider(state);
+			}
+		}
+
+		return;
+	}
+
+	position = lower_bound( table->value, table->N, x );
+
+	for( k = position - 1 ; k >= 0 ; k-- )
+	{
+		if( table->i[k] < state->low[0] || table->i[k] >= state->high[0] ||
+			table->j[k] < state->low[1] || table->j[k] >= state->high[1] ) continue;
+
+		state->part[0] = A->value[ table->i[k] ];
+		state->part[1] = B->value[ table->j[k] ];
+
+		MIXED_consider(state);
+		break;
+	}
+
+	for( k = position ; k < table->N ; k++ )
+	{
+		if( table->i[k] < state->low[0] || table->i[k] >= state->high[0] ||
+			table->j[k] < state->low[1] || table->j[k] >= state->high[1] ) continue;
+
+		state->part[0] = A->value[ table->i[k] ];
+		state->part[1] = B->value[ table->j[k] ];
+
+		MIXED_consider(state);
+		break;
+	}
+}
+
+/*	Tries the two values within bounds around x as part 0 of the candidate. */
+
+void MIXED_tryValue(MIXED_state* state, float x)
+{
+	float* value = state->set[0]->value;
+	int position;
+
+	position = state->low[0] + lower_bound( value + state->low[0], state->high[0] - state->low[0], x );
+
+	if( position > state->low[0] )
+	{
+		state->part[0] = value[ position - 1 ];
+		MIXED_consider(state);
+	}
+
+	if( position < state->high[0] )
+	{
+		state->part[0] = value[position];
+		MIXED_consider(state);
+	}
+}
+
+/*	Value the inner part, or pair, should have given the outer parts of the candidate. */
+
+float MIXED_solve(MIXED_state* state)
+{
+	float X = state->target;
+	float* part = state->part;
+
+	switch(state->topology)
+	{
+		case(SEARCH_RESISTOR_3RS):
+		case(SEARCH_RESISTOR_3RP):
+		case(SEARCH_CAPACITOR_3CS):
+		case(SEARCH_CAPACITOR_3CP):	return( SYNTHESIS_solve( state->op, X, part[2] ) );
+		case(SEARCH_RATIO_1R):		return( X * part[1] );
+		case(SEARCH_RATIO_2RS):
+		case(SEARCH_RATIO_2RP):		return( X * SYNTHESIS_combine( state->op, part[2], part[3] ) );
+		case(SEARCH_RC_1R1C):		return( X / part[1] );
+		case(SEARCH_RC_2RS1C):
+		case(SEARCH_RC_2RP1C):		return( X / part[2] );
+		case(SEARCH_RC_3RS1C):
+		case(SEARCH_RC_3RP1C):		return( SYNTHESIS_solve( state->op, X / part[3], part[2] ) );
+		default: break;
+	}
+
+	return(X);
+}
+
+/*
+ * MIXED_narrow(state, index, end)
+ *
+ * Description:
+ *
+ * Narrows the values of part 2 of a three part network to those which may give the closest
+ * candidate, from the share of the target the network has to make: all of the target, or
+ * the target over the capacitor for RC_3RS1C and RC_3RP1C. A series network exceeds each of
+ * its parts, so a value at or above the share does no better than the first such value, and
+ * a parallel one stays below each of its parts, so a value at or below the share does no
+ * better than the last such value. Sets index[2] and end[2] to the range left.
+ *
+ */
+
+void MIXED_narrow(MIXED_state* state, int* index, int* end)
+{
+	float* value = state->set[2]->value;
+	float share = state->target;
+	int low = state->low[2];
+	int high = state->high[2];
+	int position;
+
+	if( state->topology >= SEARCH_RC_1R1C ) share /= state->set[3]->value[ index[3] ];
+
+	if( state->op == SYNTHESIS_ADD )
+	{
+		position = low + lower_bound( value + low, high - low, share );
+
+		index[2] = low;
+		end[2] = ( position < high ) ? position + 1 : high;
+	}
+	else
+	{
+		position = low + upper_bound( value + low, high - low, share );
+
+		index[2] = ( position > low ) ? position - 1 : low;
+		end[2] = high;
+	}
+}
+
+/*
+ * MIXED_select(topology, X, set, R_max, R_min, C_max, C_min, part)
+ *
+ * Description:
+ *
+ * Selects the parts of a topology closest to X. Part k is chosen from set[k] and stored in
+ * *part[k]; the bounds apply as in the selectors of the topology. Parts 0 and 1 are looked
+ * up as a pair, or part 0 alone for RESISTOR_1R, CAPACITOR_1C, RATIO_1R and RC_1R1C, and
+ * every combination of the other parts is enumerated, part 2 of a three part network only
+ * over the values MIXED_narrow() leaves.
+ *
+ */
+
+void MIXED_select(SEARCH_topology topology, float X, MIXED_set* set, float R_max, float R_min, float C_max, float C_min, float** part)
+{
+	MIXED_state state;
+	SYNTHESIS_table scratch;
+	float max, min;
+	double n[2], outer, scan, sort;
+	int N_parts = SEARCH_getParts(topology);
+	int index[SEARCH_MAX_PARTS], end[SEARCH_MAX_PARTS];
+	int pair, first, narrow, k;
+
+	state.topology = topology;
+	state.target = X;
+	state.op = SYNTHESIS_ADD;
+	state.table = NULL;
+	state.error = INFINITY;
+
+	scratch.value = NULL;
+
+	switch(topology)
+	{
+		case(SEARCH_RESISTOR_2RP):
+		case(SEARCH_RESISTOR_3RP):
+		case(SEARCH_CAPACITOR_2CS):
+		case(SEARCH_CAPACITOR_3CS):
+		case(SEARCH_RATIO_2RP):
+		case(SEARCH_RC_2RP1C):
+		case(SEARCH_RC_3RP1C):	state.op = SYNTHESIS_HARMONIC; break;
+
+		default: break;
+	}
+
+	pair = !( N_parts == 1 || topology == SEARCH_RATIO_1R || topology == SEARCH_RC_1R1C );
+	first = pair ? 2 : 1;
+	narrow = ( N_parts == 3 && topology < SEARCH_RATIO_1R ) || topology == SEARCH_RC_3RS1C || topology == SEARCH_RC_3RP1C;
+
+	//	Values of each set within the bounds of its part.
+
+	for( k = 0 ; k < N_parts ; k++ )
+	{
+		max = ( topology >= SEARCH_RATIO_1R ) ? R_max : INFINITY;
+		min = ( topology >= SEARCH_RATIO_1R ) ? R_min : 0.0f;
+
+		if( topology >= SEARCH_RC_1R1C && k == N_parts - 1 )
+		{
+			max = C_max;
+			min = C_min;
+		}
+
+		state.set[k] = &set[k];
+		state.low[k] = lower_bound( set[k].value, set[k].N, min );
+		state.high[k] = upper_bound( set[k].value, set[k].N, max );
+
+		if( state.low[k] >= state.high[k] ) break;
+	}
+
+	if( k == N_parts )
+	{
+		//	Two series share a cached table, and a stock list keeps the tables it is searched
+		//	with. Otherwise a table is built for this call only when sorting it costs less than
+		//	scanning the smaller set for every outer candidate.
+
+		for( k = first, outer = 1.0 ; k < N_parts ; k++ ) outer *= state.high[k] - state.low[k];
+
+		if( narrow )
+		{
+			//	Values MIXED_narrow() leaves, summed over the capacitors of an RC network.
+
+			outer = 0.0;
+			index[3] = ( N_parts == 4 ) ? state.low[3] : 0;
+
+			do
+			{
+				MIXED_narrow( &state, index, end );
+				outer += end[2] - index[2];
+			}
+			while( N_parts == 4 && ++index[3] < state.high[3] );
+		}
+
+		if( pair )
+		{
+			n[0] = state.high[0] - state.low[0];
+			n[1] = state.high[1] - state.low[1];
+
+			scan = outer * fmin( n[0], n[1] ) * log2( fmax( n[0], n[1] ) + 1.0 );
+			sort = (double)set[0].N * set[1].N * log2( (double)set[0].N * set[1].N + 1.0 );
+
+			if( set[0].std != 0 && set[1].std != 0 && set[0].element == set[1].element ) state.table = MIXED_getTable( &set[0], &set[1], state.op, &scratch );
+			else if( ( state.table = MIXED_getStockTable( &set[0], &set[1], state.op, scan, sort ) ) == NULL && sort < scan )
+			{
+				state.table = MIXED_getTable( &set[0], &set[1], state.op, &scratch );
+			}
+		}
+
+		//	Every combination of the outer parts, counted as the digits of a number. The range
+		//	of part 2 follows the capacitor, a more significant digit.
+
+		for( k = first ; k < N_parts ; k++ )
+		{
+			index[k] = state.low[k];
+			end[k] = state.high[k];
+		}
+
+		if( narrow ) MIXED_narrow( &state, index, end );
+
+		do
+		{
+			for( k = first ; k < N_parts ; k++ ) state.part[k] = set[k].value[ index[k] ];
+
+			if( pair ) MIXED_tryPair( &state, MIXED_solve(&state) );
+			else MIXED_tryValue( &state, MIXED_solve(&state) );
+
+			for( k = first ; k < N_parts && ++index[k] == end[k] ; k++ ) index[k] = state.low[k];
+
+			if( narrow && k > 2 && k < N_parts ) MIXED_narrow( &state, index, end );
+		}
+		while( k < N_parts );
+
+		if( state.table == &scratch ) MIXED_free(&scratch);
+	}
+
+	for( k = 0 ; k < N_parts ; k++ ) *part[k] = ( state.error < INFINITY ) ? state.best[k] : NAN;
+}
+
+/*	Selectors with one set per part, in the order of their outputs. */
+
+void MIXED_1R(float R, MIXED_set* set, float* R1)
+{
+	float* part[1] = { R1 };
+
+	MIXED_select( SEARCH_RESISTOR_1R, R, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_2RS(float R, MIXED_set* set, float* R1, float* R2)
+{
+	float* part[2] = { R1, R2 };
+
+	MIXED_select( SEARCH_RESISTOR_2RS, R, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_2RP(float R, MIXED_set* set, float* R1, float* R2)
+{
+	float* part[2] = { R1, R2 };
+
+	MIXED_select( SEARCH_RESISTOR_2RP, R, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_3RS(float R, MIXED_set* set, float* R1, float* R2, float* R3)
+{
+	float* part[3] = { R1, R2, R3 };
+
+	MIXED_select( SEARCH_RESISTOR_3RS, R, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_3RP(float R, MIXED_set* set, float* R1, float* R2, float* R3)
+{
+	float* part[3] = { R1, R2, R3 };
+
+	MIXED_select( SEARCH_RESISTOR_3RP, R, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_1C(float C, MIXED_set* set, float* C1)
+{
+	float* part[1] = { C1 };
+
+	MIXED_select( SEARCH_CAPACITOR_1C, C, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_2CS(float C, MIXED_set* set, float* C1, float* C2)
+{
+	float* part[2] = { C1, C2 };
+
+	MIXED_select( SEARCH_CAPACITOR_2CS, C, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_2CP(float C, MIXED_set* set, float* C1, float* C2)
+{
+	float* part[2] = { C1, C2 };
+
+	MIXED_select( SEARCH_CAPACITOR_2CP, C, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_3CS(float C, MIXED_set* set, float* C1, float* C2, float* C3)
+{
+	float* part[3] = { C1, C2, C3 };
+
+	MIXED_select( SEARCH_CAPACITOR_3CS, C, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_3CP(float C, MIXED_set* set, float* C1, float* C2, float* C3)
+{
+	float* part[3] = { C1, C2, C3 };
+
+	MIXED_select( SEARCH_CAPACITOR_3CP, C, set, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void MIXED_RATIO_1R(float ratio, MIXED_set* set, float R_max, float R_min, float* R1, float* R2)
+{
+	float* part[2] = { R1, R2 };
+
+	MIXED_select( SEARCH_RATIO_1R, ratio, set, R_max, R_min, INFINITY, 0.0f, part );
+}
+
+void MIXED_RATIO_2RS(float ratio, MIXED_set* set, float R_max, float R_min,
+					 float* R1_A, float* R1_B, float* R2_A, float* R2_B)
+{
+	float* part[4] = { R1_A, R1_B, R2_A, R2_B };
+
+	MIXED_select( SEARCH_RATIO_2RS, ratio, set, R_max, R_min, INFINITY, 0.0f, part );
+}
+
+void MIXED_RATIO_2RP(float ratio, MIXED_set* set, float R_max, float R_min,
+					 float* R1_A, float* R1_B, float* R2_A, float* R2_B)
+{
+	float* part[4] = { R1_A, R1_B, R2_A, R2_B };
+
+	MIXED_select( SEARCH_RATIO_2RP, ratio, set, R_max, R_min, INFINITY, 0.0f, part );
+}
+
+void MIXED_RC_1R1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+				   float* R, float* C)
+{
+	float* part[2] = { R, C };
+
+	MIXED_select( SEARCH_RC_1R1C, tau, set, R_max, R_min, C_max, C_min, part );
+}
+
+void MIXED_RC_2RS1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+					float* R1, float* R2, float* C)
+{
+	float* part[3] = { R1, R2, C };
+
+	MIXED_select( SEARCH_RC_2RS1C, tau, set, R_max, R_min, C_max, C_min, part );
+}
+
+void MIXED_RC_2RP1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+					float* R1, float* R2, float* C)
+{
+	float* part[3] = { R1, R2, C };
+
+	MIXED_select( SEARCH_RC_2RP1C, tau, set, R_max, R_min, C_max, C_min, part );
+}
+
+void MIXED_RC_3RS1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+					float* R1, float* R2, float* R3, float* C)
+{
+	float* part[4] = { R1, R2, R3, C };
+
+	MIXED_select( SEARCH_RC_3RS1C, tau, set, R_max, R_min, C_max, C_min, part );
+}
+
+void MIXED_RC_3RP1C(float tau, MIXED_set* set, float R_max, float R_min, float C_max, float C_min,
+					float* R1, float* R2, float* R3, float* C)
+{
+	float* part[4] = { R1, R2, R3, C };
+
+	MIXED_select( SEARCH_RC_3RP1C, tau, set, R_max, R_min, C_max, C_min, part );
+}
+
+#endif /* PASSIVE_MIXED_H_ */
@@ -0,0 +1,316 @@
+/*
+ *
+ * 	Series/parallel networks of resistors or capacitors.
+ *
+ * 	A network is an expression tree stored as an array of nodes in which every series or
+ * 	parallel node comes after its two children, so the whole tree is evaluated in a single
+ * 	pass over the array.
+ *
+ */
+
+#ifndef PASSIVE_NETWORK_H_
+#define PASSIVE_NETWORK_H_
+
+#include <math.h>
+#include <stdio.h>
+
+#include "INTERVAL.h"
+
+#define NETWORK_MAX_NODES		31
+
+//	Element the network is made of.
+
+typedef enum{ NETWORK_RESISTOR, NETWORK_CAPACITOR } NETWORK_element;
+
+//	Node types.
+
+typedef enum{ NETWORK_PART, NETWORK_SERIES, NETWORK_PARALLEL } NETWORK_node_t;
+
+typedef struct
+{
+	NETWORK_node_t type;
+	float value;						//	Nominal value of a part.
+	float T;							//	Tolerance of a part (in percentage).
+	int left;							//	Children of a series or parallel node.
+	int right;
+}NETWORK_node;
+
+typedef struct
+{
+	NETWORK_element element;
+	int N_nodes;
+	int root;
+	NETWORK_node node[NETWORK_MAX_NODES];
+}NETWORK_t;
+
+/*****			Function declarations			*****/
+
+void NETWORK_init(NETWORK_t* network, NETWORK_element element);
+int NETWORK_addNode(NETWORK_t* network, NETWORK_node_t type, float value, float T, int left, int right);
+int NETWORK_addPart(NETWORK_t* network, float value, float T);
+int NETWORK_addSeries(NETWORK_t* network, int left, int right);
+int NETWORK_addParallel(NETWORK_t* network, int left, int right);
+
+int NETWORK_getParts(NETWORK_t* network);
+int NETWORK_isAdditive(NETWORK_t* network, NETWORK_node_t type);
+float NETWORK_getValue(NETWORK_t* network);
+INTERVAL_t NETWORK_getBounds(NETWORK_t* network);
+INTERVAL_t NETWORK_getTimeConstantBounds(NETWORK_t* R_network, NETWORK_t* C_network);
+int NETWORK_toString(NETWORK_t* network, char* buffer, int size);
+
+/*****			Function definitions			*****/
+
+/*
+ * NETWORK_init(network, element)
+ *
+ * Description:
+ *
+ * Initializes an empty network of resistors or capacitors.
+ *
+ */
+
+void NETWORK_init(NETWORK_t* network, NETWORK_element element)
+{
+	network->element = element;
+	network->N_nodes = 0;
+	network->root = -1;
+}
+
+/*
+ * NETWORK_addPart(network, value, T), NETWORK_addSeries(network, left, right),
+ * NETWORK_addParallel(network, left, right)
+ *
+ * Description:
+ *
+ * Add a part, or a series or parallel connection of two existing nodes, to a network and
+ * return the index of the new node, or -1 if the network is full or a child is not one of
+ * its nodes. The node added last becomes the root of the network.
+ *
+ * @parameter	value					:	Nominal value of the part.
+ * @parameter	T						:	Tolerance of the part (in percentage).
+ * @parameter	left, right				:	Indexes of the connected nodes.
+ *
+ */
+
+int NETWORK_addNode(NETWORK_t* network, NETWORK_node_t type, float value, float T, int left, int right)
+{
+	NETWORK_node* node;
+
+	if( network->N_nodes >= NETWORK_MAX_NODES ) return(-1);
+
+	//	Children come before their parent, which the passes over the nodes rely on.
+
+	if( type != NETWORK_PART && ( left < 0 || left >= network->N_nodes || right < 0 || right >= network->N_nodes ) ) return(-1);
+
+	node = &network->node[ network->N_nodes ];
+
+	node->type = type;
+	node->value = value;
+	node->T = T;
+	node->left = left;
+	node->right = right;
+
+	network->root = network->N_nodes++;
+
+	return( network->root );
+}
+
+int NETWORK_addPart(NETWORK_t* network, float value, float T)
+{
+	return( NETWORK_addNode( network, NETWORK_PART, value, T, -1, -1 ) );
+}
+
+int NETWORK_addSeries(NETWORK_t* network, int left, int right)
+{
+	return( NETWORK_addNode( network, NETWORK_SERIES, 0.0f, 0.0f, left, right ) );
+}
+
+int NETWORK_addParallel(NETWORK_t* network, int left, int right)
+{
+	return( NETWORK_addNode( network, NETWORK_PARALLEL, 0.0f, 0.0f, left, right ) );
+}
+
+/*
+ * NETWORK_getParts(network)
+ *
+ * Description:
+ *
+ * Returns the number of parts of a network.
+ *
+ */
+
+int NETWORK_getParts(NETWORK_t* network)
+{
+	int i;
+	int result = 0;
+
+	for( i = 0 ; i < network->N_nodes ; i++ )
+	{
+		if( network->node[i].type == NETWORK_PART ) result++;
+	}
+
+	return(result);
+}
+
+/*
+ * NETWORK_isAdditive(network, type)
+ *
+ * Description:
+ *
+ * Returns 1 if connecting two nodes with the given node type adds their values (resistors
+ * in series, capacitors in parallel) and 0 if it adds their reciprocals.
+ *
+ */
+
+int NETWORK_isAdditive(NETWORK_t* network, NETWORK_node_t type)
+{
+	return( ( type == NETWORK_SERIES ) == ( network->element == NETWORK_RESISTOR ) );
+}
+
+/*
+ * NETWORK_getValue(network)
+ *
+ * Description:
+ *
+ * Returns the nominal equivalent value of a network.
+ *
+ */
+
+float NETWORK_getValue(NETWORK_t* network)
+{
+	float value[NETWORK_MAX_NODES];
+	NETWORK_node* node;
+	float a, b;
+	int i;
+
+	for( i = 0 ; i < network->N_nodes ; i++ )
+	{
+		node = &network->node[i];
+
+		if( node->type == NETWORK_PART )
+		{
+			value[i] = node->value;
+			continue;
+		}
+
+		a = value[ node->left ];
+		b = value[ node->right ];
+
+		if( NETWORK_isAdditive( network, node->type ) ) value[i] = a + b;
+		else value[i] = ( a * b ) / ( a + b );
+	}
+
+	return( value[ network->root ] );
+}
+
+/*
+ * NETWORK_getBounds(network)
+ *
+ * Description:
+ *
+ * Returns guaranteed minimum and maximum equivalent values of a network whose parts take
+ * any value within their tolerance, in one pass over the network instead of enumerating
+ * the 2^N tolerance corners.
+ *
+ * Each part appears once in the tree and the equivalent value increases with every part,
+ * so the bounds are also the tightest possible ones, up to one rounding step per node.
+ *
+ */
+
+INTERVAL_t NETWORK_getBounds(NETWORK_t* network)
+{
+	INTERVAL_t bounds[NETWORK_MAX_NODES];
+	NETWORK_node* node;
+	int i;
+
+	for( i = 0 ; i < network->N_nodes ; i++ )
+	{
+		node = &network->node[i];
+
+		if( node->type == NETWORK_PART )
+		{
+			bounds[i] = INTERVAL_tolerance( node->value, node->T );
+		}
+		else if( NETWORK_isAdditive( network, node->type ) )
+		{
+			bounds[i] = INTERVAL_add( bounds[ node->left ], bounds[ node->right ] );
+		}
+		else
+		{
+			bounds[i] = INTERVAL_harmonic( bounds[ node->left ], bounds[ node->right ] );
+		}
+	}
+
+	return( bounds[ network->root ] );
+}
+
+/*
+ * NETWORK_getTimeConstantBounds(R_network, C_network)
+ *
+ * Description:
+ *
+ * Returns guaranteed minimum and maximum time constants of an RC circuit made of a resistor
+ * network and a capacitor network.
+ *
+ */
+
+INTERVAL_t NETWORK_getTimeConstantBounds(NETWORK_t* R_network, NETWORK_t* C_network)
+{
+	return( INTERVAL_mul( NETWORK_getBounds(R_network), NETWORK_getBounds(C_network) ) );
+}
+
+/*
+ * NETWORK_print(network, index, buffer, size)
+ *
+ * Description:
+ *
+ * Writes node number index of a network into buffer, with series connections written as
+ * " + " and parallel ones as " || ", and returns the number of characters of the full
+ * description. Once the buffer is full, the rest is only counted.
+ *
+ */
+
+int NETWORK_print(NETWORK_t* network, int index, char* buffer, int size)
+{
+	NETWORK_node* node;
+	int length, used;
+
+	node = &network->node[index];
+
+	if( node->type == NETWORK_PART ) return( snprintf( buffer, size, "%g", node->value ) );
+
+	length = snprintf( buffer, size, "( " );
+
+	used = ( length < size ) ? length : size;
+	length += NETWORK_print( network, node->left, buffer + used, size - used );
+
+	used = ( length < size ) ? length : size;
+	length += snprintf( buffer + used, size - used, ( node->type == NETWORK_SERIES ) ? " + " : " || " );
+
+	used = ( length < size ) ? length : size;
+	length += NETWORK_print( network, node->right, buffer + used, size - used );
+
+	used = ( length < size ) ? length : size;
+	length += snprintf( buffer + used, size - used, " )" );
+
+	return(length);
+}
+
+/*
+ * NETWORK_toString(network, buffer, size)
+ *
+ * Description:
+ *
+ * Writes the structure of a network into buffer, e.g. "( 1000 + ( 2200 || 4700 ) )", and
+ * returns the number of characters of the full description.
+ *
+ */
+
+int NETWORK_toString(NETWORK_t* network, char* buffer, int size)
+{
+	if( network->N_nodes == 0 ) return( snprintf( buffer, size, "(empty)" ) );
+
+	return( NETWORK_print( network, network->root, buffer, size ) );
+}
+
+#endif /* PASSIVE_NETWORK_H_ */
@@ -0,0 +1,629 @@
+/*
+ *
+ * 	Query planner of the selectors.
+ *
+ * 	Including this header makes the selectors of RESISTOR.h, CAPACITOR.h and RC.h run through
+ * 	the planner (see SELECTOR.h). Each call estimates the cost of the execution strategies
+ * 	from the sizes of the sets, the number of parts within the bounds and the pair tables
+ * 	already built, and runs the cheapest one:
+ *
+ * 		PLANNER_BRUTE		the nested loops of the *_BRUTE selectors,
+ * 		PLANNER_INDEXED		the sorted table search of SEARCH.h,
+ * 		PLANNER_THREADED	the same search with its outer positions split across threads.
+ *
+ * 	Costs are in nanoseconds, from the coefficients of PLANNER_cost. These can be measured on
+ * 	the machine by PLANNER_calibrate(), and refined from the time of every call when
+ * 	PLANNER_adaptive is set. A pair table is built when the brute force calls it would have
+ * 	saved add up to the cost of building it, so that a single call on a large standard does
+ * 	not pay for a table it may never use again.
+ *
+ * 	The selectors minimize the error of PLANNER_metric, absolute by default as in the brute
+ * 	force selectors. Every strategy finds a selection with the smallest error. When several
+ * 	selections are equally close, the parts returned may depend on the strategy. The standard
+ * 	values are built on first use. Link with -pthread.
+ *
+ */
+
+#ifndef PASSIVE_PLANNER_H_
+#define PASSIVE_PLANNER_H_
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "SEARCH.h"
+
+#define PLANNER_MAX_THREADS		64
+#define PLANNER_MIN_POSITIONS	256				//	Outer positions per thread.
+#define PLANNER_RATE			0.1				//	Weight of a call in an adaptive coefficient.
+
+typedef enum{ PLANNER_BRUTE, PLANNER_INDEXED, PLANNER_THREADED, PLANNER_STRATEGIES } PLANNER_strategy;
+
+//	Cost coefficients, in nanoseconds.
+
+typedef struct
+{
+	double candidate;							//	Brute force candidate.
+	double lookup;								//	Step of a binary search or of a pair table scan.
+	double call;								//	Fixed cost of a search.
+	double thread;								//	Start and join of a thread.
+	double pair;								//	Sorting step of a pair table being built.
+}PLANNER_model;
+
+//	Estimated costs of a query.
+
+typedef struct
+{
+	PLANNER_strategy strategy;
+	double cost[PLANNER_STRATEGIES];
+	double candidates;							//	Brute force search space.
+	double lookups;								//	Steps of the sorted table search.
+	double build;								//	Cost of the pair table still to be built.
+	int N_outer;								//	Outer positions of the search.
+	int N_threads;
+	int empty;									//	1 if no part lies within the bounds.
+}PLANNER_plan;
+
+//	Range of outer positions searched by one thread.
+
+typedef struct
+{
+	SEARCH_query* query;
+	int begin, end;
+	SEARCH_result result;
+}PLANNER_range;
+
+PLANNER_model PLANNER_cost = { 2.0, 2.0, 200.0, 30000.0, 8.0 };
+int PLANNER_adaptive = 0;
+int PLANNER_threads = 0;						//	Threads of PLANNER_THREADED, one per processor if 0.
+int PLANNER_forced = -1;						//	Strategy of every call, or -1 to plan each call.
+SEARCH_metric PLANNER_metric = SEARCH_ABSOLUTE;	//	Error minimized by the selectors.
+
+double PLANNER_rent[2][SYNTHESIS_STANDARDS][2];	//	Brute force time spent for lack of each pair table.
+pthread_mutex_t PLANNER_lock = PTHREAD_MUTEX_INITIALIZER;		//	Guards PLANNER_cost and PLANNER_rent.
+
+int PLANNER_processors = 1;						//	Online processors, read once.
+pthread_once_t PLANNER_once = PTHREAD_ONCE_INIT;
+
+/*****			Function declarations			*****/
+
+void PLANNER_estimate(SEARCH_query* query, PLANNER_plan* plan);
+void PLANNER_brute(SEARCH_query* query, SEARCH_result* result);
+int PLANNER_prepare(SEARCH_query* query);
+void PLANNER_threaded(SEARCH_query* query, int N_threads, SEARCH_result* result);
+void PLANNER_run(SEARCH_query* query, SEARCH_result* result);
+void PLANNER_calibrate(void);
+
+/*****			Function definitions			*****/
+
+/*	Counts the processors once, sysconf() costs more than a small search. */
+
+void PLANNER_countProcessors(void)
+{
+	PLANNER_processors = (int)sysconf(_SC_NPROCESSORS_ONLN);
+}
+
+int PLANNER_getProcessors(void)
+{
+	int N = PLANNER_threads;
+
+	if( N <= 0 )
+	{
+		pthread_once( &PLANNER_once, PLANNER_countProcessors );
+		N = PLANNER_processors;
+	}
+
+	if( N > PLANNER_MAX_THREADS ) N = PLANNER_MAX_THREADS;
+	if( N < 1 ) N = 1;
+
+	return(N);
+}
+
+/*
+ * PLANNER_getTable(query, element, op)
+ *
+ * Description:
+ *
+ * Returns 1 if the search of a query uses a pair table, and which one in element and op.
+ *
+ */
+
+int PLANNER_getTable(SEARCH_query* query, NETWORK_element* element, SYNTHESIS_op* op)
+{
+	SEARCH_topology topology = query->topology;
+
+	*element = ( topology >= SEARCH_CAPACITOR_1C && topology <= SEARCH_CAPACITOR_3CP ) ? NETWORK_CAPACITOR : NETWORK_RESISTOR;
+
+	switch(topology)
+	{
+		case(SEARCH_RESISTOR_2RP):
+		case(SEARCH_RESISTOR_3RP):
+		case(SEARCH_CAPACITOR_2CS):
+		case(SEARCH_CAPACITOR_3CS):
+		case(SEARCH_RATIO_2RP):
+		case(SEARCH_RC_2RP1C):
+		case(SEARCH_RC_3RP1C):	*op = SYNTHESIS_HARMONIC; break;
+
+		default:				*op = SYNTHESIS_ADD; break;
+	}
+
+	return( topology != SEARCH_RESISTOR_1R && topology != SEARCH_CAPACITOR_1C &&
+			topology != SEARCH_RATIO_1R && topology != SEARCH_RC_1R1C );
+}
+
+/*
+ * PLANNER_estimate(query, plan)
+ *
+ * Description:
+ *
+ * Estimates the cost of every strategy for a query and chooses the cheapest one, or the one
+ * of PLANNER_forced. The brute force selectors try every candidate whatever the bounds. The
+ * search tries two entries around a binary search for each outer position within the
+ * bounds, and scans past the pairs with a part out of bounds, about T/t entries for each one
+ * kept when t of the T pairs are within the bounds. The brute force selectors compare
+ * absolute errors in float, so they are not planned for queries in a wider precision or
+ * another metric.
+ *
+ */
+
+void PLANNER_estimate(SEARCH_query* query, PLANNER_plan* plan)
+{
+	SEARCH_topology topology = query->topology;
+	NETWORK_element element;
+	SYNTHESIS_op op;
+	EIA_standard std;
+	PLANNER_model cost;
+	float* set;
+	double T, t, value_step, pair_step, outer, rent = 0.0;
+	int N, n = 0, NC = 1, nC = 1, N_parts, index, k;
+
+	//	Parts within bounds, none of an unknown standard.
+
+	PLANNER_getTable( query, &element, &op );
+
+	std = ( element == NETWORK_CAPACITOR ) ? query->C_std : query->R_std;
+	set = SYNTHESIS_getSet( element, std, &N );
+
+	if( set == NULL ) N = 0;
+	else if( element == NETWORK_CAPACITOR ) n = upper_bound( set, N, query->C_max ) - lower_bound( set, N, query->C_min );
+	else n = upper_bound( set, N, query->R_max ) - lower_bound( set, N, query->R_min );
+
+	if( topology >= SEARCH_RC_1R1C )
+	{
+		set = SYNTHESIS_getSet( NETWORK_CAPACITOR, query->C_std, &NC );
+
+		if( set == NULL ) NC = nC = 0;
+		else nC = upper_bound( set, NC, query->C_max ) - lower_bound( set, NC, query->C_min );
+	}
+
+	if( n < 0 ) n = 0;
+	if( nC < 0 ) nC = 0;
+
+	//	Brute force candidates, and search steps.
+
+	N_parts = SEARCH_getParts(topology);
+
+	if( topology >= SEARCH_RC_1R1C ) N_parts--;
+
+	plan->candidates = pow( (double)N, (double)N_parts ) * (double)NC;
+
+	T = 0.5 * (double)N * (double)( N + 1 );
+	t = 0.5 * (double)n * (double)( n + 1 );
+
+	value_step = log2( (double)N ) + 2.0;
+	pair_step = log2(T) + 2.0 + ( ( t > 0.0 ) ? 2.0 * T / t : 0.0 );
+
+	switch(topology)
+	{
+		case(SEARCH_RESISTOR_1R):
+		case(SEARCH_CAPACITOR_1C):		outer = 1.0; plan->lookups = value_step; break;
+
+		case(SEARCH_RESISTOR_2RS):
+		case(SEARCH_RESISTOR_2RP):
+		case(SEARCH_CAPACITOR_2CS):
+		case(SEARCH_CAPACITOR_2CP):		outer = 1.0; plan->lookups = pair_step; break;
+
+		case(SEARCH_RESISTOR_3RS):
+		case(SEARCH_RESISTOR_3RP):
+		case(SEARCH_CAPACITOR_3CS):
+		case(SEARCH_CAPACITOR_3CP):		outer = n; plan->lookups = n * pair_step; break;
+
+		case(SEARCH_RATIO_1R):			outer = n; plan->lookups = n * value_step; break;
+
+		case(SEARCH_RATIO_2RS):
+		case(SEARCH_RATIO_2RP):			outer = T; plan->lookups = T + t * pair_step; break;
+
+		case(SEARCH_RC_1R1C):			outer = nC; plan->lookups = nC * value_step; break;
+
+		case(SEARCH_RC_2RS1C):
+		case(SEARCH_RC_2RP1C):			outer = nC; plan->lookups = nC * pair_step; break;
+
+		default:						outer = (double)nC * n; plan->lookups = outer * pair_step; break;
+	}
+
+	plan->empty = ( n == 0 || nC == 0 );
+	plan->build = 0.0;
+
+	if( plan->empty )
+	{
+		outer = 0.0;
+		plan->lookups = 0.0;
+	}
+
+	plan->N_outer = ( outer < (double)INT_MAX ) ? (int)outer : INT_MAX;
+
+	//	A missing pair table costs its sort, less the brute force time spent without it. The
+	//	coefficients are read at once, since adaptive calls move them.
+
+	index = SYNTHESIS_standardIndex(std);
+
+	if( plan->empty || index < 0 || !PLANNER_getTable( query, &element, &op ) || SYNTHESIS_hasTable( element, std, op ) ) index = -1;
+
+	pthread_mutex_lock(&PLANNER_lock);
+
+	cost = PLANNER_cost;
+
+	if( index >= 0 ) rent = PLANNER_rent[element][index][op];
+
+	pthread_mutex_unlock(&PLANNER_lock);
+
+	if( index >= 0 )
+	{
+		plan->build = T * log2(T) * cost.pair - rent;
+
+		if( plan->build < 0.0 ) plan->build = 0.0;
+	}
+
+	plan->N_threads = PLANNER_getProcessors();
+
+	if( plan->N_threads > plan->N_outer / PLANNER_MIN_POSITIONS ) plan->N_threads = plan->N_outer / PLANNER_MIN_POSITIONS;
+
+	plan->cost[PLANNER_BRUTE] = ( query->precision == SEARCH_FLOAT && query->metric == SEARCH_ABSOLUTE ) ?
+								plan->candidates * cost.candidate : INFINITY;
+	plan->cost[PLANNER_INDEXED] = cost.call + plan->lookups * cost.lookup + plan->build;
+	plan->cost[PLANNER_THREADED] = INFINITY;
+
+	if( plan->N_threads > 1 )
+	{
+		plan->cost[PLANNER_THREADED] = cost.call + plan->build + plan->lookups * cost.lookup / plan->N_threads +
+									   cost.thread * ( plan->N_threads - 1 );
+	}
+
+	plan->strategy = PLANNER_BRUTE;
+
+	for( k = 1 ; k < PLANNER_STRATEGIES ; k++ ) if( plan->cost[k] < plan->cost[ plan->strategy ] ) plan->strategy = (PLANNER_strategy)k;
+
+	if( PLANNER_forced >= 0 && PLANNER_forced < PLANNER_STRATEGIES ) plan->strategy = (PLANNER_strategy)PLANNER_forced;
+	if( plan->strategy == PLANNER_THREADED && plan->N_threads < 2 ) plan->N_threads = 1;
+}
+
+/*
+ * PLANNER_brute(query, result)
+ *
+ * Description:
+ *
+ * Runs the brute force selector of a query, which compares the absolute errors of candidates
+ * in float, and measures its selection in the precision and metric of the query. result->N_parts is 0 if it selected
+ * nothing.
+ *
+ */
+
+void PLANNER_brute(SEARCH_query* q, SEARCH_result* result)
+{
+	float* p = result->part;
+	int k;
+
+	for( k = 0 ; k < SEARCH_MAX_PARTS ; k++ ) p[k] = NAN;
+
+	switch(q->topology)
+	{
+		case(SEARCH_RESISTOR_1R):	p[0] = RESISTOR_1R_BRUTE( q->target, q->R_std ); break;
+		case(SEARCH_RESISTOR_2RS):	RESISTOR_2RS_BRUTE( q->target, q->R_std, &p[0], &p[1] ); break;
+		case(SEARCH_RESISTOR_2RP):	RESISTOR_2RP_BRUTE( q->target, q->R_std, &p[0], &p[1] ); break;
+		case(SEARCH_RESISTOR_3RS):	RESISTOR_3RS_BRUTE( q->target, q->R_std, &p[0], &p[1], &p[2] ); break;
+		case(SEARCH_RESISTOR_3RP):	RESISTOR_3RP_BRUTE( q->target, q->R_std, &p[0], &p[1], &p[2] ); break;
+		case(SEARCH_CAPACITOR_1C):	p[0] = CAPACITOR_1C_BRUTE( q->target, q->C_std ); break;
+		case(SEARCH_CAPACITOR_2CS):	CAPACITOR_2CS_BRUTE( q->target, q->C_std, &p[0], &p[1] ); break;
+		case(SEARCH_CAPACITOR_2CP):	CAPACITOR_2CP_BRUTE( q->target, q->C_std, &p[0], &p[1] ); break;
+		case(SEARCH_CAPACITOR_3CS):	CAPACITOR_3CS_BRUTE( q->target, q->C_std, &p[0], &p[1], &p[2] ); break;
+		case(SEARCH_CAPACITOR_3CP):	CAPACITOR_3CP_BRUTE( q->target, q->C_std, &p[0], &p[1], &p[2] ); break;
+		case(SEARCH_RATIO_1R):		RESISTOR_RATIO_1R_BRUTE( q->target, q->R_std, q->R_max, q->R_min, &p[0], &p[1] ); break;
+		case(SEARCH_RATIO_2RS):		RESISTOR_RATIO_2RS_BRUTE( q->target, q->R_std, q->R_max, q->R_min, &p[0], &p[1], &p[2], &p[3] ); break;
+		case(SEARCH_RATIO_2RP):		RESISTOR_RATIO_2RP_BRUTE( q->target, q->R_std, q->R_max, q->R_min, &p[0], &p[1], &p[2], &p[3] ); break;
+		case(SEARCH_RC_1R1C):		RC_1R1C_BRUTE( q->target, q->R_std, q->C_std, q->R_max, q->R_min, q->C_max, q->C_min, &p[0], &p[1] ); break;
+		case(SEARCH_RC_2RS1C):		RC_2RS1C_BRUTE( q->target, q->R_std, q->C_std, q->R_max, q->R_min, q->C_max, q->C_min, &p[0], &p[1], &p[2] ); break;
+		case(SEARCH_RC_2RP1C):		RC_2RP1C_BRUTE( q->target, q->R_std, q->C_std, q->R_max, q->R_min, q->C_max, q->C_min, &p[0], &p[1], &p[2] ); break;
+		case(SEARCH_RC_3RS1C):		RC_3RS1C_BRUTE( q->target, q->R_std, q->C_std, q->R_max, q->R_min, q->C_max, q->C_min, &p[0], &p[1], &p[2], &p[3] ); break;
+		case(SEARCH_RC_3RP1C):		RC_3RP1C_BRUTE( q->target, q->R_std, q->C_std, q->R_max, q->R_min, q->C_max, q->C_min, &p[0], &p[1], &p[2], &p[3] ); break;
+	}
+
+	result->topology = q->topology;
+	result->N_parts = isnan( p[0] ) ? 0 : SEARCH_getParts( q->topology );
+	result->value = 0.0;
+	result->error = INFINITY;
+	result->optimal = 1;
+
+	if( result->N_parts > 0 ) result->error = SEARCH_measure( q, p, &result->value );
+}
+
+/*	Builds the pair table a query needs, if it is not built yet. Returns -1 if it could not be
+	allocated. */
+
+int PLANNER_prepare(SEARCH_query* query)
+{
+	NETWORK_element element;
+	SYNTHESIS_op op;
+	EIA_standard std;
+
+	if( !PLANNER_getTable( query, &element, &op ) ) return(0);
+
+	std = ( element == NETWORK_CAPACITOR ) ? query->C_std : query->R_std;
+
+	return( ( SYNTHESIS_getTable( element, std, op ) == NULL ) ? -1 : 0 );
+}
+
+void* PLANNER_work(void* argument)
+{
+	PLANNER_range* range = (PLANNER_range*)argument;
+
+	SEARCH_runRange( range->query, NULL, range->begin, range->end, &range->result );
+
+	return(NULL);
+}
+
+/*
+ * PLANNER_threaded(query, N_threads, result)
+ *
+ * Description:
+ *
+ * Searches a query with its outer positions split into N_threads consecutive ranges, one per
+ * thread, and merges their results in order, which gives the result of SEARCH_run.
+ *
+ */
+
+void PLANNER_threaded(SEARCH_query* query, int N_threads, SEARCH_result* result)
+{
+	PLANNER_range range[PLANNER_MAX_THREADS];
+	pthread_t thread[PLANNER_MAX_THREADS];
+	int started[PLANNER_MAX_THREADS];
+	SEARCH_state state;
+	int N, i;
+
+	N = SEARCH_prepare( &state, query );
+
+	if( N_threads > PLANNER_MAX_THREADS ) N_threads = PLANNER_MAX_THREADS;
+	if( N_threads > N ) N_threads = N;
+
+	if( N_threads < 2 )
+	{
+		SEARCH_run( query, result );
+		return;
+	}
+
+	for( i = 0 ; i < N_threads ; i++ )
+	{
+		range[i].query = query;
+		range[i].begin = (int)( (long long)N * i / N_threads );
+		range[i].end = (int)( (long long)N * ( i + 1 ) / N_threads );
+	}
+
+	for( i = 1 ; i < N_threads ; i++ ) started[i] = ( pthread_create( &thread[i], NULL, PLANNER_work, &range[i] ) == 0 );
+
+	PLANNER_work( &range[0] );
+
+	*result = range[0].result;
+
+	for( i = 1 ; i < N_threads ; i++ )
+	{
+		if( started[i] ) pthread_join( thread[i], NULL );
+		else PLANNER_work( &range[i] );
+
+		SEARCH_merge( result, &range[i].result );
+	}
+
+	result->optimal = 1;
+}
+
+/*	Moves the coefficient of the strategy of a plan towards the time a call took. */
+
+void PLANNER_learn(PLANNER_plan* plan, double seconds)
+{
+	double ns = 1e9 * seconds;
+	double* coefficient;
+	double measured;
+
+	if( plan->build > 0.0 || plan->empty ) return;
+	if( plan->strategy == PLANNER_INDEXED && plan->lookups < 1.0 ) return;
+	if( plan->strategy == PLANNER_THREADED && plan->N_threads < 2 ) return;
+
+	pthread_mutex_lock(&PLANNER_lock);
+
+	switch(plan->strategy)
+	{
+		case(PLANNER_BRUTE):
+		{
+			coefficient = &PLANNER_cost.candidate;
+			measured = ns / plan->candidates;
+		}; break;
+
+		case(PLANNER_INDEXED):
+		{
+			coefficient = &PLANNER_cost.lookup;
+			measured = ( ns - PLANNER_cost.call ) / plan->lookups;
+		}; break;
+
+		default:
+		{
+			coefficient = &PLANNER_cost.thread;
+			measured = ( ns - PLANNER_cost.call - plan->lookups * PLANNER_cost.lookup / plan->N_threads ) / ( plan->N_threads - 1 );
+		}; break;
+	}
+
+	if( measured > 0.0 && isfinite(measured) ) *coefficient += PLANNER_RATE * ( measured - *coefficient );
+
+	pthread_mutex_unlock(&PLANNER_lock);
+}
+
+/*
+ * PLANNER_run(query, result)
+ *
+ * Description:
+ *
+ * Finds the selection of a query closest to its target with the cheapest strategy.
+ * result->N_parts is 0 if no part lies within the bounds.
+ *
+ */
+
+void PLANNER_run(SEARCH_query* query, SEARCH_result* result)
+{
+	PLANNER_plan plan;
+	NETWORK_element element;
+	SYNTHESIS_op op;
+	EIA_standard std;
+	double start = 0.0;
+
+	if( PLANNER_adaptive ) start = SEARCH_now();
+
+	PLANNER_estimate( query, &plan );
+
+	if( plan.strategy == PLANNER_BRUTE )
+	{
+		PLANNER_brute( query, result );
+
+		//	Pay the rent of the missing pair table.
+
+		if( plan.build > 0.0 && PLANNER_getTable( query, &element, &op ) )
+		{
+			//	Only a known standard gets a build cost, see PLANNER_estimate().
+
+			std = ( element == NETWORK_CAPACITOR ) ? query->C_std : query->R_std;
+
+			pthread_mutex_lock(&PLANNER_lock);
+			PLANNER_rent[element][ SYNTHESIS_standardIndex(std) ][op] += plan.cost[PLANNER_BRUTE];
+			pthread_mutex_unlock(&PLANNER_lock);
+		}
+	}
+	else
+	{
+		result->topology = query->topology;
+		result->N_parts = 0;
+		result->error = INFINITY;
+		result->optimal = 0;
+
+		if( PLANNER_prepare(query) < 0 ) return;
+
+		if( plan.strategy == PLANNER_THREADED ) PLANNER_threaded( query, plan.N_threads, result );
+		else SEARCH_run( query, result );
+	}
+
+	if( PLANNER_adaptive ) PLANNER_learn( &plan, SEARCH_now() - start );
+}
+
+/*
+ * PLANNER_select(topology, target, R_std, C_std, R_max, R_min, C_max, C_min, part)
+ *
+ * Description:
+ *
+ * Plans and runs a selection, and stores its parts through the pointers of part, in the order
+ * of the arguments of the selectors, minimizing the error of PLANNER_metric. They are left
+ * unchanged if no part lies within the bounds.
+ *
+ */
+
+void PLANNER_select(SEARCH_topology topology, float target, EIA_standard R_std, EIA_standard C_std,
+					float R_max, float R_min, float C_max, float C_min, float** part)
+{
+	SEARCH_query query;
+	SEARCH_result result;
+	int k;
+
+	SEARCH_initQuery( &query, topology, target, R_std );
+
+	query.C_std = C_std;
+	query.R_max = R_max;
+	query.R_min = R_min;
+	query.C_max = C_max;
+	query.C_min = C_min;
+	query.metric = PLANNER_metric;
+
+	PLANNER_run( &query, &result );
+
+	for( k = 0 ; k < result.N_parts ; k++ ) *part[k] = result.part[k];
+}
+
+/*
+ * PLANNER_calibrate()
+ *
+ * Description:
+ *
+ * Measures the coefficients of PLANNER_cost on this machine: the brute force candidate on
+ * RESISTOR_2RS_BRUTE, the search step on RC_3RS1C and the start of a thread. Builds the pair
+ * tables of the E12 resistors.
+ *
+ */
+
+void PLANNER_calibrate(void)
+{
+	SEARCH_query query;
+	SEARCH_result result;
+	PLANNER_plan plan;
+	PLANNER_range range;
+	pthread_t thread;
+	double start, candidate, lookup, spawn;
+	volatile float sink;
+	float a, b;
+	int k, N = 32;
+
+	start = SEARCH_now();
+
+	for( k = 0 ; k < N ; k++ )
+	{
+		RESISTOR_2RS_BRUTE( 10.0f * powf( 1e4f, (float)k / N ), EIA_STANDARD_E12, &a, &b );
+		sink = a + b;
+	}
+
+	candidate = 1e9 * ( SEARCH_now() - start ) / ( N * pow( RESISTOR_getSize(EIA_STANDARD_E12), 2.0 ) );
+
+	SEARCH_initQuery( &query, SEARCH_RC_3RS1C, 1e-4f, EIA_STANDARD_E12 );
+	PLANNER_prepare( &query );
+	PLANNER_estimate( &query, &plan );
+
+	start = SEARCH_now();
+
+	for( k = 0 ; k < N ; k++ )
+	{
+		query.target = 1e-6f * powf( 1e4f, (float)k / N );
+		SEARCH_run( &query, &result );
+		sink = result.value;
+	}
+
+	(void)sink;
+
+	pthread_mutex_lock(&PLANNER_lock);
+	lookup = ( 1e9 * ( SEARCH_now() - start ) / N - PLANNER_cost.call ) / plan.lookups;
+	pthread_mutex_unlock(&PLANNER_lock);
+
+	range.query = &query;
+	range.begin = 0;
+	range.end = 0;
+
+	start = SEARCH_now();
+
+	for( k = 0 ; k < N ; k++ ) if( pthread_create( &thread, NULL, PLANNER_work, &range ) == 0 ) pthread_join( thread, NULL );
+
+	spawn = 1e9 * ( SEARCH_now() - start ) / N;
+
+	pthread_mutex_lock(&PLANNER_lock);
+
+	if( candidate > 0.0 ) PLANNER_cost.candidate = candidate;
+	if( lookup > 0.0 ) PLANNER_cost.lookup = lookup;
+	if( spawn > 0.0 ) PLANNER_cost.thread = spawn;
+
+	pthread_mutex_unlock(&PLANNER_lock);
+}
+
+//	Selectors of RESISTOR.h, CAPACITOR.h and RC.h run through the planner.
+
+void (*SELECTOR_planner)(SEARCH_topology topology, float target, EIA_standard R_std, EIA_standard C_std,
+						 float R_max, float R_min, float C_max, float C_min, float** part) = PLANNER_select;
+
+#endif /* PASSIVE_PLANNER_H_ */
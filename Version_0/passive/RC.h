@@ -11,6 +11,37 @@
 
 void RC_init();
 
+DUAL_t RC_TC_1R1C_AD(DUAL_t R, DUAL_t C);
+DUAL_t RC_TC_2RS1C_AD(DUAL_t R1, DUAL_t R2, DUAL_t C);
+DUAL_t RC_TC_2RP1C_AD(DUAL_t R1, DUAL_t R2, DUAL_t C);
+DUAL_t RC_TC_3RS1C_AD(DUAL_t R1, DUAL_t R2, DUAL_t R3, DUAL_t C);
+DUAL_t RC_TC_3RP1C_AD(DUAL_t R1, DUAL_t R2, DUAL_t R3, DUAL_t C);
+
+//	Selectors, which run the brute force loops below, or the query planner when PLANNER.h is
+//	included (see SELECTOR.h).
+
+void RC_1R1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			 float R_max, float R_min, float C_max, float C_min, float* R, float* C);
+void RC_2RS1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			  float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* C);
+void RC_2RP1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			  float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* C);
+void RC_3RS1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			  float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* R3, float* C);
+void RC_3RP1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			  float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* R3, float* C);
+
+void RC_1R1C_BRUTE(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+				   float R_max, float R_min, float C_max, float C_min, float* R, float* C);
+void RC_2RS1C_BRUTE(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+				    float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* C);
+void RC_2RP1C_BRUTE(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+				    float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* C);
+void RC_3RS1C_BRUTE(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+				    float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* R3, float* C);
+void RC_3RP1C_BRUTE(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+				    float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* R3, float* C);
+
 /*****			Function definitions			*****/
 
 /*
@@ -18,7 +49,8 @@ void RC_init();
  *
  * 	DECSRIPTION:
  *
- * 	Initializes standard values of resistors and capacitors.
+ * 	Builds the standard values of resistors and capacitors of every series ahead of their
+ * 	first use.
  *
  */
 
@@ -119,7 +151,45 @@ float RC_TC_3RP1C(float R1, float R2, float R3, float C)
 
 
 /*
- * RC_1R1C(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R, C )
+ * RC_TC_1R1C_AD(R, C), RC_TC_2RS1C_AD(R1, R2, C), RC_TC_2RP1C_AD(R1, R2, C),
+ * RC_TC_3RS1C_AD(R1, R2, R3, C), RC_TC_3RP1C_AD(R1, R2, R3, C)
+ *
+ * Description:
+ *
+ * Dual number versions of the time constant functions above. They return the time constant
+ * together with its partial derivatives with respect to the input variables of the resistors
+ * and the capacitor in a single evaluation.
+ *
+ */
+
+DUAL_t RC_TC_1R1C_AD(DUAL_t R, DUAL_t C)
+{
+	return( DUAL_mul( R, C ) );
+}
+
+DUAL_t RC_TC_2RS1C_AD(DUAL_t R1, DUAL_t R2, DUAL_t C)
+{
+	return( DUAL_mul( RESISTOR_ER2S_AD(R1,R2), C ) );
+}
+
+DUAL_t RC_TC_2RP1C_AD(DUAL_t R1, DUAL_t R2, DUAL_t C)
+{
+	return( DUAL_mul( RESISTOR_ER2P_AD(R1,R2), C ) );
+}
+
+DUAL_t RC_TC_3RS1C_AD(DUAL_t R1, DUAL_t R2, DUAL_t R3, DUAL_t C)
+{
+	return( DUAL_mul( RESISTOR_ER3S_AD(R1,R2,R3), C ) );
+}
+
+DUAL_t RC_TC_3RP1C_AD(DUAL_t R1, DUAL_t R2, DUAL_t R3, DUAL_t C)
+{
+	return( DUAL_mul( RESISTOR_ER3P_AD(R1,R2,R3), C ) );
+}
+
+
+/*
+ * RC_1R1C_BRUTE(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R, C )
  *
  * Description:
  *
@@ -138,7 +208,7 @@ float RC_TC_3RP1C(float R1, float R2, float R3, float C)
  *
  */
 
-void RC_1R1C( float tau,
+void RC_1R1C_BRUTE( float tau,
 			  EIA_standard RESISTOR_EIA_std,
 			  EIA_standard CAPACITOR_EIA_std,
 			  float R_max,
@@ -155,34 +225,21 @@ void RC_1R1C( float tau,
 	int i,j, R_limit, C_limit;
 	int condition_1, condition_2;
 
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RC_1R1C, tau );
+
 	//	Select resistor and capacitor standard sets.
 
-	switch(RESISTOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; break;
-	}
-
-	switch(CAPACITOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; break;
-	}
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
 
 	//	Set search limits and error bounds.
 
-	R_limit = RESISTOR_MAX_POWER * RESISTOR_EIA_std;
-	C_limit = CAPACITOR_POWER_RANGE * CAPACITOR_EIA_std;
+	R_limit = RESISTOR_getSize(RESISTOR_EIA_std);
+	C_limit = CAPACITOR_getSize(CAPACITOR_EIA_std);
+
+	error_min = INFINITY;
 
-	error_min = 10.0f * R_set[R_limit-1] * C_set[C_limit-1];
+	INSTRUMENT_SETUP(call);
 
 	//	Start search.
 
@@ -202,20 +259,26 @@ void RC_1R1C( float tau,
 
 				if( error < 0.0f ) error = -error;
 
+				INSTRUMENT_CANDIDATE(call);
+
 				if( error < error_min )
 				{
+					INSTRUMENT_IMPROVED(call);
 					error_min = error;
 					*R = R_set[i];
 					*C = C_set[j];
 				}
 			}
+			else INSTRUMENT_PRUNED(call);
 		}
 	}
+
+	INSTRUMENT_END(call);
 }
 
 
 /*
- * RC_2RS1C(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, C )
+ * RC_2RS1C_BRUTE(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, C )
  *
  * Description:
  *
@@ -234,7 +297,7 @@ void RC_1R1C( float tau,
  *
  */
 
-void RC_2RS1C( float tau,
+void RC_2RS1C_BRUTE( float tau,
 			  EIA_standard RESISTOR_EIA_std,
 			  EIA_standard CAPACITOR_EIA_std,
 			  float R_max,
@@ -251,34 +314,21 @@ void RC_2RS1C( float tau,
 	int i, j, k, R_limit, C_limit;
 	int condition_1, condition_2, condition_3;
 
-	//	Select resistor and capacitor standard sets.
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RC_2RS1C, tau );
 
-	switch(RESISTOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; break;
-	}
+	//	Select resistor and capacitor standard sets.
 
-	switch(CAPACITOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; break;
-	}
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
 
 	//	Set search limits and error bounds.
 
-	R_limit = RESISTOR_MAX_POWER * RESISTOR_EIA_std;
-	C_limit = CAPACITOR_POWER_RANGE * CAPACITOR_EIA_std;
+	R_limit = RESISTOR_getSize(RESISTOR_EIA_std);
+	C_limit = CAPACITOR_getSize(CAPACITOR_EIA_std);
+
+	error_min = INFINITY;
 
-	error_min = 10.0f * R_set[R_limit-1] * C_set[C_limit-1];
+	INSTRUMENT_SETUP(call);
 
 	//	Start search.
 
@@ -298,22 +348,28 @@ void RC_2RS1C( float tau,
 
 					if( error < 0.0f ) error = -error;
 
+					INSTRUMENT_CANDIDATE(call);
+
 					if( error < error_min )
 					{
+						INSTRUMENT_IMPROVED(call);
 						error_min = error;
 						*R1 = R_set[i];
 						*R2 = R_set[j];
 						*C  = C_set[k];
 					}
 				}
+				else INSTRUMENT_PRUNED(call);
 			}
 		}
 	}
+
+	INSTRUMENT_END(call);
 }
 
 
 /*
- * RC_2RP1C(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, C )
+ * RC_2RP1C_BRUTE(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, C )
  *
  * Description:
  *
@@ -332,7 +388,7 @@ void RC_2RS1C( float tau,
  *
  */
 
-void RC_2RP1C( float tau,
+void RC_2RP1C_BRUTE( float tau,
 			  EIA_standard RESISTOR_EIA_std,
 			  EIA_standard CAPACITOR_EIA_std,
 			  float R_max,
@@ -349,34 +405,21 @@ void RC_2RP1C( float tau,
 	int i, j, k, R_limit, C_limit;
 	int condition_1, condition_2, condition_3;
 
-	//	Select resistor and capacitor standard sets.
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RC_2RP1C, tau );
 
-	switch(RESISTOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; break;
-	}
+	//	Select resistor and capacitor standard sets.
 
-	switch(CAPACITOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; break;
-	}
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
 
 	//	Set search limits and error bounds.
 
-	R_limit = RESISTOR_MAX_POWER * RESISTOR_EIA_std;
-	C_limit = CAPACITOR_POWER_RANGE * CAPACITOR_EIA_std;
+	R_limit = RESISTOR_getSize(RESISTOR_EIA_std);
+	C_limit = CAPACITOR_getSize(CAPACITOR_EIA_std);
 
-	error_min = 10.0f * R_set[R_limit-1] * C_set[C_limit-1];
+	error_min = INFINITY;
+
+	INSTRUMENT_SETUP(call);
 
 	//	Start search.
 
@@ -396,23 +439,29 @@ void RC_2RP1C( float tau,
 
 					if( error < 0.0f ) error = -error;
 
+					INSTRUMENT_CANDIDATE(call);
+
 					if( error < error_min )
 					{
+						INSTRUMENT_IMPROVED(call);
 						error_min = error;
 						*R1 = R_set[i];
 						*R2 = R_set[j];
 						*C  = C_set[k];
 					}
 				}
+				else INSTRUMENT_PRUNED(call);
 			}
 		}
 	}
+
+	INSTRUMENT_END(call);
 }
 
 
 
 /*
- * RC_3RS1C(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, R3, C )
+ * RC_3RS1C_BRUTE(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, R3, C )
  *
  * Description:
  *
@@ -431,7 +480,7 @@ void RC_2RP1C( float tau,
  *
  */
 
-void RC_3RS1C( float tau,
+void RC_3RS1C_BRUTE( float tau,
 			  EIA_standard RESISTOR_EIA_std,
 			  EIA_standard CAPACITOR_EIA_std,
 			  float R_max,
@@ -448,34 +497,21 @@ void RC_3RS1C( float tau,
 	int i, j, k, m, R_limit, C_limit;
 	int condition_1, condition_2, condition_3, condition_4;
 
-	//	Select resistor and capacitor standard sets.
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RC_3RS1C, tau );
 
-	switch(RESISTOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; break;
-	}
+	//	Select resistor and capacitor standard sets.
 
-	switch(CAPACITOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; break;
-	}
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
 
 	//	Set search limits and error bounds.
 
-	R_limit = RESISTOR_MAX_POWER * RESISTOR_EIA_std;
-	C_limit = CAPACITOR_POWER_RANGE * CAPACITOR_EIA_std;
+	R_limit = RESISTOR_getSize(RESISTOR_EIA_std);
+	C_limit = CAPACITOR_getSize(CAPACITOR_EIA_std);
+
+	error_min = INFINITY;
 
-	error_min = 10.0f * R_set[R_limit-1] * C_set[C_limit-1];
+	INSTRUMENT_SETUP(call);
 
 	//	Start search.
 
@@ -498,8 +534,11 @@ void RC_3RS1C( float tau,
 
 						if( error < 0.0f ) error = -error;
 
+						INSTRUMENT_CANDIDATE(call);
+
 						if( error < error_min )
 						{
+							INSTRUMENT_IMPROVED(call);
 							error_min = error;
 							*R1 = R_set[i];
 							*R2 = R_set[j];
@@ -507,16 +546,19 @@ void RC_3RS1C( float tau,
 							*C  = C_set[m];
 						}
 					}
+					else INSTRUMENT_PRUNED(call);
 				}
 			}
 		}
 	}
+
+	INSTRUMENT_END(call);
 }
 
 
 
 /*
- * RC_3RP1C(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, R3, C )
+ * RC_3RP1C_BRUTE(tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, R3, C )
  *
  * Description:
  *
@@ -535,7 +577,7 @@ void RC_3RS1C( float tau,
  *
  */
 
-void RC_3RP1C( float tau,
+void RC_3RP1C_BRUTE( float tau,
 			  EIA_standard RESISTOR_EIA_std,
 			  EIA_standard CAPACITOR_EIA_std,
 			  float R_max,
@@ -552,34 +594,21 @@ void RC_3RP1C( float tau,
 	int i, j, k, m, R_limit, C_limit;
 	int condition_1, condition_2, condition_3, condition_4;
 
-	//	Select resistor and capacitor standard sets.
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RC_3RP1C, tau );
 
-	switch(RESISTOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; break;
-	}
+	//	Select resistor and capacitor standard sets.
 
-	switch(CAPACITOR_EIA_std)
-	{
-		case(EIA_STANDARD_E3):{ C_set = CAPACITOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ C_set = CAPACITOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ C_set = CAPACITOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ C_set = CAPACITOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ C_set = CAPACITOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ C_set = CAPACITOR_E96; }; break;
-	}
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
 
 	//	Set search limits and error bounds.
 
-	R_limit = RESISTOR_MAX_POWER * RESISTOR_EIA_std;
-	C_limit = CAPACITOR_POWER_RANGE * CAPACITOR_EIA_std;
+	R_limit = RESISTOR_getSize(RESISTOR_EIA_std);
+	C_limit = CAPACITOR_getSize(CAPACITOR_EIA_std);
+
+	error_min = INFINITY;
 
-	error_min = 10.0f * R_set[R_limit-1] * C_set[C_limit-1];
+	INSTRUMENT_SETUP(call);
 
 	//	Start search.
 
@@ -602,8 +631,11 @@ void RC_3RP1C( float tau,
 
 						if( error < 0.0f ) error = -error;
 
+						INSTRUMENT_CANDIDATE(call);
+
 						if( error < error_min )
 						{
+							INSTRUMENT_IMPROVED(call);
 							error_min = error;
 							*R1 = R_set[i];
 							*R2 = R_set[j];
@@ -611,11 +643,60 @@ void RC_3RP1C( float tau,
 							*C  = C_set[m];
 						}
 					}
+					else INSTRUMENT_PRUNED(call);
 				}
 			}
 		}
 	}
+
+	INSTRUMENT_END(call);
+}
+
+/*****			Selectors			*****/
+
+void RC_1R1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			 float R_max, float R_min, float C_max, float C_min, float* R, float* C)
+{
+	float* part[2] = { R, C };
+
+	if( SELECTOR_planner == NULL ) RC_1R1C_BRUTE( tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R, C );
+	else SELECTOR_planner( SEARCH_RC_1R1C, tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, part );
+}
+
+void RC_2RS1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			  float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* C)
+{
+	float* part[3] = { R1, R2, C };
+
+	if( SELECTOR_planner == NULL ) RC_2RS1C_BRUTE( tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, C );
+	else SELECTOR_planner( SEARCH_RC_2RS1C, tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, part );
 }
 
+void RC_2RP1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			  float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* C)
+{
+	float* part[3] = { R1, R2, C };
+
+	if( SELECTOR_planner == NULL ) RC_2RP1C_BRUTE( tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, C );
+	else SELECTOR_planner( SEARCH_RC_2RP1C, tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, part );
+}
+
+void RC_3RS1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			  float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* R3, float* C)
+{
+	float* part[4] = { R1, R2, R3, C };
+
+	if( SELECTOR_planner == NULL ) RC_3RS1C_BRUTE( tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, R3, C );
+	else SELECTOR_planner( SEARCH_RC_3RS1C, tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, part );
+}
+
+void RC_3RP1C(float tau, EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+			  float R_max, float R_min, float C_max, float C_min, float* R1, float* R2, float* R3, float* C)
+{
+	float* part[4] = { R1, R2, R3, C };
+
+	if( SELECTOR_planner == NULL ) RC_3RP1C_BRUTE( tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, R1, R2, R3, C );
+	else SELECTOR_planner( SEARCH_RC_3RP1C, tau, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min, part );
+}
 
 #endif /* PASSIVE_RC_H_ */
@@ -2,31 +2,62 @@
 #ifndef PASSIVE_RESISTOR_H_
 #define PASSIVE_RESISTOR_H_
 
+#include "INSTRUMENT.h"
+
 #include <math.h>
 #include "EIA.h"
+#include "SELECTOR.h"
 #include "helper_functions.h"
+#include "DUAL.h"
+
+//	Default decades of the standard resistors, from 1 to 9.76M. SYNTHESIS_setRange() sets
+//	others.
 
+#define RESISTOR_MIN_POWER		0
 #define RESISTOR_MAX_POWER		6
 
-float RESISTOR_E3[ 3 * ( RESISTOR_MAX_POWER + 1 ) ];
-float RESISTOR_E6[ 6 * ( RESISTOR_MAX_POWER + 1 ) ];
-float RESISTOR_E12[ 12 * ( RESISTOR_MAX_POWER + 1 ) ];
-float RESISTOR_E24[ 24 * ( RESISTOR_MAX_POWER + 1 ) ];
-float RESISTOR_E48[ 48 * ( RESISTOR_MAX_POWER + 1 ) ];
-float RESISTOR_E96[ 96 * ( RESISTOR_MAX_POWER + 1 ) ];
+EIA_range RESISTOR_range = { RESISTOR_MIN_POWER, RESISTOR_MAX_POWER, { NULL } };
 
 /******	Function declarations *****/
 
 void RESISTOR_init();
+float* RESISTOR_getSet(EIA_standard RESISTOR_EIA_standard);
+int RESISTOR_getSize(EIA_standard RESISTOR_EIA_standard);
 
 float RESISTOR_ER2S(float R1, float R2);
 float RESISTOR_ER2P(float R1, float R2);
 float RESISTOR_ER3S(float R1, float R2, float R3);
 float RESISTOR_ER3P(float R1, float R2, float R3);
 
+DUAL_t RESISTOR_ER2S_AD(DUAL_t R1, DUAL_t R2);
+DUAL_t RESISTOR_ER2P_AD(DUAL_t R1, DUAL_t R2);
+DUAL_t RESISTOR_ER3S_AD(DUAL_t R1, DUAL_t R2, DUAL_t R3);
+DUAL_t RESISTOR_ER3P_AD(DUAL_t R1, DUAL_t R2, DUAL_t R3);
+
+//	Selectors, which run the brute force loops below, or the query planner when PLANNER.h is
+//	included (see SELECTOR.h).
+
 float RESISTOR_1R(float R,EIA_standard RESISTOR_EIA_standard);
 void RESISTOR_2RS(float R,EIA_standard RESISTOR_EIA_STANDARD, float* R1, float* R2);
 void RESISTOR_2RP(float R,EIA_standard RESISTOR_EIA_STANDARD, float* R1, float* R2);
+void RESISTOR_3RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3);
+void RESISTOR_3RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3);
+void RESISTOR_RATIO_1R(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min, float* R1, float* R2);
+void RESISTOR_RATIO_2RS(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min,
+						float* R1_A, float* R1_B, float* R2_A, float* R2_B);
+void RESISTOR_RATIO_2RP(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min,
+						float* R1_A, float* R1_B, float* R2_A, float* R2_B);
+
+float RESISTOR_1R_BRUTE(float R,EIA_standard RESISTOR_EIA_standard);
+void RESISTOR_2RS_BRUTE(float R,EIA_standard RESISTOR_EIA_STANDARD, float* R1, float* R2);
+void RESISTOR_2RP_BRUTE(float R,EIA_standard RESISTOR_EIA_STANDARD, float* R1, float* R2);
+void RESISTOR_3RS_BRUTE(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3);
+void RESISTOR_3RP_BRUTE(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3);
+void RESISTOR_RATIO_1R_BRUTE(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min, float* R1, float* R2);
+void RESISTOR_RATIO_2RS_BRUTE(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min,
+							  float* R1_A, float* R1_B, float* R2_A, float* R2_B);
+void RESISTOR_RATIO_2RP_BRUTE(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min,
+							  float* R1_A, float* R1_B, float* R2_A, float* R2_B);
 
 float RESISTOR_1R_SD(float R, float T);
 
@@ -34,49 +65,40 @@ float RESISTOR_1R_SD(float R, float T);
 
 /*****
  *
- * RESISTOR_init() : Initializes the standard resistor values.
+ * RESISTOR_init() : Builds the standard resistor values of every series ahead of their
+ * first use, which is otherwise when a selector needs them.
  *
  *****/
 
 void RESISTOR_init()
 {
-	int i;
-	int j;
-
-	/*	Get standard resistor values. */
-
-	for( i = 0 ; i <= RESISTOR_MAX_POWER ; i++ )
-	{
-		for( j = 0 ; j < 3 ; j++ )
-		{
-			RESISTOR_E3[ 3*i + j ] = EIA_STANDARD_E3_SET[j] * pow( 10.0f, (float)i );
-		}
+	int k;
 
-		for( j = 0 ; j < 6 ; j++ )
-		{
-			RESISTOR_E6[ 6*i + j ] = EIA_STANDARD_E6_SET[j] * pow( 10.0f, (float)i );
-		}
+	for( k = 0 ; k < EIA_SERIES ; k++ ) if( EIA_isStandard( EIA_getStandard(k) ) ) RESISTOR_getSet( EIA_getStandard(k) );
+}
 
-		for( j = 0 ; j < 12 ; j++ )
-		{
-			RESISTOR_E12[ 12*i + j ] = EIA_STANDARD_E12_SET[j] * pow( 10.0f, (float)i );
-		}
+/*****
+ *
+ * RESISTOR_getSet(RESISTOR_EIA_standard)
+ *
+ * DESCRIPTION:
+ *
+ * Returns the table of standard resistor values for the given EIA standard, over the
+ * decades of RESISTOR_range, building it on first use. The table is sorted in ascending
+ * order and holds RESISTOR_getSize(RESISTOR_EIA_standard) values.
+ *
+ *****/
 
-		for( j = 0 ; j < 24 ; j++ )
-		{
-			RESISTOR_E24[ 24*i + j ] = EIA_STANDARD_E24_SET[j] * pow( 10.0f, (float)i );
-		}
+float* RESISTOR_getSet(EIA_standard RESISTOR_EIA_standard)
+{
+	return( EIA_getSet( &RESISTOR_range, RESISTOR_EIA_standard ) );
+}
 
-		for( j = 0 ; j < 48 ; j++ )
-		{
-			RESISTOR_E48[ 48*i + j ] = EIA_STANDARD_E48_SET[j] * pow( 10.0f, (float)i );
-		}
+/*	Returns the number of standard resistor values of an EIA standard. */
 
-		for( j = 0 ; j < 96 ; j++ )
-		{
-			RESISTOR_E96[ 96*i + j ] = EIA_STANDARD_E96_SET[j] * pow( 10.0f, (float)i );
-		}
-	}
+int RESISTOR_getSize(EIA_standard RESISTOR_EIA_standard)
+{
+	return( EIA_getSize( &RESISTOR_range, RESISTOR_EIA_standard ) );
 }
 
 /*
@@ -141,7 +163,39 @@ float RESISTOR_ER3P(float R1, float R2, float R3)
 
 /*
  *
- * RESISTOR_1R(R, RESISTOR_EIA_standard)
+ * RESISTOR_ER2S_AD(R1,R2), RESISTOR_ER2P_AD(R1,R2), RESISTOR_ER3S_AD(R1,R2,R3), RESISTOR_ER3P_AD(R1,R2,R3)
+ *
+ * DESCRIPTION:
+ *
+ * Dual number versions of the equivalent resistance functions above. They return the
+ * equivalent resistance together with its partial derivatives with respect to the input
+ * variables of R1, R2 and R3 in a single evaluation.
+ *
+ */
+
+DUAL_t RESISTOR_ER2S_AD(DUAL_t R1, DUAL_t R2)
+{
+	return( DUAL_add( R1, R2 ) );
+}
+
+DUAL_t RESISTOR_ER2P_AD(DUAL_t R1, DUAL_t R2)
+{
+	return( DUAL_div( DUAL_mul( R1, R2 ), DUAL_add( R1, R2 ) ) );
+}
+
+DUAL_t RESISTOR_ER3S_AD(DUAL_t R1, DUAL_t R2, DUAL_t R3)
+{
+	return( DUAL_add( DUAL_add( R1, R2 ), R3 ) );
+}
+
+DUAL_t RESISTOR_ER3P_AD(DUAL_t R1, DUAL_t R2, DUAL_t R3)
+{
+	return( DUAL_inv( DUAL_add( DUAL_add( DUAL_inv(R1), DUAL_inv(R2) ), DUAL_inv(R3) ) ) );
+}
+
+/*
+ *
+ * RESISTOR_1R_BRUTE(R, RESISTOR_EIA_standard)
  *
  * DESCRIPTION:
  *
@@ -154,33 +208,35 @@ float RESISTOR_ER3P(float R1, float R2, float R3)
  *
  */
 
-float RESISTOR_1R(float R, EIA_standard RESISTOR_EIA_standard)
+float RESISTOR_1R_BRUTE(float R, EIA_standard RESISTOR_EIA_standard)
 {
 	float error;
 	float R_current;
-	float R_optimal;
+	float R_optimal = NAN;
 	float* R_set;
 	float error_min;
 
 	int i;
 
-	error_min = pow( 10.0f, (float)RESISTOR_MAX_POWER + 1.0f );
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RESISTOR_1R, R );
+
+	error_min = INFINITY;
 
 	//	Choose resistor set from where to select.
 
-	switch(RESISTOR_EIA_standard)
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+
+	if( R_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; 	break;
+		INSTRUMENT_END(call);
+		return(NAN);
 	}
 
+	INSTRUMENT_SETUP(call);
+
 	//	Start search.
 
-	for( i = 0 ; i < RESISTOR_EIA_standard*RESISTOR_MAX_POWER ; i++ )
+	for( i = 0 ; i < RESISTOR_getSize(RESISTOR_EIA_standard) ; i++ )
 	{
 		R_current = R_set[i];
 
@@ -188,19 +244,24 @@ float RESISTOR_1R(float R, EIA_standard RESISTOR_EIA_standard)
 
 		if( error < 0.0f ) error = -error;
 
+		INSTRUMENT_CANDIDATE(call);
+
 		if( error < error_min )
 		{
+			INSTRUMENT_IMPROVED(call);
 			error_min = error;
 			R_optimal = R_current;
 		}
 	}
 
+	INSTRUMENT_END(call);
+
 	return(R_optimal);
 }
 
 /*****
  *
- * RESISTOR_2RS(R,RESISTOR_EIA_standard, R1, R2)
+ * RESISTOR_2RS_BRUTE(R,RESISTOR_EIA_standard, R1, R2)
  *
  * DESCRIPTION:
  *
@@ -214,32 +275,35 @@ float RESISTOR_1R(float R, EIA_standard RESISTOR_EIA_standard)
  *
  *****/
 
-void RESISTOR_2RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2 )
+void RESISTOR_2RS_BRUTE(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2 )
 {
 	float error;
 	float error_min;
 	float* R_set;
-	float R1_optimal;
-	float R2_optimal;
+	float R1_optimal = NAN;
+	float R2_optimal = NAN;
 	float R_series;
 
 	int i,j;
 	int limit;
 
-	limit = RESISTOR_MAX_POWER*RESISTOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RESISTOR_2RS, R );
+
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
+
+	error_min = INFINITY;
 
-	error_min = pow( 10.0f, (float)( RESISTOR_MAX_POWER + 1 ) );
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
 
-	switch(RESISTOR_EIA_standard)
+	if( R_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; 	break;
+		*R1 = NAN;
+		*R2 = NAN;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -253,8 +317,11 @@ void RESISTOR_2RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
 				error = -error;
 			}
 
+			INSTRUMENT_CANDIDATE(call);
+
 			if( error < error_min )
 			{
+				INSTRUMENT_IMPROVED(call);
 				error_min = error;
 				R1_optimal = R_set[i];
 				R2_optimal = R_set[j];
@@ -264,11 +331,13 @@ void RESISTOR_2RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
 
 	*R1 = R1_optimal;
 	*R2 = R2_optimal;
+
+	INSTRUMENT_END(call);
 }
 
 /*****
  *
- * RESISTOR_2RP(R,RESISTOR_EIA_standard, R1, R2)
+ * RESISTOR_2RP_BRUTE(R,RESISTOR_EIA_standard, R1, R2)
  *
  * DESCRIPTION:
  *
@@ -282,32 +351,35 @@ void RESISTOR_2RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
  *
  *****/
 
-void RESISTOR_2RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2 )
+void RESISTOR_2RP_BRUTE(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2 )
 {
 	float error;
 	float error_min;
 	float* R_set;
-	float R1_optimal;
-	float R2_optimal;
+	float R1_optimal = NAN;
+	float R2_optimal = NAN;
 	float R_parallel;
 
 	int i,j;
 	int limit;
 
-	limit = RESISTOR_MAX_POWER*RESISTOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RESISTOR_2RP, R );
+
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
+
+	error_min = INFINITY;
 
-	error_min = pow( 10.0f, (float)( RESISTOR_MAX_POWER + 1 ) );
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
 
-	switch(RESISTOR_EIA_standard)
+	if( R_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; 	break;
+		*R1 = NAN;
+		*R2 = NAN;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -321,8 +393,11 @@ void RESISTOR_2RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
 				error = -error;
 			}
 
+			INSTRUMENT_CANDIDATE(call);
+
 			if( error < error_min )
 			{
+				INSTRUMENT_IMPROVED(call);
 				error_min = error;
 				R1_optimal = R_set[i];
 				R2_optimal = R_set[j];
@@ -332,12 +407,14 @@ void RESISTOR_2RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
 
 	*R1 = R1_optimal;
 	*R2 = R2_optimal;
+
+	INSTRUMENT_END(call);
 }
 
 
 /*****
  *
- * RESISTOR_3RS(R,RESISTOR_EIA_standard, R1, R2, R3)
+ * RESISTOR_3RS_BRUTE(R,RESISTOR_EIA_standard, R1, R2, R3)
  *
  * DESCRIPTION:
  *
@@ -352,33 +429,37 @@ void RESISTOR_2RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
  *
  *****/
 
-void RESISTOR_3RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3)
+void RESISTOR_3RS_BRUTE(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3)
 {
 	float error;
 	float error_min;
 	float* R_set;
-	float R1_optimal;
-	float R2_optimal;
-	float R3_optimal;
+	float R1_optimal = NAN;
+	float R2_optimal = NAN;
+	float R3_optimal = NAN;
 	float R_series;
 
 	int i,j,k;
 	int limit;
 
-	limit = RESISTOR_MAX_POWER*RESISTOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RESISTOR_3RS, R );
+
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
 
-	error_min = pow( 10.0f, (float)( RESISTOR_MAX_POWER + 1 ) );
+	error_min = INFINITY;
 
-	switch(RESISTOR_EIA_standard)
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+
+	if( R_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; 	break;
+		*R1 = NAN;
+		*R2 = NAN;
+		*R3 = NAN;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -394,8 +475,11 @@ void RESISTOR_3RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
 					error = -error;
 				}
 
+				INSTRUMENT_CANDIDATE(call);
+
 				if( error < error_min )
 				{
+					INSTRUMENT_IMPROVED(call);
 					error_min = error;
 					R1_optimal = R_set[i];
 					R2_optimal = R_set[j];
@@ -408,12 +492,14 @@ void RESISTOR_3RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
 	*R1 = R1_optimal;
 	*R2 = R2_optimal;
 	*R3 = R3_optimal;
+
+	INSTRUMENT_END(call);
 }
 
 
 /*****
  *
- * RESISTOR_3RP(R,RESISTOR_EIA_standard, R1, R2, R3)
+ * RESISTOR_3RP_BRUTE(R,RESISTOR_EIA_standard, R1, R2, R3)
  *
  * DESCRIPTION:
  *
@@ -428,33 +514,37 @@ void RESISTOR_3RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
  *
  *****/
 
-void RESISTOR_3RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3)
+void RESISTOR_3RP_BRUTE(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3)
 {
 	float error;
 	float error_min;
 	float* R_set;
-	float R1_optimal;
-	float R2_optimal;
-	float R3_optimal;
+	float R1_optimal = NAN;
+	float R2_optimal = NAN;
+	float R3_optimal = NAN;
 	float R_parallel;
 
 	int i,j,k;
 	int limit;
 
-	limit = RESISTOR_MAX_POWER*RESISTOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RESISTOR_3RP, R );
 
-	error_min = pow( 10.0f, (float)( RESISTOR_MAX_POWER + 1 ) );
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
 
-	switch(RESISTOR_EIA_standard)
+	error_min = INFINITY;
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+
+	if( R_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; 	break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; 	break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; 	break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; 	break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; 	break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; 	break;
+		*R1 = NAN;
+		*R2 = NAN;
+		*R3 = NAN;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -470,8 +560,11 @@ void RESISTOR_3RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
 					error = -error;
 				}
 
+				INSTRUMENT_CANDIDATE(call);
+
 				if( error < error_min )
 				{
+					INSTRUMENT_IMPROVED(call);
 					error_min = error;
 					R1_optimal = R_set[i];
 					R2_optimal = R_set[j];
@@ -484,6 +577,8 @@ void RESISTOR_3RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float*
 	*R1 = R1_optimal;
 	*R2 = R2_optimal;
 	*R3 = R3_optimal;
+
+	INSTRUMENT_END(call);
 }
 
 /**
@@ -662,7 +757,7 @@ float RESISTOR_3RP_SD(float R1, float R2, float R3, float T)
 
 
 /*
- * 	RESISTOR_RATIO_1R(ratio, RESISTOR_EIA_standard,R_max, R_min, R1, R2)
+ * 	RESISTOR_RATIO_1R_BRUTE(ratio, RESISTOR_EIA_standard,R_max, R_min, R1, R2)
  *
  * 	Description:
  *
@@ -676,7 +771,7 @@ float RESISTOR_3RP_SD(float R1, float R2, float R3, float T)
  *
  */
 
-void RESISTOR_RATIO_1R(
+void RESISTOR_RATIO_1R_BRUTE(
 		float ratio,
 		EIA_standard RESISTOR_EIA_standard,
 		float R_max, float R_min,
@@ -688,19 +783,22 @@ void RESISTOR_RATIO_1R(
 	float* R_set;
 	float error, error_min;
 
-	error_min = pow( 10.0f, (float)RESISTOR_MAX_POWER + 1.0f );
-	limit = RESISTOR_MAX_POWER*RESISTOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RATIO_1R, ratio );
 
-	switch(RESISTOR_EIA_standard)
+	error_min = INFINITY;
+	*R1 = NAN;
+	*R2 = NAN;
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+
+	if( R_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; break;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
 
 	for( i = 0 ; i < limit ; i++ )
 	{
@@ -715,20 +813,26 @@ void RESISTOR_RATIO_1R(
 
 				if( error < 0.0f ) error = -error;
 
+				INSTRUMENT_CANDIDATE(call);
+
 				if( error < error_min )
 				{
+					INSTRUMENT_IMPROVED(call);
 					error_min = error;
 					*R1 = R_set[i];
 					*R2 = R_set[j];
 				}
 			}
+			else INSTRUMENT_PRUNED(call);
 		}
 	}
+
+	INSTRUMENT_END(call);
 }
 
 
 /*
- * RESISTOR_RATIO_2RS(ratio, RESISTOR_EIA_standard, R_max, R_min, R1_A, R1_B, R2_A, R2_B)
+ * RESISTOR_RATIO_2RS_BRUTE(ratio, RESISTOR_EIA_standard, R_max, R_min, R1_A, R1_B, R2_A, R2_B)
  *
  *	@parameter	ratio					:	Desired ratio of ( R1_A + R1_B ) to ( R2_A + R2_B ).
  *	@parameter	RESISTOR_EIA_standard	:	EIA standard from which the resistor values are to be chosen.
@@ -737,7 +841,7 @@ void RESISTOR_RATIO_1R(
  *
  */
 
-void RESISTOR_RATIO_2RS(
+void RESISTOR_RATIO_2RS_BRUTE(
 		float ratio,
 		EIA_standard RESISTOR_EIA_standard,
 		float R_max, float R_min,
@@ -754,20 +858,26 @@ void RESISTOR_RATIO_2RS(
 	int i,j,m,n;
 	int condition_1, condition_2, condition_3, condition_4;
 
-	error_min = pow( 10.0f, (float)RESISTOR_MAX_POWER + 1.0f );
-	limit = RESISTOR_MAX_POWER * RESISTOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RATIO_2RS, ratio );
 
+	error_min = INFINITY;
+	*R1_A = NAN;
+	*R1_B = NAN;
+	*R2_A = NAN;
+	*R2_B = NAN;
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
 
-	switch(RESISTOR_EIA_standard)
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+
+	if( R_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; break;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
+
 	for( i = 0 ; i < limit ; i++ )
 	{
 	for( j = 0 ; j < limit ; j++ )
@@ -790,8 +900,11 @@ void RESISTOR_RATIO_2RS(
 
 			if( error < 0.0f ) error = -error;
 
+			INSTRUMENT_CANDIDATE(call);
+
 			if( error < error_min )
 			{
+				INSTRUMENT_IMPROVED(call);
 				error_min = error;
 				*R1_A = R_set[i];
 				*R1_B = R_set[j];
@@ -799,17 +912,20 @@ void RESISTOR_RATIO_2RS(
 				*R2_B = R_set[n];
 			}
 		}
+		else INSTRUMENT_PRUNED(call);
 	}
 	}
 	}
 	}
+
+	INSTRUMENT_END(call);
 }
 
 
 
 
 /*
- * RESISTOR_RATIO_2RP(ratio, RESISTOR_EIA_standard, R_max, R_min, R1_A, R1_B, R2_A, R2_B)
+ * RESISTOR_RATIO_2RP_BRUTE(ratio, RESISTOR_EIA_standard, R_max, R_min, R1_A, R1_B, R2_A, R2_B)
  *
  *	@parameter	ratio					:	Desired ratio of ( R1_A || R1_B ) to ( R2_A || R2_B ).
  *	@parameter	RESISTOR_EIA_standard	:	EIA standard from which the resistor values are to be chosen.
@@ -818,7 +934,7 @@ void RESISTOR_RATIO_2RS(
  *
  */
 
-void RESISTOR_RATIO_2RP(
+void RESISTOR_RATIO_2RP_BRUTE(
 		float ratio,
 		EIA_standard RESISTOR_EIA_standard,
 		float R_max, float R_min,
@@ -835,20 +951,26 @@ void RESISTOR_RATIO_2RP(
 	int i,j,m,n;
 	int condition_1, condition_2, condition_3, condition_4;
 
-	error_min = pow( 10.0f, (float)RESISTOR_MAX_POWER + 1.0f );
-	limit = RESISTOR_MAX_POWER * RESISTOR_EIA_standard;
+	INSTRUMENT_BEGIN( call, INSTRUMENT_RATIO_2RP, ratio );
+
+	error_min = INFINITY;
+	*R1_A = NAN;
+	*R1_B = NAN;
+	*R2_A = NAN;
+	*R2_B = NAN;
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
 
 
-	switch(RESISTOR_EIA_standard)
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+
+	if( R_set == NULL )
 	{
-		case(EIA_STANDARD_E3):{ R_set = RESISTOR_E3; }; break;
-		case(EIA_STANDARD_E6):{ R_set = RESISTOR_E6; }; break;
-		case(EIA_STANDARD_E12):{ R_set = RESISTOR_E12; }; break;
-		case(EIA_STANDARD_E24):{ R_set = RESISTOR_E24; }; break;
-		case(EIA_STANDARD_E48):{ R_set = RESISTOR_E48; }; break;
-		case(EIA_STANDARD_E96):{ R_set = RESISTOR_E96; }; break;
+		INSTRUMENT_END(call);
+		return;
 	}
 
+	INSTRUMENT_SETUP(call);
+
 	for( i = 0 ; i < limit ; i++ )
 	{
 	for( j = 0 ; j < limit ; j++ )
@@ -871,8 +993,11 @@ void RESISTOR_RATIO_2RP(
 
 			if( error < 0.0f ) error = -error;
 
+			INSTRUMENT_CANDIDATE(call);
+
 			if( error < error_min )
 			{
+				INSTRUMENT_IMPROVED(call);
 				error_min = error;
 				*R1_A = R_set[i];
 				*R1_B = R_set[j];
@@ -880,11 +1005,85 @@ void RESISTOR_RATIO_2RP(
 				*R2_B = R_set[n];
 			}
 		}
+		else INSTRUMENT_PRUNED(call);
 	}
 	}
 	}
 	}
+
+	INSTRUMENT_END(call);
 }
 
+/*****			Selectors			*****/
+
+float RESISTOR_1R(float R, EIA_standard RESISTOR_EIA_standard)
+{
+	float R1 = NAN;
+	float* part[1] = { &R1 };
+
+	if( SELECTOR_planner == NULL ) return( RESISTOR_1R_BRUTE( R, RESISTOR_EIA_standard ) );
+
+	SELECTOR_planner( SEARCH_RESISTOR_1R, R, RESISTOR_EIA_standard, RESISTOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+
+	return(R1);
+}
+
+void RESISTOR_2RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2)
+{
+	float* part[2] = { R1, R2 };
+
+	if( SELECTOR_planner == NULL ) RESISTOR_2RS_BRUTE( R, RESISTOR_EIA_standard, R1, R2 );
+	else SELECTOR_planner( SEARCH_RESISTOR_2RS, R, RESISTOR_EIA_standard, RESISTOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void RESISTOR_2RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2)
+{
+	float* part[2] = { R1, R2 };
+
+	if( SELECTOR_planner == NULL ) RESISTOR_2RP_BRUTE( R, RESISTOR_EIA_standard, R1, R2 );
+	else SELECTOR_planner( SEARCH_RESISTOR_2RP, R, RESISTOR_EIA_standard, RESISTOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void RESISTOR_3RS(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3)
+{
+	float* part[3] = { R1, R2, R3 };
+
+	if( SELECTOR_planner == NULL ) RESISTOR_3RS_BRUTE( R, RESISTOR_EIA_standard, R1, R2, R3 );
+	else SELECTOR_planner( SEARCH_RESISTOR_3RS, R, RESISTOR_EIA_standard, RESISTOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void RESISTOR_3RP(float R, EIA_standard RESISTOR_EIA_standard, float* R1, float* R2, float* R3)
+{
+	float* part[3] = { R1, R2, R3 };
+
+	if( SELECTOR_planner == NULL ) RESISTOR_3RP_BRUTE( R, RESISTOR_EIA_standard, R1, R2, R3 );
+	else SELECTOR_planner( SEARCH_RESISTOR_3RP, R, RESISTOR_EIA_standard, RESISTOR_EIA_standard, INFINITY, 0.0f, INFINITY, 0.0f, part );
+}
+
+void RESISTOR_RATIO_1R(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min, float* R1, float* R2)
+{
+	float* part[2] = { R1, R2 };
+
+	if( SELECTOR_planner == NULL ) RESISTOR_RATIO_1R_BRUTE( ratio, RESISTOR_EIA_standard, R_max, R_min, R1, R2 );
+	else SELECTOR_planner( SEARCH_RATIO_1R, ratio, RESISTOR_EIA_standard, RESISTOR_EIA_standard, R_max, R_min, INFINITY, 0.0f, part );
+}
+
+void RESISTOR_RATIO_2RS(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min,
+						float* R1_A, float* R1_B, float* R2_A, float* R2_B)
+{
+	float* part[4] = { R1_A, R1_B, R2_A, R2_B };
+
+	if( SELECTOR_planner == NULL ) RESISTOR_RATIO_2RS_BRUTE( ratio, RESISTOR_EIA_standard, R_max, R_min, R1_A, R1_B, R2_A, R2_B );
+	else SELECTOR_planner( SEARCH_RATIO_2RS, ratio, RESISTOR_EIA_standard, RESISTOR_EIA_standard, R_max, R_min, INFINITY, 0.0f, part );
+}
+
+void RESISTOR_RATIO_2RP(float ratio, EIA_standard RESISTOR_EIA_standard, float R_max, float R_min,
+						float* R1_A, float* R1_B, float* R2_A, float* R2_B)
+{
+	float* part[4] = { R1_A, R1_B, R2_A, R2_B };
+
+	if( SELECTOR_planner == NULL ) RESISTOR_RATIO_2RP_BRUTE( ratio, RESISTOR_EIA_standard, R_max, R_min, R1_A, R1_B, R2_A, R2_B );
+	else SELECTOR_planner( SEARCH_RATIO_2RP, ratio, RESISTOR_EIA_standard, RESISTOR_EIA_standard, R_max, R_min, INFINITY, 0.0f, part );
+}
 
 #endif /* PASSIVE_RESISTOR_H_ */
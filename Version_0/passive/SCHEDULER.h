@@ -0,0 +1,627 @@
+/*
+ *
+ * 	Work-stealing scheduler for batches of searches.
+ *
+ * 	Every worker thread owns a deque of tasks. A task either runs a group of small queries
+ * 	to completion, or searches a range of outer positions of one large query. A worker takes
+ * 	tasks from the bottom of its own deque, and when a range is larger than SCHEDULER_GRAIN
+ * 	positions it pushes back its upper half before searching the lower one. Idle workers
+ * 	steal from the top of the other deques, where the oldest and largest ranges are, so one
+ * 	slow query is spread over all workers while the small ones are run in groups.
+ *
+ * 	The standard values and pair tables are built on first use. Link with -pthread.
+ *
+ */
+
+#ifndef PASSIVE_SCHEDULER_H_
+#define PASSIVE_SCHEDULER_H_
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "SEARCH.h"
+
+#define SCHEDULER_MAX_THREADS	64
+#define SCHEDULER_GRAIN			256			//	Outer positions below which work is not split.
+
+typedef struct
+{
+	int query;								//	First query of the task.
+	int count;								//	Number of queries searched to completion, or 0
+	int begin, end;							//	for a range of positions of one query.
+}SCHEDULER_task;
+
+typedef struct
+{
+	pthread_mutex_t lock;
+	SCHEDULER_task* task;
+	int capacity;
+	int top, bottom;						//	Tasks are task[top..bottom).
+}SCHEDULER_deque;
+
+//	Statistics of one worker, or of all of them.
+
+typedef struct
+{
+	long tasks;								//	Tasks run.
+	long splits;							//	Ranges split in two.
+	long steals;							//	Tasks stolen from another worker.
+	long failed_steals;						//	Steal attempts which found every other deque empty.
+	int depth;								//	Tasks queued now.
+	int max_depth;							//	Most tasks ever queued.
+}SCHEDULER_stats;
+
+struct SCHEDULER_t;
+
+typedef struct
+{
+	struct SCHEDULER_t* scheduler;
+	int id;
+}SCHEDULER_worker;
+
+typedef struct SCHEDULER_t
+{
+	pthread_t thread[SCHEDULER_MAX_THREADS];
+	SCHEDULER_worker worker[SCHEDULER_MAX_THREADS];
+	SCHEDULER_deque deque[SCHEDULER_MAX_THREADS];
+	SCHEDULER_stats stats[SCHEDULER_MAX_THREADS];
+	int N_threads;
+
+	pthread_mutex_t lock;
+	pthread_cond_t start;					//	A batch is posted, or the scheduler stops.
+	pthread_cond_t finished;				//	The batch is over.
+	pthread_cond_t work;					//	A task is pushed, or none is outstanding.
+	int generation;
+	int pushed;								//	Tasks pushed since the scheduler started.
+	int outstanding;						//	Tasks queued or running.
+	int active;								//	Workers inside the batch.
+	int shutdown;
+
+	SEARCH_query* query;					//	Batch being run.
+	SEARCH_result* result;
+	int* N_outer;
+	int* origin;							//	First position of the range each result comes from.
+}SCHEDULER_t;
+
+/*****			Function declarations			*****/
+
+SCHEDULER_t* SCHEDULER_create(int N_threads);
+void SCHEDULER_destroy(SCHEDULER_t* scheduler);
+int SCHEDULER_run(SCHEDULER_t* scheduler, SEARCH_query* query, SEARCH_result* result, int N);
+void SCHEDULER_getStats(SCHEDULER_t* scheduler, SCHEDULER_stats* total, SCHEDULER_stats* worker);
+void SCHEDULER_resetStats(SCHEDULER_t* scheduler);
+
+/*****			Function definitions			*****/
+
+/*	Pushes a task at the bottom of the deque of a worker. Returns 0 on allocation failure. */
+
+int SCHEDULER_push(SCHEDULER_t* scheduler, int id, SCHEDULER_task task)
+{
+	SCHEDULER_deque* deque = &scheduler->deque[id];
+	SCHEDULER_stats* stats = &scheduler->stats[id];
+	SCHEDULER_task* grown;
+	int depth;
+
+	pthread_mutex_lock( &deque->lock );
+
+	if( deque->bottom == deque->capacity )
+	{
+		//	Slide the tasks to the start of the array, and grow it if that is not enough.
+
+		depth = deque->bottom - deque->top;
+
+		if( depth * 2 > deque->capacity || deque->capacity == 0 )
+		{
+			grown = (SCHEDULER_task*)realloc( deque->task, sizeof(SCHEDULER_task) * ( 2 * deque->capacity + 16 ) );
+
+			if( grown == NULL )
+			{
+				pthread_mutex_unlock( &deque->lock );
+				return(0);
+			}
+
+			deque->task = grown;
+			deque->capacity = 2 * deque->capacity + 16;
+		}
+
+		memmove( deque->task, deque->task + deque->top, sizeof(SCHEDULER_task) * depth );
+		deque->top = 0;
+		deque->bottom = depth;
+	}
+
+	deque->task[ deque->bottom++ ] = task;
+
+	depth = deque->bottom - deque->top;
+	stats->depth = depth;
+
+	if( depth > stats->max_depth ) stats->max_depth = depth;
+
+	pthread_mutex_unlock( &deque->lock );
+
+	//	Wake an idle worker to steal it.
+
+	pthread_mutex_lock( &scheduler->lock );
+	scheduler->pushed++;
+	pthread_cond_signal( &scheduler->work );
+	pthread_mutex_unlock( &scheduler->lock );
+
+	return(1);
+}
+
+/*	Takes the task at the bottom (own deque) or top (stealing) of a deque. Returns 0 if empty. */
+
+int SCHEDULER_take(SCHEDULER_t* scheduler, int id, int steal, SCHEDULER_task* task)
+{
+	SCHEDULER_deque* deque = &scheduler->deque[id];
+	int taken = 0;
+
+	pthread_mutex_lock( &deque->lock );
+
+	if( deque->top < deque->bottom )
+	{
+		*task = steal ? deque->task[ deque->top++ ] : deque->task[ --deque->bottom ];
+		taken = 1;
+	}
+
+	scheduler->stats[id].depth = deque->bottom - deque->top;
+
+	pthread_mutex_unlock( &deque->lock );
+
+	return(taken);
+}
+
+/*	Keeps the result of a range in the result of its query, the earliest range winning ties. */
+
+void SCHEDULER_merge(SCHEDULER_t* scheduler, int query, int begin, SEARCH_result* range)
+{
+	SEARCH_result* result = &scheduler->result[query];
+
+	pthread_mutex_lock( &scheduler->lock );
+
+	if( range->error < result->error || ( range->error == result->error && begin < scheduler->origin[query] ) )
+	{
+		range->optimal = result->optimal;
+		*result = *range;
+		scheduler->origin[query] = begin;
+	}
+
+	pthread_mutex_unlock( &scheduler->lock );
+}
+
+/*
+ * Returns 1 if a range of a query cannot change its result: an exact match was already found
+ * in an earlier range, and ties go to the earliest range.
+ */
+
+int SCHEDULER_isDecided(SCHEDULER_t* scheduler, int query, int begin)
+{
+	int decided;
+
+	pthread_mutex_lock( &scheduler->lock );
+	decided = ( scheduler->result[query].error == 0.0f && scheduler->origin[query] < begin );
+	pthread_mutex_unlock( &scheduler->lock );
+
+	return(decided);
+}
+
+/*	Runs a task on a worker, splitting off the upper half of large ranges. */
+
+void SCHEDULER_execute(SCHEDULER_t* scheduler, int id, SCHEDULER_task task)
+{
+	SEARCH_result range;
+	SCHEDULER_task half;
+	int i;
+
+	if( task.count > 0 )
+	{
+		for( i = task.query ; i < task.query + task.count ; i++ )
+		{
+			SEARCH_run( &scheduler->query[i], &scheduler->result[i] );
+		}
+	}
+	else if( !SCHEDULER_isDecided( scheduler, task.query, task.begin ) )
+	{
+		while( task.end - task.begin > SCHEDULER_GRAIN )
+		{
+			half = task;
+			half.begin = task.begin + ( task.end - task.begin ) / 2;
+			task.end = half.begin;
+
+			pthread_mutex_lock( &scheduler->lock );
+			scheduler->outstanding++;
+			pthread_mutex_unlock( &scheduler->lock );
+
+			if( !SCHEDULER_push( scheduler, id, half ) )
+			{
+				//	No room to share the half: search it here.
+
+				pthread_mutex_lock( &scheduler->lock );
+				scheduler->outstanding--;
+				pthread_mutex_unlock( &scheduler->lock );
+
+				task.end = half.end;
+				break;
+			}
+
+			scheduler->stats[id].splits++;
+		}
+
+		SEARCH_runRange( &scheduler->query[ task.query ], NULL, task.begin, task.end, &range );
+		SCHEDULER_merge( scheduler, task.query, task.begin, &range );
+	}
+
+	scheduler->stats[id].tasks++;
+
+	pthread_mutex_lock( &scheduler->lock );
+
+	if( --scheduler->outstanding == 0 )
+	{
+		pthread_cond_broadcast( &scheduler->finished );
+		pthread_cond_broadcast( &scheduler->work );
+	}
+
+	pthread_mutex_unlock( &scheduler->lock );
+}
+
+/*	Worker thread: runs own tasks, then steals, until the batch is over. A worker which finds
+	every deque empty sleeps until a task is pushed after its search, or none is outstanding. */
+
+void* SCHEDULER_thread(void* argument)
+{
+	SCHEDULER_worker* worker = (SCHEDULER_worker*)argument;
+	SCHEDULER_t* scheduler = worker->scheduler;
+	SCHEDULER_task task;
+	unsigned int seed = 2463534242u + 97u * worker->id;
+	int generation = 0;
+	int seen, victim, i;
+
+	while(1)
+	{
+		pthread_mutex_lock( &scheduler->lock );
+
+		while( scheduler->generation == generation && !scheduler->shutdown )
+		{
+			pthread_cond_wait( &scheduler->start, &scheduler->lock );
+		}
+
+		if( scheduler->shutdown )
+		{
+			pthread_mutex_unlock( &scheduler->lock );
+			return(NULL);
+		}
+
+		generation = scheduler->generation;
+		seen = scheduler->pushed;
+		pthread_mutex_unlock( &scheduler->lock );
+
+		while(1)
+		{
+			if( SCHEDULER_take( scheduler, worker->id, 0, &task ) )
+			{
+				SCHEDULER_execute( scheduler, worker->id, task );
+				continue;
+			}
+
+			//	Steal from the other workers, starting from a random one.
+
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+
+			victim = -1;
+
+			for( i = 0 ; i < scheduler->N_threads - 1 ; i++ )
+			{
+				victim = ( worker->id + 1 + ( seed + i ) % ( scheduler->N_threads - 1 ) ) % scheduler->N_threads;
+
+				if( SCHEDULER_take( scheduler, victim, 1, &task ) ) break;
+
+				victim = -1;
+			}
+
+			if( victim >= 0 )
+			{
+				scheduler->stats[ worker->id ].steals++;
+				SCHEDULER_execute( scheduler, worker->id, task );
+				continue;
+			}
+
+			if( scheduler->N_threads > 1 ) scheduler->stats[ worker->id ].failed_steals++;
+
+			pthread_mutex_lock( &scheduler->lock );
+
+			while( scheduler->outstanding > 0 && scheduler->pushed == seen )
+			{
+				pthread_cond_wait( &scheduler->work, &scheduler->lock );
+			}
+
+			seen = scheduler->pushed;
+
+			if( scheduler->outstanding == 0 )
+			{
+				pthread_mutex_unlock( &scheduler->lock );
+				break;
+			}
+
+			pthread_mutex_unlock( &scheduler->lock );
+		}
+
+		pthread_mutex_lock( &scheduler->lock );
+
+		if( --scheduler->active == 0 ) pthread_cond_broadcast( &scheduler->finished );
+
+		pthread_mutex_unlock( &scheduler->lock );
+	}
+}
+
+/*
+ * SCHEDULER_create(N_threads)
+ *
+ * Description:
+ *
+ * Starts a scheduler with N_threads workers, one per online processor if N_threads is 0.
+ * Returns NULL on failure.
+ *
+ */
+
+SCHEDULER_t* SCHEDULER_create(int N_threads)
+{
+	SCHEDULER_t* scheduler;
+	int i;
+
+	if( N_threads <= 0 ) N_threads = (int)sysconf( _SC_NPROCESSORS_ONLN );
+	if( N_threads <= 0 ) N_threads = 1;
+	if( N_threads > SCHEDULER_MAX_THREADS ) N_threads = SCHEDULER_MAX_THREADS;
+
+	scheduler = (SCHEDULER_t*)calloc( 1, sizeof(SCHEDULER_t) );
+
+	if( scheduler == NULL ) return(NULL);
+
+	pthread_mutex_init( &scheduler->lock, NULL );
+	pthread_cond_init( &scheduler->start, NULL );
+	pthread_cond_init( &scheduler->finished, NULL );
+	pthread_cond_init( &scheduler->work, NULL );
+
+	for( i = 0 ; i < N_threads ; i++ ) pthread_mutex_init( &scheduler->deque[i].lock, NULL );
+
+	for( scheduler->N_threads = 0 ; scheduler->N_threads < N_threads ; scheduler->N_threads++ )
+	{
+		i = scheduler->N_threads;
+
+		scheduler->stats[i].depth = 0;
+
+		scheduler->worker[i].scheduler = scheduler;
+		scheduler->worker[i].id = i;
+
+		if( pthread_create( &scheduler->thread[i], NULL, SCHEDULER_thread, &scheduler->worker[i] ) != 0 ) break;
+	}
+
+	if( scheduler->N_threads == 0 )
+	{
+		free(scheduler);
+		return(NULL);
+	}
+
+	return(scheduler);
+}
+
+/*
+ * SCHEDULER_destroy(scheduler)
+ *
+ * Description:
+ *
+ * Stops the workers of a scheduler and frees it.
+ *
+ */
+
+void SCHEDULER_destroy(SCHEDULER_t* scheduler)
+{
+	int i;
+
+	pthread_mutex_lock( &scheduler->lock );
+	scheduler->shutdown = 1;
+	pthread_cond_broadcast( &scheduler->start );
+	pthread_mutex_unlock( &scheduler->lock );
+
+	for( i = 0 ; i < scheduler->N_threads ; i++ )
+	{
+		pthread_join( scheduler->thread[i], NULL );
+		pthread_mutex_destroy( &scheduler->deque[i].lock );
+		free( scheduler->deque[i].task );
+	}
+
+	pthread_mutex_destroy( &scheduler->lock );
+	pthread_cond_destroy( &scheduler->start );
+	pthread_cond_destroy( &scheduler->finished );
+	pthread_cond_destroy( &scheduler->work );
+
+	free(scheduler);
+}
+
+/*
+ * SCHEDULER_run(scheduler, query, result, N)
+ *
+ * Description:
+ *
+ * Searches a batch of N queries on the workers of a scheduler and stores the selection of
+ * query[i] in result[i], identical to the one of SEARCH_run. Blocks until the batch is over.
+ * Returns 0, or -1 if memory could not be allocated.
+ *
+ * Queries with fewer outer positions than SCHEDULER_GRAIN are grouped into tasks of about
+ * SCHEDULER_GRAIN positions, and larger ones are split among the workers.
+ *
+ */
+
+int SCHEDULER_run(SCHEDULER_t* scheduler, SEARCH_query* query, SEARCH_result* result, int N)
+{
+	SEARCH_state state;
+	SCHEDULER_task task;
+	int* N_outer;
+	int* origin;
+	int i, sum, worker, failed;
+
+	N_outer = (int*)malloc( sizeof(int) * ( N + 1 ) );
+	origin = (int*)malloc( sizeof(int) * ( N + 1 ) );
+
+	if( N_outer == NULL || origin == NULL )
+	{
+		free(N_outer);
+		free(origin);
+		return(-1);
+	}
+
+	//	Build the tables on this thread, before the workers read them.
+
+	for( i = 0 ; i < N ; i++ )
+	{
+		N_outer[i] = SEARCH_prepare( &state, &query[i] );
+		origin[i] = INT_MAX;
+
+		result[i].topology = query[i].topology;
+		result[i].N_parts = 0;
+		result[i].value = 0.0f;
+		result[i].error = INFINITY;
+		result[i].optimal = 1;
+	}
+
+	scheduler->query = query;
+	scheduler->result = result;
+	scheduler->N_outer = N_outer;
+	scheduler->origin = origin;
+	scheduler->outstanding = 0;
+
+	//	Deal the tasks to the workers in turn.
+
+	worker = 0;
+	failed = N;
+	task.query = 0;
+	task.count = 0;
+	sum = 0;
+
+	for( i = 0 ; i <= N ; i++ )
+	{
+		//	Close the group of small queries before a large one, when it is big enough, and at
+		//	the end of the batch.
+
+		if( task.count > 0 && ( i == N || N_outer[i] > SCHEDULER_GRAIN || sum >= SCHEDULER_GRAIN ) )
+		{
+			if( !SCHEDULER_push( scheduler, worker, task ) ) { failed = task.query; break; }
+
+			scheduler->outstanding++;
+			worker = ( worker + 1 ) % scheduler->N_threads;
+			task.count = 0;
+			sum = 0;
+		}
+
+		if( i == N || N_outer[i] < 0 ) continue;
+
+		if( N_outer[i] > SCHEDULER_GRAIN )
+		{
+			task.query = i;
+			task.begin = 0;
+			task.end = N_outer[i];
+
+			if( !SCHEDULER_push( scheduler, worker, task ) ) { failed = i; break; }
+
+			scheduler->outstanding++;
+			worker = ( worker + 1 ) % scheduler->N_threads;
+			continue;
+		}
+
+		if( task.count == 0 ) task.query = i;
+
+		task.count++;
+		sum += N_outer[i] + 1;
+	}
+
+	//	Out of memory: search what could not be queued on this thread.
+
+	for( i = failed ; i < N ; i++ )
+	{
+		if( N_outer[i] >= 0 ) SEARCH_run( &query[i], &result[i] );
+	}
+
+	pthread_mutex_lock( &scheduler->lock );
+
+	scheduler->active = scheduler->N_threads;
+	scheduler->generation++;
+	pthread_cond_broadcast( &scheduler->start );
+
+	while( scheduler->outstanding > 0 || scheduler->active > 0 )
+	{
+		pthread_cond_wait( &scheduler->finished, &scheduler->lock );
+	}
+
+	pthread_mutex_unlock( &scheduler->lock );
+
+	free(N_outer);
+	free(origin);
+
+	return(0);
+}
+
+/*
+ * SCHEDULER_getStats(scheduler, total, worker)
+ *
+ * Description:
+ *
+ * Stores the statistics of all workers summed in total, and those of each worker in
+ * worker[0..N_threads) if worker is not NULL. max_depth of total is the largest of the
+ * workers.
+ *
+ */
+
+void SCHEDULER_getStats(SCHEDULER_t* scheduler, SCHEDULER_stats* total, SCHEDULER_stats* worker)
+{
+	SCHEDULER_stats* stats;
+	int i;
+
+	total->tasks = 0;
+	total->splits = 0;
+	total->steals = 0;
+	total->failed_steals = 0;
+	total->depth = 0;
+	total->max_depth = 0;
+
+	for( i = 0 ; i < scheduler->N_threads ; i++ )
+	{
+		stats = &scheduler->stats[i];
+
+		if( worker != NULL ) worker[i] = *stats;
+
+		total->tasks += stats->tasks;
+		total->splits += stats->splits;
+		total->steals += stats->steals;
+		total->failed_steals += stats->failed_steals;
+		total->depth += stats->depth;
+
+		if( stats->max_depth > total->max_depth ) total->max_depth = stats->max_depth;
+	}
+}
+
+/*
+ * SCHEDULER_resetStats(scheduler)
+ *
+ * Description:
+ *
+ * Clears the statistics of a scheduler between batches.
+ *
+ */
+
+void SCHEDULER_resetStats(SCHEDULER_t* scheduler)
+{
+	int i;
+
+	for( i = 0 ; i < scheduler->N_threads ; i++ )
+	{
+		scheduler->stats[i].tasks = 0;
+		scheduler->stats[i].splits = 0;
+		scheduler->stats[i].steals = 0;
+		scheduler->stats[i].failed_steals = 0;
+		scheduler->stats[i].max_depth = scheduler->stats[i].depth;
+	}
+}
+
+#endif /* PASSIVE_SCHEDULER_H_ */
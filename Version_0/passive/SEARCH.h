@@ -0,0 +1,1165 @@
+/*
+ *
+ * 	Sorted table search engine shared by the selectors.
+ *
+ * 	The standard value tables are sorted, and the value of every topology is monotonic in
+ * 	each of its parts. A search therefore enumerates some of the parts of a candidate (the
+ * 	outer parts), solves exactly for the value the remaining ones should have, and only tries
+ * 	the two entries around it in a sorted table, found by binary search. The remaining parts
+ * 	are either a single standard value or an unordered pair of them, looked up in the sorted
+ * 	pair tables of SYNTHESIS.h. This replaces two or three nested loops of the brute force
+ * 	selectors by a logarithmic lookup.
+ *
+ * 	The outer candidates are numbered by positions, explored nearest-first: the first outer
+ * 	position holds the outer part most likely to lead to a good candidate and the next ones
+ * 	move away from it on both sides. A search can run on any range of positions, stop when a
+ * 	goal is met or a time budget is spent, and tells whether its result is proven optimal.
+ *
+ * 	Candidates are compared in the precision of the query: in float, as the brute force
+ * 	selectors do, or in double or long double, where values near 1e-12 or products of
+ * 	resistors and capacitors keep enough digits to tell close candidates apart. They are
+ * 	compared by the metric of the query: the absolute error of the brute force selectors, the
+ * 	error relative to the target, or the distance of logarithms |ln(value / target)|, which
+ * 	does not depend on the decade of the target and weighs a value twice too large as one
+ * 	twice too small. Since every metric grows with the distance to the target on each side of
+ * 	it, the two entries around the solution remain the only ones to try.
+ *
+ * 	Searches read the monotonic clock: programs which include system headers before this one
+ * 	need _POSIX_C_SOURCE 200809L.
+ *
+ */
+
+#ifndef PASSIVE_SEARCH_H_
+#define PASSIVE_SEARCH_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+
+#include "RC.h"
+#include "SYNTHESIS.h"
+
+#define SEARCH_MAX_PARTS		4
+#define SEARCH_CLOCK_PERIOD		64			//	Outer positions explored between clock reads.
+#define SEARCH_SLACK			8.0f		//	Units in the last place of a float searched around a solution.
+
+//	Whether value is within the slack of edge, so that it may be closer in a wider precision.
+
+#define SEARCH_NEAR(state, value, edge)		( (state)->slack > 0.0f && fabsf( (value) - (edge) ) <= (state)->slack * (edge) )
+
+//	Arithmetic in which values and errors of candidates are computed.
+
+typedef enum{ SEARCH_FLOAT, SEARCH_DOUBLE, SEARCH_LONG_DOUBLE } SEARCH_precision;
+
+//	Error of a candidate: |value - target|, |value - target| / target or |ln(value / target)|.
+
+typedef enum{ SEARCH_ABSOLUTE, SEARCH_RELATIVE, SEARCH_LOGARITHMIC } SEARCH_metric;
+
+//	Selection to be made. Parts are stored in the order of the arguments of the selectors.
+
+typedef struct
+{
+	SEARCH_topology topology;
+	float target;								//	Value, ratio or time constant.
+	EIA_standard R_std;
+	EIA_standard C_std;
+	float R_max, R_min;
+	float C_max, C_min;
+	SEARCH_precision precision;
+	SEARCH_metric metric;
+}SEARCH_query;
+
+//	Conditions to stop a search before it is exhausted.
+
+typedef struct
+{
+	float T;									//	Accepted error (in percentage of the target).
+	double time_budget;							//	Wall clock budget in seconds, none if 0.
+}SEARCH_control;
+
+//	Selection made.
+
+typedef struct
+{
+	SEARCH_topology topology;
+	int N_parts;								//	0 if no part lies within the bounds.
+	float part[SEARCH_MAX_PARTS];
+	double value;								//	In the precision of the query, rounded to double.
+	double error;
+	int optimal;								//	1 if no candidate is closer to the target.
+}SEARCH_result;
+
+//	Search in progress.
+
+typedef struct
+{
+	SEARCH_query* query;
+	SEARCH_result* result;
+	float* set;									//	Resistors, or capacitors for capacitor topologies.
+	int low, high;
+	float* C_set;								//	Capacitors of RC topologies.
+	int C_low, C_high;
+	SYNTHESIS_op op;
+	SYNTHESIS_table* table;						//	Pairs of set, combined with op.
+	int pair_low, pair_high;					//	Entries of the table within reach of the bounds.
+	int N_outer;
+	int N_second;								//	Second outer part of RC_3R*1C.
+	int outer_low, outer_high, pivot;			//	First outer part.
+	float part[SEARCH_MAX_PARTS];
+	float goal;
+	int stop;
+	int width;									//	Inner entries tried on each side of the solution.
+	float slack;								//	Relative distance between entries tried past the width.
+	SEARCH_result* top;							//	K best candidates, or NULL.
+	int K, N_top;
+#ifdef PASSIVE_INSTRUMENT
+	INSTRUMENT_call call;
+#endif
+}SEARCH_state;
+
+/*****			Function declarations			*****/
+
+void SEARCH_initQuery(SEARCH_query* query, SEARCH_topology topology, float target, EIA_standard std);
+void SEARCH_initControl(SEARCH_control* control);
+int SEARCH_getParts(SEARCH_topology topology);
+float SEARCH_evaluate(SEARCH_topology topology, float* part);
+double SEARCH_evaluateDouble(SEARCH_topology topology, float* part);
+long double SEARCH_evaluateLong(SEARCH_topology topology, float* part);
+double SEARCH_measure(SEARCH_query* query, float* part, double* value);
+float SEARCH_tolerance(SEARCH_query* query, float T);
+int SEARCH_prepare(SEARCH_state* state, SEARCH_query* query);
+void SEARCH_runRange(SEARCH_query* query, SEARCH_control* control, int begin, int end, SEARCH_result* result);
+void SEARCH_merge(SEARCH_result* result, SEARCH_result* other);
+int SEARCH_compare(SEARCH_result* a, SEARCH_result* b);
+int SEARCH_insertTop(SEARCH_result* top, int K, int N_top, SEARCH_result* candidate);
+int SEARCH_runTop(SEARCH_query* query, int begin, int end, int K, SEARCH_result* top);
+void SEARCH_run(SEARCH_query* query, SEARCH_result* result);
+void SEARCH_anytime(SEARCH_query* query, SEARCH_control* control, SEARCH_result* result);
+int SEARCH_autoResistor(float R, EIA_standard RESISTOR_EIA_standard, float T, SEARCH_result* result);
+int SEARCH_autoCapacitor(float C, EIA_standard CAPACITOR_EIA_standard, float T, SEARCH_result* result);
+
+/*****			Function definitions			*****/
+
+/*
+ * SEARCH_initQuery(query, topology, target, std)
+ *
+ * Description:
+ *
+ * Initializes a query with the given standard for resistors and capacitors, no bounds on
+ * the part values, float precision and the absolute error.
+ *
+ */
+
+void SEARCH_initQuery(SEARCH_query* query, SEARCH_topology topology, float target, EIA_standard std)
+{
+	query->topology = topology;
+	query->target = target;
+	query->R_std = std;
+	query->C_std = std;
+	query->R_max = INFINITY;
+	query->R_min = 0.0f;
+	query->C_max = INFINITY;
+	query->C_min = 0.0f;
+	query->precision = SEARCH_FLOAT;
+	query->metric = SEARCH_ABSOLUTE;
+}
+
+/*
+ * SEARCH_initControl(control)
+ *
+ * Description:
+ *
+ * Initializes a control which only stops a search on an exact match.
+ *
+ */
+
+void SEARCH_initControl(SEARCH_control* control)
+{
+	control->T = 0.0f;
+	control->time_budget = 0.0;
+}
+
+/*
+ * SEARCH_getParts(topology)
+ *
+ * Description:
+ *
+ * Returns the number of parts of a topology.
+ *
+ */
+
+int SEARCH_getParts(SEARCH_topology topology)
+{
+	switch(topology)
+	{
+		case(SEARCH_RESISTOR_1R):
+		case(SEARCH_CAPACITOR_1C):		return(1);
+
+		case(SEARCH_RESISTOR_2RS):
+		case(SEARCH_RESISTOR_2RP):
+		case(SEARCH_CAPACITOR_2CS):
+		case(SEARCH_CAPACITOR_2CP):
+		case(SEARCH_RATIO_1R):
+		case(SEARCH_RC_1R1C):			return(2);
+
+		case(SEARCH_RESISTOR_3RS):
+		case(SEARCH_RESISTOR_3RP):
+		case(SEARCH_CAPACITOR_3CS):
+		case(SEARCH_CAPACITOR_3CP):
+		case(SEARCH_RC_2RS1C):
+		case(SEARCH_RC_2RP1C):			return(3);
+
+		case(SEARCH_RATIO_2RS):
+		case(SEARCH_RATIO_2RP):
+		case(SEARCH_RC_3RS1C):
+		case(SEARCH_RC_3RP1C):			return(4);
+	}
+
+	return(0);
+}
+
+/*
+ * SEARCH_evaluate(topology, part)
+ *
+ * Description:
+ *
+ * Returns the value of the parts of a topology, computed by the same functions as the brute
+ * force selectors.
+ *
+ */
+
+float SEARCH_evaluate(SEARCH_topology topology, float* part)
+{
+	switch(topology)
+	{
+		case(SEARCH_RESISTOR_1R):		return( part[0] );
+		case(SEARCH_RESISTOR_2RS):		return( RESISTOR_ER2S( part[0], part[1] ) );
+		case(SEARCH_RESISTOR_2RP):		return( RESISTOR_ER2P( part[0], part[1] ) );
+		case(SEARCH_RESISTOR_3RS):		return( RESISTOR_ER3S( part[0], part[1], part[2] ) );
+		case(SEARCH_RESISTOR_3RP):		return( RESISTOR_ER3P( part[0], part[1], part[2] ) );
+		case(SEARCH_CAPACITOR_1C):		return( part[0] );
+		case(SEARCH_CAPACITOR_2CS):		return( CAPACITOR_EC2S( part[0], part[1] ) );
+		case(SEARCH_CAPACITOR_2CP):		return( CAPACITOR_EC2P( part[0], part[1] ) );
+		case(SEARCH_CAPACITOR_3CS):		return( CAPACITOR_EC3S( part[0], part[1], part[2] ) );
+		case(SEARCH_CAPACITOR_3CP):		return( CAPACITOR_EC3P( part[0], part[1], part[2] ) );
+		case(SEARCH_RATIO_1R):			return( part[0] / part[1] );
+		case(SEARCH_RATIO_2RS):			return( RESISTOR_ER2S( part[0], part[1] ) / RESISTOR_ER2S( part[2], part[3] ) );
+		case(SEARCH_RATIO_2RP):			return( RESISTOR_ER2P( part[0], part[1] ) / RESISTOR_ER2P( part[2], part[3] ) );
+		case(SEARCH_RC_1R1C):			return( RC_TC_1R1C( part[0], part[1] ) );
+		case(SEARCH_RC_2RS1C):			return( RC_TC_2RS1C( part[0], part[1], part[2] ) );
+		case(SEARCH_RC_2RP1C):			return( RC_TC_2RP1C( part[0], part[1], part[2] ) );
+		case(SEARCH_RC_3RS1C):			return( RC_TC_3RS1C( part[0], part[1], part[2], part[3] ) );
+		case(SEARCH_RC_3RP1C):			return( RC_TC_3RP1C( part[0], part[1], part[2], part[3] ) );
+	}
+
+	return(0.0f);
+}
+
+/*
+ * SEARCH_EVALUATE(type, name)
+ *
+ * Description:
+ *
+ * Defines name(topology, part), which returns the value of the parts of a topology computed
+ * in the arithmetic of type.
+ *
+ */
+
+#define SEARCH_EVALUATE(type, name)																	\
+type name(SEARCH_topology topology, float* part)														\
+{																										\
+	type p[SEARCH_MAX_PARTS];																			\
+	int i;																								\
+																										\
+	for( i = 0 ; i < SEARCH_getParts(topology) ; i++ ) p[i] = (type)part[i];							\
+																										\
+	switch(topology)																					\
+	{																									\
+		case(SEARCH_RESISTOR_1R):																		\
+		case(SEARCH_CAPACITOR_1C):		return( p[0] );													\
+		case(SEARCH_RESISTOR_2RS):																		\
+		case(SEARCH_CAPACITOR_2CP):		return( p[0] + p[1] );											\
+		case(SEARCH_RESISTOR_2RP):																		\
+		case(SEARCH_CAPACITOR_2CS):		return( ( p[0] * p[1] ) / ( p[0] + p[1] ) );					\
+		case(SEARCH_RESISTOR_3RS):																		\
+		case(SEARCH_CAPACITOR_3CP):		return( p[0] + p[1] + p[2] );									\
+		case(SEARCH_RESISTOR_3RP):																		\
+		case(SEARCH_CAPACITOR_3CS):		return( 1 / ( 1 / p[0] + 1 / p[1] + 1 / p[2] ) );				\
+		case(SEARCH_RATIO_1R):			return( p[0] / p[1] );											\
+		case(SEARCH_RATIO_2RS):			return( ( p[0] + p[1] ) / ( p[2] + p[3] ) );					\
+		case(SEARCH_RATIO_2RP):			return( ( p[0] * p[1] * ( p[2] + p[3] ) ) / ( ( p[0] + p[1] ) * p[2] * p[3] ) );	\
+		case(SEARCH_RC_1R1C):			return( p[0] * p[1] );											\
+		case(SEARCH_RC_2RS1C):			return( ( p[0] + p[1] ) * p[2] );								\
+		case(SEARCH_RC_2RP1C):			return( ( p[0] * p[1] ) / ( p[0] + p[1] ) * p[2] );				\
+		case(SEARCH_RC_3RS1C):			return( ( p[0] + p[1] + p[2] ) * p[3] );						\
+		case(SEARCH_RC_3RP1C):			return( p[3] / ( 1 / p[0] + 1 / p[1] + 1 / p[2] ) );			\
+	}																									\
+																										\
+	return(0);																							\
+}
+
+SEARCH_EVALUATE(double, SEARCH_evaluateDouble)
+SEARCH_EVALUATE(long double, SEARCH_evaluateLong)
+
+/*
+ * SEARCH_measure(query, part, value)
+ *
+ * Description:
+ *
+ * Stores in value the value of the parts of a query and returns its error in the metric of
+ * the query, both computed in the precision of the query.
+ *
+ */
+
+#define SEARCH_ERROR(metric, x, X, abs, log)															\
+	( ( (metric) == SEARCH_LOGARITHMIC ) ? abs( log( (x) / (X) ) ) :										\
+	  ( (metric) == SEARCH_RELATIVE ) ? abs( (x) - (X) ) / abs(X) : abs( (x) - (X) ) )
+
+double SEARCH_measure(SEARCH_query* query, float* part, double* value)
+{
+	long double wide;
+	float x;
+
+	switch(query->precision)
+	{
+		case(SEARCH_DOUBLE):
+		{
+			*value = SEARCH_evaluateDouble( query->topology, part );
+			return( SEARCH_ERROR( query->metric, *value, (double)query->target, fabs, log ) );
+		}
+
+		case(SEARCH_LONG_DOUBLE):
+		{
+			wide = SEARCH_evaluateLong( query->topology, part );
+			*value = (double)wide;
+			return( (double)SEARCH_ERROR( query->metric, wide, (long double)query->target, fabsl, logl ) );
+		}
+
+		default: break;
+	}
+
+	x = SEARCH_evaluate( query->topology, part );
+
+	*value = x;
+
+	return( SEARCH_ERROR( query->metric, x, query->target, fabsf, logf ) );
+}
+
+/*
+ * SEARCH_tolerance(query, T)
+ *
+ * Description:
+ *
+ * Returns the error, in the metric of a query, of a value T percent above the target.
+ *
+ */
+
+float SEARCH_tolerance(SEARCH_query* query, float T)
+{
+	switch(query->metric)
+	{
+		case(SEARCH_RELATIVE):		return( 0.01f * T );
+		case(SEARCH_LOGARITHMIC):	return( log1pf( 0.01f * T ) );
+		default:					return( 0.01f * T * fabsf( query->target ) );
+	}
+}
+
+/*	Returns a monotonic wall clock time in seconds. */
+
+double SEARCH_now()
+{
+	struct timespec now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+
+	return( (double)now.tv_sec + 1e-9 * (double)now.tv_nsec );
+}
+
+/*
+ * SEARCH_order(position, pivot, low, high)
+ *
+ * Description:
+ *
+ * Returns the index in [low, high) explored at a position when starting from pivot and
+ * alternately moving up and down: pivot, pivot - 1, pivot + 1, pivot - 2, ... Once one
+ * side is exhausted, the other one is explored in order.
+ *
+ */
+
+int SEARCH_order(int position, int pivot, int low, int high)
+{
+	int below = pivot - low;
+	int above = high - pivot;
+	int m = ( below < above ) ? below : above;
+
+	if( position < 2 * m ) return( ( position % 2 == 0 ) ? pivot + position / 2 : pivot - ( position + 1 ) / 2 );
+
+	if( above > below ) return( pivot + position - m );
+
+	return( pivot - 1 - ( position - m ) );
+}
+
+/*	Sorts a few values in increasing order. */
+
+void SEARCH_sort(float* x, int N)
+{
+	float swap;
+	int i, j;
+
+	for( i = 1 ; i < N ; i++ )
+	{
+		for( j = i ; j > 0 && x[j-1] > x[j] ; j-- )
+		{
+			swap = x[j-1];
+			x[j-1] = x[j];
+			x[j] = swap;
+		}
+	}
+}
+
+/*
+ * SEARCH_canonical(candidate, query)
+ *
+ * Description:
+ *
+ * Sorts the interchangeable parts of a candidate in increasing order and computes its value
+ * and error from them for a query, so that every selection has a single representation.
+ *
+ */
+
+void SEARCH_canonical(SEARCH_result* candidate, SEARCH_query* query)
+{
+	float* part = candidate->part;
+
+	switch(candidate->topology)
+	{
+		case(SEARCH_RATIO_1R): break;
+
+		case(SEARCH_RATIO_2RS):
+		case(SEARCH_RATIO_2RP):
+		{
+			SEARCH_sort( part, 2 );
+			SEARCH_sort( part + 2, 2 );
+		}; break;
+
+		case(SEARCH_RC_1R1C):
+		case(SEARCH_RC_2RS1C):
+		case(SEARCH_RC_2RP1C):
+		case(SEARCH_RC_3RS1C):
+		case(SEARCH_RC_3RP1C):	SEARCH_sort( part, candidate->N_parts - 1 ); break;
+
+		default:				SEARCH_sort( part, candidate->N_parts ); break;
+	}
+
+	candidate->error = SEARCH_measure( query, part, &candidate->value );
+}
+
+/*
+ * SEARCH_compare(a, b)
+ *
+ * Description:
+ *
+ * Orders selections by error, then by parts, and returns -1, 0 or 1 as a comes before, with
+ * or after b. Equal selections compare equal.
+ *
+ */
+
+int SEARCH_compare(SEARCH_result* a, SEARCH_result* b)
+{
+	int i;
+
+	if( a->error != b->error ) return( ( a->error < b->error ) ? -1 : 1 );
+	if( a->N_parts != b->N_parts ) return( ( a->N_parts < b->N_parts ) ? -1 : 1 );
+
+	for( i = 0 ; i < a->N_parts ; i++ )
+	{
+		if( a->part[i] != b->part[i] ) return( ( a->part[i] < b->part[i] ) ? -1 : 1 );
+	}
+
+	return(0);
+}
+
+/*
+ * SEARCH_insertTop(top, K, N_top, candidate)
+ *
+ * Description:
+ *
+ * Inserts a canonical candidate into the sorted list top[0..N_top) of at most K selections,
+ * unless it is already there, and returns the new length of the list.
+ *
+ */
+
+int SEARCH_insertTop(SEARCH_result* top, int K, int N_top, SEARCH_result* candidate)
+{
+	int position, order, i;
+
+	for( position = 0 ; position < N_top ; position++ )
+	{
+		order = SEARCH_compare( candidate, &top[position] );
+
+		if( order == 0 ) return(N_top);
+		if( order < 0 ) break;
+	}
+
+	if( position >= K ) return(N_top);
+
+	if( N_top < K ) N_top++;
+
+	for( i = N_top - 1 ; i > position ; i-- ) top[i] = top[i-1];
+
+	top[position] = *candidate;
+
+	return(N_top);
+}
+
+/*	Keeps the candidate in state->part if it is closer to the target than the best one. */
+
+void SEARCH_consider(SEARCH_state* state)
+{
+	SEARCH_result* result = state->result;
+	SEARCH_result candidate;
+	double value, error;
+	int i;
+
+	error = SEARCH_measure( state->query, state->part, &value );
+
+	INSTRUMENT_CANDIDATE(state->call);
+
+	if( error < result->error )
+	{
+		INSTRUMENT_IMPROVED(state->call);
+		result->error = error;
+		result->value = value;
+		result->N_parts = SEARCH_getParts( state->query->topology );
+
+		for( i = 0 ; i < result->N_parts ; i++ ) result->part[i] = state->part[i];
+
+		if( error <= state->goal ) state->stop = 1;
+	}
+
+	if( state->top != NULL )
+	{
+		candidate.topology = state->query->topology;
+		candidate.N_parts = SEARCH_getParts( candidate.topology );
+		candidate.optimal = 1;
+
+		for( i = 0 ; i < candidate.N_parts ; i++ ) candidate.part[i] = state->part[i];
+
+		SEARCH_canonical( &candidate, state->query );
+
+		state->N_top = SEARCH_insertTop( state->top, state->K, state->N_top, &candidate );
+	}
+}
+
+/*
+ * SEARCH_tryValue(state, x, slot)
+ *
+ * Description:
+ *
+ * Tries the standard values within bounds around x, state->width on each side, as part
+ * number slot of the candidate. With a slack, the values within state->slack of the last
+ * one tried are also tried.
+ *
+ */
+
+void SEARCH_tryValue(SEARCH_state* state, float x, int slot)
+{
+	float edge;
+	int position, k;
+
+	position = state->low + lower_bound( state->set + state->low, state->high - state->low, x );
+
+	for( k = position - 1, edge = x ; k >= state->low && ( k >= position - state->width || SEARCH_NEAR( state, state->set[k], edge ) ) ; k-- )
+	{
+		state->part[slot] = state->set[k];
+
+		SEARCH_consider(state);
+		edge = state->set[k];
+	}
+
+	for( k = position, edge = x ; k < state->high && ( k < position + state->width || SEARCH_NEAR( state, state->set[k], edge ) ) ; k++ )
+	{
+		state->part[slot] = state->set[k];
+
+		SEARCH_consider(state);
+		edge = state->set[k];
+	}
+}
+
+/*
+ * SEARCH_tryPair(state, x, slot)
+ *
+ * Description:
+ *
+ * Tries the pairs within bounds around x, state->width on each side, as parts number slot
+ * and slot + 1 of the candidate. Only the entries of the table between state->pair_low and
+ * state->pair_high are searched, and the pairs there with a part out of bounds are skipped.
+ * With a slack, the pairs within state->slack of the last one tried are also tried.
+ *
+ */
+
+void SEARCH_tryPair(SEARCH_state* state, float x, int slot)
+{
+	SYNTHESIS_table* table = state->table;
+	float edge;
+	int position, k, n;
+
+	position = state->pair_low + lower_bound( table->value + state->pair_low, state->pair_high - state->pair_low, x );
+
+	for( k = position - 1, n = 0, edge = x ; k >= state->pair_low && ( n < state->width || SEARCH_NEAR( state, table->value[k], edge ) ) ; k-- )
+	{
+		if( table->i[k] < state->low || table->j[k] >= state->high )
+		{
+			INSTRUMENT_PRUNED(state->call);
+			continue;
+		}
+
+		state->part[slot]     = state->set[ table->i[k] ];
+		state->part[slot + 1] = state->set[ table->j[k] ];
+
+		SEARCH_consider(state);
+		edge = table->value[k];
+		n++;
+	}
+
+	for( k = position, n = 0, edge = x ; k < state->pair_high && ( n < state->width || SEARCH_NEAR( state, table->value[k], edge ) ) ; k++ )
+	{
+		if( table->i[k] < state->low || table->j[k] >= state->high )
+		{
+			INSTRUMENT_PRUNED(state->call);
+			continue;
+		}
+
+		state->part[slot]     = state->set[ table->i[k] ];
+		state->part[slot + 1] = state->set[ table->j[k] ];
+
+		SEARCH_consider(state);
+		edge = table->value[k];
+		n++;
+	}
+}
+
+/*
+ * SEARCH_prepare(state, query)
+ *
+ * Description:
+ *
+ * Prepares the sets, bounds, pair table and outer positions of a query. Returns the number
+ * of outer positions, which is 0 if no candidate lies within the bounds, or -1 if a set or
+ * a pair table could not be allocated.
+ *
+ */
+
+int SEARCH_prepare(SEARCH_state* state, SEARCH_query* query)
+{
+	SEARCH_topology topology = query->topology;
+	NETWORK_element element = NETWORK_RESISTOR;
+	EIA_standard std = query->R_std;
+	float max = query->R_max;
+	float min = query->R_min;
+	float middle, X;
+	int N;
+
+	X = query->target;
+
+	state->query = query;
+	state->op = SYNTHESIS_ADD;
+	state->table = NULL;
+	state->N_second = 1;
+	state->outer_low = 0;
+	state->outer_high = 1;
+	state->pivot = 0;
+	state->stop = 0;
+	state->width = 1;
+	state->slack = 0.0f;
+	state->top = NULL;
+
+	//	Values rounded to float may be out of order, or equal, in a wider precision: also try
+	//	the entries within a few units in the last place of the last one tried.
+
+	if( query->precision != SEARCH_FLOAT ) state->slack = SEARCH_SLACK * FLT_EPSILON;
+
+	if( topology >= SEARCH_CAPACITOR_1C && topology <= SEARCH_CAPACITOR_3CP )
+	{
+		element = NETWORK_CAPACITOR;
+		std = query->C_std;
+		max = query->C_max;
+		min = query->C_min;
+	}
+
+	switch(topology)
+	{
+		case(SEARCH_RESISTOR_2RP):
+		case(SEARCH_RESISTOR_3RP):
+		case(SEARCH_CAPACITOR_2CS):
+		case(SEARCH_CAPACITOR_3CS):
+		case(SEARCH_RATIO_2RP):
+		case(SEARCH_RC_2RP1C):
+		case(SEARCH_RC_3RP1C):	state->op = SYNTHESIS_HARMONIC; break;
+
+		default: break;
+	}
+
+	//	Parts within bounds.
+
+	state->set = SYNTHESIS_getSet( element, std, &N );
+
+	if( state->set == NULL ) return( state->N_outer = -1 );
+
+	state->low = lower_bound( state->set, N, min );
+	state->high = upper_bound( state->set, N, max );
+
+	if( topology >= SEARCH_RC_1R1C )
+	{
+		state->C_set = SYNTHESIS_getSet( NETWORK_CAPACITOR, query->C_std, &N );
+
+		if( state->C_set == NULL ) return( state->N_outer = -1 );
+
+		state->C_low = lower_bound( state->C_set, N, query->C_min );
+		state->C_high = upper_bound( state->C_set, N, query->C_max );
+
+		if( state->C_low >= state->C_high ) return( state->N_outer = 0 );
+	}
+
+	if( state->low >= state->high ) return( state->N_outer = 0 );
+
+	if( SEARCH_getParts(topology) > 2 || topology == SEARCH_RESISTOR_2RS || topology == SEARCH_RESISTOR_2RP ||
+		topology == SEARCH_CAPACITOR_2CS || topology == SEARCH_CAPACITOR_2CP )
+	{
+		state->table = SYNTHESIS_getTable( element, std, state->op );
+
+		if( state->table == NULL ) return( state->N_outer = -1 );
+
+		//	Pairs within bounds lie between the pair of the smallest and that of the largest
+		//	value. Rounding may put a pair a few units in the last place past them.
+
+		state->pair_low = lower_bound( state->table->value, state->table->N,
+									   SYNTHESIS_combine( state->op, state->set[ state->low ], state->set[ state->low ] ) * ( 1.0f - 4.0f * FLT_EPSILON ) );
+		state->pair_high = upper_bound( state->table->value, state->table->N,
+										SYNTHESIS_combine( state->op, state->set[ state->high - 1 ], state->set[ state->high - 1 ] ) * ( 1.0f + 4.0f * FLT_EPSILON ) );
+	}
+
+	//	Range of the first outer part, and the index it starts from: the share of the target
+	//	of one of three parts, or the value bringing the other parts to the middle of their
+	//	bounds.
+
+	middle = sqrtf( state->set[ state->low ] * state->set[ state->high - 1 ] );
+
+	switch(topology)
+	{
+		case(SEARCH_RESISTOR_3RS):
+		case(SEARCH_RESISTOR_3RP):
+		case(SEARCH_CAPACITOR_3CS):
+		case(SEARCH_CAPACITOR_3CP):
+		{
+			state->outer_low = state->low;
+			state->outer_high = state->high;
+			state->pivot = state->low + lower_bound( state->set + state->low, state->high - state->low,
+													 ( state->op == SYNTHESIS_ADD ) ? X / 3.0f : 3.0f * X );
+		}; break;
+
+		case(SEARCH_RATIO_1R):
+		{
+			state->outer_low = state->low;
+			state->outer_high = state->high;
+			state->pivot = state->low + lower_bound( state->set + state->low, state->high - state->low, middle / sqrtf(X) );
+		}; break;
+
+		case(SEARCH_RATIO_2RS):
+		case(SEARCH_RATIO_2RP):
+		{
+			state->outer_low = state->pair_low;
+			state->outer_high = state->pair_high;
+			state->pivot = state->pair_low + lower_bound( state->table->value + state->pair_low, state->pair_high - state->pair_low,
+														  SYNTHESIS_combine( state->op, middle, middle ) / sqrtf(X) );
+		}; break;
+
+		case(SEARCH_RC_1R1C):
+		case(SEARCH_RC_2RS1C):
+		case(SEARCH_RC_2RP1C):
+		case(SEARCH_RC_3RS1C):
+		case(SEARCH_RC_3RP1C):
+		{
+			if( SEARCH_getParts(topology) > 2 ) middle = SYNTHESIS_combine( state->op, middle, middle );
+
+			if( SEARCH_getParts(topology) > 3 )
+			{
+				middle = SYNTHESIS_combine( state->op, middle, sqrtf( state->set[ state->low ] * state->set[ state->high - 1 ] ) );
+				state->N_second = state->high - state->low;
+			}
+
+			state->outer_low = state->C_low;
+			state->outer_high = state->C_high;
+			state->pivot = state->C_low + lower_bound( state->C_set + state->C_low, state->C_high - state->C_low, X / middle );
+		}; break;
+
+		default: break;
+	}
+
+	state->N_outer = ( state->outer_high - state->outer_low ) * state->N_second;
+
+	return( state->N_outer );
+}
+
+/*
+ * SEARCH_visit(state, position)
+ *
+ * Description:
+ *
+ * Tries the best candidates of an outer position.
+ *
+ */
+
+void SEARCH_visit(SEARCH_state* state, int position)
+{
+	SYNTHESIS_table* table = state->table;
+	float X = state->query->target;
+	int a, b;
+
+	a = SEARCH_order( position / state->N_second, state->pivot, state->outer_low, state->outer_high );
+	b = state->low + position % state->N_second;
+
+	switch(state->query->topology)
+	{
+		case(SEARCH_RESISTOR_1R):
+		case(SEARCH_CAPACITOR_1C):
+		{
+			SEARCH_tryValue( state, X, 0 );
+		}; break;
+
+		case(SEARCH_RESISTOR_2RS):
+		case(SEARCH_RESISTOR_2RP):
+		case(SEARCH_CAPACITOR_2CS):
+		case(SEARCH_CAPACITOR_2CP):
+		{
+			SEARCH_tryPair( state, X, 0 );
+		}; break;
+
+		case(SEARCH_RESISTOR_3RS):
+		case(SEARCH_RESISTOR_3RP):
+		case(SEARCH_CAPACITOR_3CS):
+		case(SEARCH_CAPACITOR_3CP):
+		{
+			state->part[2] = state->set[a];
+
+			SEARCH_tryPair( state, SYNTHESIS_solve( state->op, X, state->set[a] ), 0 );
+		}; break;
+
+		case(SEARCH_RATIO_1R):
+		{
+			state->part[1] = state->set[a];
+
+			SEARCH_tryValue( state, X * state->set[a], 0 );
+		}; break;
+
+		case(SEARCH_RATIO_2RS):
+		case(SEARCH_RATIO_2RP):
+		{
+			if( table->i[a] < state->low || table->j[a] >= state->high )
+			{
+				INSTRUMENT_PRUNED(state->call);
+				break;
+			}
+
+			state->part[2] = state->set[ table->i[a] ];
+			state->part[3] = state->set[ table->j[a] ];
+
+			SEARCH_tryPair( state, X * table->value[a], 0 );
+		}; break;
+
+		case(SEARCH_RC_1R1C):
+		{
+			state->part[1] = state->C_set[a];
+
+			SEARCH_tryValue( state, X / state->C_set[a], 0 );
+		}; break;
+
+		case(SEARCH_RC_2RS1C):
+		case(SEARCH_RC_2RP1C):
+		{
+			state->part[2] = state->C_set[a];
+
+			SEARCH_tryPair( state, X / state->C_set[a], 0 );
+		}; break;
+
+		case(SEARCH_RC_3RS1C):
+		case(SEARCH_RC_3RP1C):
+		{
+			state->part[2] = state->set[b];
+			state->part[3] = state->C_set[a];
+
+			SEARCH_tryPair( state, SYNTHESIS_solve( state->op, X / state->C_set[a], state->set[b] ), 0 );
+		}; break;
+	}
+}
+
+/*
+ * SEARCH_runRange(query, control, begin, end, result)
+ *
+ * Description:
+ *
+ * Searches the outer positions [begin, end) of a query for the candidate closest to the
+ * target. The search stops on an exact match, and when control is not NULL, as soon as the
+ * error is within control->T percent of the target or control->time_budget is spent.
+ * result->optimal is 1 if the range was exhausted or the match is exact, and
+ * result->N_parts is 0 if no candidate was found.
+ *
+ */
+
+void SEARCH_runRange(SEARCH_query* query, SEARCH_control* control, int begin, int end, SEARCH_result* result)
+{
+	SEARCH_state state;
+	double deadline = 0.0;
+	int position;
+
+	result->topology = query->topology;
+	result->N_parts = 0;
+	result->value = 0.0f;
+	result->error = INFINITY;
+	result->optimal = 0;
+
+	INSTRUMENT_START( state.call, INSTRUMENT_SEARCH + query->topology, query->target );
+
+	if( SEARCH_prepare( &state, query ) < 0 )
+	{
+		INSTRUMENT_END(state.call);
+		return;
+	}
+
+	INSTRUMENT_SETUP(state.call);
+
+	state.result = result;
+	state.goal = 0.0f;
+
+	if( control != NULL )
+	{
+		state.goal = SEARCH_tolerance( query, control->T );
+
+		if( control->time_budget > 0.0 ) deadline = SEARCH_now() + control->time_budget;
+	}
+
+	if( begin < 0 ) begin = 0;
+	if( end > state.N_outer ) end = state.N_outer;
+
+	for( position = begin ; position < end && !state.stop ; position++ )
+	{
+		if( deadline > 0.0 && ( position - begin ) % SEARCH_CLOCK_PERIOD == 0 && SEARCH_now() > deadline ) break;
+
+		SEARCH_visit( &state, position );
+	}
+
+	result->optimal = ( position >= end && !state.stop ) || result->error == 0.0f;
+
+	INSTRUMENT_END(state.call);
+}
+
+/*
+ * SEARCH_merge(result, other)
+ *
+ * Description:
+ *
+ * Keeps in result the candidate of other if it is strictly closer to the target, so that
+ * merging the results of consecutive ranges in order gives the result of the whole search.
+ * The optimal flag of result is left to the caller.
+ *
+ */
+
+void SEARCH_merge(SEARCH_result* result, SEARCH_result* other)
+{
+	int optimal = result->optimal;
+
+	if( other->error < result->error )
+	{
+		*result = *other;
+		result->optimal = optimal;
+	}
+}
+
+/*
+ * SEARCH_runTop(query, begin, end, K, top)
+ *
+ * Description:
+ *
+ * Stores in top the K selections of the outer positions [begin, end) of a query closest to
+ * the target, in the order of SEARCH_compare, with their interchangeable parts in increasing
+ * order. Returns their number, or -1 if a pair table could not be allocated. Merging the lists
+ * of any split of the positions with SEARCH_insertTop gives the list of the whole search.
+ *
+ */
+
+int SEARCH_runTop(SEARCH_query* query, int begin, int end, int K, SEARCH_result* top)
+{
+	SEARCH_state state;
+	SEARCH_result best;
+	int position;
+
+	best.error = INFINITY;
+	best.N_parts = 0;
+
+	INSTRUMENT_START( state.call, INSTRUMENT_SEARCH + query->topology, query->target );
+
+	if( SEARCH_prepare( &state, query ) < 0 )
+	{
+		INSTRUMENT_END(state.call);
+		return(-1);
+	}
+
+	INSTRUMENT_SETUP(state.call);
+
+	state.result = &best;
+	state.goal = -1.0f;
+	state.width = K;
+	state.top = top;
+	state.K = K;
+	state.N_top = 0;
+
+	if( begin < 0 ) begin = 0;
+	if( end > state.N_outer ) end = state.N_outer;
+
+	for( position = begin ; position < end ; position++ ) SEARCH_visit( &state, position );
+
+	INSTRUMENT_END(state.call);
+
+	return( state.N_top );
+}
+
+/*
+ * SEARCH_run(query, result)
+ *
+ * Description:
+ *
+ * Finds the candidate of a query closest to the target.
+ *
+ */
+
+void SEARCH_run(SEARCH_query* query, SEARCH_result* result)
+{
+	SEARCH_runRange( query, NULL, 0, INT_MAX, result );
+}
+
+/*
+ * SEARCH_anytime(query, control, result)
+ *
+ * Description:
+ *
+ * Searches a query nearest-first until the goal or the time budget of control is met, and
+ * returns the best candidate found so far. result->optimal tells whether no other candidate
+ * is closer to the target.
+ *
+ */
+
+void SEARCH_anytime(SEARCH_query* query, SEARCH_control* control, SEARCH_result* result)
+{
+	SEARCH_runRange( query, control, 0, INT_MAX, result );
+}
+
+/*
+ * SEARCH_auto(query, topology, N_topologies, T, result)
+ *
+ * Description:
+ *
+ * Runs the given topologies in order of increasing number of parts, stopping after the first
+ * number of parts whose best selection is within T percent of the target. Keeps the closest
+ * selection in result, preferring fewer parts, and returns 1 if it is within T percent.
+ *
+ */
+
+int SEARCH_auto(SEARCH_query* query, SEARCH_topology* topology, int N_topologies, float T, SEARCH_result* result)
+{
+	SEARCH_control control;
+	SEARCH_result current;
+	int i;
+
+	SEARCH_initControl( &control );
+	control.T = T;
+
+	result->N_parts = 0;
+	result->error = INFINITY;
+
+	for( i = 0 ; i < N_topologies ; i++ )
+	{
+		//	The previous number of parts is exhausted: stop if it met the tolerance.
+
+		if( i > 0 && SEARCH_getParts( topology[i] ) > SEARCH_getParts( topology[i-1] ) &&
+			result->error <= SEARCH_tolerance( query, T ) ) return(1);
+
+		query->topology = topology[i];
+
+		SEARCH_anytime( query, &control, &current );
+
+		if( current.error < result->error ) *result = current;
+	}
+
+	return( result->error <= SEARCH_tolerance( query, T ) );
+}
+
+/*
+ * SEARCH_autoResistor(R, RESISTOR_EIA_standard, T, result)
+ *
+ * Description:
+ *
+ * Selects the smallest number of standard resistors, in series or in parallel, whose
+ * equivalent resistance is within T percent of R. One resistor is tried first, then two and
+ * then three, and the larger searches are skipped as soon as the tolerance is met. If no
+ * selection of up to three resistors meets it, the closest one is returned.
+ *
+ * Returns 1 if the tolerance is met and 0 otherwise.
+ *
+ * @parameter	R						:	Target resistor value.
+ * @parameter	RESISTOR_EIA_standard	:	EIA standard from which the resistors are chosen.
+ * @parameter	T						:	Accepted error (in percentage).
+ * @parameter	result					:	Pointer to the selection made.
+ *
+ */
+
+int SEARCH_autoResistor(float R, EIA_standard RESISTOR_EIA_standard, float T, SEARCH_result* result)
+{
+	SEARCH_topology topology[5] =
+	{
+		SEARCH_RESISTOR_1R, SEARCH_RESISTOR_2RS, SEARCH_RESISTOR_2RP, SEARCH_RESISTOR_3RS, SEARCH_RESISTOR_3RP
+	};
+	SEARCH_query query;
+
+	SEARCH_initQuery( &query, SEARCH_RESISTOR_1R, R, RESISTOR_EIA_standard );
+
+	return( SEARCH_auto( &query, topology, 5, T, result ) );
+}
+
+/*
+ * SEARCH_autoCapacitor(C, CAPACITOR_EIA_standard, T, result)
+ *
+ * Description:
+ *
+ * Selects the smallest number of standard capacitors, in series or in parallel, whose
+ * equivalent capacitance is within T percent of C. One capacitor is tried first, then two and
+ * then three, and the larger searches are skipped as soon as the tolerance is met. If no
+ * selection of up to three capacitors meets it, the closest one is returned.
+ *
+ * Returns 1 if the tolerance is met and 0 otherwise.
+ *
+ * @parameter	C						:	Target capacitor value.
+ * @parameter	CAPACITOR_EIA_standard	:	EIA standard from which the capacitors are chosen.
+ * @parameter	T						:	Accepted error (in percentage).
+ * @parameter	result					:	Pointer to the selection made.
+ *
+ */
+
+int SEARCH_autoCapacitor(float C, EIA_standard CAPACITOR_EIA_standard, float T, SEARCH_result* result)
+{
+	SEARCH_topology topology[5] =
+	{
+		SEARCH_CAPACITOR_1C, SEARCH_CAPACITOR_2CS, SEARCH_CAPACITOR_2CP, SEARCH_CAPACITOR_3CS, SEARCH_CAPACITOR_3CP
+	};
+	SEARCH_query query;
+
+	SEARCH_initQuery( &query, SEARCH_CAPACITOR_1C, C, CAPACITOR_EIA_standard );
+
+	return( SEARCH_auto( &query, topology, 5, T, result ) );
+}
+
+#endif /* PASSIVE_SEARCH_H_ */
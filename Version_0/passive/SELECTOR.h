@@ -0,0 +1,38 @@
+/*
+ *
+ * 	Topologies of the selectors, and the planner they run through.
+ *
+ * 	The selectors of RESISTOR.h, CAPACITOR.h and RC.h run their brute force loops, the
+ * 	*_BRUTE functions, so that a program including only these headers needs nothing but the
+ * 	standard library. A program which includes PLANNER.h opts in to the query planner: it
+ * 	defines SELECTOR_planner, through which every selector then runs the cheapest of the brute
+ * 	force loops and the searches of SEARCH.h.
+ *
+ * 	SELECTOR_planner is declared below without an initializer, a tentative definition which
+ * 	the definition of PLANNER.h completes, whichever header is included first. Without
+ * 	PLANNER.h it is NULL.
+ *
+ */
+
+#ifndef PASSIVE_SELECTOR_H_
+#define PASSIVE_SELECTOR_H_
+
+#include "EIA.h"
+
+//	Topologies of the selectors.
+
+typedef enum
+{
+	SEARCH_RESISTOR_1R, SEARCH_RESISTOR_2RS, SEARCH_RESISTOR_2RP, SEARCH_RESISTOR_3RS, SEARCH_RESISTOR_3RP,
+	SEARCH_CAPACITOR_1C, SEARCH_CAPACITOR_2CS, SEARCH_CAPACITOR_2CP, SEARCH_CAPACITOR_3CS, SEARCH_CAPACITOR_3CP,
+	SEARCH_RATIO_1R, SEARCH_RATIO_2RS, SEARCH_RATIO_2RP,
+	SEARCH_RC_1R1C, SEARCH_RC_2RS1C, SEARCH_RC_2RP1C, SEARCH_RC_3RS1C, SEARCH_RC_3RP1C
+}SEARCH_topology;
+
+//	Runs a selection and stores its parts through the pointers of part, in the order of the
+//	arguments of the selectors, leaving them unchanged if no part lies within the bounds.
+
+void (*SELECTOR_planner)(SEARCH_topology topology, float target, EIA_standard R_std, EIA_standard C_std,
+						 float R_max, float R_min, float C_max, float C_min, float** part);
+
+#endif /* PASSIVE_SELECTOR_H_ */
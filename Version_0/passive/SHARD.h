@@ -0,0 +1,614 @@
+/*
+ *
+ * 	Sharded searches over worker processes.
+ *
+ * 	A coordinator splits the outer positions of a batch of queries into shards and sends
+ * 	them to workers over stream sockets, keeping SHARD_PIPELINE shards in flight per worker
+ * 	so that faster workers get more of them. Each worker returns the K best selections of
+ * 	its shard, and the coordinator merges them with SEARCH_insertTop. Since selections are
+ * 	totally ordered by SEARCH_compare and duplicates are dropped, the merged lists do not
+ * 	depend on how the positions were split or in which order the shards came back.
+ *
+ * 	Messages are a 12 byte header (magic, type, payload length) followed by the payload, all
+ * 	fields being 32 bit little-endian integers or IEEE 754 floats, values and errors of
+ * 	selections 64 bit doubles, and parts 16 bit EIA codes (see EIA.h), so workers may run on
+ * 	other machines behind a TCP socket: SHARD_serve() is the whole worker. SHARD_spawn()
+ * 	starts local workers with fork() over Unix socket pairs.
+ *
+ */
+
+#ifndef PASSIVE_SHARD_H_
+#define PASSIVE_SHARD_H_
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "SEARCH.h"
+
+#define SHARD_MAGIC				0x34565350u		//	"PSV4"
+#define SHARD_MAX_K				256
+#define SHARD_MAX_WORKERS		256
+#define SHARD_PIPELINE			2				//	Shards in flight per worker.
+#define SHARD_MIN_SIZE			1024			//	Outer positions below which a query is not split.
+#define SHARD_PER_WORKER		4				//	Shards per worker of a large query.
+
+#define SHARD_QUERY_SIZE		40
+#define SHARD_REQUEST_SIZE		( 20 + SHARD_QUERY_SIZE )
+#define SHARD_ENTRY_SIZE		28
+#define SHARD_REPLY_SIZE(K)		( 12 + (K) * SHARD_ENTRY_SIZE )
+
+typedef enum{ SHARD_REQUEST = 1, SHARD_REPLY = 2, SHARD_QUIT = 3 } SHARD_message;
+
+typedef struct
+{
+	int query;
+	int begin, end;
+}SHARD_t;
+
+/*****			Function declarations			*****/
+
+int SHARD_send(int fd, SHARD_message type, unsigned char* payload, int length);
+int SHARD_receive(int fd, SHARD_message* type, unsigned char* payload, int capacity);
+int SHARD_serve(int fd);
+int SHARD_spawn(int N_workers, int* fd, pid_t* pid);
+void SHARD_stop(int N_workers, int* fd, pid_t* pid);
+int SHARD_coordinate(int* fd, int N_workers, SEARCH_query* query, int N, int K, SEARCH_result* top, int* N_top);
+
+/*****			Function definitions			*****/
+
+/*	Little-endian encoding of 16, 32 and 64 bit fields. */
+
+void SHARD_putInt(unsigned char* buffer, uint32_t x)
+{
+	buffer[0] = (unsigned char)( x );
+	buffer[1] = (unsigned char)( x >> 8 );
+	buffer[2] = (unsigned char)( x >> 16 );
+	buffer[3] = (unsigned char)( x >> 24 );
+}
+
+uint32_t SHARD_getInt(unsigned char* buffer)
+{
+	return( (uint32_t)buffer[0] | ( (uint32_t)buffer[1] << 8 ) | ( (uint32_t)buffer[2] << 16 ) | ( (uint32_t)buffer[3] << 24 ) );
+}
+
+void SHARD_putFloat(unsigned char* buffer, float x)
+{
+	uint32_t bits;
+
+	memcpy( &bits, &x, 4 );
+	SHARD_putInt( buffer, bits );
+}
+
+float SHARD_getFloat(unsigned char* buffer)
+{
+	uint32_t bits = SHARD_getInt(buffer);
+	float x;
+
+	memcpy( &x, &bits, 4 );
+
+	return(x);
+}
+
+void SHARD_putDouble(unsigned char* buffer, double x)
+{
+	uint64_t bits;
+
+	memcpy( &bits, &x, 8 );
+	SHARD_putInt( buffer, (uint32_t)bits );
+	SHARD_putInt( buffer + 4, (uint32_t)( bits >> 32 ) );
+}
+
+double SHARD_getDouble(unsigned char* buffer)
+{
+	uint64_t bits = (uint64_t)SHARD_getInt(buffer) | ( (uint64_t)SHARD_getInt( buffer + 4 ) << 32 );
+	double x;
+
+	memcpy( &x, &bits, 8 );
+
+	return(x);
+}
+
+void SHARD_putShort(unsigned char* buffer, EIA_code x)
+{
+	buffer[0] = (unsigned char)( x );
+	buffer[1] = (unsigned char)( x >> 8 );
+}
+
+EIA_code SHARD_getShort(unsigned char* buffer)
+{
+	return( (EIA_code)( buffer[0] | ( buffer[1] << 8 ) ) );
+}
+
+/*	Encoding of a query in SHARD_QUERY_SIZE bytes. */
+
+void SHARD_putQuery(unsigned char* buffer, SEARCH_query* query)
+{
+	SHARD_putInt( buffer, (uint32_t)query->topology );
+	SHARD_putFloat( buffer + 4, query->target );
+	SHARD_putInt( buffer + 8, (uint32_t)query->R_std );
+	SHARD_putInt( buffer + 12, (uint32_t)query->C_std );
+	SHARD_putFloat( buffer + 16, query->R_max );
+	SHARD_putFloat( buffer + 20, query->R_min );
+	SHARD_putFloat( buffer + 24, query->C_max );
+	SHARD_putFloat( buffer + 28, query->C_min );
+	SHARD_putInt( buffer + 32, (uint32_t)query->precision );
+	SHARD_putInt( buffer + 36, (uint32_t)query->metric );
+}
+
+void SHARD_getQuery(unsigned char* buffer, SEARCH_query* query)
+{
+	query->topology = (SEARCH_topology)SHARD_getInt( buffer );
+	query->target = SHARD_getFloat( buffer + 4 );
+	query->R_std = (EIA_standard)SHARD_getInt( buffer + 8 );
+	query->C_std = (EIA_standard)SHARD_getInt( buffer + 12 );
+	query->R_max = SHARD_getFloat( buffer + 16 );
+	query->R_min = SHARD_getFloat( buffer + 20 );
+	query->C_max = SHARD_getFloat( buffer + 24 );
+	query->C_min = SHARD_getFloat( buffer + 28 );
+	query->precision = (SEARCH_precision)SHARD_getInt( buffer + 32 );
+	query->metric = (SEARCH_metric)SHARD_getInt( buffer + 36 );
+}
+
+/*	Returns 1 if a query read from the wire names a known topology, standards, precision and metric. */
+
+int SHARD_isValid(SEARCH_query* query)
+{
+	if( (int)query->topology < SEARCH_RESISTOR_1R || (int)query->topology > SEARCH_RC_3RP1C ) return(0);
+	if( (int)query->precision < SEARCH_FLOAT || (int)query->precision > SEARCH_LONG_DOUBLE ) return(0);
+	if( (int)query->metric < SEARCH_ABSOLUTE || (int)query->metric > SEARCH_LOGARITHMIC ) return(0);
+
+	return( EIA_isStandard( query->R_std ) && EIA_isStandard( query->C_std ) );
+}
+
+/*	Writes or reads exactly length bytes. Return 0, or -1 on error or end of stream. */
+
+int SHARD_write(int fd, unsigned char* buffer, int length)
+{
+	ssize_t n;
+
+	while( length > 0 )
+	{
+		n = send( fd, buffer, length, MSG_NOSIGNAL );
+
+		if( n < 0 && errno == EINTR ) continue;
+		if( n <= 0 ) return(-1);
+
+		buffer += n;
+		length -= (int)n;
+	}
+
+	return(0);
+}
+
+int SHARD_read(int fd, unsigned char* buffer, int length)
+{
+	ssize_t n;
+
+	while( length > 0 )
+	{
+		n = read( fd, buffer, length );
+
+		if( n < 0 && errno == EINTR ) continue;
+		if( n <= 0 ) return(-1);
+
+		buffer += n;
+		length -= (int)n;
+	}
+
+	return(0);
+}
+
+/*
+ * SHARD_send(fd, type, payload, length)
+ *
+ * Description:
+ *
+ * Sends a message on a socket. Returns 0, or -1 on error.
+ *
+ */
+
+int SHARD_send(int fd, SHARD_message type, unsigned char* payload, int length)
+{
+	unsigned char header[12];
+
+	SHARD_putInt( header, SHARD_MAGIC );
+	SHARD_putInt( header + 4, (uint32_t)type );
+	SHARD_putInt( header + 8, (uint32_t)length );
+
+	if( SHARD_write( fd, header, 12 ) < 0 ) return(-1);
+
+	return( SHARD_write( fd, payload, length ) );
+}
+
+/*
+ * SHARD_receive(fd, type, payload, capacity)
+ *
+ * Description:
+ *
+ * Receives a message from a socket into payload and returns its length, or -1 on error, end
+ * of stream or a malformed or too long message.
+ *
+ */
+
+int SHARD_receive(int fd, SHARD_message* type, unsigned char* payload, int capacity)
+{
+	unsigned char header[12];
+	uint32_t length;
+
+	if( SHARD_read( fd, header, 12 ) < 0 ) return(-1);
+	if( SHARD_getInt(header) != SHARD_MAGIC ) return(-1);
+
+	*type = (SHARD_message)SHARD_getInt( header + 4 );
+	length = SHARD_getInt( header + 8 );
+
+	if( length > (uint32_t)capacity ) return(-1);
+	if( SHARD_read( fd, payload, (int)length ) < 0 ) return(-1);
+
+	return( (int)length );
+}
+
+/*
+ * SHARD_serve(fd)
+ *
+ * Description:
+ *
+ * Worker loop: searches the shards received on a socket and replies with their K best
+ * selections, until a SHARD_QUIT message or the end of the stream. A query out of range is
+ * answered with no selection. The standard values must be initialized. Returns 0 on
+ * SHARD_QUIT and -1 otherwise.
+ *
+ */
+
+int SHARD_serve(int fd)
+{
+	static unsigned char request[SHARD_REQUEST_SIZE];
+	static unsigned char reply[ SHARD_REPLY_SIZE(SHARD_MAX_K) ];
+	static SEARCH_result top[SHARD_MAX_K];
+	unsigned char* entry;
+	SHARD_message type;
+	SEARCH_query query;
+	int begin, end, K, N_top, i, j;
+
+	while(1)
+	{
+		if( SHARD_receive( fd, &type, request, SHARD_REQUEST_SIZE ) < 0 ) return(-1);
+
+		if( type == SHARD_QUIT ) return(0);
+		if( type != SHARD_REQUEST ) return(-1);
+
+		begin = (int)SHARD_getInt( request + 8 );
+		end = (int)SHARD_getInt( request + 12 );
+		K = (int)SHARD_getInt( request + 16 );
+
+		SHARD_getQuery( request + 20, &query );
+
+		if( K < 1 ) K = 1;
+		if( K > SHARD_MAX_K ) K = SHARD_MAX_K;
+
+		N_top = SHARD_isValid( &query ) ? SEARCH_runTop( &query, begin, end, K, top ) : 0;
+
+		if( N_top < 0 ) N_top = 0;
+
+		memcpy( reply, request, 8 );						//	Shard and query numbers.
+		SHARD_putInt( reply + 8, (uint32_t)N_top );
+
+		for( i = 0 ; i < N_top ; i++ )
+		{
+			entry = reply + 12 + i * SHARD_ENTRY_SIZE;
+
+			SHARD_putInt( entry, (uint32_t)top[i].N_parts );
+
+			for( j = 0 ; j < SEARCH_MAX_PARTS ; j++ )
+			{
+				SHARD_putShort( entry + 4 + 2*j, ( j < top[i].N_parts ) ? EIA_encode( top[i].part[j] ) : EIA_NONE );
+			}
+
+			SHARD_putDouble( entry + 12, top[i].value );
+			SHARD_putDouble( entry + 20, top[i].error );
+		}
+
+		if( SHARD_send( fd, SHARD_REPLY, reply, SHARD_REPLY_SIZE(N_top) ) < 0 ) return(-1);
+	}
+}
+
+/*
+ * SHARD_spawn(N_workers, fd, pid)
+ *
+ * Description:
+ *
+ * Forks N_workers local worker processes running SHARD_serve, and stores the sockets to them
+ * in fd and their process ids in pid. The standard values and tables built so far are
+ * inherited. Returns the number of workers started.
+ *
+ */
+
+int SHARD_spawn(int N_workers, int* fd, pid_t* pid)
+{
+	int pair[2];
+	int i, k;
+
+	for( i = 0 ; i < N_workers ; i++ )
+	{
+		if( socketpair( AF_UNIX, SOCK_STREAM, 0, pair ) < 0 ) break;
+
+		pid[i] = fork();
+
+		if( pid[i] < 0 )
+		{
+			close( pair[0] );
+			close( pair[1] );
+			break;
+		}
+
+		if( pid[i] == 0 )
+		{
+			for( k = 0 ; k < i ; k++ ) close( fd[k] );
+
+			close( pair[0] );
+
+			_exit( SHARD_serve( pair[1] ) == 0 ? 0 : 1 );
+		}
+
+		close( pair[1] );
+		fd[i] = pair[0];
+	}
+
+	return(i);
+}
+
+/*
+ * SHARD_stop(N_workers, fd, pid)
+ *
+ * Description:
+ *
+ * Asks local workers to quit, closes their sockets and waits for them.
+ *
+ */
+
+void SHARD_stop(int N_workers, int* fd, pid_t* pid)
+{
+	int i;
+
+	for( i = 0 ; i < N_workers ; i++ )
+	{
+		SHARD_send( fd[i], SHARD_QUIT, NULL, 0 );
+		close( fd[i] );
+	}
+
+	for( i = 0 ; i < N_workers ; i++ ) waitpid( pid[i], NULL, 0 );
+}
+
+/*	Sends shard number s to a worker. Returns 0, or -1 on error. */
+
+int SHARD_dispatch(int fd, SHARD_t* shard, int s, SEARCH_query* query, int K)
+{
+	unsigned char request[SHARD_REQUEST_SIZE];
+
+	SHARD_putInt( request, (uint32_t)s );
+	SHARD_putInt( request + 4, (uint32_t)shard[s].query );
+	SHARD_putInt( request + 8, (uint32_t)shard[s].begin );
+	SHARD_putInt( request + 12, (uint32_t)shard[s].end );
+	SHARD_putInt( request + 16, (uint32_t)K );
+	SHARD_putQuery( request + 20, &query[ shard[s].query ] );
+
+	return( SHARD_send( fd, SHARD_REQUEST, request, SHARD_REQUEST_SIZE ) );
+}
+
+/*
+ * SHARD_coordinate(fd, N_workers, query, N, K, top, N_top)
+ *
+ * Description:
+ *
+ * Searches a batch of N queries on the workers connected to the sockets fd[0..N_workers)
+ * and stores the K best selections of query[i] in top[i*K .. i*K + N_top[i]), in the order
+ * of SEARCH_compare. The shards of a worker which fails, or sends a malformed reply, are
+ * sent to the others.
+ *
+ * Returns 0, or -1 if there is no worker, every worker failed or memory could not be
+ * allocated.
+ *
+ */
+
+int SHARD_coordinate(int* fd, int N_workers, SEARCH_query* query, int N, int K, SEARCH_result* top, int* N_top)
+{
+	static unsigned char reply[ SHARD_REPLY_SIZE(SHARD_MAX_K) ];
+	struct pollfd poller[SHARD_MAX_WORKERS];
+	int flight[SHARD_MAX_WORKERS][SHARD_PIPELINE];
+	int N_flight[SHARD_MAX_WORKERS];
+	SEARCH_result candidate;
+	SEARCH_state state;
+	SHARD_message type;
+	SHARD_t* shard;
+	int* pending;
+	unsigned char* entry;
+	int N_shards, N_pending, N_done, N_alive;
+	int N_outer, size, begin, s, q, count, length, w, i, j;
+
+	if( N_workers < 1 ) return(-1);
+	if( K < 1 ) K = 1;
+	if( K > SHARD_MAX_K ) K = SHARD_MAX_K;
+	if( N_workers > SHARD_MAX_WORKERS ) N_workers = SHARD_MAX_WORKERS;
+
+	//	Split the outer positions of every query.
+
+	N_shards = 0;
+
+	for( q = 0 ; q < N ; q++ )
+	{
+		N_outer = SEARCH_prepare( &state, &query[q] );
+		N_shards += ( N_outer > SHARD_MIN_SIZE ) ? SHARD_PER_WORKER * N_workers : 1;
+	}
+
+	shard = (SHARD_t*)malloc( sizeof(SHARD_t) * ( N_shards + 1 ) );
+	pending = (int*)malloc( sizeof(int) * ( N_shards + 1 ) );
+
+	if( shard == NULL || pending == NULL )
+	{
+		free(shard);
+		free(pending);
+		return(-1);
+	}
+
+	N_shards = 0;
+
+	for( q = 0 ; q < N ; q++ )
+	{
+		N_top[q] = 0;
+		N_outer = SEARCH_prepare( &state, &query[q] );
+
+		if( N_outer <= 0 ) continue;
+
+		size = ( N_outer > SHARD_MIN_SIZE ) ? ( N_outer + SHARD_PER_WORKER * N_workers - 1 ) / ( SHARD_PER_WORKER * N_workers ) : N_outer;
+
+		for( begin = 0 ; begin < N_outer ; begin += size )
+		{
+			shard[N_shards].query = q;
+			shard[N_shards].begin = begin;
+			shard[N_shards].end = ( begin + size < N_outer ) ? begin + size : N_outer;
+			N_shards++;
+		}
+	}
+
+	//	Shards still to send, taken from the end: first shards first.
+
+	for( s = 0 ; s < N_shards ; s++ ) pending[s] = N_shards - 1 - s;
+
+	N_pending = N_shards;
+	N_done = 0;
+	N_alive = N_workers;
+
+	for( w = 0 ; w < N_workers ; w++ )
+	{
+		N_flight[w] = 0;
+		poller[w].fd = fd[w];
+		poller[w].events = POLLIN;
+	}
+
+	while( N_done < N_shards && N_alive > 0 )
+	{
+		//	Keep every live worker busy.
+
+		for( w = 0 ; w < N_workers ; w++ )
+		{
+			while( poller[w].fd >= 0 && N_flight[w] < SHARD_PIPELINE && N_pending > 0 )
+			{
+				s = pending[ --N_pending ];
+
+				if( SHARD_dispatch( fd[w], shard, s, query, K ) < 0 )
+				{
+					pending[ N_pending++ ] = s;
+					poller[w].fd = -1;
+					break;
+				}
+
+				flight[w][ N_flight[w]++ ] = s;
+			}
+
+			if( poller[w].fd < 0 && N_flight[w] >= 0 )
+			{
+				//	Failed worker: send its shards to the others.
+
+				for( i = 0 ; i < N_flight[w] ; i++ ) pending[ N_pending++ ] = flight[w][i];
+
+				N_flight[w] = -1;
+				N_alive--;
+			}
+		}
+
+		if( N_alive == 0 ) break;
+
+		if( poll( poller, N_workers, -1 ) < 0 )
+		{
+			if( errno == EINTR ) continue;
+			break;
+		}
+
+		for( w = 0 ; w < N_workers ; w++ )
+		{
+			if( poller[w].fd < 0 || poller[w].revents == 0 ) continue;
+
+			length = SHARD_receive( fd[w], &type, reply, sizeof(reply) );
+
+			if( length < 12 || type != SHARD_REPLY )
+			{
+				poller[w].fd = -1;
+				continue;
+			}
+
+			s = (int)SHARD_getInt( reply );
+			count = (int)SHARD_getInt( reply + 8 );
+
+			//	Counts come from the wire: a worker sending one out of range is failed too.
+
+			if( count < 0 || count > K || length < SHARD_REPLY_SIZE(count) )
+			{
+				poller[w].fd = -1;
+				continue;
+			}
+
+			for( i = 0 ; i < count ; i++ )
+			{
+				j = (int)SHARD_getInt( reply + 12 + i * SHARD_ENTRY_SIZE );
+
+				if( j < 0 || j > SEARCH_MAX_PARTS ) break;
+			}
+
+			if( i < count )
+			{
+				poller[w].fd = -1;
+				continue;
+			}
+
+			for( i = 0 ; i < N_flight[w] && flight[w][i] != s ; i++ );
+
+			if( i == N_flight[w] )
+			{
+				poller[w].fd = -1;
+				continue;
+			}
+
+			flight[w][i] = flight[w][ --N_flight[w] ];
+
+			q = shard[s].query;
+
+			for( i = 0 ; i < count ; i++ )
+			{
+				entry = reply + 12 + i * SHARD_ENTRY_SIZE;
+
+				candidate.topology = query[q].topology;
+				candidate.N_parts = (int)SHARD_getInt( entry );
+				candidate.optimal = 1;
+
+				for( j = 0 ; j < SEARCH_MAX_PARTS ; j++ )
+				{
+					candidate.part[j] = ( j < candidate.N_parts ) ? EIA_decode( SHARD_getShort( entry + 4 + 2*j ) ) : 0.0f;
+				}
+
+				candidate.value = SHARD_getDouble( entry + 12 );
+				candidate.error = SHARD_getDouble( entry + 20 );
+
+				N_top[q] = SEARCH_insertTop( top + q * K, K, N_top[q], &candidate );
+			}
+
+			N_done++;
+		}
+	}
+
+	free(shard);
+	free(pending);
+
+	return( ( N_done == N_shards ) ? 0 : -1 );
+}
+
+#endif /* PASSIVE_SHARD_H_ */
@@ -0,0 +1,594 @@
+/*
+ *
+ * 	Synthesis of mixed series/parallel networks from standard values.
+ *
+ * 	Finds the network of up to four standard resistors or capacitors, in any series/parallel
+ * 	arrangement such as R1 + ( R2 || R3 ) or ( R1 + R2 ) || ( R3 + R4 ), whose equivalent value
+ * 	is closest to a target.
+ *
+ * 	Every arrangement is split into parts enumerated directly and one two part sub-network
+ * 	looked up by binary search in a sorted table of all pairs. The equivalent value grows with
+ * 	the looked up sub-network, so only its two neighbours around the exact solution need to be
+ * 	evaluated. The pair tables are built once per element and standard, by whichever thread
+ * 	first needs them, and shared by all searches. SYNTHESIS_setRange() changes the decades of the standard values of an element,
+ * 	and drops its sets and pair tables, which are built again when next used.
+ *
+ */
+
+#ifndef PASSIVE_SYNTHESIS_H_
+#define PASSIVE_SYNTHESIS_H_
+
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "RESISTOR.h"
+#include "CAPACITOR.h"
+#include "NETWORK.h"
+
+#define SYNTHESIS_MAX_PARTS		4
+#define SYNTHESIS_STANDARDS		EIA_SERIES
+
+//	Ways of combining two values: adding them, or adding their reciprocals.
+
+typedef enum{ SYNTHESIS_ADD, SYNTHESIS_HARMONIC } SYNTHESIS_op;
+
+//	Arrangements searched: a part, a pair, a part and a pair, a part and a
+//	part-and-pair, two pairs.
+
+typedef enum{ SYNTHESIS_1, SYNTHESIS_2, SYNTHESIS_1_2, SYNTHESIS_1_1_2, SYNTHESIS_2_2 } SYNTHESIS_shape;
+
+//	Sorted table of every pair of standard values combined with one operation.
+
+typedef struct
+{
+	int N;
+	float* value;
+	unsigned short* i;
+	unsigned short* j;
+}SYNTHESIS_table;
+
+//	Best network found by a search.
+
+typedef struct
+{
+	float value;
+	float error;
+	SYNTHESIS_shape shape;
+	SYNTHESIS_op op[3];
+	float part[SYNTHESIS_MAX_PARTS];
+}SYNTHESIS_candidate;
+
+SYNTHESIS_table SYNTHESIS_tables[2][SYNTHESIS_STANDARDS][2];
+
+pthread_mutex_t SYNTHESIS_lock = PTHREAD_MUTEX_INITIALIZER;		//	Held while a pair table is built.
+
+/*****			Function declarations			*****/
+
+float SYNTHESIS_combine(SYNTHESIS_op op, float a, float b);
+float SYNTHESIS_solve(SYNTHESIS_op op, float X, float a);
+float* SYNTHESIS_getSet(NETWORK_element element, EIA_standard std, int* N);
+int SYNTHESIS_setRange(NETWORK_element element, int low, int high);
+SYNTHESIS_table* SYNTHESIS_getTable(NETWORK_element element, EIA_standard std, SYNTHESIS_op op);
+int SYNTHESIS_hasTable(NETWORK_element element, EIA_standard std, SYNTHESIS_op op);
+float SYNTHESIS_getNetwork(float X, NETWORK_element element, EIA_standard std, int N_max, NETWORK_t* network);
+
+/*****			Function definitions			*****/
+
+/*
+ * SYNTHESIS_combine(op, a, b)
+ *
+ * Description:
+ *
+ * Returns a + b, or 1 / ( 1/a + 1/b ).
+ *
+ */
+
+float SYNTHESIS_combine(SYNTHESIS_op op, float a, float b)
+{
+	if( op == SYNTHESIS_ADD ) return( a + b );
+
+	return( ( a * b ) / ( a + b ) );
+}
+
+/*
+ * SYNTHESIS_solve(op, X, a)
+ *
+ * Description:
+ *
+ * Returns the value x for which SYNTHESIS_combine(op, a, x) equals X. When no positive value
+ * does, returns 0 if every x gives more than X and INFINITY if every x gives less.
+ *
+ */
+
+float SYNTHESIS_solve(SYNTHESIS_op op, float X, float a)
+{
+	float g;
+
+	if( op == SYNTHESIS_ADD ) return( ( X > a ) ? ( X - a ) : 0.0f );
+
+	g = 1.0f / X - 1.0f / a;
+
+	return( ( g > 0.0f ) ? ( 1.0f / g ) : INFINITY );
+}
+
+/*
+ * SYNTHESIS_getSet(element, std, N)
+ *
+ * Description:
+ *
+ * Returns the sorted standard values of an element searched by the selectors, and their
+ * number in N. Returns NULL if they could not be allocated.
+ *
+ */
+
+float* SYNTHESIS_getSet(NETWORK_element element, EIA_standard std, int* N)
+{
+	if( element == NETWORK_RESISTOR )
+	{
+		*N = RESISTOR_getSize(std);
+		return( RESISTOR_getSet(std) );
+	}
+
+	*N = CAPACITOR_getSize(std);
+	return( CAPACITOR_getSet(std) );
+}
+
+/*	Position of an EIA standard in the table cache, or -1 if it is not a series. */
+
+int SYNTHESIS_standardIndex(EIA_standard std)
+{
+	return( EIA_seriesIndex(std) );
+}
+
+/*
+ * SYNTHESIS_setRange(element, low, high)
+ *
+ * Description:
+ *
+ * Sets the standard values of an element to the decades from 10^low to 10^(high+1)
+ * excluded, for instance -3 and 8 for resistors from 1m to 976M. The sets and pair tables
+ * of the element are freed, and built again for the new decades when next used. Returns 0,
+ * or -1 if the decades cannot be coded (see EIA.h). No search may run meanwhile, and parts
+ * stored as indexes in the sets (COLUMNS.h) refer to the new values.
+ *
+ */
+
+int SYNTHESIS_setRange(NETWORK_element element, int low, int high)
+{
+	SYNTHESIS_table* table;
+	int k, op;
+
+	if( EIA_setRange( ( element == NETWORK_RESISTOR ) ? &RESISTOR_range : &CAPACITOR_range, low, high ) < 0 ) return(-1);
+
+	pthread_mutex_lock(&SYNTHESIS_lock);
+
+	for( k = 0 ; k < SYNTHESIS_STANDARDS ; k++ )
+	{
+		for( op = SYNTHESIS_ADD ; op <= SYNTHESIS_HARMONIC ; op++ )
+		{
+			table = &SYNTHESIS_tables[element][k][op];
+
+			free(table->value);
+			free(table->i);
+			free(table->j);
+			table->value = NULL;
+			table->i = NULL;
+			table->j = NULL;
+			table->N = 0;
+		}
+	}
+
+	pthread_mutex_unlock(&SYNTHESIS_lock);
+
+	return(0);
+}
+
+/*	Orders pairs by value for qsort. */
+
+int SYNTHESIS_comparePairs(const void* a, const void* b)
+{
+	float x = ( (const float*)a )[0];
+	float y = ( (const float*)b )[0];
+
+	return( ( x > y ) - ( x < y ) );
+}
+
+/*	Builds the table of a set of N values, and publishes it by storing its values last, so
+	that a thread which sees them sees a complete table. Returns -1 if it could not be
+	allocated. */
+
+int SYNTHESIS_buildTable(SYNTHESIS_table* table, float* set, int N, SYNTHESIS_op op)
+{
+	float* pair;
+	float* value;
+	int i, j, k;
+
+	//	Pairs are sorted as ( value, i, j ) triples, then split into columns.
+
+	pair = (float*)malloc( sizeof(float) * 3 * N * ( N + 1 ) / 2 );
+
+	value = (float*)malloc( sizeof(float) * N * ( N + 1 ) / 2 );
+	table->i = (unsigned short*)malloc( sizeof(unsigned short) * N * ( N + 1 ) / 2 );
+	table->j = (unsigned short*)malloc( sizeof(unsigned short) * N * ( N + 1 ) / 2 );
+
+	if( pair == NULL || value == NULL || table->i == NULL || table->j == NULL )
+	{
+		free(pair);
+		free(value);
+		free(table->i);
+		free(table->j);
+		table->i = NULL;
+		table->j = NULL;
+
+		return(-1);
+	}
+
+	k = 0;
+
+	for( i = 0 ; i < N ; i++ )
+	{
+		for( j = i ; j < N ; j++ )
+		{
+			pair[ 3*k ]     = SYNTHESIS_combine( op, set[i], set[j] );
+			pair[ 3*k + 1 ] = (float)i;
+			pair[ 3*k + 2 ] = (float)j;
+			k++;
+		}
+	}
+
+	qsort( pair, k, 3 * sizeof(float), SYNTHESIS_comparePairs );
+
+	for( i = 0 ; i < k ; i++ )
+	{
+		value[i] = pair[ 3*i ];
+		table->i[i] = (unsigned short)pair[ 3*i + 1 ];
+		table->j[i] = (unsigned short)pair[ 3*i + 2 ];
+	}
+
+	table->N = k;
+
+	free(pair);
+
+	__atomic_store_n( &table->value, value, __ATOMIC_RELEASE );
+
+	return(0);
+}
+
+/*
+ * SYNTHESIS_getTable(element, std, op)
+ *
+ * Description:
+ *
+ * Returns the sorted table of every unordered pair of standard values combined with op,
+ * building it on first use. Any thread may call it: a table is built once, under
+ * SYNTHESIS_lock, and read without locking once built. Returns NULL if the table could not
+ * be allocated.
+ *
+ */
+
+SYNTHESIS_table* SYNTHESIS_getTable(NETWORK_element element, EIA_standard std, SYNTHESIS_op op)
+{
+	SYNTHESIS_table* table;
+	float* set;
+	int k = SYNTHESIS_standardIndex(std), N, status = 0;
+
+	if( k < 0 ) return(NULL);
+
+	table = &SYNTHESIS_tables[element][k][op];
+
+	if( __atomic_load_n( &table->value, __ATOMIC_ACQUIRE ) != NULL ) return(table);
+
+	set = SYNTHESIS_getSet(element, std, &N);
+
+	if( set == NULL ) return(NULL);
+
+	pthread_mutex_lock(&SYNTHESIS_lock);
+
+	if( table->value == NULL ) status = SYNTHESIS_buildTable( table, set, N, op );
+
+	pthread_mutex_unlock(&SYNTHESIS_lock);
+
+	return( ( status == 0 ) ? table : NULL );
+}
+
+/*	Returns 1 if a pair table is already built. */
+
+int SYNTHESIS_hasTable(NETWORK_element element, EIA_standard std, SYNTHESIS_op op)
+{
+	int k = SYNTHESIS_standardIndex(std);
+
+	return( k >= 0 && __atomic_load_n( &SYNTHESIS_tables[element][k][op].value, __ATOMIC_ACQUIRE ) != NULL );
+}
+
+/*
+ * SYNTHESIS_nearest(table, x, k)
+ *
+ * Description:
+ *
+ * Stores in k the indexes of the two table entries around x, which are equal at the ends
+ * of the table.
+ *
+ */
+
+void SYNTHESIS_nearest(SYNTHESIS_table* table, float x, int* k)
+{
+	int position;
+
+	position = lower_bound( table->value, table->N, x );
+
+	k[0] = ( position > 0 ) ? ( position - 1 ) : 0;
+	k[1] = ( position < table->N ) ? position : ( table->N - 1 );
+}
+
+/*	Keeps a candidate if it is closer to the target than the best one. */
+
+void SYNTHESIS_consider(SYNTHESIS_candidate* best, SYNTHESIS_candidate* candidate, float X)
+{
+	candidate->error = candidate->value - X;
+
+	if( candidate->error < 0.0f ) candidate->error = -candidate->error;
+
+	if( candidate->error < best->error ) *best = *candidate;
+}
+
+/*
+ * SYNTHESIS_build(candidate, element, network)
+ *
+ * Description:
+ *
+ * Builds the network of a candidate.
+ *
+ */
+
+void SYNTHESIS_build(SYNTHESIS_candidate* candidate, NETWORK_element element, NETWORK_t* network)
+{
+	NETWORK_node_t type[2];
+	int a, b, c, d;
+
+	//	Adding values is a series connection of resistors and a parallel one of capacitors.
+
+	type[SYNTHESIS_ADD]      = ( element == NETWORK_RESISTOR ) ? NETWORK_SERIES : NETWORK_PARALLEL;
+	type[SYNTHESIS_HARMONIC] = ( element == NETWORK_RESISTOR ) ? NETWORK_PARALLEL : NETWORK_SERIES;
+
+	NETWORK_init(network, element);
+
+	switch( candidate->shape )
+	{
+		case(SYNTHESIS_1):
+		{
+			NETWORK_addPart( network, candidate->part[0], 0.0f );
+		}; break;
+
+		case(SYNTHESIS_2):
+		{
+			a = NETWORK_addPart( network, candidate->part[0], 0.0f );
+			b = NETWORK_addPart( network, candidate->part[1], 0.0f );
+			NETWORK_addNode( network, type[ candidate->op[0] ], 0.0f, 0.0f, a, b );
+		}; break;
+
+		case(SYNTHESIS_1_2):
+		{
+			a = NETWORK_addPart( network, candidate->part[0], 0.0f );
+			b = NETWORK_addPart( network, candidate->part[1], 0.0f );
+			c = NETWORK_addPart( network, candidate->part[2], 0.0f );
+			b = NETWORK_addNode( network, type[ candidate->op[1] ], 0.0f, 0.0f, b, c );
+			NETWORK_addNode( network, type[ candidate->op[0] ], 0.0f, 0.0f, a, b );
+		}; break;
+
+		case(SYNTHESIS_1_1_2):
+		{
+			a = NETWORK_addPart( network, candidate->part[0], 0.0f );
+			b = NETWORK_addPart( network, candidate->part[1], 0.0f );
+			c = NETWORK_addPart( network, candidate->part[2], 0.0f );
+			d = NETWORK_addPart( network, candidate->part[3], 0.0f );
+			c = NETWORK_addNode( network, type[ candidate->op[2] ], 0.0f, 0.0f, c, d );
+			b = NETWORK_addNode( network, type[ candidate->op[1] ], 0.0f, 0.0f, b, c );
+			NETWORK_addNode( network, type[ candidate->op[0] ], 0.0f, 0.0f, a, b );
+		}; break;
+
+		case(SYNTHESIS_2_2):
+		{
+			a = NETWORK_addPart( network, candidate->part[0], 0.0f );
+			b = NETWORK_addPart( network, candidate->part[1], 0.0f );
+			c = NETWORK_addPart( network, candidate->part[2], 0.0f );
+			d = NETWORK_addPart( network, candidate->part[3], 0.0f );
+			a = NETWORK_addNode( network, type[ candidate->op[1] ], 0.0f, 0.0f, a, b );
+			c = NETWORK_addNode( network, type[ candidate->op[2] ], 0.0f, 0.0f, c, d );
+			NETWORK_addNode( network, type[ candidate->op[0] ], 0.0f, 0.0f, a, c );
+		}; break;
+	}
+}
+
+/*
+ * SYNTHESIS_getNetwork(X, element, std, N_max, network)
+ *
+ * Description:
+ *
+ * Finds the series/parallel network of at most N_max standard parts whose equivalent value
+ * is closest to X, stores it in network and returns its equivalent value. Networks with
+ * fewer parts are preferred when equally close. Returns 0 with an empty network if the
+ * pair tables could not be allocated.
+ *
+ * @parameter	X						:	Target equivalent value.
+ * @parameter	element					:	Resistors or capacitors.
+ * @parameter	std						:	EIA standard from which the parts are chosen.
+ * @parameter	N_max					:	Maximum number of parts, from 1 to 4.
+ * @parameter	network					:	Pointer to the network found.
+ *
+ */
+
+float SYNTHESIS_getNetwork(float X, NETWORK_element element, EIA_standard std, int N_max, NETWORK_t* network)
+{
+	SYNTHESIS_table* table[2];
+	SYNTHESIS_table* inner;
+	SYNTHESIS_table* outer;
+	SYNTHESIS_candidate best;
+	SYNTHESIS_candidate candidate;
+	float* set;
+	float Y, Z, P;
+	int N, i, j, m, n, k[2];
+	int op0, op1, op2;
+
+	set = SYNTHESIS_getSet(element, std, &N);
+
+	NETWORK_init(network, element);
+
+	table[SYNTHESIS_ADD]      = SYNTHESIS_getTable(element, std, SYNTHESIS_ADD);
+	table[SYNTHESIS_HARMONIC] = SYNTHESIS_getTable(element, std, SYNTHESIS_HARMONIC);
+
+	if( table[SYNTHESIS_ADD] == NULL || table[SYNTHESIS_HARMONIC] == NULL ) return(0.0f);
+
+	best.error = INFINITY;
+
+	//	Single part.
+
+	candidate.shape = SYNTHESIS_1;
+	k[0] = lower_bound( set, N, X );
+
+	for( m = k[0] - 1 ; m <= k[0] ; m++ )
+	{
+		if( m < 0 || m >= N ) continue;
+
+		candidate.part[0] = set[m];
+		candidate.value = set[m];
+
+		SYNTHESIS_consider( &best, &candidate, X );
+	}
+
+	//	Two parts: one lookup in each pair table.
+
+	for( op0 = 0 ; op0 < 2 && N_max >= 2 ; op0++ )
+	{
+		candidate.shape = SYNTHESIS_2;
+		candidate.op[0] = (SYNTHESIS_op)op0;
+
+		SYNTHESIS_nearest( table[op0], X, k );
+
+		for( m = 0 ; m < 2 ; m++ )
+		{
+			candidate.part[0] = set[ table[op0]->i[ k[m] ] ];
+			candidate.part[1] = set[ table[op0]->j[ k[m] ] ];
+			candidate.value = table[op0]->value[ k[m] ];
+
+			SYNTHESIS_consider( &best, &candidate, X );
+		}
+	}
+
+	//	Three parts: a ( b c ), looking up the pair ( b c ) for every a.
+
+	for( op0 = 0 ; op0 < 2 && N_max >= 3 ; op0++ )
+	{
+	for( op1 = 0 ; op1 < 2 ; op1++ )
+	{
+		inner = table[op1];
+
+		candidate.shape = SYNTHESIS_1_2;
+		candidate.op[0] = (SYNTHESIS_op)op0;
+		candidate.op[1] = (SYNTHESIS_op)op1;
+
+		for( i = 0 ; i < N ; i++ )
+		{
+			P = SYNTHESIS_solve( (SYNTHESIS_op)op0, X, set[i] );
+
+			SYNTHESIS_nearest( inner, P, k );
+
+			for( m = 0 ; m < 2 ; m++ )
+			{
+				candidate.part[0] = set[i];
+				candidate.part[1] = set[ inner->i[ k[m] ] ];
+				candidate.part[2] = set[ inner->j[ k[m] ] ];
+				candidate.value = SYNTHESIS_combine( (SYNTHESIS_op)op0, set[i], inner->value[ k[m] ] );
+
+				SYNTHESIS_consider( &best, &candidate, X );
+			}
+		}
+	}
+	}
+
+	//	Four parts: a ( b ( c d ) ), looking up the pair ( c d ) for every a and b.
+
+	for( op0 = 0 ; op0 < 2 && N_max >= 4 ; op0++ )
+	{
+	for( op1 = 0 ; op1 < 2 ; op1++ )
+	{
+	for( op2 = 0 ; op2 < 2 ; op2++ )
+	{
+		inner = table[op2];
+
+		candidate.shape = SYNTHESIS_1_1_2;
+		candidate.op[0] = (SYNTHESIS_op)op0;
+		candidate.op[1] = (SYNTHESIS_op)op1;
+		candidate.op[2] = (SYNTHESIS_op)op2;
+
+		for( i = 0 ; i < N ; i++ )
+		{
+			Y = SYNTHESIS_solve( (SYNTHESIS_op)op0, X, set[i] );
+
+			for( j = 0 ; j < N ; j++ )
+			{
+				P = SYNTHESIS_solve( (SYNTHESIS_op)op1, Y, set[j] );
+
+				SYNTHESIS_nearest( inner, P, k );
+
+				for( m = 0 ; m < 2 ; m++ )
+				{
+					Z = SYNTHESIS_combine( (SYNTHESIS_op)op1, set[j], inner->value[ k[m] ] );
+
+					candidate.part[0] = set[i];
+					candidate.part[1] = set[j];
+					candidate.part[2] = set[ inner->i[ k[m] ] ];
+					candidate.part[3] = set[ inner->j[ k[m] ] ];
+					candidate.value = SYNTHESIS_combine( (SYNTHESIS_op)op0, set[i], Z );
+
+					SYNTHESIS_consider( &best, &candidate, X );
+				}
+			}
+		}
+	}
+	}
+	}
+
+	//	Four parts: ( a b ) ( c d ), looking up the pair ( c d ) for every pair ( a b ).
+
+	for( op0 = 0 ; op0 < 2 && N_max >= 4 ; op0++ )
+	{
+	for( op1 = 0 ; op1 < 2 ; op1++ )
+	{
+	for( op2 = op1 ; op2 < 2 ; op2++ )
+	{
+		outer = table[op1];
+		inner = table[op2];
+
+		candidate.shape = SYNTHESIS_2_2;
+		candidate.op[0] = (SYNTHESIS_op)op0;
+		candidate.op[1] = (SYNTHESIS_op)op1;
+		candidate.op[2] = (SYNTHESIS_op)op2;
+
+		for( n = 0 ; n < outer->N ; n++ )
+		{
+			P = SYNTHESIS_solve( (SYNTHESIS_op)op0, X, outer->value[n] );
+
+			SYNTHESIS_nearest( inner, P, k );
+
+			for( m = 0 ; m < 2 ; m++ )
+			{
+				candidate.part[0] = set[ outer->i[n] ];
+				candidate.part[1] = set[ outer->j[n] ];
+				candidate.part[2] = set[ inner->i[ k[m] ] ];
+				candidate.part[3] = set[ inner->j[ k[m] ] ];
+				candidate.value = SYNTHESIS_combine( (SYNTHESIS_op)op0, outer->value[n], inner->value[ k[m] ] );
+
+				SYNTHESIS_consider( &best, &candidate, X );
+			}
+		}
+	}
+	}
+	}
+
+	SYNTHESIS_build( &best, element, network );
+
+	return( best.value );
+}
+
+#endif /* PASSIVE_SYNTHESIS_H_ */
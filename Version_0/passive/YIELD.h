@@ -0,0 +1,1228 @@
+/*
+ *
+ * 	Yield optimizing selection of standard components.
+ *
+ * 	The yield of a selection is the fraction of built circuits whose value (resistance,
+ * 	ratio or time constant) lands inside a specification window when every part deviates
+ * 	from its nominal value within its tolerance. It is estimated from a set of sampled part
+ * 	deviations which is shared by all candidates of a search, so that candidates are
+ * 	compared on the same builds.
+ *
+ * 	Candidates are enumerated only where the tolerance band of their value can reach the
+ * 	window: the last part, or pair of parts, is looked up by binary search for every choice
+ * 	of the others, among the standard values or in a sorted table of the pairs.
+ *
+ * 	Tolerances are percentages in [0, 100). A search given any other tolerance returns a
+ * 	yield of 0 without selecting parts.
+ *
+ */
+
+#ifndef PASSIVE_YIELD_H_
+#define PASSIVE_YIELD_H_
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "RC.h"
+
+#ifndef M_PI
+#define M_PI				3.14159265358979323846
+#endif
+
+#define YIELD_MAX_PARTS		4
+#define YIELD_BLOCK_SIZE	32				//	Samples evaluated between two early termination checks.
+#define YIELD_SEED			0x2545F491u		//	Seed of the sample generator, fixed for repeatable results.
+
+//	Distributions of part values within their tolerance band.
+
+typedef enum{ YIELD_UNIFORM, YIELD_GAUSSIAN } YIELD_distribution;
+
+//	Function returning the value of a network from its part values.
+
+typedef float (*YIELD_network)(float* x);
+
+//	Value of a pair of parts, and their indices in the set.
+
+typedef struct
+{
+	float value;
+	int i, j;
+}YIELD_pair;
+
+//	State of a yield search.
+
+typedef struct
+{
+	YIELD_network network;
+	int N_parts;
+	int sign[YIELD_MAX_PARTS];				//	+1 if the value increases with the part, -1 otherwise.
+	float t[YIELD_MAX_PARTS];				//	Relative tolerance of each part.
+	float spec_max;
+	float spec_min;
+
+	float* deviation;						//	Sampled deviations in units of tolerance.
+	int N_samples;
+
+	int pass_best;
+	float distance_best;
+	float x_best[YIELD_MAX_PARTS];
+}YIELD_search;
+
+/*****			Function declarations			*****/
+
+int YIELD_begin(YIELD_search* search, YIELD_network network, int N_parts, float spec_max, float spec_min,
+				YIELD_distribution distribution, int N_samples);
+void YIELD_consider(YIELD_search* search, float* x);
+float YIELD_end(YIELD_search* search);
+YIELD_pair* YIELD_getPairs(float* set, int low, int high, YIELD_network network, float** value, int* N);
+
+/*****			Function definitions			*****/
+
+/*
+ * YIELD_random(state)
+ *
+ * Description:
+ *
+ * Returns a pseudo random number uniformly distributed in [0,1) and advances the
+ * xorshift generator state.
+ *
+ */
+
+float YIELD_random(unsigned int* state)
+{
+	unsigned int x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	*state = x;
+
+	return( (float)( x >> 8 ) / 16777216.0f );
+}
+
+/*
+ * YIELD_deviation(distribution, state)
+ *
+ * Description:
+ *
+ * Returns a deviation of a part from its nominal value in units of its tolerance, i.e.
+ * in [-1,1]. The tolerance is taken as the 3 sigma limit of the gaussian distribution,
+ * samples beyond it are drawn again.
+ *
+ */
+
+float YIELD_deviation(YIELD_distribution distribution, unsigned int* state)
+{
+	float u1, u2, d;
+
+	if( distribution == YIELD_UNIFORM )
+	{
+		return( 2.0f * YIELD_random(state) - 1.0f );
+	}
+
+	do
+	{
+		u1 = 1.0f - YIELD_random(state);
+		u2 = YIELD_random(state);
+		d  = sqrt( -2.0f * log(u1) ) * cos( 2.0f * M_PI * u2 ) / 3.0f;
+	}
+	while( d < -1.0f || d > 1.0f );
+
+	return( d );
+}
+
+/*	Returns 1 if a tolerance (in percentage) is within [0, 100), so that every part keeps a
+	positive value within its band. */
+
+int YIELD_isTolerance(float T)
+{
+	return( T >= 0.0f && T < 100.0f );
+}
+
+/*
+ * YIELD_begin(search, network, N_parts, spec_max, spec_min, distribution, N_samples)
+ *
+ * Description:
+ *
+ * Prepares a yield search and draws the deviation samples shared by all candidates.
+ * The caller sets the tolerance and sign of each part afterwards. Returns 0 if the
+ * samples could not be allocated.
+ *
+ * @parameter	search					:	Search to be prepared.
+ * @parameter	network					:	Function returning the value of the network.
+ * @parameter	N_parts					:	Number of parts of the network.
+ * @parameter	spec_max, spec_min		:	Specification window of the network value.
+ * @parameter	distribution			:	Distribution of the part values.
+ * @parameter	N_samples				:	Number of sampled builds per candidate.
+ *
+ */
+
+int YIELD_begin(YIELD_search* search, YIELD_network network, int N_parts, float spec_max, float spec_min,
+				YIELD_distribution distribution, int N_samples)
+{
+	unsigned int state = YIELD_SEED;
+	int i;
+
+	search->network = network;
+	search->N_parts = N_parts;
+	search->spec_max = spec_max;
+	search->spec_min = spec_min;
+	search->N_samples = N_samples;
+	search->pass_best = -1;
+	search->distance_best = 0.0f;
+
+	for( i = 0 ; i < N_parts ; i++ )
+	{
+		search->sign[i] = 1;
+		search->t[i] = 0.0f;
+	}
+
+	search->deviation = (float*)malloc( sizeof(float) * N_samples * N_parts );
+
+	if( search->deviation == NULL ) return(0);
+
+	for( i = 0 ; i < N_samples * N_parts ; i++ )
+	{
+		search->deviation[i] = YIELD_deviation(distribution, &state);
+	}
+
+	return(1);
+}
+
+/*
+ * YIELD_consider(search, x)
+ *
+ * Description:
+ *
+ * Evaluates the yield of a candidate and keeps it if it beats the best candidate so far.
+ * Ties in yield are broken in favour of the candidate whose nominal value is closest to
+ * the centre of the window.
+ *
+ * A candidate is dropped without sampling when its tolerance band cannot reach the window,
+ * and accepted without sampling when its band lies entirely inside it. Otherwise the samples
+ * are evaluated in blocks and the candidate is dropped as soon as the remaining samples
+ * cannot bring it level with the best candidate.
+ *
+ * @parameter	search					:	Yield search.
+ * @parameter	x						:	Nominal part values of the candidate.
+ *
+ */
+
+void YIELD_consider(YIELD_search* search, float* x)
+{
+	float x_low[YIELD_MAX_PARTS];
+	float x_high[YIELD_MAX_PARTS];
+	float x_sample[YIELD_MAX_PARTS];
+	float* d;
+	float low, high, value, distance;
+
+	int i, k, pass;
+
+	for( i = 0 ; i < search->N_parts ; i++ )
+	{
+		x_low[i]  = x[i] * ( 1.0f - search->sign[i] * search->t[i] );
+		x_high[i] = x[i] * ( 1.0f + search->sign[i] * search->t[i] );
+	}
+
+	low  = search->network(x_low);
+	high = search->network(x_high);
+
+	//	Nominal error too large for any build to land in the window.
+
+	if( high < search->spec_min || low > search->spec_max ) return;
+
+	distance = search->network(x) - 0.5f * ( search->spec_max + search->spec_min );
+
+	if( distance < 0.0f ) distance = -distance;
+
+	if( low >= search->spec_min && high <= search->spec_max )
+	{
+		pass = search->N_samples;
+	}
+	else
+	{
+		pass = 0;
+
+		for( k = 0 ; k < search->N_samples ; k++ )
+		{
+			if( ( k % YIELD_BLOCK_SIZE ) == 0 && pass + ( search->N_samples - k ) < search->pass_best ) return;
+
+			d = search->deviation + k * search->N_parts;
+
+			for( i = 0 ; i < search->N_parts ; i++ )
+			{
+				x_sample[i] = x[i] * ( 1.0f + search->t[i] * d[i] );
+			}
+
+			value = search->network(x_sample);
+
+			if( value >= search->spec_min && value <= search->spec_max ) pass++;
+		}
+	}
+
+	if( pass > search->pass_best || ( pass == search->pass_best && distance < search->distance_best ) )
+	{
+		search->pass_best = pass;
+		search->distance_best = distance;
+
+		for( i = 0 ; i < search->N_parts ; i++ ) search->x_best[i] = x[i];
+	}
+}
+
+/*
+ * YIELD_end(search)
+ *
+ * Description:
+ *
+ * Releases the samples of a search and returns the yield of its best candidate, or 0 if
+ * no candidate could reach the window.
+ *
+ */
+
+float YIELD_end(YIELD_search* search)
+{
+	free(search->deviation);
+	search->deviation = NULL;
+
+	if( search->pass_best <= 0 ) return(0.0f);
+
+	return( (float)search->pass_best / (float)search->N_samples );
+}
+
+/*	Network values used by the searches below. */
+
+float YIELD_network1R(float* x){ return( x[0] ); }
+float YIELD_network2RS(float* x){ return( RESISTOR_ER2S( x[0], x[1] ) ); }
+float YIELD_network2RP(float* x){ return( RESISTOR_ER2P( x[0], x[1] ) ); }
+float YIELD_networkRatio1R(float* x){ return( x[0] / x[1] ); }
+float YIELD_networkRatio2RS(float* x){ return( RESISTOR_ER2S( x[0], x[1] ) / RESISTOR_ER2S( x[2], x[3] ) ); }
+float YIELD_networkRatio2RP(float* x){ return( RESISTOR_ER2P( x[0], x[1] ) / RESISTOR_ER2P( x[2], x[3] ) ); }
+float YIELD_network1R1C(float* x){ return( RC_TC_1R1C( x[0], x[1] ) ); }
+float YIELD_network2RS1C(float* x){ return( RC_TC_2RS1C( x[0], x[1], x[2] ) ); }
+float YIELD_network2RP1C(float* x){ return( RC_TC_2RP1C( x[0], x[1], x[2] ) ); }
+float YIELD_network3RS1C(float* x){ return( RC_TC_3RS1C( x[0], x[1], x[2], x[3] ) ); }
+float YIELD_network3RP1C(float* x){ return( RC_TC_3RP1C( x[0], x[1], x[2], x[3] ) ); }
+
+int YIELD_comparePairs(const void* a, const void* b)
+{
+	float x = ( (const YIELD_pair*)a )->value;
+	float y = ( (const YIELD_pair*)b )->value;
+
+	return( ( x > y ) - ( x < y ) );
+}
+
+/*
+ * YIELD_getPairs(set, low, high, network, value, N)
+ *
+ * Description:
+ *
+ * Returns the pairs i <= j of the values low to high (excluded) of a set, sorted by their
+ * value through network, and stores the values alone in *value for lower_bound() and
+ * upper_bound(). Both arrays hold *N entries and are freed by the caller. Returns NULL if
+ * they could not be allocated.
+ *
+ */
+
+YIELD_pair* YIELD_getPairs(float* set, int low, int high, YIELD_network network, float** value, int* N)
+{
+	YIELD_pair* pair;
+	float x[2];
+	int i, j, n = 0;
+
+	*N = ( high > low ) ? ( high - low ) * ( high - low + 1 ) / 2 : 0;
+
+	pair = (YIELD_pair*)malloc( sizeof(YIELD_pair) * ( *N + 1 ) );
+	*value = (float*)malloc( sizeof(float) * ( *N + 1 ) );
+
+	if( pair == NULL || *value == NULL )
+	{
+		free(pair);
+		free(*value);
+		return(NULL);
+	}
+
+	for( i = low ; i < high ; i++ )
+	{
+		for( j = i ; j < high ; j++ )
+		{
+			x[0] = set[i];
+			x[1] = set[j];
+
+			pair[n].value = network(x);
+			pair[n].i = i;
+			pair[n].j = j;
+			n++;
+		}
+	}
+
+	qsort( pair, n, sizeof(YIELD_pair), YIELD_comparePairs );
+
+	for( i = 0 ; i < n ; i++ ) (*value)[i] = pair[i].value;
+
+	return(pair);
+}
+
+
+/*
+ * YIELD_RESISTOR_1R(R_max, R_min, RESISTOR_EIA_standard, T, distribution, N_samples, R)
+ *
+ * Description:
+ *
+ * Selects the standard resistor with the highest yield of resistance within a window and
+ * returns the estimated yield.
+ *
+ * @parameter	R_max, R_min					:	Specification window of the resistance.
+ * @parameter	RESISTOR_EIA_standard			:	EIA standard from which the resistor is chosen.
+ * @parameter	T								:	Tolerance of resistor (in percentage).
+ * @parameter	distribution					:	Distribution of the resistor value.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R								:	Pointer to chosen value of resistor.
+ *
+ */
+
+float YIELD_RESISTOR_1R(float R_max, float R_min, EIA_standard RESISTOR_EIA_standard, float T,
+						YIELD_distribution distribution, int N_samples, float* R)
+{
+	YIELD_search search;
+	float* R_set;
+	float t, yield;
+
+	int i, limit, begin, end;
+
+	if( !YIELD_isTolerance(T) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
+	t = 0.01f * T;
+
+	if( !YIELD_begin(&search, YIELD_network1R, 1, R_max, R_min, distribution, N_samples) ) return(0.0f);
+
+	search.t[0] = t;
+
+	//	Only resistors whose tolerance band overlaps the window are candidates.
+
+	begin = lower_bound( R_set, limit, R_min / ( 1.0f + t ) );
+	end   = upper_bound( R_set, limit, R_max / ( 1.0f - t ) );
+
+	for( i = begin ; i < end ; i++ )
+	{
+		YIELD_consider(&search, &R_set[i]);
+	}
+
+	if( search.pass_best > 0 ) *R = search.x_best[0];
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+
+/*
+ * YIELD_RESISTOR_2RS(R_max, R_min, RESISTOR_EIA_standard, T, distribution, N_samples, R1, R2)
+ *
+ * Description:
+ *
+ * Selects the two standard resistors in series with the highest yield of resistance within
+ * a window and returns the estimated yield.
+ *
+ * @parameter	R_max, R_min					:	Specification window of the resistance.
+ * @parameter	RESISTOR_EIA_standard			:	EIA standard from which the resistors are chosen.
+ * @parameter	T								:	Tolerance of resistors (in percentage).
+ * @parameter	distribution					:	Distribution of the resistor values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1, R2							:	Pointers to chosen values of resistors.
+ *
+ */
+
+float YIELD_RESISTOR_2RS(float R_max, float R_min, EIA_standard RESISTOR_EIA_standard, float T,
+						 YIELD_distribution distribution, int N_samples, float* R1, float* R2)
+{
+	YIELD_search search;
+	float* R_set;
+	float x[2];
+	float t, yield;
+
+	int i, j, limit, begin, end;
+
+	if( !YIELD_isTolerance(T) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
+	t = 0.01f * T;
+
+	if( !YIELD_begin(&search, YIELD_network2RS, 2, R_max, R_min, distribution, N_samples) ) return(0.0f);
+
+	search.t[0] = t;
+	search.t[1] = t;
+
+	//	Series resistance moves by at most the tolerance, so R2 is bounded for every R1.
+
+	for( i = 0 ; i < limit ; i++ )
+	{
+		begin = lower_bound( R_set, limit, R_min / ( 1.0f + t ) - R_set[i] );
+		end   = upper_bound( R_set, limit, R_max / ( 1.0f - t ) - R_set[i] );
+
+		if( begin < i ) begin = i;
+
+		for( j = begin ; j < end ; j++ )
+		{
+			x[0] = R_set[i];
+			x[1] = R_set[j];
+
+			YIELD_consider(&search, x);
+		}
+	}
+
+	if( search.pass_best > 0 )
+	{
+		*R1 = search.x_best[0];
+		*R2 = search.x_best[1];
+	}
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+
+/*
+ * YIELD_RESISTOR_2RP(R_max, R_min, RESISTOR_EIA_standard, T, distribution, N_samples, R1, R2)
+ *
+ * Description:
+ *
+ * Selects the two standard resistors in parallel with the highest yield of resistance within
+ * a window and returns the estimated yield.
+ *
+ * @parameter	R_max, R_min					:	Specification window of the resistance.
+ * @parameter	RESISTOR_EIA_standard			:	EIA standard from which the resistors are chosen.
+ * @parameter	T								:	Tolerance of resistors (in percentage).
+ * @parameter	distribution					:	Distribution of the resistor values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1, R2							:	Pointers to chosen values of resistors.
+ *
+ */
+
+float YIELD_RESISTOR_2RP(float R_max, float R_min, EIA_standard RESISTOR_EIA_standard, float T,
+						 YIELD_distribution distribution, int N_samples, float* R1, float* R2)
+{
+	YIELD_search search;
+	float* R_set;
+	float x[2];
+	float t, yield, g_low, g_high;
+
+	int i, j, limit, begin, end;
+
+	if( !YIELD_isTolerance(T) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
+	t = 0.01f * T;
+
+	if( !YIELD_begin(&search, YIELD_network2RP, 2, R_max, R_min, distribution, N_samples) ) return(0.0f);
+
+	search.t[0] = t;
+	search.t[1] = t;
+
+	for( i = 0 ; i < limit ; i++ )
+	{
+		//	Conductance left for R2 at both ends of the widened window.
+
+		g_low  = ( 1.0f + t ) / R_min - 1.0f / R_set[i];
+		g_high = ( 1.0f - t ) / R_max - 1.0f / R_set[i];
+
+		if( g_low <= 0.0f ) continue;
+
+		begin = lower_bound( R_set, limit, 1.0f / g_low );
+		end   = ( g_high <= 0.0f ) ? limit : upper_bound( R_set, limit, 1.0f / g_high );
+
+		if( begin < i ) begin = i;
+
+		for( j = begin ; j < end ; j++ )
+		{
+			x[0] = R_set[i];
+			x[1] = R_set[j];
+
+			YIELD_consider(&search, x);
+		}
+	}
+
+	if( search.pass_best > 0 )
+	{
+		*R1 = search.x_best[0];
+		*R2 = search.x_best[1];
+	}
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+
+/*
+ * YIELD_RESISTOR_RATIO_1R(ratio_max, ratio_min, RESISTOR_EIA_standard, R_max, R_min, T,
+ * 						   distribution, N_samples, R1, R2)
+ *
+ * Description:
+ *
+ * Selects two resistors limited between two bounds with the highest yield of R1 / R2 within
+ * a window and returns the estimated yield.
+ *
+ * @parameter	ratio_max, ratio_min			:	Specification window of the ratio.
+ * @parameter	RESISTOR_EIA_standard			:	EIA standard from which the resistors are chosen.
+ * @parameter	R_max, R_min					:	Maximum and minimum bounds for resistors R1 and R2.
+ * @parameter	T								:	Tolerance of resistors (in percentage).
+ * @parameter	distribution					:	Distribution of the resistor values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1, R2							:	Pointers to chosen values of resistors.
+ *
+ */
+
+float YIELD_RESISTOR_RATIO_1R(float ratio_max, float ratio_min, EIA_standard RESISTOR_EIA_standard,
+							  float R_max, float R_min, float T,
+							  YIELD_distribution distribution, int N_samples, float* R1, float* R2)
+{
+	YIELD_search search;
+	float* R_set;
+	float x[2];
+	float t, yield, spread;
+
+	int i, j, limit, low, high, begin, end;
+
+	if( !YIELD_isTolerance(T) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
+	t = 0.01f * T;
+	spread = ( 1.0f + t ) / ( 1.0f - t );
+
+	if( !YIELD_begin(&search, YIELD_networkRatio1R, 2, ratio_max, ratio_min, distribution, N_samples) ) return(0.0f);
+
+	search.t[0] = t;
+	search.t[1] = t;
+	search.sign[1] = -1;
+
+	low  = lower_bound( R_set, limit, R_min );
+	high = upper_bound( R_set, limit, R_max );
+
+	for( i = low ; i < high ; i++ )
+	{
+		begin = lower_bound( R_set, high, R_set[i] / ( ratio_max * spread ) );
+		end   = upper_bound( R_set, high, R_set[i] * spread / ratio_min );
+
+		if( begin < low ) begin = low;
+
+		for( j = begin ; j < end ; j++ )
+		{
+			x[0] = R_set[i];
+			x[1] = R_set[j];
+
+			YIELD_consider(&search, x);
+		}
+	}
+
+	if( search.pass_best > 0 )
+	{
+		*R1 = search.x_best[0];
+		*R2 = search.x_best[1];
+	}
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+
+/*
+ * YIELD_RESISTOR_RATIO_2R(ratio_max, ratio_min, RESISTOR_EIA_standard, R_max, R_min, T,
+ * 						   distribution, N_samples, pair, ratio, R1_A, R1_B, R2_A, R2_B)
+ *
+ * Description:
+ *
+ * Search of YIELD_RESISTOR_RATIO_2RS() and YIELD_RESISTOR_RATIO_2RP(), whose pairs of
+ * resistors are combined by the network pair and whose ratio is the network ratio.
+ *
+ * The pairs within the bounds are sorted once by value. The value of a pair moves by at
+ * most the tolerance, so for every pair of the numerator the pairs of the denominator are a
+ * range of the sorted pairs, found by binary search. The search takes O(n^2 log n) steps
+ * besides the candidates it considers, for n resistors within the bounds.
+ *
+ */
+
+float YIELD_RESISTOR_RATIO_2R(float ratio_max, float ratio_min, EIA_standard RESISTOR_EIA_standard,
+							  float R_max, float R_min, float T,
+							  YIELD_distribution distribution, int N_samples,
+							  YIELD_network pair, YIELD_network ratio,
+							  float* R1_A, float* R1_B, float* R2_A, float* R2_B)
+{
+	YIELD_search search;
+	YIELD_pair* pairs;
+	float* R_set;
+	float* value;
+	float x[4];
+	float t, yield, spread;
+
+	int a, b, N, limit, low, high, begin, end;
+
+	if( !YIELD_isTolerance(T) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_standard);
+	limit = RESISTOR_getSize(RESISTOR_EIA_standard);
+	t = 0.01f * T;
+	spread = ( 1.0f + t ) / ( 1.0f - t );
+
+	if( !YIELD_begin(&search, ratio, 4, ratio_max, ratio_min, distribution, N_samples) ) return(0.0f);
+
+	for( a = 0 ; a < 4 ; a++ ) search.t[a] = t;
+
+	search.sign[2] = -1;
+	search.sign[3] = -1;
+
+	low  = lower_bound( R_set, limit, R_min );
+	high = upper_bound( R_set, limit, R_max );
+
+	pairs = YIELD_getPairs( R_set, low, high, pair, &value, &N );
+
+	if( pairs == NULL )
+	{
+		YIELD_end(&search);
+		return(0.0f);
+	}
+
+	for( a = 0 ; a < N ; a++ )
+	{
+		begin = lower_bound( value, N, pairs[a].value / ( ratio_max * spread ) );
+		end   = upper_bound( value, N, pairs[a].value * spread / ratio_min );
+
+		for( b = begin ; b < end ; b++ )
+		{
+			x[0] = R_set[ pairs[a].i ];
+			x[1] = R_set[ pairs[a].j ];
+			x[2] = R_set[ pairs[b].i ];
+			x[3] = R_set[ pairs[b].j ];
+
+			YIELD_consider(&search, x);
+		}
+	}
+
+	free(pairs);
+	free(value);
+
+	if( search.pass_best > 0 )
+	{
+		*R1_A = search.x_best[0];
+		*R1_B = search.x_best[1];
+		*R2_A = search.x_best[2];
+		*R2_B = search.x_best[3];
+	}
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+
+/*
+ * YIELD_RESISTOR_RATIO_2RS(ratio_max, ratio_min, RESISTOR_EIA_standard, R_max, R_min, T,
+ * 							distribution, N_samples, R1_A, R1_B, R2_A, R2_B)
+ *
+ * Description:
+ *
+ * Selects four resistors limited between two bounds with the highest yield of
+ * ( R1_A + R1_B ) / ( R2_A + R2_B ) within a window and returns the estimated yield.
+ *
+ * @parameter	ratio_max, ratio_min			:	Specification window of the ratio.
+ * @parameter	RESISTOR_EIA_standard			:	EIA standard from which the resistors are chosen.
+ * @parameter	R_max, R_min					:	Maximum and minimum bounds for the resistors.
+ * @parameter	T								:	Tolerance of resistors (in percentage).
+ * @parameter	distribution					:	Distribution of the resistor values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1_A, R1_B, R2_A, R2_B			:	Pointers to chosen values of resistors.
+ *
+ */
+
+float YIELD_RESISTOR_RATIO_2RS(float ratio_max, float ratio_min, EIA_standard RESISTOR_EIA_standard,
+							   float R_max, float R_min, float T,
+							   YIELD_distribution distribution, int N_samples,
+							   float* R1_A, float* R1_B, float* R2_A, float* R2_B)
+{
+	return( YIELD_RESISTOR_RATIO_2R( ratio_max, ratio_min, RESISTOR_EIA_standard, R_max, R_min, T, distribution, N_samples,
+									 YIELD_network2RS, YIELD_networkRatio2RS, R1_A, R1_B, R2_A, R2_B ) );
+}
+
+
+/*
+ * YIELD_RESISTOR_RATIO_2RP(ratio_max, ratio_min, RESISTOR_EIA_standard, R_max, R_min, T,
+ * 							distribution, N_samples, R1_A, R1_B, R2_A, R2_B)
+ *
+ * Description:
+ *
+ * Selects four resistors limited between two bounds with the highest yield of
+ * ( R1_A || R1_B ) / ( R2_A || R2_B ) within a window and returns the estimated yield.
+ *
+ * @parameter	ratio_max, ratio_min			:	Specification window of the ratio.
+ * @parameter	RESISTOR_EIA_standard			:	EIA standard from which the resistors are chosen.
+ * @parameter	R_max, R_min					:	Maximum and minimum bounds for the resistors.
+ * @parameter	T								:	Tolerance of resistors (in percentage).
+ * @parameter	distribution					:	Distribution of the resistor values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1_A, R1_B, R2_A, R2_B			:	Pointers to chosen values of resistors.
+ *
+ */
+
+float YIELD_RESISTOR_RATIO_2RP(float ratio_max, float ratio_min, EIA_standard RESISTOR_EIA_standard,
+							   float R_max, float R_min, float T,
+							   YIELD_distribution distribution, int N_samples,
+							   float* R1_A, float* R1_B, float* R2_A, float* R2_B)
+{
+	return( YIELD_RESISTOR_RATIO_2R( ratio_max, ratio_min, RESISTOR_EIA_standard, R_max, R_min, T, distribution, N_samples,
+									 YIELD_network2RP, YIELD_networkRatio2RP, R1_A, R1_B, R2_A, R2_B ) );
+}
+
+
+/*
+ * YIELD_RC_1R1C(tau_max, tau_min, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min,
+ * 				 T_R, T_C, distribution, N_samples, R, C)
+ *
+ * Description:
+ *
+ * Selects R and C limited between bounds with the highest yield of the RC time constant
+ * within a window and returns the estimated yield.
+ *
+ * @parameter	tau_max, tau_min				:	Specification window of the time constant in seconds.
+ * @parameter	RESISTOR_EIA_std				:	EIA standard set from which resistor are chosen.
+ * @parameter	CAPACITOR_EIA_std				:	EIA standard set from which capacitor are chosen.
+ * @parameter	R_max, R_min					:	Maximum and minimum value of resistor.
+ * @parameter	C_max, C_min					:	Maximum and minimum value of capacitor.
+ * @parameter	T_R, T_C						:	Tolerance of resistor and capacitor (in percentage).
+ * @parameter	distribution					:	Distribution of the part values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R								:	Pointer to chosen value of resistor.
+ * @parameter	C								:	Pointer to chosen value of capacitor.
+ *
+ */
+
+float YIELD_RC_1R1C(float tau_max, float tau_min,
+					EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+					float R_max, float R_min, float C_max, float C_min,
+					float T_R, float T_C,
+					YIELD_distribution distribution, int N_samples, float* R, float* C)
+{
+	YIELD_search search;
+	float* R_set;
+	float* C_set;
+	float x[2];
+	float t_R, t_C, yield;
+
+	int i, j, R_low, R_high, C_low, C_high, begin, end;
+
+	if( !YIELD_isTolerance(T_R) || !YIELD_isTolerance(T_C) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
+	t_R = 0.01f * T_R;
+	t_C = 0.01f * T_C;
+
+	if( !YIELD_begin(&search, YIELD_network1R1C, 2, tau_max, tau_min, distribution, N_samples) ) return(0.0f);
+
+	search.t[0] = t_R;
+	search.t[1] = t_C;
+
+	R_low  = lower_bound( R_set, RESISTOR_getSize(RESISTOR_EIA_std), R_min );
+	R_high = upper_bound( R_set, RESISTOR_getSize(RESISTOR_EIA_std), R_max );
+	C_low  = lower_bound( C_set, CAPACITOR_getSize(CAPACITOR_EIA_std), C_min );
+	C_high = upper_bound( C_set, CAPACITOR_getSize(CAPACITOR_EIA_std), C_max );
+
+	for( i = R_low ; i < R_high ; i++ )
+	{
+		begin = lower_bound( C_set, C_high, tau_min / ( R_set[i] * ( 1.0f + t_R ) * ( 1.0f + t_C ) ) );
+		end   = upper_bound( C_set, C_high, tau_max / ( R_set[i] * ( 1.0f - t_R ) * ( 1.0f - t_C ) ) );
+
+		if( begin < C_low ) begin = C_low;
+
+		for( j = begin ; j < end ; j++ )
+		{
+			x[0] = R_set[i];
+			x[1] = C_set[j];
+
+			YIELD_consider(&search, x);
+		}
+	}
+
+	if( search.pass_best > 0 )
+	{
+		*R = search.x_best[0];
+		*C = search.x_best[1];
+	}
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+
+/*
+ * YIELD_RC_2RS1C(tau_max, tau_min, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min,
+ * 				  T_R, T_C, distribution, N_samples, R1, R2, C)
+ *
+ * Description:
+ *
+ * Selects two resistors in series and a capacitor limited between bounds with the highest
+ * yield of the RC time constant within a window and returns the estimated yield.
+ *
+ * @parameter	tau_max, tau_min				:	Specification window of the time constant in seconds.
+ * @parameter	RESISTOR_EIA_std				:	EIA standard set from which resistor are chosen.
+ * @parameter	CAPACITOR_EIA_std				:	EIA standard set from which capacitor are chosen.
+ * @parameter	R_max, R_min					:	Maximum and minimum value of resistor.
+ * @parameter	C_max, C_min					:	Maximum and minimum value of capacitor.
+ * @parameter	T_R, T_C						:	Tolerance of resistors and capacitor (in percentage).
+ * @parameter	distribution					:	Distribution of the part values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1, R2							:	Pointers to chosen values of resistors.
+ * @parameter	C								:	Pointer to chosen value of capacitor.
+ *
+ */
+
+float YIELD_RC_2RS1C(float tau_max, float tau_min,
+					 EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+					 float R_max, float R_min, float C_max, float C_min,
+					 float T_R, float T_C,
+					 YIELD_distribution distribution, int N_samples, float* R1, float* R2, float* C)
+{
+	YIELD_search search;
+	float* R_set;
+	float* C_set;
+	float x[3];
+	float t_R, t_C, yield, R_eff;
+
+	int i, j, k, R_low, R_high, C_low, C_high, begin, end;
+
+	if( !YIELD_isTolerance(T_R) || !YIELD_isTolerance(T_C) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
+	t_R = 0.01f * T_R;
+	t_C = 0.01f * T_C;
+
+	if( !YIELD_begin(&search, YIELD_network2RS1C, 3, tau_max, tau_min, distribution, N_samples) ) return(0.0f);
+
+	search.t[0] = t_R;
+	search.t[1] = t_R;
+	search.t[2] = t_C;
+
+	R_low  = lower_bound( R_set, RESISTOR_getSize(RESISTOR_EIA_std), R_min );
+	R_high = upper_bound( R_set, RESISTOR_getSize(RESISTOR_EIA_std), R_max );
+	C_low  = lower_bound( C_set, CAPACITOR_getSize(CAPACITOR_EIA_std), C_min );
+	C_high = upper_bound( C_set, CAPACITOR_getSize(CAPACITOR_EIA_std), C_max );
+
+	for( i = R_low ; i < R_high ; i++ )
+	{
+		for( j = i ; j < R_high ; j++ )
+		{
+			R_eff = RESISTOR_ER2S( R_set[i], R_set[j] );
+
+			begin = lower_bound( C_set, C_high, tau_min / ( R_eff * ( 1.0f + t_R ) * ( 1.0f + t_C ) ) );
+			end   = upper_bound( C_set, C_high, tau_max / ( R_eff * ( 1.0f - t_R ) * ( 1.0f - t_C ) ) );
+
+			if( begin < C_low ) begin = C_low;
+
+			for( k = begin ; k < end ; k++ )
+			{
+				x[0] = R_set[i];
+				x[1] = R_set[j];
+				x[2] = C_set[k];
+
+				YIELD_consider(&search, x);
+			}
+		}
+	}
+
+	if( search.pass_best > 0 )
+	{
+		*R1 = search.x_best[0];
+		*R2 = search.x_best[1];
+		*C  = search.x_best[2];
+	}
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+/*
+ * YIELD_RC_2RP1C(tau_max, tau_min, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min,
+ * 				  T_R, T_C, distribution, N_samples, R1, R2, C)
+ *
+ * Description:
+ *
+ * Selects two resistors in parallel and a capacitor limited between bounds with the highest
+ * yield of the RC time constant within a window and returns the estimated yield.
+ *
+ * @parameter	tau_max, tau_min				:	Specification window of the time constant in seconds.
+ * @parameter	RESISTOR_EIA_std				:	EIA standard set from which resistor are chosen.
+ * @parameter	CAPACITOR_EIA_std				:	EIA standard set from which capacitor are chosen.
+ * @parameter	R_max, R_min					:	Maximum and minimum value of resistor.
+ * @parameter	C_max, C_min					:	Maximum and minimum value of capacitor.
+ * @parameter	T_R, T_C						:	Tolerance of resistors and capacitor (in percentage).
+ * @parameter	distribution					:	Distribution of the part values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1, R2							:	Pointers to chosen values of resistors.
+ * @parameter	C								:	Pointer to chosen value of capacitor.
+ *
+ */
+
+float YIELD_RC_2RP1C(float tau_max, float tau_min,
+					 EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+					 float R_max, float R_min, float C_max, float C_min,
+					 float T_R, float T_C,
+					 YIELD_distribution distribution, int N_samples, float* R1, float* R2, float* C)
+{
+	YIELD_search search;
+	float* R_set;
+	float* C_set;
+	float x[3];
+	float t_R, t_C, yield, R_eff;
+
+	int i, j, k, R_low, R_high, C_low, C_high, begin, end;
+
+	if( !YIELD_isTolerance(T_R) || !YIELD_isTolerance(T_C) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
+	t_R = 0.01f * T_R;
+	t_C = 0.01f * T_C;
+
+	if( !YIELD_begin(&search, YIELD_network2RP1C, 3, tau_max, tau_min, distribution, N_samples) ) return(0.0f);
+
+	search.t[0] = t_R;
+	search.t[1] = t_R;
+	search.t[2] = t_C;
+
+	R_low  = lower_bound( R_set, RESISTOR_getSize(RESISTOR_EIA_std), R_min );
+	R_high = upper_bound( R_set, RESISTOR_getSize(RESISTOR_EIA_std), R_max );
+	C_low  = lower_bound( C_set, CAPACITOR_getSize(CAPACITOR_EIA_std), C_min );
+	C_high = upper_bound( C_set, CAPACITOR_getSize(CAPACITOR_EIA_std), C_max );
+
+	for( i = R_low ; i < R_high ; i++ )
+	{
+		for( j = i ; j < R_high ; j++ )
+		{
+			R_eff = RESISTOR_ER2P( R_set[i], R_set[j] );
+
+			begin = lower_bound( C_set, C_high, tau_min / ( R_eff * ( 1.0f + t_R ) * ( 1.0f + t_C ) ) );
+			end   = upper_bound( C_set, C_high, tau_max / ( R_eff * ( 1.0f - t_R ) * ( 1.0f - t_C ) ) );
+
+			if( begin < C_low ) begin = C_low;
+
+			for( k = begin ; k < end ; k++ )
+			{
+				x[0] = R_set[i];
+				x[1] = R_set[j];
+				x[2] = C_set[k];
+
+				YIELD_consider(&search, x);
+			}
+		}
+	}
+
+	if( search.pass_best > 0 )
+	{
+		*R1 = search.x_best[0];
+		*R2 = search.x_best[1];
+		*C  = search.x_best[2];
+	}
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+/*
+ * YIELD_RC_3R1C(tau_max, tau_min, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min,
+ * 				 T_R, T_C, distribution, N_samples, parallel, R1, R2, R3, C)
+ *
+ * Description:
+ *
+ * Search of YIELD_RC_3RS1C() and YIELD_RC_3RP1C(), with the three resistors in parallel if
+ * parallel is set and in series otherwise.
+ *
+ * The time constant moves by at most the tolerances, so the capacitors within bounds
+ * bound the resistance of the network. R3 is then found by binary search for every R1 and
+ * R2, and the capacitor for every three resistors.
+ *
+ */
+
+float YIELD_RC_3R1C(float tau_max, float tau_min,
+					EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+					float R_max, float R_min, float C_max, float C_min,
+					float T_R, float T_C,
+					YIELD_distribution distribution, int N_samples, int parallel,
+					float* R1, float* R2, float* R3, float* C)
+{
+	YIELD_search search;
+	float* R_set;
+	float* C_set;
+	float x[4];
+	float t_R, t_C, yield, R_eff, R_low_eff, R_high_eff, rest_low, rest_high;
+
+	int i, j, k, l, R_low, R_high, C_low, C_high, begin, end, C_begin, C_end;
+
+	if( !YIELD_isTolerance(T_R) || !YIELD_isTolerance(T_C) ) return(0.0f);
+
+	R_set = RESISTOR_getSet(RESISTOR_EIA_std);
+	C_set = CAPACITOR_getSet(CAPACITOR_EIA_std);
+	t_R = 0.01f * T_R;
+	t_C = 0.01f * T_C;
+
+	if( !YIELD_begin(&search, parallel ? YIELD_network3RP1C : YIELD_network3RS1C, 4, tau_max, tau_min, distribution, N_samples) ) return(0.0f);
+
+	search.t[0] = t_R;
+	search.t[1] = t_R;
+	search.t[2] = t_R;
+	search.t[3] = t_C;
+
+	R_low  = lower_bound( R_set, RESISTOR_getSize(RESISTOR_EIA_std), R_min );
+	R_high = upper_bound( R_set, RESISTOR_getSize(RESISTOR_EIA_std), R_max );
+	C_low  = lower_bound( C_set, CAPACITOR_getSize(CAPACITOR_EIA_std), C_min );
+	C_high = upper_bound( C_set, CAPACITOR_getSize(CAPACITOR_EIA_std), C_max );
+
+	if( R_low >= R_high || C_low >= C_high )
+	{
+		YIELD_end(&search);
+		return(0.0f);
+	}
+
+	//	Resistance of the network reaching the window with some capacitor within bounds.
+
+	R_low_eff  = tau_min / ( C_set[ C_high - 1 ] * ( 1.0f + t_R ) * ( 1.0f + t_C ) );
+	R_high_eff = tau_max / ( C_set[C_low] * ( 1.0f - t_R ) * ( 1.0f - t_C ) );
+
+	for( i = R_low ; i < R_high ; i++ )
+	{
+		for( j = i ; j < R_high ; j++ )
+		{
+			//	Range of R3, as a resistance in series or a conductance in parallel.
+
+			if( parallel )
+			{
+				rest_low  = 1.0f / R_high_eff - 1.0f / R_set[i] - 1.0f / R_set[j];
+				rest_high = 1.0f / R_low_eff - 1.0f / R_set[i] - 1.0f / R_set[j];
+
+				if( rest_high <= 0.0f ) continue;
+
+				begin = lower_bound( R_set, R_high, 1.0f / rest_high );
+				end   = ( rest_low <= 0.0f ) ? R_high : upper_bound( R_set, R_high, 1.0f / rest_low );
+			}
+			else
+			{
+				rest_low  = R_low_eff - R_set[i] - R_set[j];
+				rest_high = R_high_eff - R_set[i] - R_set[j];
+
+				begin = lower_bound( R_set, R_high, rest_low );
+				end   = upper_bound( R_set, R_high, rest_high );
+			}
+
+			if( begin < j ) begin = j;
+
+			for( k = begin ; k < end ; k++ )
+			{
+				R_eff = parallel ? RESISTOR_ER3P( R_set[i], R_set[j], R_set[k] ) : RESISTOR_ER3S( R_set[i], R_set[j], R_set[k] );
+
+				C_begin = lower_bound( C_set, C_high, tau_min / ( R_eff * ( 1.0f + t_R ) * ( 1.0f + t_C ) ) );
+				C_end   = upper_bound( C_set, C_high, tau_max / ( R_eff * ( 1.0f - t_R ) * ( 1.0f - t_C ) ) );
+
+				if( C_begin < C_low ) C_begin = C_low;
+
+				for( l = C_begin ; l < C_end ; l++ )
+				{
+					x[0] = R_set[i];
+					x[1] = R_set[j];
+					x[2] = R_set[k];
+					x[3] = C_set[l];
+
+					YIELD_consider(&search, x);
+				}
+			}
+		}
+	}
+
+	if( search.pass_best > 0 )
+	{
+		*R1 = search.x_best[0];
+		*R2 = search.x_best[1];
+		*R3 = search.x_best[2];
+		*C  = search.x_best[3];
+	}
+
+	yield = YIELD_end(&search);
+
+	return(yield);
+}
+
+
+/*
+ * YIELD_RC_3RS1C(tau_max, tau_min, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min,
+ * 				  T_R, T_C, distribution, N_samples, R1, R2, R3, C)
+ *
+ * Description:
+ *
+ * Selects three resistors in series and a capacitor limited between bounds with the highest
+ * yield of the RC time constant within a window and returns the estimated yield.
+ *
+ * @parameter	tau_max, tau_min				:	Specification window of the time constant in seconds.
+ * @parameter	RESISTOR_EIA_std				:	EIA standard set from which resistor are chosen.
+ * @parameter	CAPACITOR_EIA_std				:	EIA standard set from which capacitor are chosen.
+ * @parameter	R_max, R_min					:	Maximum and minimum value of resistor.
+ * @parameter	C_max, C_min					:	Maximum and minimum value of capacitor.
+ * @parameter	T_R, T_C						:	Tolerance of resistors and capacitor (in percentage).
+ * @parameter	distribution					:	Distribution of the part values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1, R2, R3						:	Pointers to chosen values of resistors.
+ * @parameter	C								:	Pointer to chosen value of capacitor.
+ *
+ */
+
+float YIELD_RC_3RS1C(float tau_max, float tau_min,
+					 EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+					 float R_max, float R_min, float C_max, float C_min,
+					 float T_R, float T_C,
+					 YIELD_distribution distribution, int N_samples, float* R1, float* R2, float* R3, float* C)
+{
+	return( YIELD_RC_3R1C( tau_max, tau_min, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min,
+						   T_R, T_C, distribution, N_samples, 0, R1, R2, R3, C ) );
+}
+
+
+/*
+ * YIELD_RC_3RP1C(tau_max, tau_min, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min,
+ * 				  T_R, T_C, distribution, N_samples, R1, R2, R3, C)
+ *
+ * Description:
+ *
+ * Selects three resistors in parallel and a capacitor limited between bounds with the highest
+ * yield of the RC time constant within a window and returns the estimated yield.
+ *
+ * @parameter	tau_max, tau_min				:	Specification window of the time constant in seconds.
+ * @parameter	RESISTOR_EIA_std				:	EIA standard set from which resistor are chosen.
+ * @parameter	CAPACITOR_EIA_std				:	EIA standard set from which capacitor are chosen.
+ * @parameter	R_max, R_min					:	Maximum and minimum value of resistor.
+ * @parameter	C_max, C_min					:	Maximum and minimum value of capacitor.
+ * @parameter	T_R, T_C						:	Tolerance of resistors and capacitor (in percentage).
+ * @parameter	distribution					:	Distribution of the part values.
+ * @parameter	N_samples						:	Number of sampled builds per candidate.
+ * @parameter	R1, R2, R3						:	Pointers to chosen values of resistors.
+ * @parameter	C								:	Pointer to chosen value of capacitor.
+ *
+ */
+
+float YIELD_RC_3RP1C(float tau_max, float tau_min,
+					 EIA_standard RESISTOR_EIA_std, EIA_standard CAPACITOR_EIA_std,
+					 float R_max, float R_min, float C_max, float C_min,
+					 float T_R, float T_C,
+					 YIELD_distribution distribution, int N_samples, float* R1, float* R2, float* R3, float* C)
+{
+	return( YIELD_RC_3R1C( tau_max, tau_min, RESISTOR_EIA_std, CAPACITOR_EIA_std, R_max, R_min, C_max, C_min,
+						   T_R, T_C, distribution, N_samples, 1, R1, R2, R3, C ) );
+}
+
+#endif /* PASSIVE_YIELD_H_ */
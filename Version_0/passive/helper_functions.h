@@ -39,4 +39,61 @@ float standard_deviation(float* arr, int N)
 	return( result );
 }
 
+/*	Function to get the index of the first element of a sorted array not less than x. */
+
+int lower_bound(float* arr, int N, float x)
+{
+	int low = 0;
+	int high = N;
+	int middle;
+
+	while( low < high )
+	{
+		middle = ( low + high ) / 2;
+
+		if( arr[middle] < x ) low = middle + 1;
+		else high = middle;
+	}
+
+	return( low );
+}
+
+/*	Function to get the index of the first element of a sorted array greater than x. */
+
+int upper_bound(float* arr, int N, float x)
+{
+	int low = 0;
+	int high = N;
+	int middle;
+
+	while( low < high )
+	{
+		middle = ( low + high ) / 2;
+
+		if( arr[middle] <= x ) low = middle + 1;
+		else high = middle;
+	}
+
+	return( low );
+}
+
+/*	Function to get the index of the first element of a sorted integer array not less than x. */
+
+int lower_bound_int(int* arr, int N, int x)
+{
+	int low = 0;
+	int high = N;
+	int middle;
+
+	while( low < high )
+	{
+		middle = ( low + high ) / 2;
+
+		if( arr[middle] < x ) low = middle + 1;
+		else high = middle;
+	}
+
+	return( low );
+}
+
 #endif /* HELPER_FUNCTIONS_H_ */
@@ -48,7 +48,7 @@ typedef enum{ COPPER, ALUMINIUM } conductor_t;
 
 float WIRE_getSkinDepth(conductor_t Conductor_Type, float f)
 {
-	float rho;
+	float rho = RHO_CU;
 	float t;
 	float delta;
 	float mu_r = 1.0f;
@@ -85,7 +85,7 @@ SWG_t WIRE_getMaxGauge(conductor_t Conductor_Type, float I_max, float J_max, flo
 	float error_min = 100.0f;
 
 	int gauge;
-	int gauge_optimal;
+	int gauge_optimal = 0;
 
 	delta = WIRE_getSkinDepth(Conductor_Type, f);
 
@@ -132,7 +132,7 @@ SWG_t WIRE_getMinGauge(conductor_t Conductor_Type, float I_max, float J_max, flo
 	float error_min = 100.0f;
 
 	int gauge;
-	int gauge_optimal;
+	int gauge_optimal = 0;
 
 	delta = WIRE_getSkinDepth(Conductor_Type, f);
 
@@ -166,7 +166,7 @@ SWG_t WIRE_getMinGauge(conductor_t Conductor_Type, float I_max, float J_max, flo
 
 void WIRE_getParameters(conductor_t Conductor_Type, float radius, float f, float* delta, float* A_c, float* r)
 {
-	float rho;
+	float rho = RHO_CU;
 
 	switch( Conductor_Type )
 	{